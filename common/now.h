@@ -9,3 +9,9 @@
 int64_t now_micros();
 int64_t now_ms();
 int64_t now_s();
+
+// CLOCK_MONOTONIC in milliseconds. Only for differences between times
+// taken on the same machine, e.g. the mono_timestamp_ms of sensor protos.
+// The stamps are taken by the io2 programs, so this is the io2/lib/timer.c
+// function and needs io2/lib.
+extern "C" int64_t now_mono_ms();
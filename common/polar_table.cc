@@ -0,0 +1,205 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "common/polar_table.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+
+#include "common/normalize.h"
+#include "common/polar_diagram.h"
+
+namespace {
+const double kAngleStep = 1;    // degrees
+const int kAngles = 181;        // 0 .. 180 degrees
+const double kWindStep = 0.5;   // m/s
+const int kWindSteps = 61;      // 0 .. 30 m/s
+
+// Index and fraction of x on a grid with n points and the given step,
+// clamped to the grid.
+inline int GridIndex(double x, double step, int n, double* fraction) {
+  x /= step;
+  if (x <= 0) {
+    *fraction = 0;
+    return 0;
+  }
+  if (x >= n - 1) {
+    *fraction = 1;
+    return n - 2;
+  }
+  int i = (int)x;
+  *fraction = x - i;
+  return i;
+}
+
+// Same for a sorted, non-uniform axis.
+int AxisIndex(const std::vector<double>& axis, double x, double* fraction) {
+  int n = axis.size();
+  if (n == 1 || x <= axis[0]) {
+    *fraction = 0;
+    return 0;
+  }
+  if (x >= axis[n - 1]) {
+    *fraction = 1;
+    return n - 2;
+  }
+  int i = 0;
+  while (axis[i + 1] < x)
+    ++i;
+  *fraction = (x - axis[i]) / (axis[i + 1] - axis[i]);
+  return i;
+}
+}  // namespace
+
+PolarTable::PolarTable() : speed_(kAngles * kWindSteps) {
+  for (int i = 0; i < kAngles; ++i) {
+    for (int j = 0; j < kWindSteps; ++j) {
+      bool dead_zone_tack;
+      bool dead_zone_jibe;
+      double speed;
+      ReadPolarDiagram(i * kAngleStep, j * kWindStep,
+                       &dead_zone_tack, &dead_zone_jibe, &speed);
+      Set(i, j, speed);
+    }
+  }
+}
+
+void PolarTable::Set(int angle_index, int wind_index, double speed) {
+  speed_[angle_index * kWindSteps + wind_index] = speed;
+}
+
+bool PolarTable::Load(const char* filename) {
+  FILE* fp = fopen(filename, "r");
+  if (!fp) {
+    syslog(LOG_ERR, "Could not open polar file %s", filename);
+    return false;
+  }
+  std::vector<double> winds;
+  std::vector<double> angles;
+  std::vector<double> speeds;  // angle major
+  bool ok = true;
+  char line[1024];
+  while (ok && fgets(line, sizeof(line), fp)) {
+    if (line[0] == '#' || line[0] == '\n')
+      continue;
+    char* p = line;
+    char* end;
+    if (winds.empty()) {
+      if (strncmp(p, "wind_m_s", 8)) {
+        ok = false;
+        break;
+      }
+      p += 8;
+      // A boat without wind does not move.
+      winds.push_back(0);
+      for (double w = strtod(p, &end); end != p; w = strtod(p, &end)) {
+        p = end;
+        if (w > winds.back())
+          winds.push_back(w);
+        else if (w != 0 || winds.size() > 1)
+          ok = false;
+      }
+      continue;
+    }
+    double angle = strtod(p, &end);
+    if (end == p || (!angles.empty() && angle <= angles.back())) {
+      ok = false;
+      break;
+    }
+    p = end;
+    angles.push_back(angle);
+    speeds.push_back(0);
+    for (size_t j = 1; j < winds.size(); ++j) {
+      double s = strtod(p, &end);
+      if (end == p || s < 0) {
+        ok = false;
+        break;
+      }
+      p = end;
+      speeds.push_back(s);
+    }
+  }
+  fclose(fp);
+  if (!ok || winds.size() < 2 || angles.empty()) {
+    syslog(LOG_ERR, "Bad polar file %s", filename);
+    return false;
+  }
+
+  const int m = winds.size();
+  const int measured_angles = angles.size();
+  // Nobody measures the boat speed head to wind. Without a row for 0 degrees
+  // the first row would be used for all smaller angles and the routers would
+  // steer straight upwind, so the speed goes down to zero at 0 degrees.
+  if (angles[0] > 0) {
+    angles.insert(angles.begin(), 0);
+    speeds.insert(speeds.begin(), m, 0);
+  }
+  for (int i = 0; i < kAngles; ++i) {
+    double fa;
+    int a = AxisIndex(angles, i * kAngleStep, &fa);
+    int a1 = angles.size() > 1 ? a + 1 : a;
+    for (int j = 0; j < kWindSteps; ++j) {
+      double fw;
+      int w = AxisIndex(winds, j * kWindStep, &fw);
+      double s0 = speeds[a * m + w] * (1 - fw) + speeds[a * m + w + 1] * fw;
+      double s1 = speeds[a1 * m + w] * (1 - fw) + speeds[a1 * m + w + 1] * fw;
+      Set(i, j, s0 * (1 - fa) + s1 * fa);
+    }
+  }
+  syslog(LOG_NOTICE, "Loaded polar file %s with %d angles and %d wind speeds",
+         filename, measured_angles, m - 1);
+  return true;
+}
+
+double PolarTable::Speed(double angle_true_wind_deg,
+                         double wind_speed_m_s) const {
+  double a = fabs(angle_true_wind_deg);
+  if (a > 180)
+    a = fabs(SymmetricDeg(angle_true_wind_deg));
+  double fa;
+  double fw;
+  int i = GridIndex(a, kAngleStep, kAngles, &fa);
+  int j = GridIndex(wind_speed_m_s, kWindStep, kWindSteps, &fw);
+  const double* s = &speed_[i * kWindSteps + j];
+  double s0 = s[0] + (s[1] - s[0]) * fw;
+  double s1 = s[kWindSteps] + (s[kWindSteps + 1] - s[kWindSteps]) * fw;
+  return s0 + (s1 - s0) * fa;
+}
+
+void PolarTable::Read(double angle_true_wind_deg,
+                      double wind_speed_m_s,
+                      bool* dead_zone_tack,
+                      bool* dead_zone_jibe,
+                      double* boat_speed_m_s) const {
+  if (wind_speed_m_s < 0.01) {
+    *dead_zone_tack = false;
+    *dead_zone_jibe = false;
+    *boat_speed_m_s = 0;
+    return;
+  }
+  double a = fabs(angle_true_wind_deg);
+  if (a > 180)
+    a = fabs(SymmetricDeg(angle_true_wind_deg));
+  *dead_zone_tack = a < TackZoneDeg();
+  *dead_zone_jibe = a > JibeZoneDeg();
+  *boat_speed_m_s = Speed(a, wind_speed_m_s);
+}
+
+namespace {
+PolarTable* MutableDefaultPolarTable() {
+  static PolarTable table;
+  return &table;
+}
+}  // namespace
+
+const PolarTable& DefaultPolarTable() {
+  return *MutableDefaultPolarTable();
+}
+
+bool LoadDefaultPolarTable(const char* filename) {
+  return MutableDefaultPolarTable()->Load(filename);
+}
@@ -0,0 +1,64 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef COMMON_POLAR_TABLE_H_
+#define COMMON_POLAR_TABLE_H_
+
+#include <vector>
+
+// Tabulated polar diagram with bilinear interpolation.
+//
+// The table covers the angle to the true wind from 0 to 180 degrees in
+// 1 degree steps and the true wind speed from 0 to 30 m/s in 0.5 m/s steps.
+// Outside of this range the nearest border value is used.
+//
+// By default it is filled from the analytic ReadPolarDiagram. Against that,
+// the interpolation error is below 0.01 m/s everywhere and below
+// 0.001 m/s for wind speeds below 5 m/s (see polar_table_test.cc).
+//
+// Measured polars can be loaded from a text file:
+//
+//   # comment lines start with '#'
+//   wind_m_s  2    4    6    8   ...
+//   45        0.3  0.6  0.9  1.1 ...
+//   60        0.4  0.8  1.1  1.4 ...
+//   ...
+//
+// The first line lists the true wind speeds of the columns, every
+// following line starts with the angle to the true wind in degrees and
+// gives the boat speeds in m/s for these wind speeds. Angles and wind
+// speeds must be increasing. If the first angle is above 0 degrees, the
+// speed falls linearly to zero at 0 degrees below it. The measurements
+// are resampled onto the table grid, so the lookup cost does not depend
+// on the file.
+class PolarTable {
+ public:
+  // Filled from ReadPolarDiagram.
+  PolarTable();
+
+  // Returns false (and leaves the table unchanged) if the file could not
+  // be read or is inconsistent.
+  bool Load(const char* filename);
+
+  // Same interface and conventions as ReadPolarDiagram.
+  void Read(double angle_true_wind_deg,
+            double wind_speed_m_s,
+            bool* dead_zone_tack,
+            bool* dead_zone_jibe,
+            double* boat_speed_m_s) const;
+
+  double Speed(double angle_true_wind_deg, double wind_speed_m_s) const;
+
+ private:
+  void Set(int angle_index, int wind_index, double speed);
+
+  // speed_[angle_index * kWindSteps + wind_index]
+  std::vector<double> speed_;
+};
+
+// The polar used by the skipper and the routers. It is built from the
+// analytic polar on first use and can be replaced by a measured one.
+const PolarTable& DefaultPolarTable();
+bool LoadDefaultPolarTable(const char* filename);
+
+#endif  // COMMON_POLAR_TABLE_H_
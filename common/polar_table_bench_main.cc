@@ -0,0 +1,63 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Benchmark of the polar table lookup against ReadPolarDiagram.
+// Run with "make bench".
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "common/now.h"
+#include "common/polar_diagram.h"
+#include "common/polar_table.h"
+
+int debug = 0;
+
+int main(int argc, char** argv) {
+  const int kN = 1000;
+  const int kRounds = 2000;
+  std::vector<double> angle(kN), wind(kN);
+  for (int i = 0; i < kN; ++i) {
+    angle[i] = rand() * 360.0 / RAND_MAX - 180;
+    wind[i] = rand() * 15.0 / RAND_MAX;
+  }
+  const PolarTable& table = DefaultPolarTable();
+  bool tack, jibe;
+  double speed;
+  double sum = 0;
+
+  int64_t start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i < kN; ++i) {
+      ReadPolarDiagram(angle[i], wind[i], &tack, &jibe, &speed);
+      sum += speed;
+    }
+  }
+  int64_t analytic_us = now_micros() - start;
+
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i < kN; ++i) {
+      table.Read(angle[i], wind[i], &tack, &jibe, &speed);
+      sum += speed;
+    }
+  }
+  int64_t read_us = now_micros() - start;
+
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i < kN; ++i) {
+      sum += table.Speed(angle[i], wind[i]);
+    }
+  }
+  int64_t speed_us = now_micros() - start;
+
+  double calls = double(kN) * kRounds;
+  printf("ReadPolarDiagram   %6.1lf ns/call\n", analytic_us * 1000.0 / calls);
+  printf("PolarTable::Read   %6.1lf ns/call\n", read_us * 1000.0 / calls);
+  printf("PolarTable::Speed  %6.1lf ns/call\n", speed_us * 1000.0 / calls);
+  fprintf(stderr, "(%lg)\n", sum);
+  return 0;
+}
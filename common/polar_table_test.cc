@@ -0,0 +1,116 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "common/polar_table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common/polar_diagram.h"
+#include "lib/testing/testing.h"
+
+int debug = 0;
+
+namespace {
+double Analytic(double angle_deg, double wind_m_s) {
+  bool dead_zone_tack;
+  bool dead_zone_jibe;
+  double speed;
+  ReadPolarDiagram(angle_deg, wind_m_s, &dead_zone_tack, &dead_zone_jibe, &speed);
+  return speed;
+}
+}  // namespace
+
+ATEST(PolarTable, GridPoints) {
+  const PolarTable& table = DefaultPolarTable();
+  for (int angle = -180; angle <= 180; angle += 5) {
+    for (double wind = 0; wind <= 30; wind += 2.5) {
+      EXPECT_FLOAT_EQ(Analytic(angle, wind), table.Speed(angle, wind));
+    }
+  }
+}
+
+// The error bounds documented in polar_table.h
+ATEST(PolarTable, Accuracy) {
+  const PolarTable& table = DefaultPolarTable();
+  double max_error = 0;
+  double max_error_light = 0;
+  for (double angle = -180; angle <= 180; angle += 0.13) {
+    for (double wind = 0.01; wind <= 30; wind += 0.037) {
+      double error = fabs(Analytic(angle, wind) - table.Speed(angle, wind));
+      if (error > max_error) max_error = error;
+      if (wind < 5 && error > max_error_light) max_error_light = error;
+    }
+  }
+  printf("max error %lg m/s, below 5 m/s wind %lg m/s\n",
+         max_error, max_error_light);
+  EXPECT_LT(max_error, 0.01);
+  EXPECT_LT(max_error_light, 0.001);
+}
+
+ATEST(PolarTable, Read) {
+  const PolarTable& table = DefaultPolarTable();
+  for (double angle = -400; angle <= 400; angle += 7) {
+    bool tack, jibe, tack_t, jibe_t;
+    double speed, speed_t;
+    ReadPolarDiagram(angle, 6, &tack, &jibe, &speed);
+    table.Read(angle, 6, &tack_t, &jibe_t, &speed_t);
+    EXPECT_EQ(tack, tack_t);
+    EXPECT_EQ(jibe, jibe_t);
+    EXPECT_EQ_TOL(speed, speed_t, 0.01);
+  }
+  bool tack, jibe;
+  double speed = 1;
+  table.Read(90, 0, &tack, &jibe, &speed);
+  EXPECT_EQ(0, speed);
+}
+
+ATEST(PolarTable, Load) {
+  const char* kFile = "/tmp/polar_table_test.txt";
+  FILE* fp = fopen(kFile, "w");
+  fprintf(fp, "# measured polar\n"
+              "wind_m_s  4    8\n"
+              "0         0.2  0.4\n"
+              "90        1.0  2.0\n"
+              "180       0.6  1.2\n");
+  fclose(fp);
+  PolarTable table;
+  EXPECT_TRUE(table.Load(kFile));
+  EXPECT_FLOAT_EQ(1.0, table.Speed(90, 4));
+  EXPECT_FLOAT_EQ(2.0, table.Speed(-90, 8));
+  EXPECT_FLOAT_EQ(1.5, table.Speed(90, 6));
+  EXPECT_FLOAT_EQ(0.5, table.Speed(90, 2));   // towards no wind, no speed
+  EXPECT_FLOAT_EQ(2.0, table.Speed(90, 20));  // clamped
+  EXPECT_FLOAT_EQ(0.8, table.Speed(135, 4));
+  EXPECT_FLOAT_EQ(0.3, table.Speed(0, 6));
+
+  // Decreasing angles are rejected and the table stays as it was.
+  fp = fopen(kFile, "w");
+  fprintf(fp, "wind_m_s 4 8\n90 1 2\n45 0.5 1\n");
+  fclose(fp);
+  EXPECT_FALSE(table.Load(kFile));
+  EXPECT_FLOAT_EQ(1.5, table.Speed(90, 6));
+  EXPECT_FALSE(table.Load("/nonexistent/polar.txt"));
+}
+
+// Below the first measured angle the boat slows down to a stop head to wind.
+ATEST(PolarTable, LoadBelowFirstAngle) {
+  const char* kFile = "/tmp/polar_table_test.txt";
+  FILE* fp = fopen(kFile, "w");
+  fprintf(fp, "wind_m_s  4    8\n"
+              "45        0.9  1.8\n"
+              "90        1.0  2.0\n");
+  fclose(fp);
+  PolarTable table;
+  EXPECT_TRUE(table.Load(kFile));
+  EXPECT_FLOAT_EQ(0.9, table.Speed(45, 4));
+  EXPECT_FLOAT_EQ(0.4, table.Speed(20, 4));
+  EXPECT_FLOAT_EQ(0.8, table.Speed(-20, 8));
+  EXPECT_FLOAT_EQ(0, table.Speed(0, 4));
+  EXPECT_FLOAT_EQ(0, table.Speed(0, 8));
+}
+
+int main(int argc, char* argv[]) {
+  return testing::RunAllTests();
+}
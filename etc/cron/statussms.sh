@@ -5,9 +5,12 @@
 
 PATH=/sbin:/usr/sbin:/bin:/usr/bin:/usr/local/bin
 
-tail -1 /var/log/imu.0.log  | tr ':' ' ' | awk '{print "t:"$3" lt:"$33" ln:"$35}' > /tmp/latlng
+# the last 2 minutes of the bus recording
+busplay -s $(( $(date +%s) * 1000 - 120000 )) /var/log/lbus > /tmp/lbus.last
+
+grep '^imu:' /tmp/lbus.last | tail -1 | tr ':' ' ' | awk '{print "t:"$3" lt:"$33" ln:"$35}' > /tmp/latlng
 tail -1 /var/log/gps.0.log  | tr ':' ' ' | awk '{print "t:"$3" lt:"$7" ln:"$9}' >> /tmp/latlng
-tail -1 /var/log/helmsman_st.0.log | tr ':' ' ' | awk '{print "tji:",$5,$7,$9}' > /tmp/helmsman.sts
+grep '^helmsman_st:' /tmp/lbus.last | tail -1 | tr ':' ' ' | awk '{print "tji:",$5,$7,$9}' > /tmp/helmsman.sts
 
 for p in `cat /etc/smsphonenr`; do
 	sms send $p  "$(head -1 /tmp/latlng) $(cat /tmp/helmsman.sts) $(date +"%m/%d %H:%M")"
@@ -8,9 +8,12 @@ E=echo
 
 while [ -n "$1" ]; do
     case "$1" in 
-	ais:|compass:|fuelcell:|gps:|imu:|wind:)
+	ais:|fuelcell:|imu:)
 	    $E /etc/init.d/$(echo $1|tr -d :) restart
 	    ;;
+	compass:|gps:|wind:)
+	    $E /etc/init.d/nmea restart
+	    ;;
 	status_left:|status_right:|status_sail:)
 	    $E /etc/init.d/ebus restart
 	    ;;
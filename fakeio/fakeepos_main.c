@@ -0,0 +1,547 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Pretend to be an EPOS 24/5 on a serial port: speak the RS232 protocol
+// on a pseudo terminal, so eposcom, rudderctl and sailctl can run
+// without hardware.
+//
+//   fakeepos -s 0x09011145 /tmp/rudder_l &
+//   plug /var/run/ebus -- eposcom /tmp/rudder_l
+//
+// It implements the framing (crc, 'O' and 'F' acks), the objects we use
+// (status, control, opmode, target and actual position, homing and
+// profile parameters, the error registers and TxPDO1) and a first order
+// motor model in profile position and homing mode.  Latency, NACKs, crc
+// errors and drive faults can be injected.  SIGUSR1 prints statistics
+// on stderr.
+//
+
+#define _GNU_SOURCE  // posix_openpt, cfmakeraw
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <math.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "io2/actuator.h"
+
+static const char* argv0;
+static int debug = 0;
+
+static void
+crash(const char* fmt, ...)
+{
+	va_list ap;
+	char buf[1000];
+	va_start(ap, fmt);
+	vsnprintf(buf, sizeof(buf), fmt, ap);
+	va_end(ap);
+	fprintf(stderr, "%s: %s%s%s\n", argv0, buf,
+		(errno) ? ": " : "",
+		(errno) ? strerror(errno):"" );
+	exit(1);
+}
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: %s [options] [/path/to/link]\n"
+		"options:\n"
+		"\t-s serial   serial number (default the left rudder)\n"
+		"\t-n nodeid   (default 1)\n"
+		"\t-l ms       response latency (default 2)\n"
+		"\t-j ms       uniform jitter on the latency\n"
+		"\t-N p        probability of a NACK per frame\n"
+		"\t-C p        probability of a bad crc per response\n"
+		"\t-F p        probability of a drive fault per request\n"
+		"\t-t s        time constant of the motor (default 0.05)\n"
+		"\t-p qc       initial position (default 10000)\n"
+		"prints the pty name, and links it to /path/to/link if given.\n"
+		, argv0);
+	exit(2);
+}
+
+static int64_t
+now_us(void)
+{
+	struct timeval tv;
+	if (gettimeofday(&tv, NULL) < 0) crash("no working clock");
+	return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+static int
+chance(double p)
+{
+	return p > 0 && rand() < p * RAND_MAX;
+}
+
+// -----------------------------------------------------------------------------
+//   Object dictionary
+
+enum {
+	SDO_ERR_READONLY = 0x06010002,
+	SDO_ERR_NOOBJECT = 0x06020000,
+	ERR_FOLLOWING = 0x8611,
+};
+
+struct Object {
+	uint32_t reg;
+	int32_t value;
+	int writable;
+};
+
+static struct Object od[] = {
+	{ REGISTER(0x1018, 4), 0x09011145, 0 },  // serial number
+	{ REG_ERROR, 0, 0 },
+	{ REG_ERRHISTCOUNT, 0, 1 },
+	{ REGISTER(0x1003, 1), 0, 0 },	// last error
+	{ REG_CONTROL, 0, 1 },
+	{ REG_STATUS, 0, 0 },
+	{ REG_OPMODE, OPMODE_PPM, 1 },
+	{ REG_TARGPOS, 0, 1 },
+	{ REG_CURRPOS, 0, 0 },
+	{ REG_PROFVEL, 1000, 1 },
+	{ REG_ENCPULSES, 500, 1 },
+	{ REGISTER(0x2080, 0), 500, 1 },	// homing current threshold
+	{ REGISTER(0x2081, 0), 0, 1 },		// home position
+	{ REGISTER(0x6065, 0), 2000, 1 },	// max following error
+	{ REGISTER(0x6067, 0), 100, 1 },	// position window
+	{ REGISTER(0x6068, 0), 50, 1 },		// position time window
+	{ REGISTER(0x607C, 0), 0, 1 },		// home offset
+	{ REGISTER(0x607D, 1), -2147483647-1, 1 },  // min position limit
+	{ REGISTER(0x607D, 2), 2147483647, 1 },	// max position limit
+	{ REGISTER(0x607F, 0), 25000, 1 },	// max profile velocity
+	{ REGISTER(0x6083, 0), 10000, 1 },	// profile acceleration
+	{ REGISTER(0x6084, 0), 10000, 1 },	// profile deceleration
+	{ REGISTER(0x6085, 0), 10000, 1 },	// quickstop deceleration
+	{ REGISTER(0x6086, 0), 0, 1 },		// motion profile type
+	{ REGISTER(0x6098, 0), 0, 1 },		// homing method
+	{ REGISTER(0x6099, 1), 100, 1 },	// switch search speed
+	{ REGISTER(0x6099, 2), 10, 1 },		// zero search speed
+	{ REGISTER(0x609A, 0), 1000, 1 },	// homing acceleration
+	{ REGISTER(0x6410, 1), 5000, 1 },	// continuous current limit
+	{ REGISTER(0x1800, 1), 0x180, 1 },	// TxPDO1 cob id
+	{ REGISTER(0x1800, 2), 255, 1 },	// TxPDO1 transmission type
+	{ REGISTER(0x1A00, 0), 0, 1 },		// TxPDO1 mapping
+	{ REGISTER(0x1A00, 1), 0, 1 },
+	{ REGISTER(0x1A00, 2), 0, 1 },
+};
+
+#define nelem(x) (sizeof(x)/sizeof(x[0]))
+
+static struct Object*
+find(uint32_t reg)
+{
+	int i;
+	for (i = 0; i < nelem(od); i++)
+		if (od[i].reg == reg)
+			return &od[i];
+	return NULL;
+}
+
+static int32_t get(uint32_t reg) { return find(reg)->value; }
+static void set(uint32_t reg, int32_t value) { find(reg)->value = value; }
+
+// -----------------------------------------------------------------------------
+//   Drive
+
+static struct {
+	double pos_qc;
+	double target_qc;
+	int moving;	// in profile position or homing mode
+	int homed;
+	int fault;
+	int reached;
+	int operational;  // NMT state, for PDOs
+	double tau_s;
+	int64_t last_us;
+} drive;
+
+static struct {
+	long long frames, nacks, badcrc, faults, reads, writes, pdos, nmts;
+} stats;
+
+static void
+update_status(void)
+{
+	uint32_t control = get(REG_CONTROL);
+	uint32_t status = 0x0100;	// remote
+	if (control & 1) status |= 0x21;	// ready to switch on, quick stop off
+	if ((control & 0xF) == 0xF) status |= 0x16;	// switched on, operation enabled
+	if (drive.fault) status = 0x0108;
+	if (drive.reached) status |= STATUS_TARGETREACHED;
+	if (drive.homed) status |= STATUS_HOMEREF;
+	set(REG_STATUS, status);
+	set(REG_CURRPOS, lrint(drive.pos_qc));
+}
+
+// Profile velocity in rpm to qc/s.
+static double
+qc_per_s(int32_t rpm)
+{
+	return rpm * 4.0 * get(REG_ENCPULSES) / 60;
+}
+
+// The position approaches the target with a time constant, not faster
+// than the profile velocity.
+static void
+step(int64_t now)
+{
+	double dt = (now - drive.last_us) / 1E6;
+	drive.last_us = now;
+	if (dt <= 0 || !drive.moving || drive.fault || (get(REG_CONTROL) & 0xF) != 0xF) {
+		update_status();
+		return;
+	}
+
+	int homing = get(REG_OPMODE) == OPMODE_HOMING;
+	double vmax = qc_per_s(homing ? get(REGISTER(0x6099, 1)) : get(REG_PROFVEL));
+	double v = (drive.target_qc - drive.pos_qc) / drive.tau_s;
+	if (v > vmax) v = vmax;
+	if (v < -vmax) v = -vmax;
+	double d = v * dt;
+	if (fabs(d) > fabs(drive.target_qc - drive.pos_qc))
+		d = drive.target_qc - drive.pos_qc;
+	drive.pos_qc += d;
+
+	if (fabs(drive.target_qc - drive.pos_qc) <= get(REGISTER(0x6067, 0))) {
+		drive.reached = 1;
+		if (homing) {
+			drive.pos_qc = drive.target_qc;
+			drive.homed = 1;
+			drive.moving = 0;
+		}
+	}
+	update_status();
+}
+
+static void
+inject_fault(void)
+{
+	drive.fault = 1;
+	drive.moving = 0;
+	set(REG_ERROR, 1);
+	set(REGISTER(0x1003, 1), ERR_FOLLOWING);
+	set(REG_ERRHISTCOUNT, get(REG_ERRHISTCOUNT) + 1);
+	stats.faults++;
+	update_status();
+}
+
+static void
+control(uint32_t value)
+{
+	if (value & CONTROL_CLEARFAULT) {
+		drive.fault = 0;
+		set(REG_ERROR, 0);
+		return;
+	}
+	if (drive.fault || (value & 0x1F) != (CONTROL_START & 0x1F))
+		return;
+
+	// A new setpoint.
+	drive.reached = 0;
+	drive.moving = 1;
+	if (get(REG_OPMODE) == OPMODE_HOMING) {
+		drive.homed = 0;
+		drive.target_qc = get(REGISTER(0x2081, 0));
+	} else {
+		int32_t t = get(REG_TARGPOS);
+		if (t < get(REGISTER(0x607D, 1))) t = get(REGISTER(0x607D, 1));
+		if (t > get(REGISTER(0x607D, 2))) t = get(REGISTER(0x607D, 2));
+		drive.target_qc = t;
+	}
+}
+
+static uint32_t
+readobject(uint32_t reg, int32_t* value)
+{
+	struct Object* o = find(reg);
+	if (!o) return SDO_ERR_NOOBJECT;
+	*value = o->value;
+	return 0;
+}
+
+static uint32_t
+writeobject(uint32_t reg, int32_t value)
+{
+	struct Object* o = find(reg);
+	if (!o) return SDO_ERR_NOOBJECT;
+	if (!o->writable) return SDO_ERR_READONLY;
+	o->value = value;
+	if (reg == REG_CONTROL)
+		control(value);
+	if (reg == REG_OPMODE)
+		drive.moving = 0;
+	update_status();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+//   Framing, see io2/com.c and section 6 of the EPOS Communication Guide.
+
+static uint16_t
+crc_ccitt(uint16_t crc, uint16_t data)
+{
+	uint16_t mask;
+	for (mask = 0x8000; mask; mask >>= 1) {
+		uint16_t c = crc & 0x8000;
+		crc <<= 1;
+		if (data & mask) crc++;
+		if (c) crc ^= 0x1021;
+	}
+	return crc;
+}
+
+// Over the words of the frame, opcode and len swapped, the crc word as 0.
+static uint16_t
+frame_crc(const uint8_t* p, int n)
+{
+	uint16_t crc = crc_ccitt(0, p[1] + (p[0]<<8));
+	int i;
+	for (i = 2; i < n - 2; i += 2)
+		crc = crc_ccitt(crc, p[i] + (p[i+1]<<8));
+	return crc_ccitt(crc, 0);
+}
+
+static int
+read_timeout(int fd, uint8_t* buf, int size, int timeout_ms)
+{
+	int n = 0;
+	while (n < size) {
+		fd_set rfds;
+		struct timeval tv = { timeout_ms / 1000, (timeout_ms % 1000) * 1000 };
+		FD_ZERO(&rfds);  FD_SET(fd, &rfds);
+		int r = select(fd + 1, &rfds, NULL, NULL, &tv);
+		if (r < 0 && errno == EINTR) continue;
+		if (r <= 0) return n;
+		r = read(fd, buf + n, size - n);
+		if (r <= 0) return n;
+		n += r;
+	}
+	return n;
+}
+
+static void
+put(int fd, const uint8_t* buf, int n)
+{
+	while (n > 0) {
+		int r = write(fd, buf, n);
+		if (r < 0 && errno == EINTR) continue;
+		if (r <= 0) crash("write");
+		buf += r;
+		n -= r;
+	}
+}
+
+static void
+ack(int fd, uint8_t a)
+{
+	put(fd, &a, 1);
+}
+
+// Send a response frame (opcode 0) with the words in data.
+static void
+respond(int fd, const uint8_t* data, int nwords, double badcrc)
+{
+	uint8_t frame[2 + 2*6 + 2];
+	frame[0] = 0;
+	frame[1] = nwords - 1;
+	memmove(frame + 2, data, 2*nwords);
+	int n = 2 + 2*nwords + 2;
+	uint16_t crc = frame_crc(frame, n);
+	if (chance(badcrc)) {
+		crc ^= 0x5555;
+		stats.badcrc++;
+	}
+	frame[n-2] = crc;
+	frame[n-1] = crc >> 8;
+
+	uint8_t a = 0;
+	put(fd, frame, 1);
+	if (read_timeout(fd, &a, 1, 500) != 1 || a != 'O') return;
+	put(fd, frame + 1, n - 1);
+	read_timeout(fd, &a, 1, 500);	// end ack, nothing to do if it's 'F'
+}
+
+static void
+le32(uint8_t* p, uint32_t v)
+{
+	p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static void
+printstats(void)
+{
+	fprintf(stderr, "%s: frames:%lld reads:%lld writes:%lld pdos:%lld nmts:%lld nacks:%lld badcrc:%lld faults:%lld pos:%.0lf\n",
+		argv0, stats.frames, stats.reads, stats.writes, stats.pdos, stats.nmts,
+		stats.nacks, stats.badcrc, stats.faults, drive.pos_qc);
+}
+
+static int sigflg = 0;
+static void setflg(int sig) { sigflg = sig; }
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+	int nodeid = 1;
+	double latency_ms = 2;
+	double jitter_ms = 0;
+	double p_nack = 0, p_badcrc = 0, p_fault = 0;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	drive.tau_s = 0.05;
+	drive.pos_qc = 10000;
+
+	while ((ch = getopt(argc, argv, "dhs:n:l:j:N:C:F:t:p:")) != -1){
+		switch (ch) {
+		case 'd': ++debug; break;
+		case 's': set(REGISTER(0x1018, 4), strtoul(optarg, NULL, 0)); break;
+		case 'n': nodeid = atoi(optarg); break;
+		case 'l': latency_ms = atof(optarg); break;
+		case 'j': jitter_ms = atof(optarg); break;
+		case 'N': p_nack = atof(optarg); break;
+		case 'C': p_badcrc = atof(optarg); break;
+		case 'F': p_fault = atof(optarg); break;
+		case 't': drive.tau_s = atof(optarg); break;
+		case 'p': drive.pos_qc = atof(optarg); break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc > 1 || drive.tau_s <= 0) usage();
+
+	if (signal(SIGUSR1, setflg) == SIG_ERR) crash("signal(SIGUSR1)");
+
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0)
+		crash("posix_openpt");
+	const char* name = ptsname(fd);
+
+	// Keep the slave open and raw, so the master doesn't see EIO between
+	// clients and nothing is echoed before the client sets the port up.
+	int slave = open(name, O_RDWR | O_NOCTTY);
+	if (slave < 0) crash("open(%s)", name);
+	struct termios t;
+	memset(&t, 0, sizeof t);
+	cfmakeraw(&t);
+	if (tcsetattr(slave, TCSANOW, &t) < 0) crash("tcsetattr(%s)", name);
+
+	if (argc == 1) {
+		unlink(argv[0]);
+		if (symlink(name, argv[0]) < 0) crash("symlink(%s, %s)", name, argv[0]);
+	}
+	printf("%s\n", name);
+	fflush(stdout);
+
+	drive.last_us = now_us();
+	update_status();
+
+	for (;;) {
+		uint8_t frame[2 + 2*256 + 2];
+
+		int n = read_timeout(fd, frame, 1, 10);
+		step(now_us());
+		if (sigflg) {
+			sigflg = 0;
+			printstats();
+		}
+		if (n != 1) continue;
+
+		stats.frames++;
+		if (chance(p_nack)) {
+			stats.nacks++;
+			ack(fd, 'F');
+			continue;
+		}
+		ack(fd, 'O');
+
+		if (read_timeout(fd, frame + 1, 1, 500) != 1) continue;
+		n = 2 + 2*(frame[1] + 1) + 2;
+		if (read_timeout(fd, frame + 2, n - 2, 500) != n - 2) continue;
+		if (frame_crc(frame, n) != frame[n-2] + (frame[n-1] << 8)) {
+			ack(fd, 'F');
+			continue;
+		}
+		ack(fd, 'O');
+
+		uint8_t op = frame[0];
+		uint32_t reg = REGISTER(frame[2] + (frame[3] << 8), frame[4]);
+		uint8_t rsp[12];
+		int nwords = 0;
+		memset(rsp, 0, sizeof rsp);
+
+		if ((op == 0x10 || op == 0x11) && frame[5] != nodeid)
+			continue;  // another node would answer, or nobody
+
+		if (chance(p_fault))
+			inject_fault();
+
+		switch (op) {
+		case 0x10: {  // ReadObject
+			int32_t value = 0;
+			stats.reads++;
+			le32(rsp, readobject(reg, &value));
+			le32(rsp + 4, value);
+			nwords = 4;
+			break;
+		}
+		case 0x11: {  // WriteObject
+			int32_t value = frame[6] | frame[7] << 8 | frame[8] << 16 | (uint32_t)frame[9] << 24;
+			stats.writes++;
+			le32(rsp, writeobject(reg, value));
+			nwords = 2;
+			break;
+		}
+		case 0x0e:  // SendNMTService, no response
+			stats.nmts++;
+			if (frame[2] == nodeid || frame[2] == 0)
+				drive.operational = (frame[4] == 1);
+			continue;
+		case 0x20: {  // SendCANFrame (no response) or RequestCANFrame
+			if (frame[1] != 1) continue;
+			uint16_t cobid = frame[2] | frame[3] << 8;
+			stats.pdos++;
+			if (!drive.operational || cobid != get(REGISTER(0x1800, 1)) ||
+			    get(REGISTER(0x1A00, 0)) != 2 || get(REGISTER(0x1800, 2)) != 253) {
+				le32(rsp, SDO_ERR_NOOBJECT);
+			} else {
+				uint32_t status = get(REG_STATUS);
+				rsp[4] = status;
+				rsp[5] = status >> 8;
+				le32(rsp + 6, get(REG_CURRPOS));
+			}
+			nwords = 6;
+			break;
+		}
+		default:
+			if (debug) fprintf(stderr, "%s: unknown opcode 0x%02x\n", argv0, op);
+			continue;
+		}
+
+		double delay_ms = latency_ms + jitter_ms * rand() / RAND_MAX;
+		if (delay_ms > 0) usleep(delay_ms * 1000);
+		step(now_us());
+
+		respond(fd, rsp, nwords, p_badcrc);
+	}
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+#!/bin/sh
+#
+# Runs eposcom against fakeepos on a pseudo terminal: a register written
+# is read back, and an injected drive fault shows in the error register
+# and in the statistics on SIGUSR1.
+#
+# Needs fakeepos (make fakeepos) and io2/eposcom built.
+#
+
+FAKEEPOS=${FAKEEPOS:-`dirname $0`/fakeepos}
+EPOSCOM=${EPOSCOM:-`dirname $0`/../io2/eposcom}
+DIR=`mktemp -d /tmp/test_fakeepos.XXXXXX`
+SERIAL=0x9011145
+FAILED=0
+
+cleanup() {
+	kill $PID 2> /dev/null
+	wait $PID 2> /dev/null
+	rm -rf $DIR
+}
+trap cleanup EXIT
+
+fail() {
+	echo "FAIL: $*"
+	FAILED=1
+}
+
+# start_fakeepos [options]: starts fakeepos on $DIR/link, sets PID.
+start_fakeepos() {
+	$FAKEEPOS -s $SERIAL "$@" $DIR/link > /dev/null 2> $DIR/stderr &
+	PID=$!
+	for i in 1 2 3 4 5 6 7 8 9 10; do
+		[ -L $DIR/link ] && return
+		sleep 0.1
+	done
+	echo "FAIL: fakeepos did not start"
+	exit 1
+}
+
+# eposcom lines...: runs the requests, the replies are in $DIR/out.
+eposcom() {
+	for l in "$@"; do echo "$l"; done | $EPOSCOM $DIR/link > $DIR/out 2> /dev/null
+}
+
+# A SET of the target position, read back with a GET.
+start_fakeepos
+eposcom "$SERIAL:0x607a[0] := 0x3e8" "$SERIAL:0x607a[0]"
+[ `grep -c "^$SERIAL:0x607a\[0\] = 0x3e8\$" $DIR/out` -eq 2 ] ||
+	fail "SET/GET round trip: `cat $DIR/out`"
+kill $PID; wait $PID 2> /dev/null; rm -f $DIR/link
+
+# Every request makes a fault.
+start_fakeepos -F 1
+eposcom "$SERIAL:0x1001[0]"
+grep -q "^$SERIAL:0x1001\[0\] = 0x1\$" $DIR/out ||
+	fail "no error after an injected fault: `cat $DIR/out`"
+kill -USR1 $PID
+sleep 0.2
+grep -q "faults:[1-9]" $DIR/stderr ||
+	fail "no faults in the statistics: `cat $DIR/stderr`"
+
+[ $FAILED -eq 0 ] && echo OK
+exit $FAILED
@@ -16,6 +16,7 @@
 #include "helmsman/wind_sensor.h"
 #include "proto/compass.h"
 #include "proto/imu.h"
+#include "proto/position.h"
 #include "proto/rudder.h"
 #include "proto/wind.h"
 
@@ -58,9 +59,12 @@ struct ControllerOutput {
   void Reset() {
     drives_reference.Reset();
     skipper_input.Reset();
+    PositionProto init = INIT_POSITIONPROTO;
+    position = init;
   }
 
   SkipperInput skipper_input;
+  PositionProto position;  // NAN until the first fix
   DriveReferenceValuesRad drives_reference;
   HelmsmanStatus status;
 };
@@ -79,6 +83,9 @@ struct FilteredMeasurements {
     mag_aoa = 0;
     longitude_deg = 0;
     latitude_deg = 0;
+    var_north_m2 = 0;
+    var_east_m2 = 0;
+    cov_north_east_m2 = 0;
     phi_x_rad = 0;
     phi_y_rad = 0;
     temperature_c = 0;
@@ -102,9 +109,13 @@ struct FilteredMeasurements {
   // Slow filter.
   double angle_aoa;
   double mag_aoa;
-  // GPS data
+  // Position, dead reckoned between GPS fixes, and its covariance.
+  // All 0 until the first fix.
   double longitude_deg;
   double latitude_deg;
+  double var_north_m2;
+  double var_east_m2;
+  double cov_north_east_m2;
 
   double phi_x_rad;     // roll or heel
   double phi_y_rad;     // pitch
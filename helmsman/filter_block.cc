@@ -6,6 +6,8 @@
 // What shall be filtered?
 // The IMU measurements are outputs of a Kalman-Bucy-filter and as such
 // they are filtered with an unknown delay dependant on the noise.
+// The bearing (phi_z) is fused from the gyro and all bearing sensors in
+// the HeadingFilter.
 // After IMU tests we found out that the speed data are just a very rough
 // approximation of the real motion vector over ground. The bearing (phi_z)
 // and the rotational speed omega_z need spike suppression and sliding average filters of 1s and 8s respectively.
@@ -14,7 +16,8 @@
 // fluctuations of the measured wind overlayed with the errors
 // by the boats motion (masttip, x- and y-axis-rotation of the boat, caused by waves).
 // Consequently filtering is applied only for:
-//   1. The true wind to get a very calm general wind direction (averaged at least over 60s).
+//   1. The true wind to get a calm general wind direction (averaged over 10s after
+//      correcting the wind sensor errors, see TrueWindEstimator).
 //   2. The heel angle calculated from the acceleration vector.
 //
 
@@ -41,6 +44,15 @@ namespace {
 const double kOmegaZFilterPeriod = 8.0;
 const double kSpeedFilterPeriod = 20.0;
 
+// Standard deviation of the bearings.
+const double kImuYawSigma = 0.1;       // rad
+const double kImuCompassSigma = 0.3;   // rad
+const double kCompassSigma = 0.1;      // rad
+
+// Standard deviation of the position fixes.
+const double kGpsSigma = 5;      // m
+const double kImuGpsSigma = 7;   // m, the IMU GPS is less accurate.
+
 }  // namespace
 
 extern int debug;
@@ -76,18 +88,17 @@ FilterBlock::FilterBlock()
     mag_true_filter_(len_100s),
     mag_aoa_filter_(len_30s),
 
-    phi_z_filter_(),
-    phi_z_wrap_(&phi_z_filter_),
     angle_app_filter_(len_4s),
     angle_app_wrap_(&angle_app_filter_),
-    alpha_true_filter_x_(len_100s),
-    alpha_true_filter_y_(len_100s),
-    alpha_true_polar_(&alpha_true_filter_x_, &alpha_true_filter_y_),
     angle_aoa_filter_x_(len_30s),
     angle_aoa_filter_y_(len_30s),
     angle_aoa_polar_(&angle_aoa_filter_x_, &angle_aoa_filter_y_),
     gamma_sail_filter_(len_0_6s),
     gamma_sail_wrap_(&gamma_sail_filter_),
+    last_imu_lat_(0),
+    last_imu_lon_(0),
+    last_gps_lat_(0),
+    last_gps_lon_(0),
     gamma_sail_model_(0) {}
 
 
@@ -124,7 +135,6 @@ void FilterBlock::Filter(const ControllerInput& in,
                          double gamma_sail_star_rad,
                          FilteredMeasurements* fil) {
   fil->Reset();
-  // TODO: signal mixer (IMU + compass) comes here. It overwrites IMU data.
   imu_fault_ = isnan(in.imu.attitude.phi_z_rad) || isnan(in.imu.velocity.x_m_s);
   if (imu_fault_ && debug)
     fprintf(stderr, "IMU fault\n");
@@ -137,25 +147,28 @@ void FilterBlock::Filter(const ControllerInput& in,
     fprintf(stderr, "Secondary GPS fault\n");
 
 
-  // yaw (== bearing) from 2 independant sources: IMU Kalman filter, raw IMU magnetic sensor and
-  // independant compass.
-  // The IMU magnetic sensor is variable by +- 8 degrees in standstill so the IMU weight
-  // is reduced to 0.575 in total.
+  // yaw (== bearing) from the gyro and 3 absolute sources: IMU Kalman filter,
+  // raw IMU magnetic sensor and independant compass.
+  // The IMU magnetic sensor is variable by +- 8 degrees in standstill.
   // The raw magnetic sensor IMU output is a rather noisy and often incorrect.
   // Under rough conditions (high waves) the compass is disturbed by the changing
-  // accelerations. So the compass weight was reduced to 0.5.
-  double consensus = 0;
-  double compass_phi_z = CompassMixer::Mix(in.imu.attitude.phi_z_rad, imu_fault_ ? 0 : 0.5,
-                                           in.imu.compass.phi_z_rad, in.imu.compass.valid ? 0.075 : 0,
-                                           in.compass_sensor.phi_z_rad, 0.5,  // invalid if outdated TODO
-                                           &consensus);
-  if (consensus >= 0.5) {
-    fil->phi_z_boat = phi_z_wrap_.Filter(compass_phi_z);
+  // accelerations, the heading filter rejects the worst of that.
+  // The GPS course over ground includes leeway and current, so it is no bearing.
+  heading_.Predict(in.imu.gyro.omega_z_rad_s, kSamplingPeriod);
+  if (!imu_fault_)
+    heading_.Update(in.imu.attitude.phi_z_rad, kImuYawSigma);
+  if (in.imu.compass.valid)
+    heading_.Update(in.imu.compass.phi_z_rad, kImuCompassSigma);
+  heading_.Update(in.compass_sensor.phi_z_rad, kCompassSigma);  // invalid if outdated TODO
+  bool heading_fault = !heading_.Valid();
+  if (!heading_fault) {
+    fil->phi_z_boat = heading_.phi_z_rad();
     if (debug) {
-      fprintf(stderr, "filtered compass phi_z %lf deg\n", Rad2Deg(fil->phi_z_boat));
+      fprintf(stderr, "filtered compass phi_z %lf deg, gyro bias %lf deg/s\n",
+              Rad2Deg(fil->phi_z_boat), Rad2Deg(heading_.bias_rad_s()));
     }
-  } else {
-    fprintf(stderr, "No compass consensus, %lf\n", consensus);
+  } else if (debug) {
+    fprintf(stderr, "No valid heading, variance %lf\n", heading_.var_phi_z());
   }
 
   // Position
@@ -181,27 +194,6 @@ void FilterBlock::Filter(const ControllerInput& in,
     ASSIGN_NOT_NAN(gps_speed_m_s, in.gps.speed_m_s);
   }
 
-  // The position values are not overwritten if sensors fail.
-  // TODO Mark them as stale after 15 minutes.
-  if (imu_lat != 0 || gps_lat != 0) {
-    // Due to the small relative errors of latitude and longitude the consensus is
-    // less expressive for the position.
-    // fprintf(stderr,"lat mix %lf %lf \n", imu_lat, gps_lat);
-    fil->latitude_deg = SymmetricDeg(Rad2Deg(
-        CompassMixer::Mix(Deg2Rad(imu_lat), imu_gps_fault_ ? 0 : 0.51,
-                          0, 0,
-                          Deg2Rad(gps_lat), gps_fault_ ? 0 : 1,
-                          &consensus)));
-  }
-  if (imu_lon != 0 || gps_lon != 0) {
-    // fprintf(stderr,"lon mix %lf %lf \n", imu_lon, gps_lon);
-    fil->longitude_deg = SymmetricDeg(Rad2Deg(
-        CompassMixer::Mix(Deg2Rad(imu_lon), imu_gps_fault_ ? 0 : 0.51,
-                          0, 0,
-                          Deg2Rad(gps_lon), gps_fault_ ? 0 : 1,
-                          &consensus)));
-  }
-  // fprintf(stderr, "Filtered positions: lat lon %lf %lf \n", fil->latitude_deg, fil->longitude_deg);
 
   // Speed
   // The GPS has no orientation (bearing) information so all speeds are
@@ -226,6 +218,32 @@ void FilterBlock::Filter(const ControllerInput& in,
     fil->mag_boat = CensorSpeed(speed_filter_.Filter(sum / (weight_imu + weight_gps)));
     mag_boat_fault = false;
   }
+  // Position, dead reckoning with the filtered speed and heading between fixes.
+  // Without speed or heading we just drift and let the covariance grow.
+  // A fix counts as new if it differs from the previous one of the same sensor.
+  position_.Predict(fil->phi_z_boat, mag_boat_fault || heading_fault ? 0 : fil->mag_boat,
+                    kSamplingPeriod);
+  if (imu_lat != 0 && (imu_lat != last_imu_lat_ || imu_lon != last_imu_lon_)) {
+    if (!position_.Update(imu_lat, imu_lon, kImuGpsSigma) && debug)
+      fprintf(stderr, "IMU position outlier %.7lf %.7lf\n", imu_lat, imu_lon);
+    last_imu_lat_ = imu_lat;
+    last_imu_lon_ = imu_lon;
+  }
+  if (gps_lat != 0 && (gps_lat != last_gps_lat_ || gps_lon != last_gps_lon_)) {
+    if (!position_.Update(gps_lat, gps_lon, kGpsSigma) && debug)
+      fprintf(stderr, "GPS position outlier %.7lf %.7lf\n", gps_lat, gps_lon);
+    last_gps_lat_ = gps_lat;
+    last_gps_lon_ = gps_lon;
+  }
+  // The position values are not overwritten if sensors fail.
+  if (position_.Valid()) {
+    fil->latitude_deg = position_.latitude_deg();
+    fil->longitude_deg = position_.longitude_deg();
+    fil->var_north_m2 = position_.var_north_m2();
+    fil->var_east_m2 = position_.var_east_m2();
+    fil->cov_north_east_m2 = position_.cov_north_east_m2();
+  }
+
   if (debug) {
       fprintf(stderr, "raw boat speed*0.8 %6.3lf filtered %6.3lf m/s, lat_lon %.7lf %.7lf phi_z %6.3lf \n",
               in.imu.velocity.x_m_s, fil->mag_boat,
@@ -295,32 +313,22 @@ void FilterBlock::Filter(const ControllerInput& in,
     if (mag_app == 0)
       angle_app = 0;
 
-    Polar alpha_true_out(0, 0);
-    if (!mag_boat_fault) {
-      Polar wind_true(0, 0);
-      TruePolar(Polar(angle_app,  mag_app),
-                Polar(fil->phi_z_boat, fil->mag_boat),
-                fil->phi_z_boat,
-                &wind_true);
-      alpha_true_polar_.Filter(wind_true, &alpha_true_out);
-      if (debug)
-        fprintf(stderr, "trueInOut alpha mag: %lg, %lg, filtered: %lg, %lg\n",
-                wind_true.AngleRad(), wind_true.Mag(),
-                alpha_true_out.AngleRad(), alpha_true_out.Mag());
-      // The validity of the true wind takes some time and is flagged separately with
-      // valid_true_wind.
+    // The true wind estimator calibrates the wind sensor at tacks and jibes.
+    // Without speed or heading it cannot, and approximates the true wind
+    // with the apparent wind.
+    if (!mag_boat_fault && !heading_fault) {
+      true_wind_.Update(angle_app, mag_app, fil->phi_z_boat, fil->mag_boat, kSamplingPeriod);
     } else {
       if (debug)
         fprintf(stderr, "Imu failed -> Approximate true wind.\n");
-      Polar wind_true(angle_app + fil->phi_z_boat, mag_app);
-      alpha_true_polar_.Filter(wind_true, &alpha_true_out);
-      if (debug)
-        fprintf(stderr, "Approximated trueInOut alpha mag: %lg, %lg, filtered: %lg, %lg\n",
-                NormalizeRad(angle_app + fil->phi_z_boat), mag_app,
-                alpha_true_out.AngleRad(), alpha_true_out.Mag());
+      true_wind_.Update(angle_app, mag_app, fil->phi_z_boat, 0, kSamplingPeriod);
     }
-    fil->alpha_true = alpha_true_out.AngleRad();
-    fil->mag_true = alpha_true_out.Mag();
+    fil->alpha_true = true_wind_.alpha_true_rad();
+    fil->mag_true = true_wind_.mag_true_m_s();
+    if (debug)
+      fprintf(stderr, "true wind alpha mag: %lg, %lg, sensor bias %lg deg, upwash %lg deg\n",
+              fil->alpha_true, fil->mag_true, Rad2Deg(true_wind_.bias_rad()),
+              Rad2Deg(true_wind_.upwash_rad(mag_app)));
 
     fil->angle_app = SymmetricRad(angle_app_wrap_.Filter(angle_app));
     fil->mag_app =  mag_app_filter_.Filter(mag_app);
@@ -339,7 +347,7 @@ void FilterBlock::Filter(const ControllerInput& in,
   }
   // All but the true wind.
   fil->valid = valid_app_wind_ && om_z_filter_.ValidOutput() &&
-               om_z_med_.ValidOutput() && phi_z_wrap_.ValidOutput();
+               om_z_med_.ValidOutput() && heading_.Valid();
 
   fil->valid_app_wind = valid_app_wind_;
   fil->valid_true_wind = ValidTrueWind();
@@ -357,7 +365,7 @@ bool FilterBlock::ValidAppWind() {
 }
 
 bool FilterBlock::ValidTrueWind() {
-  return alpha_true_polar_.ValidOutput() && !imu_fault_ && valid_app_wind_;  // TODO remove !imu_fault condition
+  return true_wind_.Valid() && !imu_fault_ && valid_app_wind_;  // TODO remove !imu_fault condition
 }
 
 bool FilterBlock::ValidSpeed() {
@@ -7,14 +7,17 @@
 // The signals from IMU and wind sensor are filtered through different filters.
 // Besides that a valid_app_wind flag in provided in the filtered_ output indicating that
 // the apparent wind is valid.
-// The true wind vector is very noisy and is stabilized with a slow (100s)
-// sliding average filter. The filter has its own valid_true_wind flag.
+// The true wind vector is very noisy. With the wind sensor errors calibrated
+// at each maneuver it is stabilized with a 10s filter. The filter has its
+// own valid_true_wind flag.
 
 #ifndef HELMSMAN_FILTER_BLOCK_H
 #define HELMSMAN_FILTER_BLOCK_H
 
 #include "helmsman/controller_io.h"
-#include "helmsman/compass_mixer.h"
+#include "helmsman/heading_filter.h"
+#include "helmsman/position_estimator.h"
+#include "helmsman/true_wind_estimator.h"
 
 #include "lib/filter/median_filter.h"
 #include "lib/filter/polar_filter.h"
@@ -69,16 +72,15 @@ class FilterBlock {
   SlidingAverageFilter mag_true_filter_;
   SlidingAverageFilter mag_aoa_filter_;
 
-  // The yaw (phi_z) and wind directions are angles that can
+  // The yaw (phi_z) from gyro and bearings.
+  HeadingFilter heading_;
+
+  // The wind directions are angles that can
   // wrap around at 360 degrees and need a wrap around filter.
-  Median5Filter phi_z_filter_;
-  WrapAroundFilter phi_z_wrap_;  // phi_z wraps around from 360 to 0 degree.
   SlidingAverageFilter angle_app_filter_;
   WrapAroundFilter angle_app_wrap_;
 
-  SlidingAverageFilter alpha_true_filter_x_;
-  SlidingAverageFilter alpha_true_filter_y_;
-  PolarFilter alpha_true_polar_;
+  TrueWindEstimator true_wind_;
 
   SlidingAverageFilter angle_aoa_filter_x_;
   SlidingAverageFilter angle_aoa_filter_y_;
@@ -87,6 +89,13 @@ class FilterBlock {
   SlidingAverageFilter gamma_sail_filter_;
   WrapAroundFilter gamma_sail_wrap_;
 
+  // Position, and the last fixes fed into it to recognize new ones.
+  PositionEstimator position_;
+  double last_imu_lat_;
+  double last_imu_lon_;
+  double last_gps_lat_;
+  double last_gps_lon_;
+
   int counter_;  // for logging downsampling
   double gamma_sail_model_;
 };
@@ -183,7 +183,7 @@ TEST(FilterBlock, All) {
   SetEnv(wind_true, boat, gamma_sail, &in);
 
   // The time until all filters are valid depends on the filter constants and
-  // the sampling period, but eventually after > 100s second, the filters should
+  // the sampling period, but eventually after > 30s second, the filters should
   // be filled and even the slow true wind filter has to be valid.
   for (int i = 0; i < 200 / kSamplingPeriod; ++i) {
     b.Filter(in, gamma_sail, &filtered);
@@ -236,7 +236,7 @@ TEST(FilterBlock, All) {
   EXPECT_TRUE(b.ValidSpeed());
 
   EXPECT_EQ(int(7.9 / kSamplingPeriod + 0.5), calls_until_valid);
-  EXPECT_EQ(int(102.1 / kSamplingPeriod + 0.5), calls_until_wind_valid);
+  EXPECT_EQ(int(32.1 / kSamplingPeriod + 0.5), calls_until_wind_valid);
   EXPECT_EQ(int(19.9 / kSamplingPeriod + 0.5), calls_until_speed_valid);
 
 
@@ -298,9 +298,10 @@ TEST(FilterBlock, All) {
   for (int i = 0; i < 45; ++i) {
     b.Filter(in, gamma_sail, &filtered);
   }
-  // no effect on true and apparent wind ...
-  EXPECT_IN_INTERVAL(-M_PI / 2 - 0.001, filtered.alpha_true, -M_PI / 2 + 0.001);
-  EXPECT_IN_INTERVAL(1.998, filtered.mag_true, 2.002);
+  // no effect on true and apparent wind, but for a small transient of the
+  // sail angle model that the 10s true wind filter still sees ...
+  EXPECT_IN_INTERVAL(-M_PI / 2 - 0.005, filtered.alpha_true, -M_PI / 2 + 0.005);
+  EXPECT_IN_INTERVAL(1.99, filtered.mag_true, 2.01);
   EXPECT_IN_INTERVAL(-M_PI * 3.0 / 4 - 0.002, filtered.angle_app, -M_PI * 3.0 / 4 + 0.002);
   EXPECT_FLOAT_EQ(2.0 * sqrt(2), filtered.mag_app);
   // but on the wind sensor direction.
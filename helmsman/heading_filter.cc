@@ -0,0 +1,108 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "helmsman/heading_filter.h"
+
+#include <math.h>
+
+#include "common/normalize.h"
+
+namespace {
+
+// Growth of the heading variance in rad^2/s with and without gyro. The
+// gyro noise is some 0.02rad/s, without gyro the boat can turn with up
+// to 0.3rad/s.
+const double kGyroNoise = 0.02 * 0.02;
+const double kNoGyroNoise = 0.3 * 0.3;
+// The gyro bias wanders slowly with the temperature.
+const double kBiasNoise = 0.0005 * 0.0005;
+const double kInitialBiasVariance = 0.02 * 0.02;
+
+// Squared innovation over its variance beyond which a bearing is an
+// outlier (4 sigma).
+const double kGate = 16;
+const int kMaxRejected = 30;
+
+// Too uncertain to steer with, 20 degrees.
+const double kMaxVariance = 0.35 * 0.35;
+
+}  // namespace
+
+HeadingFilter::HeadingFilter() {
+  Reset();
+}
+
+void HeadingFilter::Reset() {
+  initialized_ = false;
+  phi_z_rad_ = 0;
+  bias_rad_s_ = 0;
+  p_[0][0] = p_[0][1] = p_[1][0] = p_[1][1] = 0;
+  rejected_ = 0;
+}
+
+void HeadingFilter::Restart(double phi_z_rad, double sigma_rad) {
+  initialized_ = true;
+  phi_z_rad_ = NormalizeRad(phi_z_rad);
+  bias_rad_s_ = 0;
+  p_[0][0] = sigma_rad * sigma_rad;
+  p_[0][1] = p_[1][0] = 0;
+  p_[1][1] = kInitialBiasVariance;
+  rejected_ = 0;
+}
+
+bool HeadingFilter::Valid() const {
+  return initialized_ && p_[0][0] < kMaxVariance;
+}
+
+void HeadingFilter::Predict(double omega_z_rad_s, double dt_s) {
+  if (!initialized_)
+    return;
+  if (isnan(omega_z_rad_s)) {
+    // Hold the heading, the bias is not observable now.
+    p_[0][0] += kNoGyroNoise * dt_s;
+    return;
+  }
+  phi_z_rad_ = NormalizeRad(phi_z_rad_ + (omega_z_rad_s - bias_rad_s_) * dt_s);
+
+  // P = F P F' + Q with F = [1 -dt; 0 1]
+  const double p00 = p_[0][0] - dt_s * (p_[0][1] + p_[1][0]) + dt_s * dt_s * p_[1][1];
+  const double p01 = p_[0][1] - dt_s * p_[1][1];
+  p_[0][0] = p00 + kGyroNoise * dt_s;
+  p_[0][1] = p_[1][0] = p01;
+  p_[1][1] += kBiasNoise * dt_s;
+}
+
+bool HeadingFilter::Update(double phi_z_rad, double sigma_rad) {
+  if (isnan(phi_z_rad))
+    return false;
+  if (!initialized_) {
+    Restart(phi_z_rad, sigma_rad);
+    return true;
+  }
+  const double innovation = SymmetricRad(phi_z_rad - phi_z_rad_);
+  const double s = p_[0][0] + sigma_rad * sigma_rad;
+  if (innovation * innovation > kGate * s) {
+    if (++rejected_ >= kMaxRejected) {
+      Restart(phi_z_rad, sigma_rad);
+      return true;
+    }
+    return false;
+  }
+  rejected_ = 0;
+
+  // H = [1 0], K = P H' / s
+  const double k0 = p_[0][0] / s;
+  const double k1 = p_[1][0] / s;
+  phi_z_rad_ = NormalizeRad(phi_z_rad_ + k0 * innovation);
+  bias_rad_s_ += k1 * innovation;
+
+  // P = (I - K H) P
+  const double p00 = (1 - k0) * p_[0][0];
+  const double p01 = (1 - k0) * p_[0][1];
+  const double p11 = p_[1][1] - k1 * p_[0][1];
+  p_[0][0] = p00;
+  p_[0][1] = p_[1][0] = p01;
+  p_[1][1] = p11;
+  return true;
+}
@@ -0,0 +1,53 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef HELMSMAN_HEADING_FILTER_H
+#define HELMSMAN_HEADING_FILTER_H
+
+// Heading (phi_z) from the gyro and absolute bearings.
+//
+// A Kalman filter with the heading and the gyro bias as state.
+// The gyro omega_z integrates the heading at the control rate, so turns
+// show up without the delay of an averaging filter. The absolute
+// bearings (IMU yaw, IMU magnetic sensor, compass) pull the heading back
+// according to their standard deviation and let the filter learn the
+// gyro bias. Without gyro data the heading is held and its variance
+// grows quickly, so it follows the bearings alone.
+//
+// Bearings far outside the expected range are rejected (spikes, the
+// compass disturbed by waves). If nothing fits for a while, we got lost
+// and restart at the next bearing.
+//
+// All matrices have a fixed size of 2, there is no heap allocation.
+class HeadingFilter {
+ public:
+  HeadingFilter();
+  void Reset();
+
+  // Advance by dt_s with the yaw rate omega_z_rad_s (same sense as phi_z,
+  // i.e. clockwise seen from above). NaN if the gyro is not available.
+  void Predict(double omega_z_rad_s, double dt_s);
+
+  // A bearing phi_z_rad (from north, clockwise) with standard deviation
+  // sigma_rad. Returns false if it was NaN or rejected as outlier.
+  bool Update(double phi_z_rad, double sigma_rad);
+
+  // False until the first bearing and whenever the heading got too
+  // uncertain to steer with.
+  bool Valid() const;
+
+  double phi_z_rad() const { return phi_z_rad_; }  // [0, 2PI)
+  double bias_rad_s() const { return bias_rad_s_; }
+  double var_phi_z() const { return p_[0][0]; }
+
+ private:
+  void Restart(double phi_z_rad, double sigma_rad);
+
+  bool initialized_;
+  double phi_z_rad_;
+  double bias_rad_s_;
+  double p_[2][2];  // covariance of (phi_z, bias)
+  int rejected_;    // consecutive outliers
+};
+
+#endif  // HELMSMAN_HEADING_FILTER_H
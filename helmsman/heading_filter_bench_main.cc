@@ -0,0 +1,150 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Replay benchmark of the HeadingFilter against the former chain of
+// CompassMixer and median filter.
+// A 20 minute trace with tacks, wave yaw and noisy, delayed and
+// spiky sensors is recorded first and then replayed through both.
+// Lag is the delay of the truth that fits the output best, noise the
+// remaining RMS error.
+// Run with "make bench".
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "common/convert.h"
+#include "common/normalize.h"
+#include "common/now.h"
+#include "helmsman/compass_mixer.h"
+#include "helmsman/heading_filter.h"
+#include "helmsman/sampling_period.h"
+#include "lib/filter/median_filter.h"
+#include "lib/filter/wrap_around_filter.h"
+
+int debug = 0;
+
+namespace {
+
+struct Sample {
+  double truth;
+  double omega_z;
+  double imu_yaw;
+  double imu_compass;
+  double compass;
+};
+
+double Gauss(double sigma) {
+  double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+  return sigma * sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);
+}
+
+void Record(int n, std::vector<Sample>* trace) {
+  const double dt = kSamplingPeriod;
+  const int imu_delay = 0.3 / dt + 0.5;      // IMU internal Kalman filter
+  const int compass_delay = 0.2 / dt + 0.5;
+  std::vector<double> truth(n);
+  double course = 0;
+  for (int i = 0; i < n; ++i) {
+    double t = i * dt;
+    // A 90 degree tack every minute with 0.2 rad/s.
+    double target = int(t / 60) % 2 ? M_PI / 2 : 0;
+    double course_rate = 0;
+    if (fabs(target - course) > 0.2 * dt)
+      course_rate = target > course ? 0.2 : -0.2;
+    course += course_rate * dt;
+    // Yaw in waves, 4 degrees with 7s period.
+    const double w = 2 * M_PI / 7;
+    double yaw = Deg2Rad(4) * sin(w * t);
+    truth[i] = NormalizeRad(course + yaw);
+
+    Sample s;
+    s.truth = truth[i];
+    s.omega_z = course_rate + Deg2Rad(4) * w * cos(w * t) + 0.01 + Gauss(0.02);
+    s.imu_yaw = NormalizeRad(truth[std::max(0, i - imu_delay)] + Gauss(0.03));
+    s.imu_compass = NormalizeRad(truth[i] + Gauss(0.15));
+    s.compass = truth[std::max(0, i - compass_delay)] + Gauss(0.05);
+    if (rand() % 50 == 0)
+      s.compass += rand() % 2 ? 0.8 : -0.8;  // disturbed by waves
+    s.compass = NormalizeRad(s.compass);
+    trace->push_back(s);
+  }
+}
+
+// Finds the delay of the truth that fits out best and the RMS error
+// remaining at that delay.
+void LagAndNoise(const std::vector<Sample>& trace, const std::vector<double>& out,
+                 double* lag_s, double* noise_rad, double* max_rad) {
+  const int skip = 100;
+  double best = 1E9;
+  for (int d = 0; d < 30; ++d) {
+    double sum = 0;
+    double max = 0;
+    for (size_t i = skip; i < out.size(); ++i) {
+      double e = SymmetricRad(out[i] - trace[i - d].truth);
+      sum += e * e;
+      max = std::max(max, fabs(e));
+    }
+    double rms = sqrt(sum / (out.size() - skip));
+    if (rms < best) {
+      best = rms;
+      *lag_s = d * kSamplingPeriod;
+      *noise_rad = rms;
+      *max_rad = max;
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int kN = 20 * 60 / kSamplingPeriod;
+  const int kRounds = 20;
+  srand(1);
+  std::vector<Sample> trace;
+  Record(kN, &trace);
+  std::vector<double> mixed(kN), fused(kN);
+
+  int64_t start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    Median5Filter median;
+    WrapAroundFilter wrap(&median);
+    for (int i = 0; i < kN; ++i) {
+      const Sample& s = trace[i];
+      double consensus;
+      double phi = CompassMixer::Mix(s.imu_yaw, 0.5, s.imu_compass, 0.075,
+                                     s.compass, 0.5, &consensus);
+      mixed[i] = consensus >= 0.5 ? wrap.Filter(phi) : mixed[std::max(0, i - 1)];
+    }
+  }
+  int64_t mixer_us = now_micros() - start;
+
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    HeadingFilter heading;
+    for (int i = 0; i < kN; ++i) {
+      const Sample& s = trace[i];
+      heading.Predict(s.omega_z, kSamplingPeriod);
+      heading.Update(s.imu_yaw, 0.1);
+      heading.Update(s.imu_compass, 0.3);
+      heading.Update(s.compass, 0.1);
+      fused[i] = heading.phi_z_rad();
+    }
+  }
+  int64_t heading_us = now_micros() - start;
+
+  double lag, noise, max;
+  double calls = double(kN) * kRounds;
+  printf("                 lag/s  rms/deg  max/deg  ns/update\n");
+  LagAndNoise(trace, mixed, &lag, &noise, &max);
+  printf("CompassMixer    %6.1lf  %7.2lf  %7.2lf  %9.1lf\n",
+         lag, Rad2Deg(noise), Rad2Deg(max), mixer_us * 1000.0 / calls);
+  LagAndNoise(trace, fused, &lag, &noise, &max);
+  printf("HeadingFilter   %6.1lf  %7.2lf  %7.2lf  %9.1lf\n",
+         lag, Rad2Deg(noise), Rad2Deg(max), heading_us * 1000.0 / calls);
+  return 0;
+}
@@ -0,0 +1,117 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#include "helmsman/heading_filter.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "common/convert.h"
+#include "common/normalize.h"
+#include "lib/testing/testing.h"
+
+namespace {
+const double kDt = 0.1;
+
+double Noise(double sigma) {
+  return sigma * (rand() % 2001 - 1000) / 1000.0 * sqrt(3.0);  // uniform
+}
+}
+
+TEST(HeadingFilter, Basic) {
+  HeadingFilter h;
+  EXPECT_FALSE(h.Valid());
+  h.Predict(0.1, kDt);
+  EXPECT_FALSE(h.Valid());
+  EXPECT_FALSE(h.Update(NAN, 0.1));
+  EXPECT_FALSE(h.Valid());
+
+  EXPECT_TRUE(h.Update(1, 0.1));
+  EXPECT_TRUE(h.Valid());
+  EXPECT_FLOAT_EQ(1, h.phi_z_rad());
+  EXPECT_FLOAT_EQ(0.01, h.var_phi_z());
+
+  // The gyro turns the heading by itself, over north.
+  for (int i = 0; i < 100; ++i)
+    h.Predict(-0.1, kDt);
+  EXPECT_FLOAT_EQ(0, SymmetricRad(h.phi_z_rad()));
+  EXPECT_GT(h.var_phi_z(), 0.01);
+
+  // A bearing across north pulls it the short way round.
+  EXPECT_TRUE(h.Update(0.05, 0.1));
+  EXPECT_LT(NormalizeRad(h.phi_z_rad() + M_PI), M_PI + 0.05);
+  EXPECT_GT(NormalizeRad(h.phi_z_rad() + M_PI), M_PI);
+}
+
+TEST(HeadingFilter, Bias) {
+  // A gyro with 0.01rad/s bias, the compass says we go straight.
+  HeadingFilter h;
+  for (int i = 0; i < 3000; ++i) {
+    h.Predict(0.01, kDt);
+    h.Update(Deg2Rad(30), 0.1);
+  }
+  EXPECT_LT(fabs(h.bias_rad_s() - 0.01), 0.001);
+  EXPECT_LT(fabs(SymmetricRad(h.phi_z_rad() - Deg2Rad(30))), 0.001);
+}
+
+TEST(HeadingFilter, NoGyro) {
+  HeadingFilter h;
+  h.Update(0, 0.1);
+  for (int i = 0; i < 10; ++i)
+    h.Predict(NAN, kDt);
+  EXPECT_FLOAT_EQ(0, h.phi_z_rad());
+  EXPECT_FLOAT_EQ(0.01 + 0.09, h.var_phi_z());
+  // A large turn within a second is plausible now.
+  EXPECT_TRUE(h.Update(0.5, 0.1));
+  EXPECT_GT(h.phi_z_rad(), 0.4);
+
+  // Too uncertain after a minute without any input.
+  for (int i = 0; i < 600; ++i)
+    h.Predict(NAN, kDt);
+  EXPECT_FALSE(h.Valid());
+}
+
+TEST(HeadingFilter, Outliers) {
+  HeadingFilter h;
+  for (int i = 0; i < 100; ++i) {
+    h.Predict(0, kDt);
+    h.Update(1, 0.1);
+  }
+  // A spike is ignored.
+  EXPECT_FALSE(h.Update(2, 0.1));
+  EXPECT_FLOAT_EQ(1, h.phi_z_rad());
+  // But if it persists, we take it.
+  int accepted = 0;
+  for (int i = 0; i < 100 && !accepted; ++i) {
+    h.Predict(0, kDt);
+    accepted = h.Update(2, 0.1);
+  }
+  EXPECT_TRUE(accepted);
+  EXPECT_FLOAT_EQ(2, h.phi_z_rad());
+}
+
+TEST(HeadingFilter, Turn) {
+  // A 90 degree turn with 10 deg/s, noisy compass and gyro.
+  srand(1);
+  HeadingFilter h;
+  double phi = 0;
+  double max_error = 0;
+  for (int i = 0; i < 600; ++i) {
+    double omega = (i >= 200 && i < 290) ? Deg2Rad(10) : 0;
+    phi += omega * kDt;
+    h.Predict(omega + 0.005 + Noise(0.02), kDt);
+    h.Update(NormalizeRad(phi + Noise(0.1)), 0.1);
+    if (i > 50)
+      max_error = std::max(max_error, fabs(SymmetricRad(h.phi_z_rad() - phi)));
+  }
+  EXPECT_LT(max_error, Deg2Rad(4));
+}
+
+int main(int argc, char* argv[]) {
+  HeadingFilter_Basic();
+  HeadingFilter_Bias();
+  HeadingFilter_NoGyro();
+  HeadingFilter_Outliers();
+  HeadingFilter_Turn();
+  return 0;
+}
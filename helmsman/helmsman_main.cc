@@ -25,20 +25,25 @@
 #include <unistd.h>
 
 #include "io2/lib/linebuffer.h"
+#include "io2/lib/log.h"
 
 #include "proto/gps.h"
 #include "proto/rudder.h"
 #include "proto/wind.h"
 #include "proto/imu.h"
+#include "proto/mono_timestamp.h"
 #include "proto/helmsman.h"
 #include "proto/helmsman_status.h"
+#include "proto/position.h"
 #include "proto/remote.h"
+#include "proto/sensor_age.h"
 #include "skipper_input.h"
 
 #include "common/convert.h"
 #include "common/now.h"
 #include "common/unknown.h"
 #include "sampling_period.h"
+#include "sensor_age.h"
 #include "ship_control.h"
 
 extern int debug;
@@ -54,19 +59,6 @@ namespace {
 const char* argv0;
 int verbose = 0;
 
-void crash(const char* fmt, ...) {
-  va_list ap;
-  char buf[1000];
-  va_start(ap, fmt);
-  vsnprintf(buf, sizeof(buf), fmt, ap);
-  syslog(LOG_CRIT, "%s%s%s\n", buf,
-	 (errno) ? ": " : "",
-	 (errno) ? strerror(errno):"" );
-  exit(1);
-  va_end(ap);
-  return;
-}
-
 static void bus_fault(int i) { crash("bus fault"); }
 static void segv_fault(int i) { crash("segv fault"); }
 
@@ -84,7 +76,7 @@ static const int64_t kPeriodMicros = kSamplingPeriod * 1E6;
 void AdvanceCallTime(int64_t* next_call_micros) {
   *next_call_micros += kPeriodMicros;
   if (now_micros() > *next_call_micros) {
-    syslog(LOG_WARNING, "Irkss!! Too late by %lld micros\n", (now_micros() - *next_call_micros));
+    slog(LOG_WARNING, "Irkss!! Too late by %lld micros\n", (now_micros() - *next_call_micros));
     *next_call_micros = now_micros();
   }
 }
@@ -100,9 +92,19 @@ bool CalculateTimeOut(int64_t next_call_micros, struct timespec* timeout) {
   return until_call > 0;
 }
 
+// Whether a sensor line with all_items parsed into items, and its
+// mono_timestamp_ms set to 0 if it has none (see proto/mono_timestamp.h).
+bool SensorLine(int items, int all_items, int64_t* mono_timestamp_ms) {
+  if (!MONO_LINE_VALID(items, all_items))
+    return false;
+  if (!MONO_TIMESTAMP_VALID(items, all_items, *mono_timestamp_ms))
+    *mono_timestamp_ms = 0;
+  return true;
+}
+
 void HandleRemoteControl(RemoteProto remote, int* control_mode) {
   if (remote.command != *control_mode)
-    syslog(LOG_NOTICE, "Helmsman switched to control mode %d\n", remote.command);
+    slog(LOG_NOTICE, "Helmsman switched to control mode %d\n", remote.command);
   switch (remote.command) {
     case kNormalControlMode:
     case kOverrideSkipperMode:
@@ -123,7 +125,7 @@ void HandleRemoteControl(RemoteProto remote, int* control_mode) {
       ShipControl::Idle();
       break;
   default:
-    syslog(LOG_WARNING, "Illegal remote control: %d", remote.command);
+    slog(LOG_WARNING, "Illegal remote control: %d", remote.command);
   }
 }
 
@@ -134,7 +136,7 @@ void HandleRemoteControlFailSafe(int64_t last_remote_message_millis, int* contro
        kOverrideSkipperMode == *control_mode) &&
       now_ms() > last_remote_message_millis + kRemoteControlTimeOutSeconds * 1000) {
     *control_mode = kBrakeControlMode;
-    syslog(LOG_WARNING, "helsman main: remote control communication timeout, braking");
+    slog(LOG_WARNING, "helsman main: remote control communication timeout, braking");
     ShipControl::Brake();
   }
 }
@@ -169,13 +171,14 @@ int main(int argc, char* argv[]) {
   if(!debug) setlogmask(LOG_UPTO(LOG_NOTICE));
 
   if(setvbuf(stdout, NULL, _IOLBF, 0))
-    syslog(LOG_WARNING, "Failed to make stdout line-buffered.");
+    slog(LOG_WARNING, "Failed to make stdout line-buffered.");
 
   if (signal(SIGBUS, bus_fault) == SIG_ERR)  crash("signal(SIGBUS)");
   if (signal(SIGSEGV, segv_fault) == SIG_ERR)  crash("signal(SIGSEGV)");
   if (signal(SIGPIPE, SIG_IGN) == SIG_ERR) crash("signal");
 
-  syslog(LOG_NOTICE, "Helmsman started");
+  slog(LOG_NOTICE, "Helmsman started");
+  slog_flush();  // from now on only when idle
 
   ControllerInput ctrl_in;
   ControllerOutput ctrl_out;  // in this scope because it keeps the statistics.
@@ -183,6 +186,8 @@ int main(int argc, char* argv[]) {
   struct WindProto wind_sensor  = INIT_WINDPROTO;
   struct CompassProto compass  = INIT_COMPASSPROTO;
   struct RudderProto sts = INIT_RUDDERPROTO;
+  const struct RudderProto ctl_none = INIT_RUDDERPROTO;
+  struct RudderProto last_ctl = ctl_none;  // the reference of the last period
   struct IMUProto imu    = INIT_IMUPROTO;
   struct HelmsmanCtlProto ctl = INIT_HELMSMANCTLPROTO;
   struct RemoteProto remote = INIT_REMOTEPROTO;
@@ -191,6 +196,13 @@ int main(int argc, char* argv[]) {
   int control_mode = kNormalControlMode;
   int64_t last_remote_message_millis = now_ms();
 
+  // Age of the sensor data at control time, published every 10s.
+  SensorAge imu_age("imu");
+  SensorAge compass_age("compass");
+  SensorAge wind_age("wind");
+  SensorAge gps_age("gps");
+  SensorAge* const ages[] = { &imu_age, &compass_age, &wind_age, &gps_age };
+
   int loops = 0;
 
   // Run ship controller exactly once every 100ms
@@ -208,10 +220,19 @@ int main(int argc, char* argv[]) {
     FD_SET(fileno(stdin), &rfds);
     sigset_t empty_mask;
     sigemptyset(&empty_mask);
-    int r = pselect(fileno(stdin) + 1, &rfds,  NULL, NULL, &timeout, &empty_mask);
+    // Write the log only if we would wait anyway.
+    fd_set rfds_idle = rfds;
+    struct timespec nowait = { 0, 0 };
+    int r = pselect(fileno(stdin) + 1, &rfds,  NULL, NULL, &nowait, &empty_mask);
+    if (r == 0 && (timeout.tv_sec > 0 || timeout.tv_nsec > 0)) {
+      slog_flush();
+      rfds = rfds_idle;
+      CalculateTimeOut(next_call_micros, &timeout);
+      r = pselect(fileno(stdin) + 1, &rfds,  NULL, NULL, &timeout, &empty_mask);
+    }
     if (r == -1 && errno != EINTR) crash("pselect");
 
-    if (debug>2) syslog(LOG_DEBUG, "Woke up %d\n", r);
+    if (debug>2) slog(LOG_DEBUG, "Woke up %d\n", r);
 
     if (r == 1) {
       r = lb_readfd(&lbuf, fileno(stdin));
@@ -223,12 +244,14 @@ int main(int argc, char* argv[]) {
     char line[1024];
     while(lb_getline(line, sizeof line, &lbuf) > 0) {
       int nn = 0;
-      if (sscanf(line, IFMT_WINDPROTO(&wind_sensor, &nn)) > 0) {
+      if (SensorLine(sscanf(line, IFMT_WINDPROTO(&wind_sensor, &nn)),
+                     IFMT_WINDPROTO_ITEMS, &wind_sensor.mono_timestamp_ms)) {
 	ctrl_in.wind_sensor.Reset();
 	ctrl_in.wind_sensor.alpha_deg = SymmetricDeg(NormalizeDeg(wind_sensor.angle_deg));
 	ctrl_in.wind_sensor.mag_m_s = wind_sensor.speed_m_s;
 	ctrl_in.wind_sensor.valid = wind_sensor.valid;
-      } else if (sscanf(line, IFMT_IMUPROTO(&imu, &nn)) > 0) {
+      } else if (SensorLine(sscanf(line, IFMT_IMUPROTO(&imu, &nn)),
+                            IFMT_IMUPROTO_ITEMS, &imu.mono_timestamp_ms)) {
 	ctrl_in.imu.Reset();
 	ctrl_in.imu.FromProto(imu);
       } else if (sscanf(line, IFMT_RUDDERPROTO_STS(&sts, &nn)) > 0) {
@@ -247,9 +270,12 @@ int main(int argc, char* argv[]) {
       } else if (sscanf(line, IFMT_STATUS_SAIL(&sts, &nn)) > 0) {
 	ctrl_in.drives.gamma_sail_rad  = Deg2Rad(sts.sail_deg);
 	ctrl_in.drives.homed_sail = !isnan(sts.sail_deg);
-      } else if (sscanf(line, IFMT_COMPASSPROTO(&compass, &nn)) > 0) {
+      } else if (SensorLine(sscanf(line, IFMT_COMPASSPROTO(&compass, &nn)),
+                            IFMT_COMPASSPROTO_ITEMS,
+                            &compass.mono_timestamp_ms)) {
 	ctrl_in.compass_sensor.phi_z_rad  = Deg2Rad(compass.yaw_deg);
-      } else if (sscanf(line, IFMT_GPSPROTO(&gps, &nn)) > 0) {
+      } else if (SensorLine(sscanf(line, IFMT_GPSPROTO(&gps, &nn)),
+                            IFMT_GPSPROTO_ITEMS, &gps.mono_timestamp_ms)) {
         ctrl_in.gps.latitude_deg = gps.lat_deg;
         ctrl_in.gps.longitude_deg = gps.lng_deg;
         ctrl_in.gps.speed_m_s = gps.speed_m_s;
@@ -275,6 +301,12 @@ int main(int argc, char* argv[]) {
     HandleRemoteControlFailSafe(last_remote_message_millis, &control_mode);
 
     if (!CalculateTimeOut(next_call_micros, &timeout)) {
+      int64_t now_mono = now_mono_ms();
+      imu_age.Add(now_mono, imu.mono_timestamp_ms);
+      compass_age.Add(now_mono, compass.mono_timestamp_ms);
+      wind_age.Add(now_mono, wind_sensor.mono_timestamp_ms);
+      gps_age.Add(now_mono, gps.mono_timestamp_ms);
+
       ctrl_out.Reset();
       ShipControl::Run(ctrl_in, &ctrl_out);
       AdvanceCallTime(&next_call_micros);
@@ -283,7 +315,18 @@ int main(int argc, char* argv[]) {
         RudderProto ctl;
         ctrl_out.drives_reference.ToProto(&ctl);
         ctl.timestamp_ms = now_ms();
-        printf(OFMT_RUDDERPROTO_CTL(ctl));
+        // The reference changes once per period, rudderctl follows it
+        // as a trajectory with these rates.
+        if (isnan(last_ctl.rudder_l_deg) || isnan(last_ctl.rudder_r_deg)) {
+          printf(OFMT_RUDDERPROTO_CTL(ctl));
+        } else {
+          printf(OFMT_RUDDERPROTO_CTL_RATES(ctl,
+              (ctl.rudder_l_deg - last_ctl.rudder_l_deg) / kSamplingPeriod,
+              (ctl.rudder_r_deg - last_ctl.rudder_r_deg) / kSamplingPeriod));
+        }
+        last_ctl = ctl;
+      } else {
+        last_ctl = ctl_none;
       }
       // One minute should be enough to execute the last direction change.
       if (loops % static_cast<int>(60.0 / kSamplingPeriod) == 0) {
@@ -299,12 +342,30 @@ int main(int argc, char* argv[]) {
           printf("%s", to_skipper.ToString().c_str());
         }
       }
+      // The skipper and the logs get the position estimate once a second.
+      if (loops % static_cast<int>(1.0 / kSamplingPeriod) == 3 &&
+          !isnan(ctrl_out.position.lat_deg)) {
+        PositionProto pos = ctrl_out.position;
+        pos.timestamp_ms = now_ms();
+        printf(OFMT_POSITIONPROTO(pos));
+      }
       if (loops % 20 == 5) {
         HelmsmanStatusProto hsts = INIT_HELMSMAN_STATUSPROTO;
         ctrl_out.status.ToProto(&hsts);
         hsts.timestamp_ms = now_ms();
         printf(OFMT_HELMSMAN_STATUSPROTO(hsts));
       }
+      if (loops % 100 == 50) {
+        for (size_t i = 0; i < sizeof(ages) / sizeof(ages[0]); ++i) {
+          if (ages[i]->count() == 0)
+            continue;
+          SensorAgeProto age_sts = INIT_SENSORAGEPROTO;
+          ages[i]->ToProto(&age_sts);
+          age_sts.timestamp_ms = now_ms();
+          printf(OFMT_SENSORAGEPROTO(age_sts));
+          ages[i]->Reset();
+        }
+      }
 
       ++loops;
 //      loops %= 1000;
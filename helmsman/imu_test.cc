@@ -50,7 +50,8 @@ ATEST(IMUData, All) {
       "mag_x_au:22.786 mag_y_au:-0.000 mag_z_au:41.107 "
       "roll_deg:0.000 pitch_deg:0.000 yaw_deg:0.000 "
       "lat_deg:48.2389060 lng_deg:-4.7698000 alt_m:0.000 "
-      "vel_x_m_s:-0.586 vel_y_m_s:0.000 vel_z_m_s:0.000\n";
+      "vel_x_m_s:-0.586 vel_y_m_s:0.000 vel_z_m_s:0.000 "
+      "mono_timestamp_ms:0\n";
   IMUProto imu_proto_out = INIT_IMUPROTO;
   imu.ToProto(&imu_proto_out);
   char buffer[1024];
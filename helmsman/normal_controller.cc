@@ -216,13 +216,9 @@ void NormalController::ShapeReferenceValue(double alpha_star,
       new_sailable = AddOvershoot(old_phi_z_star_, maneuver_target.rad(), maneuver_type_);
       if (debug) fprintf(stderr, "Start %s maneuver, from  %lf to %lf degrees\n",
                          ManeuverToString(maneuver_type_), Rad2Deg(old_phi_z_star_), Rad2Deg(new_sailable));
-      double new_gamma_sail;
-      double delta_gamma_sail;
-      NewGammaSail(old_gamma_sail,
+      double delta_gamma_sail = NewGammaSail(rad(old_gamma_sail),
                    maneuver_type_,
-                   kTackOvershootRad,
-                   &new_gamma_sail,
-                   &delta_gamma_sail);
+                   rad(kTackOvershootRad));
 
       ref_.SetReferenceValues(old_phi_z_star_, old_gamma_sail);
       ref_.NewPlan(new_sailable, delta_gamma_sail);
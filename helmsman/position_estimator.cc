@@ -0,0 +1,131 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "helmsman/position_estimator.h"
+
+#include <math.h>
+
+#include "common/convert.h"
+
+namespace {
+
+const double kMetersPerDegree = 60 * 1852.0;  // latitude
+
+// Growth of the position variance in m^2/s. The filtered speed is off by
+// some 0.3m/s over periods of about 10s, the heading by some 0.1 rad and
+// currents and leeway add up to 0.2m/s in any direction.
+const double kAlongTrackNoise = 0.3 * 0.3 * 10;
+const double kCrossTrackNoisePerSpeed2 = 0.1 * 0.1 * 10;  // times speed^2
+const double kDriftNoise = 0.2 * 0.2 * 10;
+
+// Squared Mahalanobis distance beyond which a fix is an outlier
+// (chi-square with 2 degrees of freedom, p < 0.0005).
+const double kGate = 16;
+const int kMaxRejected = 5;
+
+}  // namespace
+
+PositionEstimator::PositionEstimator() {
+  Reset();
+}
+
+void PositionEstimator::Reset() {
+  valid_ = false;
+  latitude_deg_ = 0;
+  longitude_deg_ = 0;
+  p_nn_ = 0;
+  p_ee_ = 0;
+  p_ne_ = 0;
+  since_fix_s_ = 0;
+  rejected_ = 0;
+}
+
+void PositionEstimator::Restart(double latitude_deg, double longitude_deg,
+                                double sigma_m) {
+  valid_ = true;
+  latitude_deg_ = latitude_deg;
+  longitude_deg_ = longitude_deg;
+  p_nn_ = p_ee_ = sigma_m * sigma_m;
+  p_ne_ = 0;
+  since_fix_s_ = 0;
+  rejected_ = 0;
+}
+
+void PositionEstimator::Predict(double phi_z_rad, double speed_m_s, double dt_s) {
+  if (!valid_)
+    return;
+  const double c = cos(phi_z_rad);
+  const double s = sin(phi_z_rad);
+  const double meters_per_degree_lon = kMetersPerDegree * cos(Deg2Rad(latitude_deg_));
+  latitude_deg_ += speed_m_s * c * dt_s / kMetersPerDegree;
+  longitude_deg_ += speed_m_s * s * dt_s / meters_per_degree_lon;
+  if (longitude_deg_ > 180)
+    longitude_deg_ -= 360;
+  if (longitude_deg_ < -180)
+    longitude_deg_ += 360;
+
+  // Process noise, rotated from track into north/east coordinates.
+  const double q_along = kAlongTrackNoise * dt_s;
+  const double q_cross = kCrossTrackNoisePerSpeed2 * speed_m_s * speed_m_s * dt_s;
+  const double q_drift = kDriftNoise * dt_s;
+  p_nn_ += q_along * c * c + q_cross * s * s + q_drift;
+  p_ee_ += q_along * s * s + q_cross * c * c + q_drift;
+  p_ne_ += (q_along - q_cross) * s * c;
+  since_fix_s_ += dt_s;
+}
+
+bool PositionEstimator::Update(double latitude_deg, double longitude_deg,
+                               double sigma_m) {
+  if (!valid_) {
+    Restart(latitude_deg, longitude_deg, sigma_m);
+    return true;
+  }
+  const double meters_per_degree_lon = kMetersPerDegree * cos(Deg2Rad(latitude_deg_));
+  double d_lon = longitude_deg - longitude_deg_;
+  if (d_lon > 180)
+    d_lon -= 360;
+  if (d_lon < -180)
+    d_lon += 360;
+  const double dn = (latitude_deg - latitude_deg_) * kMetersPerDegree;
+  const double de = d_lon * meters_per_degree_lon;
+
+  // Innovation covariance S = P + R and its inverse.
+  const double r = sigma_m * sigma_m;
+  const double s_nn = p_nn_ + r;
+  const double s_ee = p_ee_ + r;
+  const double s_ne = p_ne_;
+  const double det = s_nn * s_ee - s_ne * s_ne;
+  const double i_nn = s_ee / det;
+  const double i_ee = s_nn / det;
+  const double i_ne = -s_ne / det;
+
+  const double d2 = dn * dn * i_nn + 2 * dn * de * i_ne + de * de * i_ee;
+  if (d2 > kGate) {
+    if (++rejected_ >= kMaxRejected) {
+      Restart(latitude_deg, longitude_deg, sigma_m);
+      return true;
+    }
+    return false;
+  }
+  rejected_ = 0;
+
+  // Gain K = P S^-1
+  const double k_nn = p_nn_ * i_nn + p_ne_ * i_ne;
+  const double k_ne = p_nn_ * i_ne + p_ne_ * i_ee;
+  const double k_en = p_ne_ * i_nn + p_ee_ * i_ne;
+  const double k_ee = p_ne_ * i_ne + p_ee_ * i_ee;
+
+  latitude_deg_ += (k_nn * dn + k_ne * de) / kMetersPerDegree;
+  longitude_deg_ += (k_en * dn + k_ee * de) / meters_per_degree_lon;
+
+  // P = (I - K) P
+  const double nn = (1 - k_nn) * p_nn_ - k_ne * p_ne_;
+  const double ne = (1 - k_nn) * p_ne_ - k_ne * p_ee_;
+  const double ee = -k_en * p_ne_ + (1 - k_ee) * p_ee_;
+  p_nn_ = nn;
+  p_ne_ = ne;
+  p_ee_ = ee;
+  since_fix_s_ = 0;
+  return true;
+}
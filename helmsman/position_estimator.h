@@ -0,0 +1,59 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef HELMSMAN_POSITION_ESTIMATOR_H
+#define HELMSMAN_POSITION_ESTIMATOR_H
+
+// Dead reckoning between position fixes.
+//
+// A Kalman filter with the position as state. Every control period the
+// position is advanced with the filtered speed and heading and the
+// covariance grows, more along the track (speed error) than across it
+// (heading error). A fix pulls the position back towards the measurement
+// according to the ratio of both covariances.
+// So we get a fresh position at the control rate from the 1Hz GPS, and
+// when waves wash over the antenna, the position keeps moving with the
+// boat while its covariance tells how far it can be trusted.
+//
+// Fixes far outside the covariance are rejected as outliers. If several
+// consecutive fixes disagree, we got lost and restart at the last fix.
+//
+// The covariance is kept in m^2 in north/east coordinates.
+class PositionEstimator {
+ public:
+  PositionEstimator();
+  void Reset();
+
+  // Advance by dt_s with speed_m_s over ground (negative if drifting
+  // backwards) into direction phi_z_rad (from north, clockwise).
+  void Predict(double phi_z_rad, double speed_m_s, double dt_s);
+
+  // A fix with standard deviation sigma_m. Returns false if it was
+  // rejected as outlier.
+  bool Update(double latitude_deg, double longitude_deg, double sigma_m);
+
+  // False until the first fix.
+  bool Valid() const { return valid_; }
+
+  double latitude_deg() const { return latitude_deg_; }
+  double longitude_deg() const { return longitude_deg_; }
+  double var_north_m2() const { return p_nn_; }
+  double var_east_m2() const { return p_ee_; }
+  double cov_north_east_m2() const { return p_ne_; }
+  // Time since the last accepted fix.
+  double since_fix_s() const { return since_fix_s_; }
+
+ private:
+  void Restart(double latitude_deg, double longitude_deg, double sigma_m);
+
+  bool valid_;
+  double latitude_deg_;
+  double longitude_deg_;
+  double p_nn_;
+  double p_ee_;
+  double p_ne_;
+  double since_fix_s_;
+  int rejected_;  // consecutive outliers
+};
+
+#endif  // HELMSMAN_POSITION_ESTIMATOR_H
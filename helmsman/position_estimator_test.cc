@@ -0,0 +1,111 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#include "helmsman/position_estimator.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include "common/convert.h"
+#include "lib/testing/testing.h"
+
+namespace {
+const double kMetersPerDegree = 60 * 1852.0;
+}
+
+TEST(PositionEstimator, DeadReckoning) {
+  PositionEstimator p;
+  EXPECT_FALSE(p.Valid());
+  p.Predict(0, 1, 0.1);
+  EXPECT_FALSE(p.Valid());
+
+  EXPECT_TRUE(p.Update(48, -5, 5));
+  EXPECT_TRUE(p.Valid());
+  EXPECT_FLOAT_EQ(48, p.latitude_deg());
+  EXPECT_FLOAT_EQ(25, p.var_north_m2());
+  EXPECT_FLOAT_EQ(25, p.var_east_m2());
+
+  // 10s north with 2m/s
+  for (int i = 0; i < 100; ++i)
+    p.Predict(0, 2, 0.1);
+  EXPECT_FLOAT_EQ(48 + 20 / kMetersPerDegree, p.latitude_deg());
+  EXPECT_FLOAT_EQ(-5, p.longitude_deg());
+  EXPECT_FLOAT_EQ(10, p.since_fix_s());
+  // Less certain along the track than across it.
+  EXPECT_GT(p.var_north_m2(), p.var_east_m2());
+  EXPECT_GT(p.var_east_m2(), 25);
+
+  // 10s east
+  double lat = p.latitude_deg();
+  for (int i = 0; i < 100; ++i)
+    p.Predict(M_PI / 2, 2, 0.1);
+  EXPECT_FLOAT_EQ(lat, p.latitude_deg());
+  EXPECT_FLOAT_EQ(-5 + 20 / (kMetersPerDegree * cos(Deg2Rad(lat))), p.longitude_deg());
+
+  // A fix shrinks the covariance and moves towards the measurement.
+  double var = p.var_north_m2() + p.var_east_m2();
+  double lon = p.longitude_deg();
+  EXPECT_TRUE(p.Update(lat + 10 / kMetersPerDegree, lon, 5));
+  EXPECT_GT(p.latitude_deg(), lat);
+  EXPECT_LT(p.latitude_deg(), lat + 10 / kMetersPerDegree);
+  EXPECT_LT(p.var_north_m2() + p.var_east_m2(), var);
+  EXPECT_FLOAT_EQ(0, p.since_fix_s());
+}
+
+TEST(PositionEstimator, Outliers) {
+  PositionEstimator p;
+  p.Update(48, -5, 5);
+  p.Update(48, -5, 5);
+  // 1km off is rejected, unless it keeps coming.
+  const double off = 48 + 1000 / kMetersPerDegree;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FALSE(p.Update(off, -5, 5));
+    EXPECT_FLOAT_EQ(48, p.latitude_deg());
+  }
+  EXPECT_TRUE(p.Update(off, -5, 5));
+  EXPECT_FLOAT_EQ(off, p.latitude_deg());
+}
+
+TEST(PositionEstimator, Dropout) {
+  // Sailing at 45 degrees with noisy 1Hz fixes and a 60s GPS dropout.
+  srand(1);
+  PositionEstimator p;
+  const double phi = M_PI / 4;
+  const double v = 2;
+  double north_m = 0;
+  double east_m = 0;
+  double max_error_m = 0;
+  for (int i = 0; i < 3000; ++i) {
+    north_m += v * cos(phi) * 0.1;
+    east_m += v * sin(phi) * 0.1;
+    // The filtered speed and heading are a bit off.
+    p.Predict(phi + 0.03, v * 0.95, 0.1);
+    bool dropout = i > 1000 && i < 1600;
+    if (i % 10 == 0 && !dropout) {
+      double noise_n = (rand() % 1000 - 500) / 100.0;
+      double noise_e = (rand() % 1000 - 500) / 100.0;
+      p.Update(48 + (north_m + noise_n) / kMetersPerDegree,
+               -5 + (east_m + noise_e) / (kMetersPerDegree * cos(Deg2Rad(48))), 3);
+    }
+    double error_n = (p.latitude_deg() - 48) * kMetersPerDegree - north_m;
+    double error_e = (p.longitude_deg() + 5) * kMetersPerDegree * cos(Deg2Rad(48)) - east_m;
+    double error = sqrt(error_n * error_n + error_e * error_e);
+    if (i > 100) {
+      // The error stays within 3 sigma.
+      EXPECT_LT(error, 3 * sqrt(p.var_north_m2() + p.var_east_m2()));
+      if (error > max_error_m)
+        max_error_m = error;
+    }
+    if (i == 1599) {
+      EXPECT_FLOAT_EQ(59.9, p.since_fix_s());
+    }
+  }
+  // 5% speed and 2 degrees heading error over 60s at 2m/s are about 7m.
+  EXPECT_LT(max_error_m, 10);
+}
+
+int main(int argc, char* argv[]) {
+  PositionEstimator_DeadReckoning();
+  PositionEstimator_Outliers();
+  PositionEstimator_Dropout();
+  return 0;
+}
@@ -17,7 +17,7 @@
 #include "common/delta_angle.h"
 #include "common/sign.h"
 #include "common/normalize.h"
-#include "common/Polar_diagram.h"
+#include "common/polar_diagram.h"
 
 #include "helmsman/sail_controller_const.h"
 #include "helmsman/sampling_period.h"  // kSamplingPeriod
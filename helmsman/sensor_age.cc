@@ -0,0 +1,48 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "helmsman/sensor_age.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+const int kLimitsMs[SENSOR_AGE_BUCKETS - 1] = SENSOR_AGE_LIMITS_MS;
+}  // namespace
+
+SensorAge::SensorAge(const char* name) : name_(name) {
+  Reset();
+}
+
+void SensorAge::Reset() {
+  last_ms_ = -1;
+  count_ = 0;
+  max_ms_ = 0;
+  memset(bucket_, 0, sizeof(bucket_));
+}
+
+void SensorAge::Add(int64_t now_mono_ms, int64_t mono_timestamp_ms) {
+  if (mono_timestamp_ms == 0) {
+    last_ms_ = -1;
+    return;
+  }
+  int64_t age = now_mono_ms - mono_timestamp_ms;
+  if (age < 0)
+    age = 0;  // Stamped by another machine or a reboot in between.
+  last_ms_ = age > 0x7fffffff ? 0x7fffffff : static_cast<int>(age);
+  int i = 0;
+  while (i < SENSOR_AGE_BUCKETS - 1 && last_ms_ >= kLimitsMs[i])
+    ++i;
+  ++bucket_[i];
+  ++count_;
+  if (last_ms_ > max_ms_)
+    max_ms_ = last_ms_;
+}
+
+void SensorAge::ToProto(SensorAgeProto* proto) const {
+  snprintf(proto->sensor, sizeof(proto->sensor), "%s", name_);
+  proto->count = count_;
+  proto->max_ms = max_ms_;
+  memcpy(proto->bucket, bucket_, sizeof(bucket_));
+}
@@ -0,0 +1,38 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef HELMSMAN_SENSOR_AGE_H
+#define HELMSMAN_SENSOR_AGE_H
+
+#include <stdint.h>
+
+#include "proto/sensor_age.h"
+
+// Collects how old the data of one sensor is when the controller runs.
+// The producers (nmeacat, imucat) stamp their protos with CLOCK_MONOTONIC
+// when read() returned, so the age includes the time spent in pipes, the
+// linebus and our own input queue. A slow control response with young
+// data points at the controller, with old data at the acquisition chain.
+class SensorAge {
+ public:
+  explicit SensorAge(const char* name);
+  void Reset();
+
+  // Stamps of 0 come from producers that do not stamp and are ignored.
+  void Add(int64_t now_mono_ms, int64_t mono_timestamp_ms);
+
+  // Age of the last added data, -1 if unknown.
+  int last_ms() const { return last_ms_; }
+  int count() const { return count_; }
+
+  void ToProto(SensorAgeProto* proto) const;
+
+ private:
+  const char* name_;
+  int last_ms_;
+  int count_;
+  int max_ms_;
+  int bucket_[SENSOR_AGE_BUCKETS];
+};
+
+#endif  // HELMSMAN_SENSOR_AGE_H
@@ -0,0 +1,51 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#include "helmsman/sensor_age.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "lib/testing/testing.h"
+
+
+TEST(SensorAge, Histogram) {
+  SensorAge age("imu");
+  EXPECT_EQ(-1, age.last_ms());
+  age.Add(1000, 995);   // 5ms
+  EXPECT_EQ(5, age.last_ms());
+  age.Add(1000, 990);   // 10ms is not below 10
+  age.Add(1000, 850);   // 150ms
+  age.Add(5000, 1000);  // 4s
+  age.Add(5000, 0);     // not stamped
+  EXPECT_EQ(-1, age.last_ms());
+  age.Add(1000, 1001);  // from the future counts as fresh
+  EXPECT_EQ(0, age.last_ms());
+  EXPECT_EQ(5, age.count());
+
+  SensorAgeProto proto = INIT_SENSORAGEPROTO;
+  age.ToProto(&proto);
+  EXPECT_EQ(0, strcmp("imu", proto.sensor));
+  EXPECT_EQ(5, proto.count);
+  EXPECT_EQ(4000, proto.max_ms);
+  EXPECT_EQ(2, proto.bucket[0]);
+  EXPECT_EQ(1, proto.bucket[1]);
+  EXPECT_EQ(1, proto.bucket[4]);
+  EXPECT_EQ(1, proto.bucket[7]);
+
+  char line[256];
+  snprintf(line, sizeof(line), OFMT_SENSORAGEPROTO(proto));
+  SensorAgeProto parsed = INIT_SENSORAGEPROTO;
+  int n = 0;
+  EXPECT_EQ(12, sscanf(line, IFMT_SENSORAGEPROTO(&parsed, &n)));
+  EXPECT_EQ(0, strcmp("imu", parsed.sensor));
+  EXPECT_EQ(4000, parsed.max_ms);
+  EXPECT_EQ(1, parsed.bucket[7]);
+
+  age.Reset();
+  EXPECT_EQ(0, age.count());
+}
+
+int main(int argc, char* argv[]) {
+  SensorAge_Histogram();
+  return 0;
+}
@@ -142,6 +142,15 @@ void ShipControl::Run(const ControllerInput& in, ControllerOutput* out) {
     }
   }  
 
+  // The position estimate for the skipper
+  if (filtered_.latitude_deg != 0 || filtered_.longitude_deg != 0) {
+    out->position.lat_deg           = filtered_.latitude_deg;
+    out->position.lng_deg           = filtered_.longitude_deg;
+    out->position.var_north_m2      = filtered_.var_north_m2;
+    out->position.var_east_m2       = filtered_.var_east_m2;
+    out->position.cov_north_east_m2 = filtered_.cov_north_east_m2;
+  }
+
   wind_strength_apparent_ = WindStrength(wind_strength_apparent_, filtered_.mag_app);
 
   // Find state 
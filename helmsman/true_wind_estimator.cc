@@ -0,0 +1,242 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "helmsman/true_wind_estimator.h"
+
+#include <algorithm>  // min
+#include <math.h>
+#include <stdio.h>
+
+#include "common/convert.h"
+#include "common/normalize.h"
+
+extern int debug;
+
+namespace {
+
+const double kTimeConstant = 10;  // s, of the true wind output
+
+// A leg is averaged over 20s of steady sailing, starting 10s after the
+// wind changed sides, when the boat has finished turning and the speed
+// filter has mostly caught up. The leg after a maneuver has to follow
+// within 2 minutes, else the wind may have changed too much.
+const double kLegPeriod = 20;
+const double kSettle = 10;
+const double kMaxManeuver = 120;
+const double kMaxTurnRate = 0.1;    // rad/s, more is no steady sailing
+const double kMinBoatSpeed = 0.5;   // m/s
+const double kMinAppWind = 2;       // m/s
+const double kMinSin = 0.2;         // close to the bow or stern the side is unclear
+
+// Upper apparent wind speed limits of the upwash ranges.
+const double kRangeLimits[] = {4, 8};
+
+// Prior standard deviations, the mounting offset is corrected before.
+const double kBiasSigma = 0.15;     // rad
+const double kUpwashSigma = 0.1;    // rad
+const double kDriftSigma = 0.01;    // rad per calibration
+// Noise of the averaged true wind, per component.
+const double kNoise = 0.2;          // m/s
+const double kRelativeNoise = 0.05;
+// A wind shift during the maneuver, chi-square with 2 degrees of freedom.
+const double kGate = 16;
+
+}  // namespace
+
+void TrueWindEstimator::Leg::Reset() {
+  v[0] = v[1] = 0;
+  j[0] = j[1] = 0;
+  js[0] = js[1] = 0;
+  mag_app = 0;
+  time_s = 0;
+}
+
+void TrueWindEstimator::Leg::Add(const double v_in[2], const double j_in[2],
+                                 double s, double mag_app_in, double alpha) {
+  if (time_s == 0)
+    alpha = 1;
+  for (int i = 0; i < 2; ++i) {
+    v[i] += alpha * (v_in[i] - v[i]);
+    j[i] += alpha * (j_in[i] - j[i]);
+    js[i] += alpha * (j_in[i] * s - js[i]);
+  }
+  mag_app += alpha * (mag_app_in - mag_app);
+}
+
+TrueWindEstimator::TrueWindEstimator() {
+  Reset();
+}
+
+void TrueWindEstimator::Reset() {
+  for (int k = 0; k < kN; ++k) {
+    theta_[k] = 0;
+    for (int l = 0; l < kN; ++l)
+      p_[k][l] = 0;
+  }
+  p_[0][0] = kBiasSigma * kBiasSigma;
+  for (int k = 1; k < kN; ++k)
+    p_[k][k] = kUpwashSigma * kUpwashSigma;
+  calibrations_ = 0;
+  v_[0] = v_[1] = 0;
+  time_s_ = 0;
+  last_phi_z_rad_ = 0;
+  side_ = 0;
+  since_side_change_s_ = 0;
+  leg_.Reset();
+  before_.Reset();
+  since_before_s_ = 0;
+}
+
+int TrueWindEstimator::Range(double mag_app_m_s) {
+  int r = 0;
+  while (r < kRanges - 1 && mag_app_m_s >= kRangeLimits[r])
+    ++r;
+  return r;
+}
+
+double TrueWindEstimator::Correct(double angle_app_rad, double mag_app_m_s) const {
+  return angle_app_rad - theta_[0] - theta_[1 + Range(mag_app_m_s)] * sin(angle_app_rad);
+}
+
+bool TrueWindEstimator::Valid() const {
+  return time_s_ >= 3 * kTimeConstant;
+}
+
+double TrueWindEstimator::alpha_true_rad() const {
+  return v_[0] == 0 && v_[1] == 0 ? 0 : atan2(v_[1], v_[0]);
+}
+
+double TrueWindEstimator::mag_true_m_s() const {
+  return sqrt(v_[0] * v_[0] + v_[1] * v_[1]);
+}
+
+void TrueWindEstimator::Update(double angle_app_rad, double mag_app_m_s,
+                               double phi_z_rad, double mag_boat_m_s, double dt_s) {
+  if (isnan(angle_app_rad) || isnan(mag_app_m_s) || isnan(phi_z_rad) || isnan(mag_boat_m_s))
+    return;
+  const double angle = Correct(angle_app_rad, mag_app_m_s);
+
+  // v_true = v_boat + v_app in the global frame, and its derivative
+  // to the apparent wind angle.
+  const double global = phi_z_rad + angle;
+  double v[2];
+  double j[2];
+  v[0] = mag_boat_m_s * cos(phi_z_rad) + mag_app_m_s * cos(global);
+  v[1] = mag_boat_m_s * sin(phi_z_rad) + mag_app_m_s * sin(global);
+  j[0] = -mag_app_m_s * sin(global);
+  j[1] = mag_app_m_s * cos(global);
+
+  const bool first = time_s_ == 0;
+  const double alpha = first ? 1 : std::min(1.0, dt_s / kTimeConstant);
+  v_[0] += alpha * (v[0] - v_[0]);
+  v_[1] += alpha * (v[1] - v_[1]);
+  time_s_ += dt_s;
+
+  const double turn_rate = first ? 0 : SymmetricRad(phi_z_rad - last_phi_z_rad_) / dt_s;
+  last_phi_z_rad_ = phi_z_rad;
+
+  // Watch the wind changing sides.
+  const double s = sin(angle);
+  const int side = s > kMinSin ? 1 : (s < -kMinSin ? -1 : 0);
+  since_side_change_s_ += dt_s;
+  since_before_s_ += dt_s;
+  if (side != 0 && side != side_) {
+    if (side_ != 0 && leg_.time_s >= kLegPeriod) {
+      before_ = leg_;
+      since_before_s_ = 0;
+    }
+    side_ = side;
+    since_side_change_s_ = 0;
+    leg_.Reset();
+  }
+
+  const bool steady = side != 0 && since_side_change_s_ >= kSettle &&
+                      fabs(turn_rate) < kMaxTurnRate &&
+                      mag_boat_m_s > kMinBoatSpeed && mag_app_m_s > kMinAppWind;
+  if (steady) {
+    leg_.Add(v, j, s, mag_app_m_s, dt_s / kLegPeriod);
+    leg_.time_s += dt_s;
+  }
+
+  if (before_.time_s >= kLegPeriod && leg_.time_s >= kLegPeriod) {
+    if (since_before_s_ < kMaxManeuver) {
+      Calibrate(before_, leg_);
+      // The averages of this leg are based on the old calibration.
+      leg_.Reset();
+    }
+    before_.Reset();
+  }
+}
+
+void TrueWindEstimator::Calibrate(const Leg& before, const Leg& after) {
+  // The true wind did not change, so the difference of the averages is
+  // caused by the remaining errors of the parameters:
+  //   after.v - before.v = H * (theta - theta_)
+  double h[2][kN];
+  double z[2];
+  const int rb = 1 + Range(before.mag_app);
+  const int ra = 1 + Range(after.mag_app);
+  for (int i = 0; i < 2; ++i) {
+    for (int k = 0; k < kN; ++k)
+      h[i][k] = 0;
+    h[i][0] = after.j[i] - before.j[i];
+    h[i][rb] -= before.js[i];
+    h[i][ra] += after.js[i];
+    z[i] = after.v[i] - before.v[i];
+  }
+
+  // The parameters may drift a bit, e.g. with the trim of the sail.
+  for (int k = 0; k < kN; ++k)
+    p_[k][k] += kDriftSigma * kDriftSigma;
+
+  // P H' and S = H P H' + R
+  double pht[kN][2];
+  for (int k = 0; k < kN; ++k) {
+    for (int i = 0; i < 2; ++i) {
+      pht[k][i] = 0;
+      for (int l = 0; l < kN; ++l)
+        pht[k][i] += p_[k][l] * h[i][l];
+    }
+  }
+  const double mag = 0.5 * (sqrt(before.v[0] * before.v[0] + before.v[1] * before.v[1]) +
+                            sqrt(after.v[0] * after.v[0] + after.v[1] * after.v[1]));
+  const double sigma = kNoise + kRelativeNoise * mag;
+  double s[2][2];
+  for (int i = 0; i < 2; ++i) {
+    for (int m = 0; m < 2; ++m) {
+      s[i][m] = i == m ? 2 * sigma * sigma : 0;  // noise of both averages
+      for (int k = 0; k < kN; ++k)
+        s[i][m] += h[i][k] * pht[k][m];
+    }
+  }
+  const double det = s[0][0] * s[1][1] - s[0][1] * s[1][0];
+  double si[2][2];
+  si[0][0] = s[1][1] / det;
+  si[1][1] = s[0][0] / det;
+  si[0][1] = -s[0][1] / det;
+  si[1][0] = -s[1][0] / det;
+
+  const double d2 = z[0] * (si[0][0] * z[0] + si[0][1] * z[1]) +
+                    z[1] * (si[1][0] * z[0] + si[1][1] * z[1]);
+  if (d2 > kGate) {
+    if (debug)
+      fprintf(stderr, "TrueWindEstimator: wind shift during maneuver, %lg %lg m/s\n", z[0], z[1]);
+    return;
+  }
+
+  // K = P H' S^-1, theta += K z, P -= K H P
+  double k[kN][2];
+  for (int r = 0; r < kN; ++r)
+    for (int i = 0; i < 2; ++i)
+      k[r][i] = pht[r][0] * si[0][i] + pht[r][1] * si[1][i];
+  for (int r = 0; r < kN; ++r)
+    theta_[r] += k[r][0] * z[0] + k[r][1] * z[1];
+  for (int r = 0; r < kN; ++r)
+    for (int c = 0; c < kN; ++c)
+      p_[r][c] -= k[r][0] * pht[c][0] + k[r][1] * pht[c][1];
+  ++calibrations_;
+  if (debug)
+    fprintf(stderr, "TrueWindEstimator: bias %lg deg, upwash %lg %lg %lg deg\n",
+            Rad2Deg(theta_[0]), Rad2Deg(theta_[1]), Rad2Deg(theta_[2]), Rad2Deg(theta_[3]));
+}
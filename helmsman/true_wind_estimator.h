@@ -0,0 +1,81 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef HELMSMAN_TRUE_WIND_ESTIMATOR_H
+#define HELMSMAN_TRUE_WIND_ESTIMATOR_H
+
+// True wind from the apparent wind with online calibration of the wind
+// sensor.
+//
+// The measured apparent wind angle has an error of
+//   bias + upwash(mag_app) * sin(angle_app)
+// The bias comes from mounting the sensor on the mast top, the upwash is
+// the deflection of the flow by the sail, it changes sides with the wind.
+// Both make the true wind jump at every tack and jibe, while the real
+// true wind stays the same. So we average the true wind over the steady
+// periods before and after each maneuver (the wind changes sides then)
+// and feed the difference into a Kalman filter over the bias and the
+// upwash in 3 apparent wind speed ranges.
+//
+// With the corrected apparent wind the true wind is steady enough to be
+// averaged over 10s instead of 100s.
+//
+// All matrices have a fixed size, there is no heap allocation.
+class TrueWindEstimator {
+ public:
+  TrueWindEstimator();
+  void Reset();
+
+  // angle_app_rad is the measured apparent wind in the boat frame (where
+  // it blows to), phi_z_rad the heading and mag_boat_m_s the speed of the
+  // boat. Without boat speed we calibrate nothing and the true wind is
+  // approximated by the apparent wind.
+  void Update(double angle_app_rad, double mag_app_m_s,
+              double phi_z_rad, double mag_boat_m_s, double dt_s);
+
+  // After 3 time constants.
+  bool Valid() const;
+
+  double alpha_true_rad() const;  // (-PI, PI]
+  double mag_true_m_s() const;
+
+  // The apparent wind angle after correction.
+  double Correct(double angle_app_rad, double mag_app_m_s) const;
+
+  double bias_rad() const { return theta_[0]; }
+  double upwash_rad(double mag_app_m_s) const { return theta_[1 + Range(mag_app_m_s)]; }
+  int calibrations() const { return calibrations_; }
+
+ private:
+  static const int kRanges = 3;
+  static const int kN = 1 + kRanges;  // bias, upwash per speed range
+
+  // Averages over the steady part of a leg on one side.
+  struct Leg {
+    void Reset();
+    void Add(const double v[2], const double j[2], double s, double mag_app, double alpha);
+    double v[2];    // true wind north, east
+    double j[2];    // derivative of v to the apparent wind angle
+    double js[2];   // j * sin(angle_app)
+    double mag_app;
+    double time_s;  // steady time
+  };
+
+  static int Range(double mag_app_m_s);
+  void Calibrate(const Leg& before, const Leg& after);
+
+  double theta_[kN];
+  double p_[kN][kN];
+  int calibrations_;
+
+  double v_[2];       // filtered true wind, north, east
+  double time_s_;     // since the first update
+  double last_phi_z_rad_;
+  int side_;          // sign of sin(angle_app), 0 if unknown
+  double since_side_change_s_;
+  Leg leg_;
+  Leg before_;        // the leg before the last maneuver
+  double since_before_s_;
+};
+
+#endif  // HELMSMAN_TRUE_WIND_ESTIMATOR_H
@@ -0,0 +1,129 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#include "helmsman/true_wind_estimator.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include "common/convert.h"
+#include "common/normalize.h"
+#include "lib/testing/testing.h"
+
+int debug = 0;
+
+namespace {
+
+const double kDt = 0.1;
+
+// The sensor error of the wind sensor.
+const double kBias = Deg2Rad(6);
+const double kUpwash = Deg2Rad(4);
+
+double Noise(double sigma) {
+  return sigma * (rand() % 2001 - 1000) / 1000.0 * sqrt(3.0);  // uniform
+}
+
+// One step sailing with heading phi_z and speed mag_boat in the true wind
+// (alpha_true, mag_true), the measured apparent wind has the sensor error.
+void Step(double alpha_true, double mag_true, double phi_z, double mag_boat,
+          TrueWindEstimator* e) {
+  double x = mag_true * cos(alpha_true) - mag_boat * cos(phi_z);
+  double y = mag_true * sin(alpha_true) - mag_boat * sin(phi_z);
+  double angle_app = SymmetricRad(atan2(y, x) - phi_z);
+  double mag_app = sqrt(x * x + y * y);
+  double measured = angle_app + kBias + kUpwash * sin(angle_app) + Noise(0.05);
+  e->Update(measured, mag_app + Noise(0.2), phi_z, mag_boat, kDt);
+}
+
+// Sail close hauled for leg_s, then tack within 10s, n times.
+// The true wind blows to the south with 5m/s, turned by shift_rad.
+// Returns the difference of the true wind direction at the end of the
+// last two legs.
+double Beat(int n, double leg_s, double shift_rad, double* phi_z,
+            TrueWindEstimator* e) {
+  const double alpha_true = M_PI + shift_rad;
+  double last_alpha[2] = {0, 0};
+  for (int tack = 0; tack < n; ++tack) {
+    for (int i = 0; i < leg_s / kDt; ++i)
+      Step(alpha_true, 5, *phi_z, 1.5, e);
+    last_alpha[tack % 2] = e->alpha_true_rad();
+    double from = *phi_z;
+    double to = SymmetricRad(2 * shift_rad - from);
+    for (int i = 0; i < 100; ++i)
+      Step(alpha_true, 5, from + (to - from) * i / 100.0, 0.8, e);
+    *phi_z = to;
+  }
+  return fabs(SymmetricRad(last_alpha[0] - last_alpha[1]));
+}
+
+}  // namespace
+
+TEST(TrueWindEstimator, Valid) {
+  TrueWindEstimator e;
+  EXPECT_FALSE(e.Valid());
+  EXPECT_FLOAT_EQ(0, e.mag_true_m_s());
+  // Without boat speed the apparent wind is the true wind.
+  for (int i = 0; i < 299; ++i)
+    e.Update(M_PI / 2, 3, M_PI / 2, 0, kDt);
+  EXPECT_FALSE(e.Valid());
+  e.Update(M_PI / 2, 3, M_PI / 2, 0, kDt);
+  EXPECT_TRUE(e.Valid());
+  EXPECT_FLOAT_EQ(M_PI, e.alpha_true_rad());
+  EXPECT_FLOAT_EQ(3, e.mag_true_m_s());
+  EXPECT_EQ(0, e.calibrations());
+}
+
+TEST(TrueWindEstimator, TimeConstant) {
+  // A sudden wind shift is followed within some 10s.
+  TrueWindEstimator e;
+  for (int i = 0; i < 300; ++i)
+    e.Update(0, 3, 0, 0, kDt);
+  EXPECT_FLOAT_EQ(0, e.alpha_true_rad());
+  for (int i = 0; i < 100; ++i)
+    e.Update(0, 3, M_PI / 2, 0, kDt);
+  EXPECT_GT(e.alpha_true_rad(), Deg2Rad(45));
+  for (int i = 0; i < 300; ++i)
+    e.Update(0, 3, M_PI / 2, 0, kDt);
+  EXPECT_LT(fabs(e.alpha_true_rad() - M_PI / 2), Deg2Rad(5));
+}
+
+TEST(TrueWindEstimator, Tacks) {
+  srand(2);
+  TrueWindEstimator e;
+  double phi_z = Deg2Rad(45);
+  // Uncalibrated the true wind jumps at each tack. The legs are too
+  // short to calibrate anything.
+  double jump = Beat(2, 25, 0, &phi_z, &e);
+  EXPECT_GT(jump, Deg2Rad(4));
+  EXPECT_EQ(0, e.calibrations());
+
+  jump = Beat(24, 60, 0, &phi_z, &e);
+  EXPECT_GT(e.calibrations(), 20);
+  EXPECT_LT(fabs(e.bias_rad() - kBias), Deg2Rad(1.5));
+  // The apparent wind is some 6m/s close hauled.
+  EXPECT_LT(fabs(e.upwash_rad(6) - kUpwash), Deg2Rad(1));
+  EXPECT_LT(jump, Deg2Rad(1));
+  EXPECT_LT(fabs(SymmetricRad(e.alpha_true_rad() - M_PI)), Deg2Rad(2));
+  EXPECT_LT(fabs(e.mag_true_m_s() - 5), 0.2);
+}
+
+TEST(TrueWindEstimator, WindShift) {
+  srand(3);
+  TrueWindEstimator e;
+  double phi_z = Deg2Rad(45);
+  Beat(24, 60, 0, &phi_z, &e);
+  double bias = e.bias_rad();
+  // A 20 degree shift during the tack is no sensor error. The calibration
+  // is certain enough by now to hardly move.
+  Beat(2, 60, Deg2Rad(20), &phi_z, &e);
+  EXPECT_LT(fabs(e.bias_rad() - bias), Deg2Rad(1));
+  EXPECT_LT(fabs(SymmetricRad(e.alpha_true_rad() - M_PI - Deg2Rad(20))), Deg2Rad(2));
+}
+
+int main(int argc, char* argv[]) {
+  TrueWindEstimator_Valid();
+  TrueWindEstimator_TimeConstant();
+  TrueWindEstimator_Tacks();
+  TrueWindEstimator_WindShift();
+  return 0;
+}
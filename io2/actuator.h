@@ -51,6 +51,8 @@ enum {
 
         REG_TARGPOS = REGISTER(0x607A, 0),
         REG_CURRPOS = REGISTER(0x6064, 0),
+        REG_PROFVEL = REGISTER(0x6081, 0),      // rpm
+        REG_ENCPULSES = REGISTER(0x2210, 1),    // encoder lines per revolution
 
         REG_BMMHPOS = REGISTER(0x6004, 0),
 };
@@ -57,6 +57,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _IO_AIS_H_
 #define _IO_AIS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define NMEA_MAX	91		/* max length of NMEA sentence */
@@ -766,6 +767,53 @@ aivdm_decode(const char *buf, size_t buflen,
 	     struct aivdm_context_t ais_contexts[AIVDM_CHANNELS],
 	     struct ais_t *ais);
 
+/*
+ * Fast path for the single sentence position reports of types 1, 2, 3,
+ * 18 and 19, which are nearly all of the traffic.  The sentence is not
+ * copied, the payload is checked and de-armoured in one pass and only the
+ * fields asked for are extracted, the others are left 'not available'.
+ * Lat/lon use the type 1 scale and N/A values for all types.
+ * The checksum is not checked, that is up to the caller.
+ *
+ * Returns AIVDM_POSITION if pos was filled, AIVDM_OTHER for all other
+ * sentences (to be handed to aivdm_decode) and AIVDM_INVALID for
+ * malformed position reports.
+ */
+enum { AIVDM_INVALID = -1, AIVDM_OTHER = 0, AIVDM_POSITION = 1 };
+
+#define AIS_POS_STATUS		0x01	/* status and turn, types 1-3 */
+#define AIS_POS_SPEED		0x02
+#define AIS_POS_ACCURACY	0x04
+#define AIS_POS_LATLON		0x08
+#define AIS_POS_COURSE		0x10
+#define AIS_POS_HEADING		0x20
+#define AIS_POS_STATIC		0x40	/* size and shipname, type 19 */
+#define AIS_POS_ALL		0x7f
+
+struct ais_position_t {
+	uint8_t type;
+	uint8_t status;			/* navigation status, 0 if N/A */
+	int8_t turn;			/* rate of turn */
+	bool accuracy;
+	unsigned int mmsi;
+	int32_t lon;			/* longitude, 1/10000 minute */
+	int32_t lat;			/* latitude, 1/10000 minute */
+	uint16_t speed;			/* speed over ground in deciknots */
+	uint16_t course;		/* course over ground, 0.1 degree */
+	uint16_t heading;		/* true heading */
+	uint16_t size_m;		/* bow to stern, 0 if N/A */
+	char shipname[AIS_SHIPNAME_MAXLEN+1];
+};
+
+int
+aivdm_decode_position(const char *buf, size_t buflen, unsigned int fields,
+		      struct ais_position_t *pos);
+
+/* The same for a position report assembled by aivdm_decode. Returns 0
+ * if ais is of another type. */
+int
+aivdm_position(const struct ais_t *ais, struct ais_position_t *pos);
+
 
 
 #endif /* _GPSD_GPS_H_ */
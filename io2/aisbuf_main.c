@@ -3,8 +3,9 @@
 // that can be found in the LICENSE file.
 //
 // Read aiscat output on stdin and keep the last line per mssid/message type, 
-// discard anything older than an hour, and update /var/run/ais.txt
-// at most once per 10 seconds.
+// discard anything older than an hour, and keep the snapshot file
+// (see lib/aissnap.h) up to date with every message.
+// Use aisdump to see its contents.
 // 
 
 #include <errno.h>
@@ -22,6 +23,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include "lib/aissnap.h"
 #include "lib/linebuffer.h"
 #include "lib/log.h"
 
@@ -32,51 +34,148 @@ static void
 usage(void)
 {
 	fprintf(stderr,
-		"usage: [aiscat /dev/ttyXXX |] %s [options] outfile\n"
+		"usage: [aiscat /dev/ttyXXX |] %s [options] snapshotfile\n"
 		"options:\n"
 		"\t-d debug            (don't syslog, -dd opens port as plain file)\n"
-		"\t-u update_s        write at most every this seconds\n"
        		"\t-g garbage_s       garbage collect messages older than this many seconds\n"
 		, argv0);
 	exit(2);
 }
 
-static struct AISMsg {
-	struct AISMsg* link;
+// One entry per record of the snapshot, at the same index.  A message is
+// identified by its mmsi and class, where types 1, 2 and 3 (class A
+// position reports) are the same class.  All messages are on a doubly
+// linked list from newest to oldest, free entries on a stack.
+struct AISMsg {
+	struct AISMsg* newer;
+	struct AISMsg* older;
 	int64_t timestamp_ms;
 	int mmsi;
-	int msgtype;
-  	char line[1024];
-} *msgs = NULL;
+	int msgclass;
+};
 
+enum { HIGHWATERMARK = 3000, LOWWATERMARK = 2000 };
 
+static struct AISSnap* snap;
+static struct AISMsg msgs[AISSNAP_RECORDS];
+static struct AISMsg* freemsgs[AISSNAP_RECORDS];
+static int nfree = 0;
+static struct AISMsg* newest = NULL;
+static struct AISMsg* oldest = NULL;
+static int msgcnt = 0;
+
+// Open addressing with linear probing over a power of 2 table, kept
+// below half full so probe chains stay short.
+enum { TABLESIZE = 2 * AISSNAP_RECORDS };
+
+static struct AISMsg* table[TABLESIZE];
+
+static uint32_t
+hashslot(int mmsi, int msgclass)
+{
+	uint32_t h = (uint32_t)mmsi * 2654435761u ^ (uint32_t)msgclass * 40503u;
+	return (h ^ (h >> 15)) & (TABLESIZE - 1);
+}
+
+// Returns the slot holding the key, or the empty slot where it belongs.
+static uint32_t
+lookup(int mmsi, int msgclass)
+{
+	uint32_t i = hashslot(mmsi, msgclass);
+	while (table[i] && (table[i]->mmsi != mmsi || table[i]->msgclass != msgclass))
+		i = (i + 1) & (TABLESIZE - 1);
+	return i;
+}
+
+// Empty slot i and move later entries of the probe chain back into the
+// hole, so lookups never need tombstones.
+static void
+clearslot(uint32_t i)
+{
+	uint32_t j = i;
+	for (;;) {
+		j = (j + 1) & (TABLESIZE - 1);
+		if (!table[j]) break;
+		uint32_t k = hashslot(table[j]->mmsi, table[j]->msgclass);
+		// Move j to i unless its home slot k lies cyclically in (i, j].
+		if ((i < j) ? (k <= i || k > j) : (k <= i && k > j)) {
+			table[i] = table[j];
+			i = j;
+		}
+	}
+	table[i] = NULL;
+}
+
+static void
+unlink_msg(struct AISMsg* m)
+{
+	if (m->newer) m->newer->older = m->older; else newest = m->older;
+	if (m->older) m->older->newer = m->newer; else oldest = m->newer;
+}
+
+static void
+push_newest(struct AISMsg* m)
+{
+	m->newer = NULL;
+	m->older = newest;
+	if (newest) newest->newer = m; else oldest = m;
+	newest = m;
+}
+
+static void
+evict(struct AISMsg* m)
+{
+	clearslot(lookup(m->mmsi, m->msgclass));
+	unlink_msg(m);
+	aissnap_clear(snap, m - msgs);
+	freemsgs[nfree++] = m;
+	msgcnt--;
+}
+
+// Store line as the newest message, in place of an older version of the
+// same mmsi and class.
 static int
-samemsg(struct AISMsg *a, struct AISMsg *b)
+insert(const char* line)
 {
-	if (a->mmsi != b->mmsi) return 0;
-	if (a->msgtype == b->msgtype) return 1;
-	switch(a->msgtype) {
-	case 1: case 2: case 3:
-		switch(b->msgtype) {
-		case 1: case 2: case 3:
-			return 1;
+	struct AISSnapRecord r;
+	if (!aissnap_parse(line, &r)) return 0;
+
+	if (newest && r.timestamp_ms < newest->timestamp_ms) { // clock jumped back
+		if (debug) fprintf(stderr, "Clock jumped back, dropping %d messages\n", msgcnt);
+		while (oldest) evict(oldest);
+	}
+
+	uint32_t i = lookup(r.mmsi, r.msgclass);
+	struct AISMsg* m = table[i];
+	if (m) {
+		unlink_msg(m);
+	} else {
+		if (!nfree) {
+			evict(oldest);
+			i = lookup(r.mmsi, r.msgclass);
 		}
+		m = freemsgs[--nfree];
+		m->mmsi = r.mmsi;
+		m->msgclass = r.msgclass;
+		table[i] = m;
+		msgcnt++;
 	}
-	return 0;
+	m->timestamp_ms = r.timestamp_ms;
+	push_newest(m);
+	aissnap_put(snap, m - msgs, &r);
+	return 1;
 }
 
 int main(int argc, char* argv[]) {
 
 	int ch;
-	int update_s = 5;
 	int garbage_s = 3600;
 
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "u:g:dh")) != -1){
+	while ((ch = getopt(argc, argv, "g:dh")) != -1){
 		switch (ch) {
-		case 'u': update_s = atoi(optarg); break;
 		case 'g': garbage_s = atoi(optarg); break;
 		case 'd': ++debug; break;
 		case 'h': 
@@ -94,20 +193,21 @@ int main(int argc, char* argv[]) {
         signal(SIGSEGV, fault);
 
 	if (!debug) openlog(argv0, LOG_PERROR, LOG_DAEMON);
-	char tmppath[1024];
-	snprintf(tmppath, sizeof tmppath, "%s.tmp", argv[0]);
 
-	int64_t lastwritten_ms = 0;
+	snap = aissnap_create(argv[0]);
+	if (!snap) crash("creating %s", argv[0]);
+	while (nfree < AISSNAP_RECORDS) {
+		freemsgs[nfree] = &msgs[AISSNAP_RECORDS - 1 - nfree];
+		nfree++;
+	}
 
 	int badcnt = 0;
-	int msgcnt = 0;
 	struct LineBuffer line;
 	memset(&line, 0, sizeof line);
-	struct AISMsg* msg = malloc(sizeof *msg);
-	memset(msg, 0, sizeof *msg);
+	char buf[AISSNAP_LINE];
 	for(;;) {
 
-		struct timespec timeout = { update_s, 0 };
+		struct timespec timeout = { 10, 0 };
 		fd_set rfds;
 		FD_ZERO(&rfds);
 		FD_SET(fileno(stdin), &rfds);
@@ -123,85 +223,28 @@ int main(int argc, char* argv[]) {
 			if (r != 0) crash("reading stdin");
 		}
 
-		while(lb_getline(msg->line, sizeof msg->line, &line) > 0) {
-
-			int n = sscanf(msg->line, "ais: timestamp_ms:%lld mmsi:%d msgtype:%d ",
-				       &msg->timestamp_ms, &msg->mmsi, &msg->msgtype);
-		  if (n < 3) {
-			  if (badcnt++ > 100) crash("Nothing but garbage on stdin: %s", msg->line);
-			  if (debug) fprintf(stderr, "Could not parse stdin:%s", msg->line);
+		while(lb_getline(buf, sizeof buf, &line) > 0) {
+		  if (!insert(buf)) {
+			  if (badcnt++ > 100) crash("Nothing but garbage on stdin: %s", buf);
+			  if (debug) fprintf(stderr, "Could not parse stdin:%s", buf);
 			  continue;
 		  }
 
 		  badcnt = 0;
-		  msgcnt++;
-		  msg->link = msgs;
-		  msgs = msg;
-
-		  msg = malloc(sizeof *msg);
-		  memset(msg, 0, sizeof *msg);
-
-		  // delete older versions
-		  struct AISMsg** pp = &msgs->link;
-		  while (*pp) {
-			  struct AISMsg* curr = *pp;
-			  if (samemsg(curr, msgs)) {
-				  *pp = curr->link;
-				  free(curr);
-				  msgcnt--;
-			  } else {
-				  pp = &(*pp)->link;
-			  }
-		  }
 		}
 
-		if(!msgs) continue;
+		if(!newest) continue;
 
-		// clean to lowwatermark when above highwatermarkxs
-		if (msgcnt > 3000) {  // highwatermark
+		// clean to lowwatermark when above highwatermark
+		if (msgcnt > HIGHWATERMARK) {
 			if (debug) fprintf(stderr, "Cleaning %d to low watermark\n", msgcnt);
-			int lowwatermark = 2000; // lowwatermark
-			struct AISMsg** pp;
-			for (pp = &msgs; *pp && lowwatermark; pp=&(*pp)->link)
-				lowwatermark--;
-			while (*pp) {
-				struct AISMsg* curr = *pp;
-				*pp = curr->link;
-				free(curr);
-				msgcnt--;
-			}
+			while (msgcnt > LOWWATERMARK)
+				evict(oldest);
 		}
 
-		if (msgs->timestamp_ms < lastwritten_ms) // clock jumped back
-			lastwritten_ms = 0;
-	  
-		if (lastwritten_ms + update_s*1000 < msgs->timestamp_ms) {
-			if (debug) fprintf(stderr, "Flushing %d messages\n", msgcnt);
-
-			FILE* tmp = fopen(tmppath, "w");
-			if (!tmp) crash("opening %s", tmppath);
-
-			struct AISMsg** pp;
-			for (pp = &msgs; *pp; pp=&(*pp)->link) {
-				if ((*pp)->timestamp_ms > msgs->timestamp_ms) // clock jumped back
-					break;
-				if ((*pp)->timestamp_ms + 1000*garbage_s < msgs->timestamp_ms)
-					break;
-				// cheat: read linebuf without clearing
-				fputs((*pp)->line, tmp);
-			}
-			
-			if (fclose(tmp)) crash("closing %s", tmppath);
-			if (rename(tmppath, argv[0])) crash("renaming to %s", argv[0]);
-
-			// garbage collect the rest
-			while (*pp) {
-				struct AISMsg* curr = *pp;
-				*pp = curr->link;
-				free(curr);
-				msgcnt--;
-			}
-		}
+		// garbage collect old messages
+		while (oldest->timestamp_ms + 1000*garbage_s < newest->timestamp_ms)
+			evict(oldest);
 
 		if (debug) fprintf(stderr, "Loop  %d messages\n", msgcnt);
 	}
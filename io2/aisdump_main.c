@@ -0,0 +1,82 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Print the ais: lines in an aisbuf snapshot, newest first.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lib/aissnap.h"
+
+static const char* argv0;
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: %s [options] snapshotfile\n"
+		"options:\n"
+		"\t-g age_s           only messages at most this many seconds older than the newest\n"
+		, argv0);
+	exit(2);
+}
+
+static struct AISSnapRecord recs[AISSNAP_RECORDS];
+
+static int
+newer_first(const void* a, const void* b)
+{
+	const struct AISSnapRecord* ra = a;
+	const struct AISSnapRecord* rb = b;
+	if (ra->timestamp_ms > rb->timestamp_ms) return -1;
+	if (ra->timestamp_ms < rb->timestamp_ms) return 1;
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+	int age_s = -1;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	while ((ch = getopt(argc, argv, "g:h")) != -1){
+		switch (ch) {
+		case 'g': age_s = atoi(optarg); break;
+		case 'h': 
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc != 1) usage();
+
+	const struct AISSnap* snap = aissnap_open(argv[0]);
+	if (!snap) {
+		fprintf(stderr, "%s: %s is not an AIS snapshot\n", argv0, argv[0]);
+		exit(1);
+	}
+
+	int i, n = 0;
+	for (i = 0; i < AISSNAP_RECORDS; ++i)
+		if (aissnap_get(snap, i, &recs[n]))
+			++n;
+	qsort(recs, n, sizeof recs[0], newer_first);
+
+	for (i = 0; i < n; ++i) {
+		if (age_s >= 0 && recs[i].timestamp_ms + 1000LL*age_s < recs[0].timestamp_ms)
+			break;
+		fputs(recs[i].line, stdout);
+	}
+	aissnap_close(snap);
+	return 0;
+}
@@ -167,6 +167,196 @@ from_sixbit(char *bitvec, int start, int count, char *to)
 			break;
 }
 
+/*
+ * Check the armoured payload [data, end) and append its 6 bit characters
+ * to the big-endian bit buffer bits, which holds bitlen bits so far.
+ * Returns the new bit length, or -1 on an invalid character or if the
+ * buffer of maxbytes is full.
+ */
+static int
+dearmour(const char *data, const char *end, uint8_t *bits, size_t maxbytes, size_t bitlen)
+{
+	size_t byte = bitlen / 8;
+	unsigned int nacc = bitlen % 8;
+	uint32_t acc = nacc ? bits[byte] >> (8 - nacc) : 0;
+
+	for (; data < end; data++) {
+		unsigned int ch = (unsigned char)*data - 48;
+		if (ch > 39) {
+			/* '0'..'W' are 0..39, '`'..'w' are 40..63 */
+			if (ch < 48 || ch > 71)
+				return -1;
+			ch -= 8;
+		}
+		acc = (acc << 6) | ch;
+		nacc += 6;
+		bitlen += 6;
+		if (nacc >= 8) {
+			nacc -= 8;
+			if (byte >= maxbytes)
+				return -1;
+			bits[byte++] = acc >> nacc;
+			acc &= (1u << nacc) - 1;
+		}
+	}
+	if (nacc) {
+		if (byte >= maxbytes)
+			return -1;
+		bits[byte] = acc << (8 - nacc);
+	}
+	return bitlen;
+}
+
+/* ubits() for the fast path, bits needs 8 bytes of room after the field */
+static inline uint32_t
+getbits(const uint8_t *bits, unsigned int start, unsigned int width)
+{
+	const uint8_t *b = bits + start / 8;
+	uint64_t w = ((uint64_t)b[0] << 56) | ((uint64_t)b[1] << 48) | ((uint64_t)b[2] << 40) |
+		((uint64_t)b[3] << 32) | ((uint64_t)b[4] << 24) | ((uint64_t)b[5] << 16) |
+		((uint64_t)b[6] << 8) | (uint64_t)b[7];
+	return (w << (start % 8)) >> (64 - width);
+}
+
+static inline int32_t
+getsbits(const uint8_t *bits, unsigned int start, unsigned int width)
+{
+	uint32_t u = getbits(bits, start, width);
+	return (int32_t)(u << (32 - width)) >> (32 - width);
+}
+
+int
+aivdm_decode_position(const char *buf, size_t buflen, unsigned int fields,
+		      struct ais_position_t *pos)
+{
+	const char *end = buf + buflen;
+	const char *field[7];
+	const char *p;
+	int nfields = 0;
+	uint8_t bits[48] = { 0 };	/* 312 bits for type 19, and room for getbits */
+	int bitlen, expected;
+
+	field[nfields++] = buf;
+	for (p = buf; p < end && nfields < 7; p++)
+		if (*p == ',')
+			field[nfields++] = p + 1;
+	if (nfields < 7 || field[6] >= end)
+		return AIVDM_OTHER;
+
+	/* single sentence messages only, fragments go the long way */
+	if (field[1][0] != '1' || field[1][1] != ',')
+		return AIVDM_OTHER;
+
+	/* the type is in the first character, don't bother with the rest if we don't want it */
+	if (dearmour(field[5], field[5] + 1, bits, sizeof bits, 0) != 6)
+		return field[5] == field[6] - 1 ? AIVDM_OTHER : AIVDM_INVALID;
+	switch (bits[0] >> 2) {
+	case 1: case 2: case 3: case 18:
+		expected = 168;
+		break;
+	case 19:
+		expected = 312;
+		break;
+	default:
+		return AIVDM_OTHER;
+	}
+
+	bitlen = dearmour(field[5] + 1, field[6] - 1, bits, sizeof bits, 6);
+	if (bitlen < 0)
+		return AIVDM_INVALID;
+	if (isdigit((unsigned char)field[6][0]))
+		bitlen -= field[6][0] - '0';
+	if (bitlen != expected) {
+		VLOGF("AIVDM message type %d size not %d bits (%d).\n", bits[0] >> 2, expected, bitlen);
+		return AIVDM_INVALID;
+	}
+
+	pos->type	= bits[0] >> 2;
+	pos->mmsi	= getbits(bits, 8, 30);
+	pos->status	= 0;
+	pos->turn	= AIS_TURN_NOT_AVAILABLE;
+	pos->accuracy	= 0;
+	pos->lon	= AIS_LON_NOT_AVAILABLE;
+	pos->lat	= AIS_LAT_NOT_AVAILABLE;
+	pos->speed	= AIS_SPEED_NOT_AVAILABLE;
+	pos->course	= AIS_COURSE_NOT_AVAILABLE;
+	pos->heading	= AIS_HEADING_NOT_AVAILABLE;
+	pos->size_m	= 0;
+	pos->shipname[0] = '\0';
+
+	if (pos->type <= 3) {
+		if (fields & AIS_POS_STATUS) {
+			pos->status	= getbits(bits, 38, 4);
+			pos->turn	= getsbits(bits, 42, 8);
+		}
+		if (fields & AIS_POS_SPEED)	pos->speed	= getbits(bits, 50, 10);
+		if (fields & AIS_POS_ACCURACY)	pos->accuracy	= getbits(bits, 60, 1);
+		if (fields & AIS_POS_LATLON) {
+			pos->lon	= getsbits(bits, 61, 28);
+			pos->lat	= getsbits(bits, 89, 27);
+		}
+		if (fields & AIS_POS_COURSE)	pos->course	= getbits(bits, 116, 12);
+		if (fields & AIS_POS_HEADING)	pos->heading	= getbits(bits, 128, 9);
+		return AIVDM_POSITION;
+	}
+
+	/* types 18 and 19 share the layout up to the heading */
+	if (fields & AIS_POS_SPEED)	pos->speed	= getbits(bits, 46, 10);
+	if (fields & AIS_POS_ACCURACY)	pos->accuracy	= getbits(bits, 56, 1);
+	if (fields & AIS_POS_LATLON) {
+		pos->lon	= getsbits(bits, 57, 28);
+		pos->lat	= getsbits(bits, 85, 27);
+	}
+	if (fields & AIS_POS_COURSE)	pos->course	= getbits(bits, 112, 12);
+	if (fields & AIS_POS_HEADING)	pos->heading	= getbits(bits, 124, 9);
+	if (pos->type == 19 && (fields & AIS_POS_STATIC)) {
+		from_sixbit((char *)bits, 143, sizeof pos->shipname, pos->shipname);
+		pos->size_m = getbits(bits, 271, 9) + getbits(bits, 280, 9);
+	}
+	return AIVDM_POSITION;
+}
+
+int
+aivdm_position(const struct ais_t *ais, struct ais_position_t *pos)
+{
+	memset(pos, 0, sizeof *pos);
+	pos->type = ais->type;
+	pos->mmsi = ais->mmsi;
+	switch (ais->type) {
+	case 1: case 2: case 3:
+		pos->status	= ais->type1.status;
+		pos->turn	= ais->type1.turn;
+		pos->accuracy	= ais->type1.accuracy;
+		pos->lon	= ais->type1.lon;
+		pos->lat	= ais->type1.lat;
+		pos->speed	= ais->type1.speed;
+		pos->course	= ais->type1.course;
+		pos->heading	= ais->type1.heading;
+		return 1;
+	case 18:
+		pos->turn	= AIS_TURN_NOT_AVAILABLE;
+		pos->accuracy	= ais->type18.accuracy;
+		pos->lon	= ais->type18.lon;
+		pos->lat	= ais->type18.lat;
+		pos->speed	= ais->type18.speed;
+		pos->course	= ais->type18.course;
+		pos->heading	= ais->type18.heading;
+		return 1;
+	case 19:
+		pos->turn	= AIS_TURN_NOT_AVAILABLE;
+		pos->accuracy	= ais->type19.accuracy;
+		pos->lon	= ais->type19.lon;
+		pos->lat	= ais->type19.lat;
+		pos->speed	= ais->type19.speed;
+		pos->course	= ais->type19.course;
+		pos->heading	= ais->type19.heading;
+		pos->size_m	= ais->type19.to_bow + ais->type19.to_stern;
+		snprintf(pos->shipname, sizeof pos->shipname, "%s", ais->type19.shipname);
+		return 1;
+	}
+	return 0;
+}
+
 #define UBITS(s, l)	ubits((char *)ais_context->bits, s, l)
 #define SBITS(s, l)	sbits((char *)ais_context->bits, s, l)
 #define UCHARS(s, to)	from_sixbit((char *)ais_context->bits, s, sizeof(to), to)
@@ -189,7 +379,7 @@ aivdm_decode(const char *buf, size_t buflen,
 	uint8_t *field[NMEA_MAX*2];
 	uint8_t fieldcopy[NMEA_MAX*2+1];
 	uint8_t *data, *cp;
-	uint8_t ch, pad;
+	uint8_t pad;
 	struct aivdm_context_t *ais_context;
 	int imo;
 	int i;
@@ -277,20 +467,14 @@ aivdm_decode(const char *buf, size_t buflen,
 	}
 
 	/* wacky 6-bit encoding, shades of FIELDATA */
-	for (cp = data; cp < data + strlen((char *)data); cp++) {
-		ch = *cp;
-		ch -= 48;
-		if (ch >= 40)
-			ch -= 8;
-
-		for (i = 5; i >= 0; i--) {
-			if ((ch >> i) & 0x01) {
-				ais_context->bits[ais_context->bitlen / 8] |=
-					(1 << (7 - ais_context->bitlen % 8));
-			}
-			ais_context->bitlen++;
-		}
+	i = dearmour((char *)data, (char *)data + strlen((char *)data),
+		     ais_context->bits, sizeof ais_context->bits, ais_context->bitlen);
+	if (i < 0) {
+		VLOGF("invalid AIVDM payload %s\n", data);
+		ais_context->decoded_frags = 0;
+		return 0;
 	}
+	ais_context->bitlen = i;
 	if (isdigit(pad))
 		ais_context->bitlen -= (pad - '0');	/* ASCII assumption */
 
@@ -1064,8 +1248,7 @@ aivdm_decode(const char *buf, size_t buflen,
 						VLOGF("AIVDM message type 24 collision on channel %c: 24B sentence from %09u without 24A.\n", field[4][0], ais->mmsi);
 					return 0;
 				}
-				memset(ais->type24.shipname, 0, sizeof ais->type24.shipname);
-				strncpy(ais->type24.shipname, ais_context->shipname24, sizeof(ais->type24.shipname)-1);
+				snprintf(ais->type24.shipname, sizeof ais->type24.shipname, "%s", ais_context->shipname24);
 				ais->type24.shiptype = UBITS(40, 8);
 				UCHARS(48, ais->type24.vendorid);
 				UCHARS(90, ais->type24.callsign);
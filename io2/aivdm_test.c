@@ -0,0 +1,162 @@
+#include "ais.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+// Checks the fast position decoder against aivdm_decode.
+
+static int
+same(const struct ais_position_t* a, const struct ais_position_t* b)
+{
+	return a->type == b->type && a->mmsi == b->mmsi &&
+		a->status == b->status && a->turn == b->turn &&
+		a->accuracy == b->accuracy &&
+		a->lon == b->lon && a->lat == b->lat &&
+		a->speed == b->speed && a->course == b->course &&
+		a->heading == b->heading && a->size_m == b->size_m &&
+		!strcmp(a->shipname, b->shipname);
+}
+
+// Armour nbits of bits into an !AIVDM sentence (without checksum).
+static void
+armour(const unsigned char* bits, int nbits, char* out)
+{
+	int pad = (6 - nbits % 6) % 6;
+	char* p = out + sprintf(out, "!AIVDM,1,1,,A,");
+	int i;
+	for (i = 0; i < nbits + pad; i += 6) {
+		int j, ch = 0;
+		for (j = i; j < i + 6; j++)
+			ch = (ch << 1) | (j < nbits ? (bits[j / 8] >> (7 - j % 8)) & 1 : 0);
+		*p++ = ch < 40 ? ch + 48 : ch + 56;
+	}
+	sprintf(p, ",%d*00\r\n", pad);
+}
+
+static void
+setbits(unsigned char* bits, int start, int width, unsigned long long value)
+{
+	int i;
+	for (i = 0; i < width; i++) {
+		int b = start + i;
+		if ((value >> (width - 1 - i)) & 1)
+			bits[b / 8] |= 1 << (7 - b % 8);
+		else
+			bits[b / 8] &= ~(1 << (7 - b % 8));
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	struct aivdm_context_t contexts[AIVDM_CHANNELS];
+	struct ais_t ais;
+	struct ais_position_t fast, slow;
+	memset(contexts, 0, sizeof contexts);
+
+	// Recorded traffic.
+	FILE* fp = fopen("ais_testdata.txt", "r");
+	assert(fp);
+	int positions = 0;
+	char line[200];
+	while (fgets(line, sizeof line, fp)) {
+		char* end = strchr(line, '*');
+		if (!end) continue;
+		int r = aivdm_decode_position(line, end - line, AIS_POS_ALL, &fast);
+		assert(r != AIVDM_INVALID);
+		int complete = aivdm_decode(line, end - line, contexts, &ais);
+		if (r == AIVDM_POSITION) {
+			assert(complete);
+			assert(aivdm_position(&ais, &slow));
+			assert(same(&fast, &slow));
+			positions++;
+		} else if (complete) {
+			assert(!aivdm_position(&ais, &slow));
+		}
+	}
+	fclose(fp);
+	assert(positions > 80);
+
+	// Synthetic type 19, with a name.
+	unsigned char bits[40];
+	char sentence[100];
+	memset(bits, 0, sizeof bits);
+	setbits(bits, 0, 6, 19);
+	setbits(bits, 8, 30, 244670000);
+	setbits(bits, 46, 10, 57);
+	setbits(bits, 57, 28, (unsigned)-5700000 & 0xfffffff);
+	setbits(bits, 85, 27, 26100000);
+	setbits(bits, 112, 12, 2713);
+	setbits(bits, 124, 9, 270);
+	const char* name = "AVALON";
+	int i;
+	for (i = 0; i < 20; i++)  // six bit letters are 'A' - '@', padded with spaces
+		setbits(bits, 143 + 6 * i, 6, i < strlen(name) ? name[i] - '@' : ' ');
+	setbits(bits, 271, 9, 3);
+	setbits(bits, 280, 9, 1);
+	armour(bits, 312, sentence);
+
+	assert(aivdm_decode_position(sentence, strchr(sentence, '*') - sentence, AIS_POS_ALL, &fast) == AIVDM_POSITION);
+	assert(fast.type == 19);
+	assert(fast.mmsi == 244670000);
+	assert(fast.speed == 57);
+	assert(fast.lon == -5700000);
+	assert(fast.lat == 26100000);
+	assert(fast.course == 2713);
+	assert(fast.heading == 270);
+	assert(fast.size_m == 4);
+	assert(!strcmp(fast.shipname, "AVALON"));
+	memset(contexts, 0, sizeof contexts);
+	assert(aivdm_decode(sentence, strchr(sentence, '*') - sentence, contexts, &ais));
+	assert(aivdm_position(&ais, &slow));
+	assert(same(&fast, &slow));
+
+	// Only what was asked for.
+	assert(aivdm_decode_position(sentence, strchr(sentence, '*') - sentence, AIS_POS_LATLON, &fast) == AIVDM_POSITION);
+	assert(fast.lat == 26100000);
+	assert(fast.speed == AIS_SPEED_NOT_AVAILABLE);
+	assert(fast.course == AIS_COURSE_NOT_AVAILABLE);
+	assert(fast.shipname[0] == 0);
+
+	// Class B without speed and position: the class A not available
+	// values, not the type 17 ones.
+	memset(bits, 0, sizeof bits);
+	setbits(bits, 0, 6, 18);
+	setbits(bits, 8, 30, 244670001);
+	setbits(bits, 46, 10, AIS_SPEED_NOT_AVAILABLE);
+	setbits(bits, 57, 28, AIS_LON_NOT_AVAILABLE);
+	setbits(bits, 85, 27, AIS_LAT_NOT_AVAILABLE);
+	setbits(bits, 112, 12, AIS_COURSE_NOT_AVAILABLE);
+	setbits(bits, 124, 9, AIS_HEADING_NOT_AVAILABLE);
+	armour(bits, 168, sentence);
+	assert(aivdm_decode_position(sentence, strchr(sentence, '*') - sentence, AIS_POS_ALL, &fast) == AIVDM_POSITION);
+	assert(fast.type == 18);
+	assert(fast.speed == AIS_SPEED_NOT_AVAILABLE);
+	assert(fast.lon == AIS_LON_NOT_AVAILABLE && fast.lon != AIS_GNS_LON_NOT_AVAILABLE);
+	assert(fast.lat == AIS_LAT_NOT_AVAILABLE && fast.lat != AIS_GNS_LAT_NOT_AVAILABLE);
+	assert(fast.course == AIS_COURSE_NOT_AVAILABLE);
+	assert(fast.heading == AIS_HEADING_NOT_AVAILABLE);
+	memset(contexts, 0, sizeof contexts);
+	assert(aivdm_decode(sentence, strchr(sentence, '*') - sentence, contexts, &ais));
+	assert(ais.type18.speed == AIS_SPEED_NOT_AVAILABLE);
+	assert(ais.type18.lon == AIS_LON_NOT_AVAILABLE);
+	assert(aivdm_position(&ais, &slow));
+	assert(same(&fast, &slow));
+
+	// Broken armour and wrong length.
+	char broken[100];
+	strcpy(broken, sentence);
+	broken[20] = 'Z';
+	assert(aivdm_decode_position(broken, strchr(broken, '*') - broken, AIS_POS_ALL, &fast) == AIVDM_INVALID);
+	armour(bits, 300, broken);
+	assert(aivdm_decode_position(broken, strchr(broken, '*') - broken, AIS_POS_ALL, &fast) == AIVDM_INVALID);
+
+	// Other types and fragments are left to aivdm_decode.
+	const char* type5 = "!AIVDM,2,1,1,B,53niU401smF0h4aWH004pT<T4000000000000016;@@<65l60=ClTTjhADP0,0*5C";
+	assert(aivdm_decode_position(type5, strlen(type5), AIS_POS_ALL, &fast) == AIVDM_OTHER);
+	const char* type24 = "!AIVDM,1,1,,A,H3ukeb1HN377N0eDpM=HTd00000,2*55";
+	assert(aivdm_decode_position(type24, strlen(type24), AIS_POS_ALL, &fast) == AIVDM_OTHER);
+
+	puts("OK");
+	return 0;
+}
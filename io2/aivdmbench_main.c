@@ -0,0 +1,154 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Throughput of the AIVDM decoders on recorded traffic, compared to the
+// sentence rate of the AIS receiver at 38400 baud sped up 100 times, as in
+// a burst on a busy channel.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lib/timer.h"
+
+#include "ais.h"
+
+static const char* argv0;
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: %s [options] [ais_testdata.txt]\n"
+		"options:\n"
+		"\t-b baudrate        of the receiver (default 38400)\n"
+		"\t-x speedup         replay this much faster than the receiver (default 100)\n"
+		, argv0);
+	exit(2);
+}
+
+enum { MAXSENTENCES = 1000 };
+
+static char sentences[MAXSENTENCES][100];
+static int lengths[MAXSENTENCES];
+static int nsentences = 0;
+
+static struct aivdm_context_t contexts[AIVDM_CHANNELS];
+
+// Decode all sentences, the way nmeacat did before the fast path.
+static int
+run_full(void)
+{
+	int i, n = 0;
+	for (i = 0; i < nsentences; i++) {
+		struct ais_t ais;
+		struct ais_position_t pos;
+		if (aivdm_decode(sentences[i], lengths[i], contexts, &ais))
+			n += aivdm_position(&ais, &pos);
+	}
+	return n;
+}
+
+// Decode all sentences, the way nmeacat does now.
+static int
+run_fast(void)
+{
+	int i, n = 0;
+	for (i = 0; i < nsentences; i++) {
+		struct ais_t ais;
+		struct ais_position_t pos;
+		switch (aivdm_decode_position(sentences[i], lengths[i], AIS_POS_ALL, &pos)) {
+		case AIVDM_POSITION:
+			n++;
+			break;
+		case AIVDM_OTHER:
+			if (aivdm_decode(sentences[i], lengths[i], contexts, &ais))
+				n += aivdm_position(&ais, &pos);
+			break;
+		}
+	}
+	return n;
+}
+
+// Sentences per second, over at least a second of runtime.
+static double
+measure(const char* name, int (*run)(void), double required)
+{
+	int64_t start = now_us();
+	int64_t rounds = 0;
+	int positions = 0;
+	while (now_us() - start < 1000000) {
+		int i;
+		for (i = 0; i < 100; i++)
+			positions = run();
+		rounds += 100;
+	}
+	double s = (now_us() - start) / 1E6;
+	double rate = rounds * nsentences / s;
+	printf("%-5s %9.0f sentences/s %7.3f us/sentence, %d positions, load %5.1f%%\n",
+	       name, rate, 1E6 / rate, positions, 100 * required / rate);
+	return rate;
+}
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+	int baudrate = 38400;
+	double speedup = 100;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	while ((ch = getopt(argc, argv, "b:x:h")) != -1){
+		switch (ch) {
+		case 'b': baudrate = atoi(optarg); break;
+		case 'x': speedup = atof(optarg); break;
+		case 'h': 
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc > 1) usage();
+
+	const char* path = argc ? argv[0] : "ais_testdata.txt";
+	FILE* fp = fopen(path, "r");
+	if (!fp) {
+		perror(path);
+		exit(1);
+	}
+	int chars = 0;
+	char line[200];
+	while (nsentences < MAXSENTENCES && fgets(line, sizeof line, fp)) {
+		char* end = strchr(line, '*');
+		if (strncmp(line, "!AIVDM", 6) || !end || end - line + 1 > sizeof sentences[0])
+			continue;
+		lengths[nsentences] = end - line;
+		memcpy(sentences[nsentences], line, end - line);
+		sentences[nsentences][end - line] = 0;
+		chars += end - line + 5;  // *hh\r\n
+		nsentences++;
+	}
+	fclose(fp);
+	if (!nsentences) {
+		fprintf(stderr, "%s: no AIVDM sentences in %s\n", argv0, path);
+		exit(1);
+	}
+
+	// 10 bits per character on the serial line
+	double required = speedup * baudrate / 10.0 / ((double)chars / nsentences);
+	printf("%d sentences, %.1f characters average, %.0fx receiver rate is %.0f sentences/s\n",
+	       nsentences, (double)chars / nsentences, speedup, required);
+
+	double full = measure("full", run_full, required);
+	double fast = measure("fast", run_fast, required);
+	printf("speedup %.1fx\n", fast / full);
+	return fast >= required ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Record all linebus input, compressed, into a directory of chunk files
+// (see busrec.h), and keep the directory under a size budget by removing
+// the oldest chunks.  Read them back with busplay.
+//
+//   plug -bon lbuslogs /var/run/lbus -- buslog -b 500 /var/log/lbus
+//
+// A block is written when it is full or after -f seconds, so on a crash
+// at most that much is lost.  A chunk is closed, indexed and the budget
+// enforced when it has grown to -c MB, on EOF and on SIGTERM.
+//
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "busrec.h"
+#include "lib/linebuffer.h"
+#include "lib/log.h"
+#include "lib/timer.h"
+
+static const char* argv0;
+static int debug = 0;
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: plug -o /var/run/lbus | %s [options] directory\n"
+		"options:\n"
+		"\t-d           debug (don't syslog)\n"
+		"\t-b 500       keep the directory under this many MB\n"
+		"\t-c 4         start a new chunk after this many MB\n"
+		"\t-f 10        write a block at least every this many seconds\n"
+		, argv0);
+	exit(2);
+}
+
+static int sigflg = 0;
+static void setflg(int sig) { sigflg = sig; }
+
+enum { MAXBLOCKS = 4096 };	// per chunk
+
+static const char* dir;
+static int64_t budget;
+static int64_t chunksize;
+
+static struct BusrecCodec enc;
+static int of = -1;
+static char chunkname[1024];
+static struct BusrecIndex index_[MAXBLOCKS];
+static int nblocks;
+static int64_t offset;
+
+static struct {
+	int64_t lines, rawbytes, bytes, chunks, removed;
+} stats;
+
+static void
+write_all(const void* buf, int n)
+{
+	const char* p = buf;
+	while (n) {
+		int r = write(of, p, n);
+		if (r == -1 && (errno == EAGAIN || errno == EINTR)) continue;
+		if (r == -1) crash("write(%s)", chunkname);
+		n -= r;
+		p += r;
+	}
+}
+
+// Remove the oldest chunks while the directory is over budget.  Chunk
+// names sort by time.
+static int
+cmpname(const void* a, const void* b)
+{
+	return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static void
+enforce_budget(void)
+{
+	DIR* d = opendir(dir);
+	if (!d) crash("opendir(%s)", dir);
+
+	char** names = NULL;
+	int n = 0, cap = 0;
+	int64_t total = 0;
+	struct dirent* e;
+	while ((e = readdir(d)) != NULL) {
+		int len = strlen(e->d_name);
+		if (len < 5 || strcmp(e->d_name + len - 4, ".brc")) continue;
+		char path[1024];
+		snprintf(path, sizeof path, "%s/%s", dir, e->d_name);
+		struct stat st;
+		if (stat(path, &st) == -1) continue;
+		if (n == cap) {
+			cap = cap ? 2 * cap : 256;
+			names = realloc(names, cap * sizeof names[0]);
+			if (!names) crash("out of memory");
+		}
+		names[n++] = strdup(path);
+		total += st.st_size;
+	}
+	closedir(d);
+
+	qsort(names, n, sizeof names[0], cmpname);
+
+	int i;
+	for (i = 0; i < n && total > budget; i++) {
+		if (!strcmp(names[i], chunkname) && of != -1) break;  // never the open one
+		struct stat st;
+		if (stat(names[i], &st) == -1) continue;
+		if (unlink(names[i]) == -1) {
+			slog(LOG_ERR, "unlink(%s): %s", names[i], strerror(errno));
+			continue;
+		}
+		total -= st.st_size;
+		stats.removed++;
+		slog(LOG_INFO, "removed %s", names[i]);
+	}
+	for (i = 0; i < n; i++)
+		free(names[i]);
+	free(names);
+}
+
+static void
+close_chunk(void)
+{
+	if (of == -1) return;
+	struct BusrecTrailer t = { BUSREC_INDEX_MAGIC, nblocks, offset };
+	write_all(index_, nblocks * sizeof index_[0]);
+	write_all(&t, sizeof t);
+	if (close(of) == -1) crash("close(%s)", chunkname);
+	of = -1;
+	nblocks = 0;
+	offset = 0;
+	stats.chunks++;
+	enforce_budget();
+}
+
+static void
+write_block(void)
+{
+	if (enc.hdr.nlines == 0) return;
+
+	if (of == -1) {
+		snprintf(chunkname, sizeof chunkname, "%s/%013lld.brc", dir, (long long)(enc.hdr.first_us / 1000));
+		of = open(chunkname, O_WRONLY|O_CREAT|O_TRUNC, S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
+		if (of == -1) crash("open(%s)", chunkname);
+	}
+
+	struct BusrecIndex* ix = &index_[nblocks++];
+	ix->first_us = enc.hdr.first_us;
+	ix->last_us = enc.hdr.last_us;
+	ix->offset = offset;
+	write_all(&enc.hdr, sizeof enc.hdr);
+	write_all(enc.buf, enc.len);
+	offset += sizeof enc.hdr + enc.len;
+	stats.bytes += sizeof enc.hdr + enc.len;
+	stats.rawbytes += enc.hdr.rawsize;
+
+	busrec_reset(&enc);
+
+	if (offset >= chunksize || nblocks == MAXBLOCKS)
+		close_chunk();
+}
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+	int flush_s = 10;
+	budget = 500;
+	chunksize = 4;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	while ((ch = getopt(argc, argv, "b:c:df:h")) != -1){
+		switch (ch) {
+		case 'b': budget = atoi(optarg); break;
+		case 'c': chunksize = atoi(optarg); break;
+		case 'd': ++debug; break;
+		case 'f': flush_s = atoi(optarg); break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc != 1 || budget <= 0 || chunksize <= 0 || flush_s <= 0) usage();
+	if (chunksize > budget) chunksize = budget;
+	dir = argv[0];
+	budget <<= 20;
+	chunksize <<= 20;
+
+	if (mkdir(dir, 0755) == -1 && errno != EEXIST) crash("mkdir(%s)", dir);
+
+	if (signal(SIGBUS, fault) == SIG_ERR)  crash("signal(SIGBUS)");
+	if (signal(SIGSEGV, fault) == SIG_ERR)  crash("signal(SIGSEGV)");
+	if (signal(SIGTERM, setflg) == SIG_ERR)  crash("signal(SIGTERM)");
+	if (signal(SIGINT, setflg) == SIG_ERR)  crash("signal(SIGINT)");
+
+	openlog(argv0, debug?LOG_PERROR:0, LOG_DAEMON);
+	if (!debug) setlogmask(LOG_UPTO(LOG_NOTICE));
+
+	enforce_budget();
+	busrec_reset(&enc);
+
+	slog(LOG_NOTICE, "recording to %s, budget %lld MB", dir, (long long)(budget >> 20));
+	slog_flush();  // from now on only when idle
+
+	sigset_t empty_mask;
+	sigemptyset(&empty_mask);
+
+	struct LineBuffer lb;
+	memset(&lb, 0, sizeof lb);
+
+	int64_t flush_us = 0;
+
+	while (!sigflg) {
+		fd_set rfds;
+		FD_ZERO(&rfds);
+		FD_SET(fileno(stdin), &rfds);
+
+		int64_t wait_us = (enc.hdr.nlines > 0) ? flush_us - now_us() : 1000000LL * flush_s;
+		if (wait_us < 0) wait_us = 0;
+		struct timespec timeout = { wait_us / 1000000, (wait_us % 1000000) * 1000 };
+
+		// Write the log only if we would wait anyway.
+		fd_set rfds_idle = rfds;
+		struct timespec nowait = { 0, 0 };
+		int r = pselect(fileno(stdin) + 1, &rfds, NULL, NULL, &nowait, &empty_mask);
+		if (r == 0 && wait_us != 0) {
+			slog_flush();
+			rfds = rfds_idle;
+			r = pselect(fileno(stdin) + 1, &rfds, NULL, NULL, &timeout, &empty_mask);
+		}
+		if (r == -1 && errno != EINTR) crash("pselect");
+
+		int64_t now = now_us();
+
+		if (r == 1) {
+			r = lb_readfd(&lb, fileno(stdin));
+			if (r == EOF) break;
+			if (r != 0 && r != EAGAIN) crash("reading stdin");
+		}
+
+		char line[BUSREC_MAXLINE];
+		int n;
+		while ((n = lb_getline(line, sizeof line, &lb)) > 0) {
+			if (line[n-1] == '\n') line[--n] = 0;
+			if (enc.hdr.nlines == 0)
+				flush_us = now + 1000000LL * flush_s;
+			if (busrec_add(&enc, now, line, n) < 0) {
+				write_block();
+				flush_us = now + 1000000LL * flush_s;
+				if (busrec_add(&enc, now, line, n) < 0)
+					crash("line doesn't fit in an empty block");
+			}
+			stats.lines++;
+		}
+
+		if (enc.hdr.nlines > 0 && now >= flush_us)
+			write_block();
+	}
+
+	write_block();
+	close_chunk();
+	slog(LOG_NOTICE, "%lld lines, %lld bytes in %lld bytes (%.1f%%), %lld chunks, %lld removed",
+	     (long long)stats.lines, (long long)stats.rawbytes, (long long)stats.bytes,
+	     stats.rawbytes ? 100.0 * stats.bytes / stats.rawbytes : 0.0,
+	     (long long)stats.chunks, (long long)stats.removed);
+	slog_flush();
+	return 0;
+}
@@ -0,0 +1,202 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Print the lines recorded by buslog, optionally only those that
+// arrived in a time range, like
+//
+//   busplay -s 1334567890000 -e 1334567950000 /var/log/lbus | grep imu:
+//
+// The chunk and the block of the start time are found by bisection, on
+// the file names and the chunk index.
+//
+
+#include <dirent.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "busrec.h"
+#include "lib/log.h"
+
+static const char* argv0;
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: %s [options] directory|chunk...\n"
+		"options:\n"
+		"\t-s ms        start at this time (ms since the epoch)\n"
+		"\t-e ms        end at this time\n"
+		"\t-t           prefix each line with its time of arrival in ms\n"
+		, argv0);
+	exit(2);
+}
+
+static int64_t start_us = INT64_MIN;
+static int64_t end_us = INT64_MAX;
+static int timestamps = 0;
+
+static struct BusrecCodec dec;
+static uint8_t payload[BUSREC_BLOCKSIZE];
+
+// Print the lines of the block at off.  Returns -1 at the end of the
+// chunk or if it is corrupt, 1 after end_us, 0 otherwise.
+static int
+play_block(FILE* f, const char* name, int64_t off)
+{
+	struct BusrecBlock hdr;
+	if (fseeko(f, off, SEEK_SET) == -1 || fread(&hdr, sizeof hdr, 1, f) != 1)
+		return -1;
+	if (hdr.magic == BUSREC_INDEX_MAGIC)
+		return -1;
+	if (hdr.magic != BUSREC_BLOCK_MAGIC || hdr.size > BUSREC_BLOCKSIZE ||
+	    fread(payload, 1, hdr.size, f) != hdr.size || busrec_start(&dec, &hdr, payload) < 0) {
+		fprintf(stderr, "%s: %s: bad block at %lld\n", argv0, name, (long long)off);
+		return -1;
+	}
+
+	char line[BUSREC_MAXLINE];
+	int64_t us;
+	int r;
+	while ((r = busrec_next(&dec, &us, line, sizeof line)) >= 0) {
+		if (us < start_us) continue;
+		if (us > end_us) return 1;
+		if (timestamps)
+			printf("%lld ", (long long)(us / 1000));
+		puts(line);
+	}
+	if (r == -2) {
+		fprintf(stderr, "%s: %s: corrupt block at %lld\n", argv0, name, (long long)off);
+		return -1;
+	}
+	return 0;
+}
+
+// Returns 1 after end_us.
+static int
+play_chunk(const char* name)
+{
+	FILE* f = fopen(name, "r");
+	if (!f) {
+		fprintf(stderr, "%s: %s: can't open\n", argv0, name);
+		return 0;
+	}
+
+	// With an index, bisect for the first block that ends after start_us.
+	struct BusrecTrailer t;
+	struct BusrecIndex* ix = NULL;
+	if (fseeko(f, -(off_t)sizeof t, SEEK_END) == 0 && fread(&t, sizeof t, 1, f) == 1 &&
+	    t.magic == BUSREC_INDEX_MAGIC && (ix = malloc(t.nblocks * sizeof ix[0] + 1)) != NULL &&
+	    (fseeko(f, t.offset, SEEK_SET) == -1 || fread(ix, sizeof ix[0], t.nblocks, f) != t.nblocks)) {
+		free(ix);
+		ix = NULL;
+	}
+
+	int r = 0;
+	if (ix) {
+		int lo = 0, hi = t.nblocks;
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (ix[mid].last_us < start_us) lo = mid + 1; else hi = mid;
+		}
+		for (; lo < t.nblocks && r == 0; lo++) {
+			if (ix[lo].first_us > end_us) { r = 1; break; }
+			r = play_block(f, name, ix[lo].offset);
+		}
+		free(ix);
+	} else {
+		int64_t off = 0;
+		while (r == 0) {
+			r = play_block(f, name, off);
+			off += sizeof dec.hdr + dec.hdr.size;
+		}
+	}
+	fclose(f);
+	return r == 1;
+}
+
+static int
+cmpname(const void* a, const void* b)
+{
+	return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Play the chunks of a directory from the one holding start_us.
+static void
+play_dir(const char* dir)
+{
+	DIR* d = opendir(dir);
+	if (!d) crash("opendir(%s)", dir);
+
+	char** names = NULL;
+	int n = 0, cap = 0;
+	struct dirent* e;
+	while ((e = readdir(d)) != NULL) {
+		int len = strlen(e->d_name);
+		if (len < 5 || strcmp(e->d_name + len - 4, ".brc")) continue;
+		if (n == cap) {
+			cap = cap ? 2 * cap : 256;
+			names = realloc(names, cap * sizeof names[0]);
+			if (!names) crash("out of memory");
+		}
+		names[n++] = strdup(e->d_name);
+	}
+	closedir(d);
+	qsort(names, n, sizeof names[0], cmpname);
+
+	// The last chunk that starts at or before start_us.
+	int lo = 0, hi = n;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (atoll(names[mid]) * 1000 <= start_us) lo = mid + 1; else hi = mid;
+	}
+	if (lo > 0) lo--;
+
+	for (; lo < n; lo++) {
+		if (atoll(names[lo]) * 1000 > end_us) break;
+		char path[1024];
+		snprintf(path, sizeof path, "%s/%s", dir, names[lo]);
+		if (play_chunk(path)) break;
+	}
+	while (n--)
+		free(names[n]);
+	free(names);
+}
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	while ((ch = getopt(argc, argv, "e:hs:t")) != -1){
+		switch (ch) {
+		case 'e': end_us = atoll(optarg) * 1000; break;
+		case 's': start_us = atoll(optarg) * 1000; break;
+		case 't': ++timestamps; break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc == 0) usage();
+
+	for (; argc; argc--, argv++) {
+		struct stat st;
+		if (stat(argv[0], &st) == -1) crash("stat(%s)", argv[0]);
+		if (S_ISDIR(st.st_mode))
+			play_dir(argv[0]);
+		else
+			play_chunk(argv[0]);
+	}
+	return 0;
+}
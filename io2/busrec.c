@@ -0,0 +1,271 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+#include "busrec.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// In a shape, a number is NUM followed by its number of decimals + 1.
+// ESC precedes a literal NUM or ESC.
+enum { NUM = 1, ESC = 2 };
+
+void
+busrec_reset(struct BusrecCodec* c)
+{
+	memset(&c->hdr, 0, sizeof c->hdr);
+	c->hdr.magic = BUSREC_BLOCK_MAGIC;
+	c->len = 0;
+	c->pos = 0;
+	c->nshapes = 0;
+	c->poollen = 0;
+}
+
+// -----------------------------------------------------------------------------
+//   Varints
+
+static int
+put_uvarint(uint8_t* p, uint64_t v)
+{
+	int n = 0;
+	while (v >= 0x80) {
+		p[n++] = v | 0x80;
+		v >>= 7;
+	}
+	p[n++] = v;
+	return n;
+}
+
+static int
+put_varint(uint8_t* p, int64_t v)
+{
+	return put_uvarint(p, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+static int
+get_uvarint(struct BusrecCodec* c, uint64_t* v)
+{
+	int shift;
+	*v = 0;
+	for (shift = 0; shift < 64 && c->pos < c->len; shift += 7) {
+		uint8_t b = c->buf[c->pos++];
+		*v |= (uint64_t)(b & 0x7f) << shift;
+		if (!(b & 0x80))
+			return 0;
+	}
+	return -1;
+}
+
+static int
+get_varint(struct BusrecCodec* c, int64_t* v)
+{
+	uint64_t u;
+	if (get_uvarint(c, &u) < 0) return -1;
+	*v = (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+//   Encoder
+
+static int
+isdig(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+// Parse a number at p that prints back the same: no leading zeros, no
+// negative zero, up to 18 digits.  Returns its length or 0.
+static int
+number(const char* p, const char* end, int64_t* m, int* dec)
+{
+	const char* s = p;
+	int neg = 0, digits = 0;
+	int64_t v = 0;
+
+	if (p < end && *p == '-') { neg = 1; p++; }
+	if (p == end || !isdig(*p)) return 0;
+	if (*p == '0' && p + 1 < end && isdig(p[1])) return 0;
+	while (p < end && isdig(*p)) {
+		if (++digits > 18) return 0;
+		v = 10 * v + (*p++ - '0');
+	}
+	*dec = 0;
+	if (p + 1 < end && *p == '.' && isdig(p[1])) {
+		p++;
+		while (p < end && isdig(*p)) {
+			if (++digits > 18) return 0;
+			v = 10 * v + (*p++ - '0');
+			++*dec;
+		}
+	}
+	if (neg && v == 0) return 0;
+	*m = neg ? -v : v;
+	return p - s;
+}
+
+static uint32_t
+fnv(const char* p, int n)
+{
+	uint32_t h = 2166136261u;
+	while (n--) {
+		h ^= (uint8_t)*p++;
+		h *= 16777619;
+	}
+	return h;
+}
+
+int
+busrec_add(struct BusrecCodec* c, int64_t us, const char* line, int len)
+{
+	char shape[2*BUSREC_MAXLINE];
+	int64_t num[BUSREC_MAXNUMS];
+	int slen = 0, nnum = 0;
+	const char* end = line + (len < BUSREC_MAXLINE ? len : BUSREC_MAXLINE);
+	const char* p = line;
+
+	while (p < end) {
+		int dec, n = 0;
+		if (nnum < BUSREC_MAXNUMS && (n = number(p, end, &num[nnum], &dec)) > 0) {
+			shape[slen++] = NUM;
+			shape[slen++] = dec + 1;
+			nnum++;
+			p += n;
+			continue;
+		}
+		if (*p == NUM || *p == ESC)
+			shape[slen++] = ESC;
+		shape[slen++] = *p++;
+	}
+
+	uint32_t h = fnv(shape, slen);
+	int id;
+	for (id = 0; id < c->nshapes; id++)
+		if (c->hash[id] == h && c->shapelen[id] == slen &&
+		    !memcmp(c->pool + c->shape[id], shape, slen))
+			break;
+
+	int newshape = (id == c->nshapes);
+	if (newshape && (c->nshapes == BUSREC_MAXSHAPES || c->poollen + slen > BUSREC_SHAPEPOOL))
+		return -1;
+	if (c->len + 10 + 10 + slen + 10 + 10*nnum > BUSREC_BLOCKSIZE)
+		return -1;
+
+	c->len += put_uvarint(c->buf + c->len, id);
+	if (newshape) {
+		c->len += put_uvarint(c->buf + c->len, slen);
+		memmove(c->buf + c->len, shape, slen);
+		c->len += slen;
+		c->hash[id] = h;
+		c->shape[id] = c->poollen;
+		c->shapelen[id] = slen;
+		memmove(c->pool + c->poollen, shape, slen);
+		c->poollen += slen;
+		memset(c->prev[id], 0, sizeof c->prev[id]);
+		c->nshapes++;
+	}
+
+	if (c->hdr.nlines == 0)
+		c->hdr.first_us = c->hdr.last_us = us;
+	c->len += put_varint(c->buf + c->len, us - c->hdr.last_us);
+	c->hdr.last_us = us;
+
+	int k;
+	for (k = 0; k < nnum; k++) {
+		c->len += put_varint(c->buf + c->len, num[k] - c->prev[id][k]);
+		c->prev[id][k] = num[k];
+	}
+
+	c->hdr.nlines++;
+	c->hdr.rawsize += end - line + 1;
+	c->hdr.size = c->len;
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+//   Decoder
+
+int
+busrec_start(struct BusrecCodec* c, const struct BusrecBlock* hdr, const uint8_t* payload)
+{
+	busrec_reset(c);
+	if (hdr->magic != BUSREC_BLOCK_MAGIC || hdr->size > BUSREC_BLOCKSIZE)
+		return -1;
+	c->hdr = *hdr;
+	c->hdr.nlines = 0;	// counts the decoded ones
+	c->hdr.last_us = hdr->first_us;
+	memmove(c->buf, payload, hdr->size);
+	c->len = hdr->size;
+	return 0;
+}
+
+static const int64_t tens[] = {
+	1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL,
+	1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL,
+	100000000000000LL, 1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+	1000000000000000000LL,
+};
+
+int
+busrec_next(struct BusrecCodec* c, int64_t* us, char* line, int size)
+{
+	if (c->pos == c->len)
+		return -1;
+
+	uint64_t id, slen;
+	if (get_uvarint(c, &id) < 0 || id > c->nshapes)
+		return -2;
+	if (id == c->nshapes) {
+		if (id == BUSREC_MAXSHAPES || get_uvarint(c, &slen) < 0 ||
+		    slen > c->len - c->pos || c->poollen + slen > BUSREC_SHAPEPOOL)
+			return -2;
+		c->shape[id] = c->poollen;
+		c->shapelen[id] = slen;
+		memmove(c->pool + c->poollen, c->buf + c->pos, slen);
+		c->poollen += slen;
+		c->pos += slen;
+		memset(c->prev[id], 0, sizeof c->prev[id]);
+		c->nshapes++;
+	}
+
+	int64_t d;
+	if (get_varint(c, &d) < 0)
+		return -2;
+	c->hdr.last_us += d;
+	*us = c->hdr.last_us;
+
+	// Numbers are decoded even if the line doesn't fit, for the next line.
+	const char* s = c->pool + c->shape[id];
+	const char* end = s + c->shapelen[id];
+	int n = 0, k = 0;
+	while (s < end) {
+		char num[24];
+		const char* t = num;
+		int tlen = 1;
+		if (*s == ESC && s + 1 < end) {
+			t = s + 1;
+			s += 2;
+		} else if (*s != NUM || s + 1 >= end) {
+			t = s++;
+		} else {
+			int dec = s[1] - 1;
+			s += 2;
+			if (k == BUSREC_MAXNUMS || dec < 0 || dec > 18 || get_varint(c, &d) < 0)
+				return -2;
+			int64_t m = c->prev[id][k] + d;
+			c->prev[id][k++] = m;
+			unsigned long long a = (m < 0) ? -(uint64_t)m : m;
+			if (dec == 0)
+				tlen = snprintf(num, sizeof num, "%s%llu", (m < 0) ? "-" : "", a);
+			else
+				tlen = snprintf(num, sizeof num, "%s%llu.%0*llu", (m < 0) ? "-" : "",
+						a / tens[dec], dec, a % tens[dec]);
+		}
+		while (tlen-- > 0 && n < size - 1)
+			line[n++] = *t++;
+	}
+	line[n] = 0;
+	c->hdr.nlines++;
+	return n;
+}
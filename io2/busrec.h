@@ -0,0 +1,100 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Compressed bus recordings, written by buslog and read by busplay.
+//
+// A recording is a directory of chunk files named after the time of
+// their first line in ms, so they sort by time.  A chunk is a sequence
+// of blocks, and when it is closed an index of the blocks is appended:
+//
+//   block:   struct BusrecBlock, payload
+//   index:   struct BusrecIndex per block, struct BusrecTrailer
+//
+// A chunk without index (the recorder died) is read by walking the
+// block headers.  Blocks are decoded independently, so with the index a
+// reader finds the block of a given time by bisection.
+//
+// Every line is stored with its time of arrival.  The payload encodes
+// each line as its shape, the text with the decimal numbers cut out, and
+// the differences of the numbers to those of the previous line with the
+// same shape.  Bus messages of one kind have the same shape and numbers
+// that change little, e.g. "imu: timestamp_ms:1334567890123 ..." is a
+// shape id and a few bytes.  Shapes are sent in full the first time in a
+// block.  All integers are zigzag varints, little endian, as in
+// protocol buffers.  The text comes back byte for byte.
+//
+#ifndef IO_BUSREC_H
+#define IO_BUSREC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	BUSREC_BLOCK_MAGIC = 0x42524231,	// "1BRB"
+	BUSREC_INDEX_MAGIC = 0x58495242,	// "BRIX"
+	BUSREC_BLOCKSIZE = 64*1024,		// max payload bytes
+	BUSREC_MAXLINE = 1024,
+	BUSREC_MAXSHAPES = 256,
+	BUSREC_MAXNUMS = 32,			// per line, more stay in the shape
+	BUSREC_SHAPEPOOL = 32*1024,
+};
+
+struct BusrecBlock {
+	uint32_t magic;
+	uint32_t size;		// of the payload
+	uint32_t nlines;
+	uint32_t rawsize;	// of the text
+	int64_t first_us;
+	int64_t last_us;
+};
+
+struct BusrecIndex {
+	int64_t first_us;
+	int64_t last_us;
+	int64_t offset;		// of the block header in the file
+};
+
+struct BusrecTrailer {
+	uint32_t magic;
+	uint32_t nblocks;
+	int64_t offset;		// of the index
+};
+
+// Encoder and decoder state of a block.
+struct BusrecCodec {
+	struct BusrecBlock hdr;
+	uint8_t buf[BUSREC_BLOCKSIZE];
+	int len;		// of buf
+	int pos;		// decoder position in buf
+	int nshapes;
+	uint32_t hash[BUSREC_MAXSHAPES];
+	int shape[BUSREC_MAXSHAPES];	// offset in pool
+	int shapelen[BUSREC_MAXSHAPES];
+	char pool[BUSREC_SHAPEPOOL];
+	int poollen;
+	int64_t prev[BUSREC_MAXSHAPES][BUSREC_MAXNUMS];
+};
+
+// Start an empty block.
+void busrec_reset(struct BusrecCodec* c);
+
+// Encode a line (without '\n') that arrived at us.  Returns 0, or -1 if
+// the block is full: write it out, reset and add the line again.
+int busrec_add(struct BusrecCodec* c, int64_t us, const char* line, int len);
+
+// Start decoding the block hdr with payload.  Returns -1 if the header is bad.
+int busrec_start(struct BusrecCodec* c, const struct BusrecBlock* hdr, const uint8_t* payload);
+
+// Decode the next line into line (0-terminated, without '\n').  Returns
+// its length, -1 at the end of the block or -2 if the block is corrupt.
+int busrec_next(struct BusrecCodec* c, int64_t* us, char* line, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IO_BUSREC_H
@@ -0,0 +1,100 @@
+#include "busrec.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct BusrecCodec enc, dec;
+
+static const char* lines[] = {
+	"imu: timestamp_ms:1334567890123 temp_c:31.5 acc_x_m_s2:-0.123 acc_y_m_s2:9.81 yaw_deg:-179.9",
+	"gps: timestamp_ms:1334567890200 lat_deg:47.123456 lng_deg:-8.000001 speed_m_s:0.0 cog_deg:359.99",
+	"imu: timestamp_ms:1334567890223 temp_c:31.5 acc_x_m_s2:0.004 acc_y_m_s2:9.80 yaw_deg:180.0",
+	"leading zeros 007 00.5 -0 -0.0 0.0 -.5 5. 1.2.3 1e-3 --1",
+	"long 1234567890123456789 -123456789012345678 12345678901234567.89",
+	"escapes \001\002 \001 5 \002 7",
+	"",
+	"no numbers at all",
+	"imu: timestamp_ms:1334567890323 temp_c:31.6 acc_x_m_s2:-10.5 acc_y_m_s2:9.79 yaw_deg:-0.01",
+	"many 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35",
+	"imu: timestamp_ms:1334567890423 temp_c:31.6 acc_x_m_s2:-10.5 acc_y_m_s2:9.79 yaw_deg:-0.01",
+};
+
+enum { NLINES = sizeof lines / sizeof lines[0] };
+
+int main(int argc, char* argv[]) {
+	char line[BUSREC_MAXLINE];
+	int64_t us;
+	int i;
+
+	// Round trip, byte for byte, with times going back and forth.
+	busrec_reset(&enc);
+	for (i = 0; i < NLINES; i++)
+		assert(busrec_add(&enc, 1000000LL * i - 7 * (i % 2), lines[i], strlen(lines[i])) == 0);
+	assert(enc.hdr.nlines == NLINES);
+	assert(enc.hdr.first_us == 0 && enc.hdr.last_us == 1000000LL * (NLINES - 1));
+
+	assert(busrec_start(&dec, &enc.hdr, enc.buf) == 0);
+	for (i = 0; i < NLINES; i++) {
+		int n = busrec_next(&dec, &us, line, sizeof line);
+		assert(n == strlen(lines[i]));
+		assert(!strcmp(line, lines[i]));
+		assert(us == 1000000LL * i - 7 * (i % 2));
+	}
+	assert(busrec_next(&dec, &us, line, sizeof line) == -1);
+
+	// A repeated line is a byte for the shape, the time and each number.
+	int len = enc.len;
+	assert(busrec_add(&enc, enc.hdr.last_us, lines[NLINES-1], strlen(lines[NLINES-1])) == 0);
+	assert(enc.len - len == 1 + 1 + 7);
+
+	// Truncated output doesn't lose the state for the next lines.
+	assert(busrec_start(&dec, &enc.hdr, enc.buf) == 0);
+	for (i = 0; i < NLINES; i++) {
+		int n = busrec_next(&dec, &us, line, 8);
+		assert(n == (strlen(lines[i]) < 7 ? strlen(lines[i]) : 7));
+		assert(!strncmp(line, lines[i], n));
+	}
+	assert(busrec_next(&dec, &us, line, sizeof line) == strlen(lines[NLINES-1]));
+	assert(!strcmp(line, lines[NLINES-1]));
+
+	// The block fills up.
+	busrec_reset(&enc);
+	srand(1);
+	for (i = 0; ; i++) {
+		snprintf(line, sizeof line, "ai%c: timestamp_ms:%d mmsi:%d", "sdx"[i % 3], 1000 * i, rand());
+		if (busrec_add(&enc, i, line, strlen(line)) < 0)
+			break;
+	}
+	assert(i > 1000 && enc.len <= BUSREC_BLOCKSIZE);
+	assert(busrec_start(&dec, &enc.hdr, enc.buf) == 0);
+	int n = 0;
+	while (busrec_next(&dec, &us, line, sizeof line) >= 0)
+		n++;
+	assert(n == i);
+
+	// Corruption is detected, not crashed on.
+	struct BusrecBlock hdr = enc.hdr;
+	hdr.magic++;
+	assert(busrec_start(&dec, &hdr, enc.buf) == -1);
+	hdr = enc.hdr;
+	hdr.size = BUSREC_BLOCKSIZE + 1;
+	assert(busrec_start(&dec, &hdr, enc.buf) == -1);
+	hdr = enc.hdr;
+	hdr.size = 100;
+	assert(busrec_start(&dec, &hdr, enc.buf) == 0);
+	int r;
+	while ((r = busrec_next(&dec, &us, line, sizeof line)) >= 0)
+		;
+	assert(r == -2);
+	for (i = 0; i < 1000; i++) {
+		enc.buf[rand() % enc.len] ^= 1 << (rand() % 8);
+		assert(busrec_start(&dec, &enc.hdr, enc.buf) == 0);
+		while (busrec_next(&dec, &us, line, sizeof line) >= 0)
+			;
+	}
+
+	puts("OK");
+	return 0;
+}
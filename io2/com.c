@@ -166,7 +166,7 @@ recv(int fd, uint8_t* data, int* size)
         write(fd, &ack, 1);
         VLOGF("recv: send ack (%02x, '%c'): %d\n", ack, ack, err);
 
-        return (ack = 'O') ? 0 : EPOS_ERR_BADRESPONSE;
+        return (ack == 'O') ? 0 : EPOS_ERR_BADRESPONSE;
 }
 
 
@@ -311,8 +311,8 @@ epos_requestcanframe(int fd, uint16_t cobid, int len, uint8_t data[8])
 
         r = (recvframe[5]<<24) + (recvframe[4]<<16) + (recvframe[3]<<8) + recvframe[2];
         if (r == 0) {
-                memmove(recvframe+6, data, len);
-                memset(data+len, 0, sizeof(data)-len);
+                memmove(data, recvframe+6, len);
+                memset(data+len, 0, 8-len);
         }
         return r;
 }
@@ -3,6 +3,7 @@
 // that can be found in the LICENSE file.
 //
 // Decode status registers on ebus and output drive status messages on lbus.
+// Status messages streamed by eposcom -P are passed on as they are.
 // Use plug -o and plug -i to connect to the busses.
 // 
 
@@ -34,6 +35,12 @@ static void usage(void) {
 	exit(2);
 }
 
+// Restart the period between reports, as if we sent one.
+static void restart(struct Timer* t, int64_t us) {
+	timer_tick(t, us, 0);
+	timer_tick(t, us, 1);
+}
+
 int main(int argc, char* argv[]) {
 
 	int ch;
@@ -91,6 +98,28 @@ int main(int argc, char* argv[]) {
 		int32_t value 	= 0;
 		us = 0;
 
+		// Streamed by eposcom -P, newer than what we decode here.
+		struct RudderProto in = INIT_RUDDERPROTO;
+		int nn = 0;
+		if (sscanf(line, IFMT_STATUS_LEFT(&in, &nn)) == 2) {
+			sts.rudder_l_deg = in.rudder_l_deg;
+			restart(&timer[LEFT], in.timestamp_ms * 1000);
+			fputs(line, stdout);
+			continue;
+		}
+		if (sscanf(line, IFMT_STATUS_RIGHT(&in, &nn)) == 2) {
+			sts.rudder_r_deg = in.rudder_r_deg;
+			restart(&timer[RIGHT], in.timestamp_ms * 1000);
+			fputs(line, stdout);
+			continue;
+		}
+		if (sscanf(line, IFMT_STATUS_SAIL(&in, &nn)) == 2) {
+			sts.sail_deg = in.sail_deg;
+			restart(&timer[SAIL], in.timestamp_ms * 1000);
+			fputs(line, stdout);
+			continue;
+		}
+
 		if (!ebus_parse_rsp(line, &op, &serial, &reg, &value, &us))
 			continue;
 
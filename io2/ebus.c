@@ -52,3 +52,81 @@ int ebus_parse(const char* line, char* op, uint32_t* serial, uint32_t* reg, int3
 		
 	return 0;
 }
+
+static char*
+put(char* p, uint64_t v, int n)
+{
+	for (; n > 0; n--, v >>= 8) {
+		char c = v & 0xff;
+		if (c == '\n' || c == 0 || c == EBUS_BIN_ESC) {
+			*p++ = EBUS_BIN_ESC;
+			c ^= 0x20;
+		}
+		*p++ = c;
+	}
+	return p;
+}
+
+int ebus_bin_encode(char* buf, const struct EbusFrame* f) {
+	char* p = buf;
+	*p++ = (f->op == '?' || f->op == ':') ? EBUS_BIN_REQ : EBUS_BIN_RSP;
+	*p++ = f->client;
+	*p++ = f->op;
+	p = put(p, f->id, 2);
+	p = put(p, f->serial, 4);
+	p = put(p, f->reg, 4);
+	p = put(p, (uint32_t)f->value, 4);
+	if (f->us)
+		p = put(p, f->us, 8);
+	*p++ = '\n';
+	*p = 0;
+	return p - buf;
+}
+
+int ebus_bin_decode(const char* line, struct EbusFrame* f) {
+	if (line[0] != EBUS_BIN_REQ && line[0] != EBUS_BIN_RSP)
+		return 0;
+	if (!line[1] || !line[2])
+		return 0;
+
+	uint8_t b[22];
+	int n = 0;
+	const char* p;
+	for (p = line + 3; *p && *p != '\n'; p++) {
+		if (n == sizeof b)
+			return 0;
+		uint8_t c = *p;
+		if (c == EBUS_BIN_ESC) {
+			if (!*++p) return 0;
+			c = *p ^ 0x20;
+		}
+		b[n++] = c;
+	}
+	if (n != 14 && n != 22)
+		return 0;
+
+	f->client = line[1];
+	f->op = line[2];
+	switch (f->op) {
+	case '?': case ':':
+		if (line[0] != EBUS_BIN_REQ) return 0;
+		break;
+	case '=': case '#':
+		if (line[0] != EBUS_BIN_RSP) return 0;
+		break;
+	default:
+		return 0;
+	}
+
+	f->id     = b[0] | b[1] << 8;
+	f->serial = b[2] | b[3] << 8 | b[4] << 16 | (uint32_t)b[5] << 24;
+	f->reg    = b[6] | b[7] << 8 | b[8] << 16 | (uint32_t)b[9] << 24;
+	f->value  = b[10] | b[11] << 8 | b[12] << 16 | (uint32_t)b[13] << 24;
+	f->us = 0;
+	if (n == 22) {
+		int i;
+		for (i = 21; i >= 14; i--)
+			f->us = f->us << 8 | b[i];
+	}
+	return 1;
+}
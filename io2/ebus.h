@@ -5,7 +5,7 @@
 // API for the ebus protocol
 //
 #ifndef _IO_RUDDERD2_EBUS_H
-#define _IO_RUDDERD2_EUBS_H
+#define _IO_RUDDERD2_EBUS_H
 
 #include <stdint.h>
 
@@ -40,4 +40,48 @@ int ebus_parse_rsp(const char* line, char* op, uint32_t* serial, uint32_t* reg,
 // Returns 1 if the line contained a response or request, 0 otherwise.
 int ebus_parse(const char* line, char* op, uint32_t* serial, uint32_t* reg, int32_t* val, uint64_t* us);
 
+// Binary framing, optional next to the text protocol above.
+//
+// A frame is still one line on the linebus, so that linebusd can route
+// it, but the fields are binary, little endian:
+//
+//   magic client op id:2 serial:4 reg:4 value:4 [us:8] '\n'
+//
+// magic is EBUS_BIN_REQ for requests (op '?' or ':') and EBUS_BIN_RSP for
+// responses (op '=' or '#').  client is a printable character that names
+// the requester, eposcom addresses the response to it, so a client can
+// $subscribe to its own responses only ("<R") instead of seeing every
+// ACK on the bus.  id is chosen by the client to match responses to its
+// requests.  us is left out if it is 0.
+//
+// The bytes '\n', '\0' and EBUS_BIN_ESC are sent as EBUS_BIN_ESC, byte ^ 0x20.
+// ebustext translates frames to and from text for debugging with plug.
+enum {
+	EBUS_BIN_REQ = '>',
+	EBUS_BIN_RSP = '<',
+	EBUS_BIN_ESC = 0x7d,
+	EBUS_BIN_MAXLEN = 3 + 2*22 + 2,  // including '\n' and the terminating 0
+};
+
+struct EbusFrame {
+	char client;
+	char op;	// '?', ':', '=' or '#'
+	uint16_t id;
+	uint32_t serial;
+	uint32_t reg;
+	int32_t value;
+	uint64_t us;	// 0 if none
+};
+
+// Encodes f into buf, which must hold EBUS_BIN_MAXLEN bytes.  Returns the
+// length without the terminating 0.
+int ebus_bin_encode(char* buf, const struct EbusFrame* f);
+
+// Decodes a frame line, with or without the '\n'.
+// Returns 1 if the line contained a frame, 0 otherwise.
+int ebus_bin_decode(const char* line, struct EbusFrame* f);
+
+// The frame header for the text translation, followed by one of the OFMTs above.
+#define EBUS_BIN_TEXT_OFMT(f) "%c%c %u ", ((f)->op == '?' || (f)->op == ':') ? EBUS_BIN_REQ : EBUS_BIN_RSP, (f)->client, (f)->id
+
 #endif //_IO_RUDDERD2_EBUS_H
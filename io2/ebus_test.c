@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 int main(int argc, char* argv[]) {
 
@@ -115,6 +116,33 @@ int main(int argc, char* argv[]) {
 	assert(value == 0x4321);
 	assert(us == 0x12345678);
 
+	// Binary frames, with bytes that need escaping.
+	char bin[EBUS_BIN_MAXLEN];
+	struct EbusFrame f = { 'R', ':', 0x0a7d, 0x1234, REGISTER(0x607a, 0), -10, 0 };
+	struct EbusFrame g;
+	int n = ebus_bin_encode(bin, &f);
+	assert(n == strlen(bin));
+	assert(bin[0] == EBUS_BIN_REQ && bin[n-1] == '\n');
+	assert(!strchr(bin, '\n') || strchr(bin, '\n') == bin + n - 1);
+	memset(&g, 0, sizeof g);
+	assert(ebus_bin_decode(bin, &g));
+	assert(g.client == 'R' && g.op == ':' && g.id == 0x0a7d);
+	assert(g.serial == 0x1234 && g.reg == REGISTER(0x607a, 0) && g.value == -10 && g.us == 0);
+	assert(!ebus_parse(bin, &op, &serial, &regidx, &value, &us));
+
+	struct EbusFrame h = { 'S', '#', 0xffff, 0xffffffff, 0, 0x0a000000, 0x123456789a000aLL };
+	n = ebus_bin_encode(bin, &h);
+	assert(n < EBUS_BIN_MAXLEN);
+	assert(bin[0] == EBUS_BIN_RSP);
+	assert(ebus_bin_decode(bin, &g));
+	assert(g.client == 'S' && g.op == '#' && g.id == 0xffff);
+	assert(g.serial == 0xffffffff && g.reg == 0 && g.value == 0x0a000000 && g.us == 0x123456789a000aLL);
+
+	// Text lines and garbage are no frames.
+	assert(!ebus_bin_decode(buf, &g));
+	assert(!ebus_bin_decode(">R:", &g));
+	bin[0] = EBUS_BIN_REQ;
+	assert(!ebus_bin_decode(bin, &g));  // a response op in a request
 
 	puts("OK");
 	return 0;
@@ -0,0 +1,110 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Translate binary ebus frames (ebus.h) to text, to watch them with plug:
+//
+//   plug -o /var/run/ebus | ebustext
+//
+// With -c the text requests on stdin are sent as binary frames of that
+// client, to talk to binary drives by hand:
+//
+//   plug /var/run/ebus -- ebustext -c X
+//
+// All other lines pass unchanged.
+//
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ebus.h"
+
+static const char* argv0;
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: %s [options]\n"
+		"options:\n"
+		"\t-c client   send text requests as binary frames from client\n"
+		, argv0);
+	exit(2);
+}
+
+static void
+print_text(const struct EbusFrame* f)
+{
+	printf(EBUS_BIN_TEXT_OFMT(f));
+	switch (f->op) {
+	case '?':
+		if (f->us) printf(EBUS_GET_T_OFMT(f->serial, f->reg, f->us));
+		else	   printf(EBUS_GET_OFMT(f->serial, f->reg));
+		break;
+	case ':':
+		if (f->us) printf(EBUS_SET_T_OFMT(f->serial, f->reg, f->value, f->us));
+		else	   printf(EBUS_SET_OFMT(f->serial, f->reg, f->value));
+		break;
+	case '=':
+		if (f->us) printf(EBUS_ACK_T_OFMT(f->serial, f->reg, f->value, f->us));
+		else	   printf(EBUS_ACK_OFMT(f->serial, f->reg, f->value));
+		break;
+	case '#':
+		if (f->us) printf(EBUS_ERR_T_OFMT(f->serial, f->reg, f->value, f->us));
+		else	   printf(EBUS_ERR_OFMT(f->serial, f->reg, f->value));
+		break;
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+	char client = 0;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	while ((ch = getopt(argc, argv, "c:h")) != -1){
+		switch (ch) {
+		case 'c': client = optarg[0]; break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc != 0) usage();
+
+	if(setvbuf(stdout, NULL, _IOLBF, 0))
+		fprintf(stderr, "%s: failed to make stdout line-buffered.\n", argv0);
+
+	if (client) {
+		printf("$name ebustext-%c\n", client);
+		printf("$subscribe %c%c\n", EBUS_BIN_RSP, client);
+	}
+
+	uint16_t id = 0;
+	char line[1024];
+	while (fgets(line, sizeof line, stdin)) {
+		struct EbusFrame f;
+		memset(&f, 0, sizeof f);
+		if (ebus_bin_decode(line, &f)) {
+			print_text(&f);
+		} else if (client && ebus_parse_req(line, &f.op, &f.serial, &f.reg, &f.value, &f.us)) {
+			char buf[EBUS_BIN_MAXLEN];
+			f.client = client;
+			f.id = ++id;
+			ebus_bin_encode(buf, &f);
+			fputs(buf, stdout);
+		} else {
+			fputs(line, stdout);
+		}
+	}
+	return 0;
+}
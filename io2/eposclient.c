@@ -16,14 +16,34 @@
 
 enum { INVALID, PENDING, VALID };
 
+enum {
+	REQ_TIMEOUT_US = 1*1000*1000,   // after 1 second, PENDING->INVALID so next will re-issue
+	RSP_TIMEOUT_US = 5*1000*1000    // after 5 seconds VALID->INVALID so next will re-issue
+};
+
+// The registers of a device live in an open addressed table (linear
+// probing, never more than half full).  A controller uses some 30
+// registers, so the table rarely grows.
+enum { REGTAB_INITIAL_SIZE = 64 };
+
+// PENDING and VALID registers are on a timer wheel, in the slot of
+// their timeout.  The wheel spans more than RSP_TIMEOUT_US, so all
+// registers in a slot are due within the same turn.
+enum { WHEEL_SLOTS = 64, WHEEL_TICK_US = 100*1000 };
+
 typedef struct Register Register;
 
 struct Register {
-	Register *next;
 	uint32_t reg;
 	uint32_t value;
+	int used;
 	int state;
-	struct Timer timer;
+	int64_t since_us;	// PENDING: request sent, VALID: response received
+	int64_t due_us;		// timeout of the state
+	uint16_t id;		// of the last binary request
+	Register *wnext;	// timer wheel slot list
+	Register **wprev;	// NULL if not on the wheel
+	struct Timer* timer;	// only if stats are enabled
 };
 
 struct Device {
@@ -31,24 +51,158 @@ struct Device {
 	Bus *bus;
 	uint32_t serial;
 	Register* registers;
+	uint32_t size;		// power of 2
+	uint32_t n;
 };
 
 struct Bus {
 	FILE* ctl;
 	Device* devices;
 	int timestamp;
+	int stats;
+	char client;		// binary framing if not 0
+	int64_t requests;
+	uint16_t id;		// of the last binary request
+	Register* wheel[WHEEL_SLOTS];
+	int64_t wheel_tick;	// the slot to expire next
+	int64_t last_us;	// of the last bus_expire
 };
 
 Bus* bus_new(FILE* ctl) {
 	Bus* bus = malloc(sizeof(*bus));
+	memset(bus, 0, sizeof *bus);
 	bus->ctl = ctl;
-	bus->devices = NULL;
-	bus->timestamp = 0;
+	bus->last_us = now_us();
+	bus->wheel_tick = bus->last_us / WHEEL_TICK_US;
 	return bus;
 }
 
 void bus_enable_timestamp(Bus* bus, int on) { bus->timestamp = on; }
 
+void bus_enable_stats(Bus* bus, int on) { bus->stats = on; }
+
+void bus_enable_binary(Bus* bus, char client) { bus->client = client; }
+
+int64_t bus_requests(Bus* bus) { return bus->requests; }
+
+// Send a request as a binary frame.
+static void send_frame(Device* dev, Register* reg, char op, uint32_t val, int64_t now) {
+	Bus* bus = dev->bus;
+	struct EbusFrame f = { bus->client, op, ++bus->id, dev->serial, reg->reg, val, bus->timestamp ? now : 0 };
+	char buf[EBUS_BIN_MAXLEN];
+	reg->id = f.id;
+	ebus_bin_encode(buf, &f);
+	fputs(buf, bus->ctl);
+}
+
+// -----------------------------------------------------------------------------
+//   Timer wheel
+
+static void unschedule(Register* reg) {
+	if (!reg->wprev) return;
+	*reg->wprev = reg->wnext;
+	if (reg->wnext) reg->wnext->wprev = reg->wprev;
+	reg->wnext = NULL;
+	reg->wprev = NULL;
+}
+
+static void schedule(Bus* bus, Register* reg, int64_t due_us) {
+	unschedule(reg);
+	Register** slot = &bus->wheel[(due_us / WHEEL_TICK_US) % WHEEL_SLOTS];
+	reg->due_us = due_us;
+	reg->wnext = *slot;
+	if (*slot) (*slot)->wprev = &reg->wnext;
+	reg->wprev = slot;
+	*slot = reg;
+}
+
+// The latency timer, only kept with stats on.
+static void tick(Bus* bus, Register* reg, int64_t now, int start) {
+	if (!reg->timer) {
+		if (!bus->stats || start != TIMER_START) return;
+		reg->timer = malloc(sizeof *reg->timer);
+		memset(reg->timer, 0, sizeof *reg->timer);
+	}
+	timer_tick(reg->timer, now, start);
+}
+
+static void set_state(Bus* bus, Register* reg, int state, int64_t now) {
+	if (reg->state == PENDING)
+		tick(bus, reg, now, TIMER_STOP);
+	reg->state = state;
+	switch (state) {
+	case INVALID:
+		unschedule(reg);
+		break;
+	case PENDING:
+		tick(bus, reg, now, TIMER_START);
+		reg->since_us = now;
+		schedule(bus, reg, now + REQ_TIMEOUT_US);
+		break;
+	case VALID:
+		reg->since_us = now;
+		schedule(bus, reg, now + RSP_TIMEOUT_US);
+		break;
+	}
+}
+
+// -----------------------------------------------------------------------------
+//   Register table
+
+static uint32_t hash(uint32_t regidx) {
+	uint32_t h = regidx * 2654435761u;
+	return h ^ (h >> 16);
+}
+
+// Returns the slot of regidx or the empty slot where it would go.
+static Register* probe(Register* table, uint32_t size, uint32_t regidx) {
+	uint32_t i = hash(regidx) & (size - 1);
+	while (table[i].used && table[i].reg != regidx)
+		i = (i + 1) & (size - 1);
+	return &table[i];
+}
+
+static void grow(Device* dev) {
+	uint32_t size = dev->size ? 2*dev->size : REGTAB_INITIAL_SIZE;
+	Register* table = malloc(size * sizeof table[0]);
+	memset(table, 0, size * sizeof table[0]);
+	uint32_t i;
+	for (i = 0; i < dev->size; ++i) {
+		Register* old = &dev->registers[i];
+		if (!old->used) continue;
+		int scheduled = old->wprev != NULL;
+		unschedule(old);
+		Register* reg = probe(table, size, old->reg);
+		*reg = *old;
+		if (scheduled) schedule(dev->bus, reg, old->due_us);
+	}
+	free(dev->registers);
+	dev->registers = table;
+	dev->size = size;
+}
+
+static Register* lookup_reg(Device* dev, uint32_t regidx) {
+	if (!dev->size) return NULL;
+	Register* reg = probe(dev->registers, dev->size, regidx);
+	return reg->used ? reg : NULL;
+}
+
+static Register* find_reg(Device* dev, uint32_t regidx) {
+	Register* reg = lookup_reg(dev, regidx);
+	if (reg) return reg;
+
+	if (2*(dev->n + 1) > dev->size)
+		grow(dev);
+	reg = probe(dev->registers, dev->size, regidx);
+	reg->used = 1;
+	reg->reg = regidx;
+	reg->state = INVALID;
+	++dev->n;
+	return reg;
+}
+
+// -----------------------------------------------------------------------------
+
 int64_t bus_receive(Bus* bus, char* line) {
 
 	uint32_t serial = 0;
@@ -56,8 +210,17 @@ int64_t bus_receive(Bus* bus, char* line) {
 	char op 	= 0;
 	int32_t value 	= 0;
 	uint64_t us 	= 0;  // timestamp added by sender, currently unused
-
-	if (!ebus_parse_rsp(line, &op, &serial, &regidx, &value, &us))
+	int binary	= line[0] == EBUS_BIN_RSP;
+	struct EbusFrame f;
+
+	if (binary) {
+		if (!ebus_bin_decode(line, &f) || f.client != bus->client)
+			return 0;
+		op = f.op;
+		serial = f.serial;
+		regidx = f.reg;
+		value = f.value;
+	} else if (!ebus_parse_rsp(line, &op, &serial, &regidx, &value, &us))
 		return 0;
 
 	Device* dev = NULL;
@@ -67,64 +230,61 @@ int64_t bus_receive(Bus* bus, char* line) {
 
 	if(!dev) return 0;
 
-	Register* reg = NULL;
-	for (reg = dev->registers; reg; reg = reg->next)
-		if (reg->reg == regidx)
-			break;
-
+	Register* reg = lookup_reg(dev, regidx);
 	if (!reg) return 0;
 
+	// The answer to an earlier request, superseded by the pending one.
+	if (binary && reg->state == PENDING && f.id != reg->id)
+		return 0;
+
 	int prev = reg->state;
+	int64_t since = reg->since_us;
+	int64_t now = now_us();
 
 	if (op == '=') {
 		reg->value = value;
-		reg->state = VALID;
+		set_state(bus, reg, VALID, now);
 	} else {
-		reg->state = INVALID;
+		set_state(bus, reg, INVALID, now);
 	}
 
 	if (prev != PENDING)  // we got a response to someone elses request
 		return 1;
 
-	assert(timer_running(&reg->timer));
-	int64_t dt = timer_tick_now(&reg->timer, 0);
+	int64_t dt = now - since;
 	if (dt < 2) dt = 2;
 	return dt;
 }
 
-enum {
-	REQ_TIMEOUT_US = 1*1000*1000,   // after 1 second, PENDING->INVALID so next will re-issue
-	RSP_TIMEOUT_US = 5*1000*1000    // after 5 seconds VALID->INVALID so next will re-issue
-};
-
 // Return number of timed out pending requests (not responses)
 int bus_expire(Bus* bus) {
-	Device* dev;
-	Register* reg;
 	int r = 0;
 	int64_t t = now_us();
-	int64_t s = 0;
-	for (dev = bus->devices; dev; dev = dev->next)
-		for (reg = dev->registers; reg; reg = reg->next) {
-			switch (reg->state) {
-			case PENDING:
-				assert(timer_running(&reg->timer));
-				s = t - timer_started(&reg->timer);
-				if (0 < s && s < REQ_TIMEOUT_US)
-					continue;
-				timer_tick(&reg->timer, t, 0);
-				reg->state = INVALID;
-				++r;
-				break;
-			case VALID:
-				assert(!timer_running(&reg->timer));
-				s = t - timer_stopped(&reg->timer);
-				if (0 < s && s < RSP_TIMEOUT_US)
-					continue;
-				reg->state = INVALID;
-				break;
+	int64_t last = t / WHEEL_TICK_US;
+	int64_t tk = bus->wheel_tick;
+
+	// If the clock went back, expire everything.
+	if (t < bus->last_us)
+		tk = last - WHEEL_SLOTS + 1;
+	if (tk < last - WHEEL_SLOTS + 1)
+		tk = last - WHEEL_SLOTS + 1;
+
+	for (; tk <= last; ++tk) {
+		Register* reg = bus->wheel[tk % WHEEL_SLOTS];
+		while (reg) {
+			Register* next = reg->wnext;
+			if (reg->due_us <= t || t < bus->last_us) {
+				if (reg->state == PENDING)
+					++r;
+				set_state(bus, reg, INVALID, t);
 			}
+			reg = next;
 		}
+	}
+
+	// The current slot may have registers due later in this tick.
+	bus->wheel_tick = last;
+	bus->last_us = t;
 	return r;
 }
 
@@ -134,30 +294,15 @@ Device* bus_open_device(Bus* bus, uint32_t serial) {
 		if (dev->serial == serial)
 			return dev;
 	dev = malloc(sizeof(*dev));
+	memset(dev, 0, sizeof *dev);
 	dev->serial = serial;
-	dev->registers = NULL;
 	dev->bus = bus;
+	grow(dev);
 	dev->next = bus->devices;
 	bus->devices = dev;
 	return dev;
 }
 
-static Register* find_reg(Device* dev, uint32_t regidx) {
-	Register* reg;
-	for (reg = dev->registers; reg; reg = reg->next) {
-		if (reg->reg == regidx)
-			return reg;
-	}
-
-	reg = malloc(sizeof(*reg));
-	memset(reg, 0, sizeof *reg);
-	reg->reg = regidx;
-	reg->state = INVALID;
-	reg->next = dev->registers;
-	dev->registers = reg;
-	return reg;
-}
-
 int device_get_register(Device* dev, uint32_t regidx, uint32_t* val) {
 	Register* reg = find_reg(dev, regidx);
 	int64_t now;
@@ -169,10 +314,12 @@ int device_get_register(Device* dev, uint32_t regidx, uint32_t* val) {
 
 	if (reg->state == INVALID) {
 		now = now_us();
-		timer_tick(&reg->timer, now, 1);
-		reg->state = PENDING;
+		set_state(dev->bus, reg, PENDING, now);
+		dev->bus->requests++;
 		int n;
-		if (dev->bus->timestamp)
+		if (dev->bus->client)
+			send_frame(dev, reg, '?', 0, now);
+		else if (dev->bus->timestamp)
 			n = fprintf(dev->bus->ctl, EBUS_GET_T_OFMT(dev->serial, regidx, now));
 		else
 			n = fprintf(dev->bus->ctl, EBUS_GET_OFMT(dev->serial, regidx));
@@ -195,14 +342,13 @@ int device_set_register(Device* dev, uint32_t regidx, uint32_t val) {
 	// we were invalid, or pending or valid with a differend val
 
 	const int64_t now = now_us();
-	if (reg->state == PENDING)
-		timer_tick(&reg->timer, now, 0);
-
-	timer_tick(&reg->timer, now, 1);
-	reg->state = PENDING;
+	set_state(dev->bus, reg, PENDING, now);
+	dev->bus->requests++;
 	reg->value = val;
 	int n;
-	if (dev->bus->timestamp)
+	if (dev->bus->client)
+		send_frame(dev, reg, ':', val, now);
+	else if (dev->bus->timestamp)
 		n = fprintf(dev->bus->ctl, EBUS_SET_T_OFMT(dev->serial, regidx, val, now));
 	else
 		n = fprintf(dev->bus->ctl, EBUS_SET_OFMT(dev->serial, regidx, val));
@@ -213,23 +359,21 @@ int device_set_register(Device* dev, uint32_t regidx, uint32_t val) {
 }
 
 void device_invalidate_register(Device* dev, uint32_t regidx) {
-	Register* reg;
-	const int64_t now = now_us();
-	for (reg = dev->registers; reg; reg = reg->next)
-		if (reg->reg == regidx) {
-			if (reg->state == PENDING)
-				timer_tick(&reg->timer, now, 0);
-			reg->state = INVALID;
-			break;
-		}
+	Register* reg = lookup_reg(dev, regidx);
+	if (reg)
+		set_state(dev->bus, reg, INVALID, now_us());
 }
 
 void device_invalidate_all(Device* dev) {
-	Register* reg;
 	const int64_t now = now_us();
-	for (reg = dev->registers; reg; reg = reg->next) {
-		if (reg->state == PENDING)
-			timer_tick(&reg->timer, now, 0);
-		reg->state = INVALID;
-	}
+	uint32_t i;
+	for (i = 0; i < dev->size; ++i)
+		if (dev->registers[i].used)
+			set_state(dev->bus, &dev->registers[i], INVALID, now);
+}
+
+int device_register_stats(Device* dev, uint32_t regidx, struct TimerStats* stats) {
+	Register* reg = lookup_reg(dev, regidx);
+	if (!reg || !reg->timer) return -1;
+	return timer_stats(reg->timer, stats);
 }
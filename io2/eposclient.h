@@ -13,6 +13,7 @@
 // requests on the bus' backing FILE*. (connected to an ebus).
 typedef struct Bus Bus;
 typedef struct Device Device;
+struct TimerStats;
 
 // Instantiate and connect a new bus.  ctl will be used to issue commands.
 Bus* bus_new(FILE* ctl);
@@ -20,6 +21,15 @@ Bus* bus_new(FILE* ctl);
 // set or clear the add-timestamps-to-generated-messages flag.
 void bus_enable_timestamp(Bus* bus, int on);
 
+// Use the binary framing of ebus.h with the given client character
+// instead of text, 0 to go back to text.  The caller should $subscribe
+// to its responses, EBUS_BIN_RSP followed by client.
+void bus_enable_binary(Bus* bus, char client);
+
+// set or clear the keep-latency-statistics flag, see device_register_stats.
+// Off by default, it costs a struct Timer per register.
+void bus_enable_stats(Bus* bus, int on);
+
 // parse and dispatch a received line to devices.
 // returns 0 if no register updated, or the time difference in uS since the command was issued.
 // If the received message was a response to someone elses request, a fake time difference of 1 uS is reported.
@@ -28,8 +38,12 @@ int64_t bus_receive(Bus* bus, char* line);
 // Timeout variables to the INVALID state that have been PENDING for more than 1 second
 // and clear cached VALID values that are older than 5 seconds.
 // Returns the number of pending requests timed out.
+// The cost is in the number of expired registers, not the number of registers.
 int bus_expire(Bus* bus);
 
+// Number of requests sent on the bus so far.
+int64_t bus_requests(Bus* bus);
+
 // Connect a new device with serial number @serial to the bus. repeated opens are idempotent.
 Device* bus_open_device(Bus* bus, uint32_t serial);
 
@@ -49,4 +63,8 @@ int  device_set_register(Device* dev, uint32_t reg, uint32_t val);
 void device_invalidate_register(Device* dev, uint32_t reg);
 void device_invalidate_all(Device* dev);
 
+// Latency statistics of a register, only kept with bus_enable_stats.
+// Returns like timer_stats(), or -1 if there are no statistics.
+int device_register_stats(Device* dev, uint32_t reg, struct TimerStats* stats);
+
 #endif //_IO_RUDDERD2_EPOSCLIENT_H
@@ -0,0 +1,99 @@
+#include "eposclient.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ebus.h"
+#include "lib/timer.h"
+
+int main(int argc, char* argv[]) {
+	FILE* ctl = tmpfile();
+	assert(ctl);
+	Bus* bus = bus_new(ctl);
+	Device* dev = bus_open_device(bus, 0x1234);
+	assert(bus_open_device(bus, 0x1234) == dev);
+
+	char line[1024];
+	uint32_t val = 0;
+	int i;
+
+	// More registers than fit in the initial table, half of them
+	// answered, half pending.
+	for (i = 0; i < 100; ++i)
+		assert(!device_get_register(dev, REGISTER(0x2000 + i, i % 3), &val));
+	for (i = 0; i < 100; i += 2) {
+		snprintf(line, sizeof line, EBUS_ACK_OFMT(0x1234, REGISTER(0x2000 + i, i % 3), i));
+		assert(bus_receive(bus, line) >= 2);
+	}
+	// Not ours.
+	snprintf(line, sizeof line, EBUS_ACK_OFMT(0x4321, REGISTER(0x2000, 0), 1));
+	assert(bus_receive(bus, line) == 0);
+
+	for (i = 0; i < 100; i += 2) {
+		assert(device_get_register(dev, REGISTER(0x2000 + i, i % 3), &val));
+		assert(val == i);
+	}
+	assert(!device_get_register(dev, REGISTER(0x2001, 1), &val));
+
+	// A set with the cached value needs no request.
+	assert(device_set_register(dev, REGISTER(0x2002, 2), 2));
+	assert(!device_set_register(dev, REGISTER(0x2002, 2), 3));
+	assert(!device_get_register(dev, REGISTER(0x2002, 2), &val));
+
+	assert(bus_expire(bus) == 0);
+	device_invalidate_register(dev, REGISTER(0x2000, 0));
+	assert(!device_get_register(dev, REGISTER(0x2000, 0), &val));
+
+	// The 50 pending gets, the pending set and the reissued get time out.
+	usleep(1200*1000);
+	assert(bus_expire(bus) == 52);
+	assert(bus_expire(bus) == 0);
+	assert(device_get_register(dev, REGISTER(0x2004, 1), &val));
+
+	// Without stats there are none.
+	struct TimerStats stats;
+	assert(device_register_stats(dev, REGISTER(0x2004, 1), &stats) == -1);
+	bus_enable_stats(bus, 1);
+	device_invalidate_all(dev);
+	assert(!device_get_register(dev, REGISTER(0x2004, 1), &val));
+	snprintf(line, sizeof line, EBUS_ACK_OFMT(0x1234, REGISTER(0x2004, 1), 5));
+	assert(bus_receive(bus, line) >= 2);
+	assert(device_register_stats(dev, REGISTER(0x2004, 1), &stats) == 1);
+	assert(stats.count == 1);
+
+	// Binary framing, responses are matched by id.
+	FILE* bctl = tmpfile();
+	Bus* bbus = bus_new(bctl);
+	bus_enable_binary(bbus, 'R');
+	Device* bdev = bus_open_device(bbus, 0x1234);
+	assert(!device_set_register(bdev, REGISTER(0x607a, 0), 10));
+	assert(!device_set_register(bdev, REGISTER(0x607a, 0), 20));
+	rewind(bctl);
+	struct EbusFrame f;
+	assert(fgets(line, sizeof line, bctl) && ebus_bin_decode(line, &f));
+	assert(f.client == 'R' && f.op == ':' && f.value == 10);
+	uint16_t first = f.id;
+	assert(fgets(line, sizeof line, bctl) && ebus_bin_decode(line, &f));
+	assert(f.value == 20 && f.id != first);
+
+	// The ack of the first set, someone else's and a text one don't count.
+	struct EbusFrame ack = { 'R', '=', first, 0x1234, REGISTER(0x607a, 0), 10, 0 };
+	ebus_bin_encode(line, &ack);
+	assert(bus_receive(bbus, line) == 0);
+	ack.client = 'L';
+	ack.id = f.id;
+	ebus_bin_encode(line, &ack);
+	assert(bus_receive(bbus, line) == 0);
+	assert(!device_set_register(bdev, REGISTER(0x607a, 0), 20));
+
+	ack.client = 'R';
+	ack.value = 20;
+	ebus_bin_encode(line, &ack);
+	assert(bus_receive(bbus, line) >= 2);
+	assert(device_set_register(bdev, REGISTER(0x607a, 0), 20));
+
+	puts("OK");
+	return 0;
+}
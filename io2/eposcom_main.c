@@ -4,6 +4,12 @@
 //
 //  Commandline tool to read/write EPOS registers over RS232.
 //
+//  Requests are text or binary frames (see ebus.h), the reply is in kind.
+//  With -P the drive positions are streamed as status_left/right/sail:
+//  messages, see pdo_setup(). Writes that are ready go before the polls.
+//  Requests are not executed in the order of arrival, see eposq.h.
+//  Failed requests are retried while the other nodes go ahead.
+//
 
 #include <ctype.h>
 #include <errno.h>
@@ -13,11 +19,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <libgen.h>
+#include <sys/select.h>
 #include <sys/time.h>
+#include <math.h>
 #include <unistd.h>
 
+#include "actuator.h"
 #include "com.h"
+#include "eposq.h"
 #include "seq.h"
+#include "proto/rudder.h"
+#include "lib/linebuffer.h"
 #include "lib/log.h"
 #include "lib/timer.h"
 #include "ebus.h"
@@ -27,7 +39,7 @@ static const char* argv0;
 static int debug=0;
 
 static void usage(void) {
-        fprintf(stderr, "usage: echo nodeid index subindex [:= value] | %s [-r] [-T] [-t timeout] /path/to/port\n", argv0);
+        fprintf(stderr, "usage: echo nodeid index subindex [:= value] | %s [-r] [-T] [-t timeout] [-P hz] [-L logfile] /path/to/port\n", argv0);
         exit(1);
 }
 
@@ -38,34 +50,176 @@ static void usage(void) {
 		(s).pmin/1000, (s).pavg/1000, (s).pdev/1000, (s).pmax/1000, \
 		(s).rmin/1000, (s).ravg/1000, (s).rdev/1000, (s).rmax/1000
 
+// The same for the latency per request class, from arrival to reply.
+#define LATENCY_OFMT(name, s)		\
+	"class: %s count:%lld   f(Hz): %.3lf  latency(ms): %.3lf / %.3lf (±%.3lf) / %.3lf", \
+		name, (s).count, (s).f,				\
+		(s).rmin/1000, (s).ravg/1000, (s).rdev/1000, (s).rmax/1000
+
 #define nelem(x) (sizeof(x)/sizeof(x[0]))
 
 // Map serial numbers to nodeids.  We don't probe beyond number 9.
-static uint32_t nodeidmap[] = {
+static uint32_t nodeidmap[EPOSQ_MAXNODES] = {
 	-1, -1, -1, -1,
 	-1, -1, -1, -1,
-	-1, -1, /* -1, -1,
-        -1, -1, -1, -1, */
+	-1, -1,
 };
 
 static struct Timer timer[nelem(nodeidmap)];
 
+// Relative deadlines per request class.  The rudder targets are the
+// reason to schedule at all.
+enum {
+	TARGPOS_DEADLINE_US =  20*1000,
+	SET_DEADLINE_US     = 100*1000,
+	GET_DEADLINE_US     = 200*1000,
+};
+
+// Retry backoff, 10ms << tries, GETs are retried until the -t timeout.
+enum { SET_TRIES = 3, BACKOFF_US = 10*1000, MAX_GET_BACKOFF_US = 50*1000 };
+
+static const char* classname[EPOSQ_NCLASS] = { "targpos", "set", "get" };
+static struct Timer latency[EPOSQ_NCLASS];
+
+static struct EposSched sched;
+
+// Position streaming.  The RS232 link only answers requests, so the
+// drives can't push PDOs to us.  Instead TxPDO1 is mapped to the status
+// word and the actual position and transmitted on a remote request:
+// one RequestCANFrame transaction per drive instead of two SDO reads.
+enum {
+	COBID_TXPDO1 = 0x180,
+	PDO_RTR_ONLY = 253,	// asynchronous, on remote request only
+	PDO_LEN = 6,
+	MAX_PDO_HZ = 50,	// per drive, each poll takes the link for a few ms
+};
+
+static int pdo_ok[nelem(nodeidmap)];
+
+static uint32_t
+pdo_setup(int fd, int nodeid)
+{
+	struct EposCmd cmds[] = {
+		{ 0x1A00, 0, 0 },		// no mapping while we change it
+		{ 0x1A00, 1, 0x60410010 },	// status word, 16 bits
+		{ 0x1A00, 2, 0x60640020 },	// position actual value, 32 bits
+		{ 0x1A00, 0, 2 },
+		{ 0x1800, 2, PDO_RTR_ONLY },
+		{ 0x1800, 1, COBID_TXPDO1 + nodeid },
+		{ 0, 0, 0 },
+	};
+	struct EposCmd* cmd = cmds;
+	uint32_t err = epos_sequence(fd, nodeid, &cmd);
+	if (err) return err;
+	// PDOs only work in the operational state.
+	return epos_sendnmtservice(fd, nodeid, EPOS_NMT_CMD_STARTREMOTENODE);
+}
+
+// Print the drive status like drivests does from the register reads.
+static void
+pdo_publish(uint32_t serial, uint32_t status, int32_t pos, int64_t now)
+{
+	struct RudderProto sts = INIT_RUDDERPROTO;
+	sts.timestamp_ms = now / 1000;
+	if (serial == motor_params[LEFT].serial_number) {
+		if (status & STATUS_HOMEREF)
+			sts.rudder_l_deg = qc_to_angle(&motor_params[LEFT], pos);
+		printf(OFMT_STATUS_LEFT(sts));
+	} else if (serial == motor_params[RIGHT].serial_number) {
+		if (status & STATUS_HOMEREF)
+			sts.rudder_r_deg = qc_to_angle(&motor_params[RIGHT], pos);
+		printf(OFMT_STATUS_RIGHT(sts));
+	} else if (serial == motor_params[SAIL].serial_number) {
+		sts.sail_deg = qc_to_angle(&motor_params[SAIL], pos);
+		while (sts.sail_deg < -180.0) sts.sail_deg += 360.0;
+		while (sts.sail_deg >  180.0) sts.sail_deg -= 360.0;
+		printf(OFMT_STATUS_SAIL(sts));
+	}
+}
+
+static int
+is_drive(uint32_t serial)
+{
+	return serial == motor_params[LEFT].serial_number ||
+		serial == motor_params[RIGHT].serial_number ||
+		serial == motor_params[SAIL].serial_number;
+}
+
 static int sigflg = 0;
 static void setflg(int sig) { sigflg = sig; }
 
+static void
+reply(const struct EposReq* req, uint32_t serial, uint32_t err, int32_t value, int64_t now, int dotimestamps)
+{
+	if (req->client) {
+		struct EbusFrame f = { req->client, err ? '#' : '=', req->id, serial, req->reg,
+				       err ? (int32_t)err : value, dotimestamps ? now : 0 };
+		char buf[EBUS_BIN_MAXLEN];
+		ebus_bin_encode(buf, &f);
+		fputs(buf, stdout);
+	} else if (err) {
+		if(dotimestamps)
+			printf(EBUS_ERR_T_OFMT(serial, req->reg, err, now));
+		else
+			printf(EBUS_ERR_OFMT(serial, req->reg, err));
+	} else {
+		if(dotimestamps)
+			printf(EBUS_ACK_T_OFMT(serial, req->reg, value, now));
+		else
+			printf(EBUS_ACK_OFMT(serial, req->reg, value));
+	}
+}
+
+static void
+printstats(void)
+{
+	int nodeid, cls;
+	for(nodeid = 1; nodeid < nelem(nodeidmap); ++nodeid) {
+		if (nodeidmap[nodeid] == -1) continue;
+		struct TimerStats stats;
+		if(timer_stats(&timer[nodeid], &stats))
+			slog(LOG_INFO, "serial 0x%x count:%lld", nodeidmap[nodeid], stats.count);
+		else
+			slog(LOG_INFO, TIMER_OFMT(nodeidmap[nodeid], stats));
+	}
+	for(cls = 0; cls < EPOSQ_NCLASS; ++cls) {
+		struct TimerStats stats;
+		if(timer_stats(&latency[cls], &stats))
+			slog(LOG_INFO, "class: %s count:%lld", classname[cls], stats.count);
+		else
+			slog(LOG_INFO, LATENCY_OFMT(classname[cls], stats));
+	}
+	slog(LOG_INFO, "queued:%d coalesced:%lld superseded:%lld dropped:%lld",
+	     eposq_len(&sched), sched.coalesced, sched.superseded, sched.dropped);
+}
+
 int main(int argc, char* argv[]) {
 	int ch;
 	int raw = 0;
 	int dotimestamps = 0;
 	int timeout_ms = 1000;
+	int64_t pdo_period_us = 0;
+	const char* logfile = NULL;
 	argv0 = argv[0];
 
-	 while ((ch = getopt(argc, argv,"dhrTt:")) != -1){
+	 while ((ch = getopt(argc, argv,"dhrTt:P:L:")) != -1){
 		 switch (ch) {
 		 case 'd': ++debug; break;
 		 case 'r': ++raw; break;
 		 case 'T': ++dotimestamps; break;
 		 case 't': timeout_ms = atoi(optarg); break;
+		 case 'P': {
+			 char* end;
+			 long hz = strtol(optarg, &end, 10);
+			 if (end == optarg || *end || hz <= 0) usage();
+			 if (hz > MAX_PDO_HZ) {
+				 fprintf(stderr, "%s: -P %ld capped at %d Hz\n", argv0, hz, MAX_PDO_HZ);
+				 hz = MAX_PDO_HZ;
+			 }
+			 pdo_period_us = 1000*1000 / hz;
+			 break;
+		 }
+		 case 'L': logfile = optarg; break;
 		 default:
 			 usage();
 		 }
@@ -78,6 +232,8 @@ int main(int argc, char* argv[]) {
 
 	 openlog(argv0, debug?LOG_PERROR:0, LOG_LOCAL2);
 	 //if(!debug) setlogmask(LOG_UPTO(LOG_NOTICE));
+	 if (logfile && slog_binary(logfile) < 0) crash("opening %s", logfile);
+	 slog_flush();  // from now on only when idle
 
 	if(setvbuf(stdout, NULL, _IOLBF, 0))
 		 syslog(LOG_WARNING, "Failed to make stdout line-buffered.");
@@ -106,91 +262,168 @@ int main(int argc, char* argv[]) {
 		 printf("$subscribe 0x%x\n", nodeidmap[nodeid]);
 		 ++found;
 	 }
+	 printf("$subscribe %c\n", EBUS_BIN_REQ);  // binary requests for all nodes
 
 	 printf("$xon\n");  // prevent garbage from piling up before we're done probing.
 
 	 if(!found)
 		 crash("No epos devices found");
 
-	 while (!feof(stdin)) {
+	 for (nodeid = 1; pdo_period_us && nodeid < nelem(nodeidmap); ++nodeid) {
+		 if (nodeidmap[nodeid] == -1 || !is_drive(nodeidmap[nodeid])) continue;
+		 uint32_t err = pdo_setup(fd, nodeid);
+		 if (err)
+			 slog(LOG_WARNING, "serial:0x%x no position streaming: %s", nodeidmap[nodeid], epos_strerror(err));
+		 else
+			 pdo_ok[nodeid] = 1;
+	 }
+	 int64_t pdo_due_us = now_us();
+	 int pdo_node = 0;  // next to poll in this period
+
+	 eposq_init(&sched, TARGPOS_DEADLINE_US, SET_DEADLINE_US, GET_DEADLINE_US);
+
+	 struct LineBuffer lbuf;
+	 memset(&lbuf, 0, sizeof lbuf);
+
+	 sigset_t empty_mask;
+	 sigemptyset(&empty_mask);
+
+	 int64_t wait_us = -1;
+	 int eof = 0;
+
+	 while (!eof || eposq_len(&sched)) {
 
 		 if(sigflg) {
 			 sigflg = 0;
+			 printstats();
+		 }
 
-			 for(nodeid = 1; nodeid < nelem(nodeidmap); ++nodeid) {
-				 if (nodeidmap[nodeid] == -1) continue;
-				 struct TimerStats stats;
-				 if(timer_stats(&timer[nodeid], &stats))
-					 slog(LOG_INFO, "serial 0x%x count:%lld", nodeidmap[nodeid], stats.count);
-				 else
-					 slog(LOG_INFO, TIMER_OFMT(nodeidmap[nodeid], stats));
-			 }
+		 // Wait for input only if nothing is ready to go to the bus.
+		 fd_set rfds;
+		 FD_ZERO(&rfds);
+		 if (!eof) FD_SET(fileno(stdin), &rfds);
+		 struct timespec timeout = { wait_us / 1000000, (wait_us % 1000000) * 1000 };
+
+		 // Write the log only if we would wait anyway.
+		 fd_set rfds_idle = rfds;
+		 struct timespec nowait = { 0, 0 };
+		 int r = pselect(fileno(stdin) + 1, &rfds, NULL, NULL, &nowait, &empty_mask);
+		 if (r == 0 && wait_us != 0) {
+			 slog_flush();
+			 rfds = rfds_idle;
+			 r = pselect(fileno(stdin) + 1, &rfds, NULL, NULL, (wait_us < 0) ? NULL : &timeout, &empty_mask);
+		 }
+		 if (r == -1 && errno != EINTR) crash("pselect");
+
+		 if (r == 1) {
+			 r = lb_readfd(&lbuf, fileno(stdin));
+			 if (r == EOF) eof = 1;
+			 else if (r != 0 && r != EAGAIN) crash("reading stdin");
 		 }
 
+		 int64_t now = now_us();
+
 		 char line[1024];
-		 if (!fgets(line, sizeof(line), stdin))
-			 crash("reading stdin");
+		 while (lb_getline(line, sizeof line, &lbuf) > 0) {
+			 struct EbusFrame f;
+			 memset(&f, 0, sizeof f);
+			 if(!ebus_bin_decode(line, &f) &&
+			    !ebus_parse_req(line, &f.op, &f.serial, &f.reg, &f.value, &f.us)) {
+				 slog(LOG_DEBUG, "unparseable line:\"%s\"", line);
+				 continue;
+			 }
+			 if (f.op != '?' && f.op != ':')  // a binary response from another eposcom
+				 continue;
+
+			 for(nodeid = 1; nodeid < nelem(nodeidmap); ++nodeid)
+				 if (nodeidmap[nodeid] == f.serial)
+					 break;
+			 if (nodeid == nelem(nodeidmap))  // not for us
+				 continue;
+
+			 if (eposq_add(&sched, nodeid, f.op, f.reg, f.value, f.client, f.id, now) < 0) {
+				 slog(LOG_WARNING, "queue full for serial:0x%x\n", f.serial);
+				 struct EposReq dropped;
+				 memset(&dropped, 0, sizeof dropped);
+				 dropped.reg = f.reg;
+				 dropped.client = f.client;
+				 dropped.id = f.id;
+				 reply(&dropped, f.serial, EPOS_ERR_TIMEOUT, 0, now, dotimestamps);
+			 }
+		 }
 
-		 uint32_t serial = 0;
-		 uint32_t regidx = 0;
-		 char op 	 = 0;
-		 int32_t value   = 0;
-		 uint64_t us     = 0;
+		 // One position poll per iteration, the drives in turn, unless a
+		 // write is ready: a rudder target must not wait for the polls.
+		 if (pdo_period_us && now >= pdo_due_us && !eposq_set_ready(&sched, now)) {
+			 while (++pdo_node < nelem(nodeidmap) && !pdo_ok[pdo_node])
+				 ;
+			 if (pdo_node == nelem(nodeidmap)) {
+				 pdo_node = 0;
+				 pdo_due_us += pdo_period_us;
+				 if (pdo_due_us < now) pdo_due_us = now + pdo_period_us;  // fell behind
+			 } else {
+				 uint8_t data[8];
+				 timer_tick(&timer[pdo_node], now, TIMER_START);
+				 uint32_t err = epos_requestcanframe(fd, COBID_TXPDO1 + pdo_node, PDO_LEN, data);
+				 now = now_us();
+				 timer_tick(&timer[pdo_node], now, TIMER_STOP);
+				 if (err)
+					 slog(LOG_DEBUG, "serial:0x%x position request: %s", nodeidmap[pdo_node], epos_strerror(err));
+				 else
+					 pdo_publish(nodeidmap[pdo_node], data[0] | data[1] << 8,
+						     data[2] | data[3] << 8 | data[4] << 16 | (uint32_t)data[5] << 24, now);
+			 }
+			 wait_us = 0;
+			 continue;
+		 }
 
-		 if(!ebus_parse_req(line, &op, &serial, &regidx, &value, &us)) {
-			 slog(LOG_DEBUG, "unparseable line:\"%s\"", line);
+		 struct EposReq req;
+		 nodeid = eposq_next(&sched, now, &req, &wait_us);
+		 if (nodeid == 0) {
+			 if (eof && wait_us < 0) break;
+			 if (pdo_period_us && !eof && (wait_us < 0 || wait_us > pdo_due_us - now))
+				 wait_us = pdo_due_us - now;
 			 continue;
 		 }
+		 wait_us = 0;  // poll stdin and see if there is more
 
-		 int index       = INDEX(regidx);
-		 int subindex    = SUBINDEX(regidx);
+		 uint32_t serial = nodeidmap[nodeid];
+		 int index       = INDEX(req.reg);
+		 int subindex    = SUBINDEX(req.reg);
+		 int32_t value   = req.value;
+		 uint32_t err;
 
-		 for(nodeid = 1; nodeid < nelem(nodeidmap); ++nodeid)
-			 if (nodeidmap[nodeid] == serial)
-				 break;
-		 if (nodeid == nelem(nodeidmap))  // not for us
-			 continue;
+		 timer_tick(&timer[nodeid], now, TIMER_START);
+
+		 if (req.op == ':')
+			 err = epos_writeobject(fd, index, subindex, nodeid, value);
+		 else
+			 err = epos_readobject(fd, index, subindex, nodeid, (uint32_t*)&value);
 
-		 uint32_t err;		 
-		 timer_tick_now(&timer[nodeid], 1);
+		 now = now_us();
+		 if (timer_tick(&timer[nodeid], now, TIMER_STOP) > 100*1000) // 100ms should be enough
+			 slog(LOG_WARNING, "slow epos response on serial:0x%x\n", serial);
 
-		 switch(op) {
-		 case ':':  // a set request
-			 if (raw) {
-				 err = epos_writeobject(fd, index, subindex, nodeid, value);
+		 if (err && !raw) {
+			 int64_t backoff = (int64_t)BACKOFF_US << req.tries;
+			 int retry;
+			 if (req.op == ':') {
+				 retry = req.tries + 1 < SET_TRIES;
 			 } else {
-				 struct EposCmd cmds[] = {
-					 { index, subindex, value },
-					 { 0, 0, 0 },
-				 };
-				 struct EposCmd* cmd = cmds;
-				 err = epos_sequence(fd, nodeid, &cmd);
+				 if (backoff > MAX_GET_BACKOFF_US) backoff = MAX_GET_BACKOFF_US;
+				 retry = now + backoff < req.arrival_us + timeout_ms * 1000LL;
+			 }
+			 req.tries++;
+			 if (retry && eposq_retry(&sched, nodeid, &req, now + backoff) == 0) {
+				 if (debug) slog(LOG_DEBUG, "retry %d serial:0x%x %s", req.tries, serial, epos_strerror(err));
+				 continue;
 			 }
-			 break;
-		 case '?': // a get request
-			 if (raw)
-				 err = epos_readobject(fd, index, subindex, nodeid, (uint32_t*)&value);
-			 else
-				 err = epos_waitobject(fd, timeout_ms, index, subindex, nodeid, 0, (uint32_t*)&value);
-			 break;
 		 }
-		    
-		 int64_t now = now_us();
-		 if (timer_tick(&timer[nodeid], now, 0) > 100*1000) // 100ms should be enough
-			 slog(LOG_WARNING, "slow epos response on serial:0x%x\n", serial);
 
-		 if (err) { 
-			 if(dotimestamps)
-				 printf(EBUS_ERR_T_OFMT(serial, regidx, err, now));
-			 else
-				 printf(EBUS_ERR_OFMT(serial, regidx, err));
-		 } else {
-			 if(dotimestamps)
-				 printf(EBUS_ACK_T_OFMT(serial, regidx, value, now));
-			 else
-				 printf(EBUS_ACK_OFMT(serial, regidx, value));
+		 timer_tick(&latency[req.cls], req.arrival_us, TIMER_START);
+		 timer_tick(&latency[req.cls], now, TIMER_STOP);
 
-		 }
+		 reply(&req, serial, err, value, now, dotimestamps);
 	 }
 
 	 crash("main loop exit");
@@ -0,0 +1,154 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+#include "eposq.h"
+
+#include <string.h>
+
+#include "actuator.h"
+
+void
+eposq_init(struct EposSched* s, int64_t targpos_us, int64_t set_us, int64_t get_us)
+{
+	memset(s, 0, sizeof *s);
+	s->deadline_us[EPOSQ_TARGPOS] = targpos_us;
+	s->deadline_us[EPOSQ_SET] = set_us;
+	s->deadline_us[EPOSQ_GET] = get_us;
+}
+
+int
+eposq_class(char op, uint32_t reg)
+{
+	if (op == '?') return EPOSQ_GET;
+	if (reg == REG_TARGPOS) return EPOSQ_TARGPOS;
+	return EPOSQ_SET;
+}
+
+int
+eposq_add(struct EposSched* s, int nodeid, char op, uint32_t reg, int32_t value,
+	  char client, uint16_t id, int64_t now_us)
+{
+	struct EposQueue* q = &s->node[nodeid];
+	int cls = eposq_class(op, reg);
+	int i;
+	for (i = q->n - 1; i >= 0; i--) {
+		struct EposReq* r = &q->req[i];
+		// A GET queued before a SET of the register would read the old value.
+		if (op == '?' && r->op == ':' && r->reg == reg) break;
+		if (r->op != op || r->reg != reg || r->client != client) continue;
+		if (op == '?') {
+			r->id = id;
+			s->coalesced++;
+			return 1;
+		}
+		if (cls == EPOSQ_TARGPOS) {
+			r->value = value;  // keeps its place and deadline
+			r->id = id;
+			s->superseded++;
+			return 1;
+		}
+	}
+
+	if (q->n == EPOSQ_LEN) {
+		s->dropped++;
+		return -1;
+	}
+
+	struct EposReq* r = &q->req[q->n++];
+	memset(r, 0, sizeof *r);
+	r->op = op;
+	r->reg = reg;
+	r->value = value;
+	r->cls = cls;
+	r->arrival_us = now_us;
+	r->deadline_us = now_us + s->deadline_us[cls];
+	r->seq = s->seq++;
+	r->client = client;
+	r->id = id;
+	return 0;
+}
+
+int
+eposq_retry(struct EposSched* s, int nodeid, const struct EposReq* r, int64_t notbefore_us)
+{
+	struct EposQueue* q = &s->node[nodeid];
+	if (q->n == EPOSQ_LEN) {
+		s->dropped++;
+		return -1;
+	}
+	memmove(q->req + 1, q->req, q->n * sizeof q->req[0]);
+	q->req[0] = *r;
+	q->req[0].notbefore_us = notbefore_us;
+	q->n++;
+	return 0;
+}
+
+// Earlier is better: first the deadline, then the order of arrival.
+static int
+before(const struct EposReq* a, const struct EposReq* b)
+{
+	if (a->deadline_us != b->deadline_us) return a->deadline_us < b->deadline_us;
+	return (int32_t)(a->seq - b->seq) < 0;
+}
+
+int
+eposq_next(struct EposSched* s, int64_t now_us, struct EposReq* r, int64_t* wait_us)
+{
+	int bestnode = 0;
+	int besti = -1;
+	int64_t wait = -1;
+	int nodeid, i;
+
+	for (nodeid = 0; nodeid < EPOSQ_MAXNODES; nodeid++) {
+		struct EposQueue* q = &s->node[nodeid];
+		// Candidates are the GETs up to and including the first SET.
+		for (i = 0; i < q->n; i++) {
+			struct EposReq* c = &q->req[i];
+			if (c->notbefore_us > now_us) {
+				int64_t w = c->notbefore_us - now_us;
+				if (wait < 0 || w < wait) wait = w;
+			} else if (besti < 0 || before(c, &s->node[bestnode].req[besti])) {
+				bestnode = nodeid;
+				besti = i;
+			}
+			if (c->op == ':') break;
+		}
+	}
+
+	if (besti < 0) {
+		*wait_us = wait;
+		return 0;
+	}
+
+	struct EposQueue* q = &s->node[bestnode];
+	*r = q->req[besti];
+	q->n--;
+	memmove(q->req + besti, q->req + besti + 1, (q->n - besti) * sizeof q->req[0]);
+	*wait_us = 0;
+	return bestnode;
+}
+
+int
+eposq_set_ready(struct EposSched* s, int64_t now_us)
+{
+	int nodeid, i;
+	for (nodeid = 0; nodeid < EPOSQ_MAXNODES; nodeid++) {
+		struct EposQueue* q = &s->node[nodeid];
+		for (i = 0; i < q->n; i++) {
+			if (q->req[i].op != ':') continue;
+			if (q->req[i].notbefore_us <= now_us) return 1;
+			break;
+		}
+	}
+	return 0;
+}
+
+int
+eposq_len(struct EposSched* s)
+{
+	int n = 0, nodeid;
+	for (nodeid = 0; nodeid < EPOSQ_MAXNODES; nodeid++)
+		n += s->node[nodeid].n;
+	return n;
+}
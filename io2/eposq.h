@@ -0,0 +1,88 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Request scheduler for eposcom.
+//
+// The EPOS RS232 protocol is strictly one transaction at a time, so
+// the best we can do is to choose well which request goes next.
+// Requests are kept in a queue per node and the next one is the ready
+// request with the earliest deadline, so a rudder command does not
+// wait behind a sail status poll or a retry on another node.
+//
+// Within a node the order of the SETs is kept, because drives are
+// controlled with sequences of writes, and a GET does not overtake an
+// earlier SET.  SETs may overtake earlier GETs.
+//
+// A GET for a register that is already queued, and not followed by a
+// SET of that register, is coalesced with it, the reply goes to the bus
+// and satisfies both.  A SET of REG_TARGPOS
+// replaces a queued SET of the same register, only the latest target
+// matters.  Binary requests (see ebus.h) are only merged with requests
+// of the same client, which gets the reply with the latest id.
+//
+#ifndef IO_EPOSQ_H
+#define IO_EPOSQ_H
+
+#include <stdint.h>
+
+enum { EPOSQ_MAXNODES = 10, EPOSQ_LEN = 32 };
+
+// Request classes, for the deadline and the statistics.
+enum { EPOSQ_TARGPOS, EPOSQ_SET, EPOSQ_GET, EPOSQ_NCLASS };
+
+struct EposReq {
+	char op;		// ':' set or '?' get
+	uint32_t reg;
+	int32_t value;
+	int cls;
+	int tries;		// failed attempts so far
+	int64_t arrival_us;
+	int64_t deadline_us;	// for the ordering
+	int64_t notbefore_us;	// when retrying
+	uint32_t seq;		// order of arrival
+	char client;		// binary requester, 0 for text
+	uint16_t id;
+};
+
+struct EposQueue {
+	struct EposReq req[EPOSQ_LEN];  // in order of arrival
+	int n;
+};
+
+struct EposSched {
+	struct EposQueue node[EPOSQ_MAXNODES];
+	int64_t deadline_us[EPOSQ_NCLASS];  // relative to arrival
+	uint32_t seq;
+	int64_t coalesced, superseded, dropped;
+};
+
+// Initialize with the relative deadlines per class.
+void eposq_init(struct EposSched* s, int64_t targpos_us, int64_t set_us, int64_t get_us);
+
+// Classify a request.
+int eposq_class(char op, uint32_t reg);
+
+// Queue a request for nodeid, from a binary client with id, or from a
+// text client (client 0).  Returns 0 if it was queued, 1 if it was
+// merged into a queued one, -1 if the queue is full.
+int eposq_add(struct EposSched* s, int nodeid, char op, uint32_t reg, int32_t value,
+	      char client, uint16_t id, int64_t now_us);
+
+// Put a failed request back in front of its node queue, to be retried
+// not before notbefore_us.  Returns -1 if the queue is full.
+int eposq_retry(struct EposSched* s, int nodeid, const struct EposReq* r, int64_t notbefore_us);
+
+// Take the next request to execute.  Returns its nodeid, or 0 if none
+// is ready.  Then *wait_us is the time until the next one becomes ready,
+// or -1 if all queues are empty.
+int eposq_next(struct EposSched* s, int64_t now_us, struct EposReq* r, int64_t* wait_us);
+
+// Whether a SET could go next, i.e. one is ready and not behind another
+// SET of its node.
+int eposq_set_ready(struct EposSched* s, int64_t now_us);
+
+// Number of queued requests.
+int eposq_len(struct EposSched* s);
+
+#endif // IO_EPOSQ_H
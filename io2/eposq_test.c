@@ -0,0 +1,90 @@
+#include "eposq.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "actuator.h"
+
+static struct EposSched s;
+
+int main(int argc, char* argv[]) {
+	struct EposReq r;
+	int64_t wait;
+
+	eposq_init(&s, 50000, 200000, 1000000);
+	assert(eposq_next(&s, 0, &r, &wait) == 0 && wait == -1);
+
+	// GETs of the same register coalesce, TARGPOS SETs supersede.
+	assert(eposq_add(&s, 1, '?', REG_CURRPOS, 0, 0, 0, 0) == 0);
+	assert(eposq_add(&s, 1, '?', REG_CURRPOS, 0, 0, 0, 10) == 1);
+	assert(eposq_add(&s, 1, ':', REG_TARGPOS, 100, 0, 0, 20) == 0);
+	assert(eposq_add(&s, 1, ':', REG_CONTROL, 0x3f, 0, 0, 30) == 0);
+	assert(eposq_add(&s, 1, ':', REG_TARGPOS, 200, 0, 0, 40) == 1);
+	assert(s.coalesced == 1 && s.superseded == 1);
+	assert(eposq_len(&s) == 3);
+
+	// A sail status poll on another node.
+	assert(eposq_add(&s, 2, '?', REG_CURRPOS, 0, 0, 0, 0) == 0);
+
+	// The target position has the earliest deadline and overtakes the GETs.
+	assert(eposq_next(&s, 50, &r, &wait) == 1);
+	assert(r.op == ':' && r.reg == REG_TARGPOS && r.value == 200 && r.arrival_us == 20);
+	// The control word has the next deadline, the GET on node 1 can't
+	// overtake it.
+	assert(eposq_next(&s, 50, &r, &wait) == 1);
+	assert(r.reg == REG_CONTROL);
+	// The GETs by order of arrival.
+	assert(eposq_next(&s, 50, &r, &wait) == 1 && r.op == '?');
+	assert(eposq_next(&s, 50, &r, &wait) == 2 && r.op == '?');
+	assert(eposq_len(&s) == 0);
+	assert(!eposq_set_ready(&s, 50));
+
+	// A GET does not overtake an earlier SET on the same node.
+	assert(eposq_add(&s, 3, ':', REG_CONTROL, 6, 0, 0, 100) == 0);
+	assert(eposq_add(&s, 3, ':', REG_TARGPOS, 1, 0, 0, 200) == 0);
+	assert(eposq_add(&s, 3, '?', REG_STATUS, 0, 0, 0, 300) == 0);
+	assert(eposq_next(&s, 400, &r, &wait) == 3 && r.reg == REG_CONTROL);
+
+	// A retry waits, the other nodes go ahead meanwhile.
+	r.tries++;
+	assert(eposq_set_ready(&s, 400));
+	assert(eposq_retry(&s, 3, &r, 10400) == 0);
+	assert(!eposq_set_ready(&s, 400));  // the TARGPOS waits for the retry
+	assert(eposq_set_ready(&s, 10400));
+	assert(eposq_add(&s, 4, '?', REG_STATUS, 0, 0, 0, 500) == 0);
+	assert(eposq_next(&s, 600, &r, &wait) == 4);
+	assert(eposq_next(&s, 600, &r, &wait) == 0 && wait == 9800);
+	assert(eposq_next(&s, 10400, &r, &wait) == 3 && r.reg == REG_CONTROL && r.tries == 1);
+	assert(eposq_next(&s, 10400, &r, &wait) == 3 && r.reg == REG_TARGPOS);
+	assert(eposq_next(&s, 10400, &r, &wait) == 3 && r.reg == REG_STATUS);
+
+	// A GET after a SET of the same register reads the new value, it is
+	// not coalesced with the GET before the SET.
+	assert(eposq_add(&s, 7, '?', REG_PROFVEL, 0, 0, 0, 0) == 0);
+	assert(eposq_add(&s, 7, ':', REG_PROFVEL, 500, 0, 0, 10) == 0);
+	assert(eposq_add(&s, 7, '?', REG_PROFVEL, 0, 0, 0, 20) == 0);
+	assert(eposq_add(&s, 7, '?', REG_PROFVEL, 0, 0, 0, 30) == 1);
+	assert(eposq_len(&s) == 3);
+	assert(eposq_next(&s, 0, &r, &wait) == 7 && r.op == ':');
+	assert(eposq_next(&s, 0, &r, &wait) == 7 && r.op == '?' && r.arrival_us == 0);
+	assert(eposq_next(&s, 0, &r, &wait) == 7 && r.op == '?' && r.arrival_us == 20);
+
+	// Binary clients are only merged with themselves.
+	assert(eposq_add(&s, 6, '?', REG_STATUS, 0, 'L', 1, 0) == 0);
+	assert(eposq_add(&s, 6, '?', REG_STATUS, 0, 'R', 1, 0) == 0);
+	assert(eposq_add(&s, 6, '?', REG_STATUS, 0, 0, 0, 0) == 0);
+	assert(eposq_add(&s, 6, '?', REG_STATUS, 0, 'L', 2, 0) == 1);
+	assert(eposq_next(&s, 0, &r, &wait) == 6 && r.client == 'L' && r.id == 2);
+	assert(eposq_next(&s, 0, &r, &wait) == 6 && r.client == 'R' && r.id == 1);
+	assert(eposq_next(&s, 0, &r, &wait) == 6 && r.client == 0);
+
+	// Full queues drop.
+	int i;
+	for (i = 0; i < EPOSQ_LEN; i++)
+		assert(eposq_add(&s, 5, ':', REG_CONTROL, i, 0, 0, i) == 0);
+	assert(eposq_add(&s, 5, ':', REG_CONTROL, i, 0, 0, i) == -1);
+	assert(s.dropped == 1);
+
+	puts("OK");
+	return 0;
+}
@@ -6,6 +6,14 @@
 // Default mode and settings are defined in mtcp.h and set
 // by imucfg_main.c.
 //
+// By default every message is printed as a full imu: line.  With -o,
+// several streams with their own name, subset of fields and rate can be
+// printed instead, e.g.
+//   imucat -o imu:all -o imupos:pos:2 /dev/imu
+// gives the helmsman the full rate imu: line and a logger a 2Hz imupos:
+// line.  Only what some stream needs is decoded, and a line is only
+// formatted when its stream is due.
+//
 
 #include <errno.h>
 #include <fcntl.h>
@@ -22,6 +30,7 @@
 
 #include "proto/imu.h"
 #include "mtcp.h"
+#include "mtdata.h"
 #include "lib/log.h"
 #include "lib/timer.h"
 
@@ -40,176 +49,184 @@ usage(void)
 		"\t-g seconds          default 10, use 0 to disable:if no signal for this many seconds, exit.\n"
 		"\t-m output_mode      default 0x....\n"
 		"\t-s output_settings  default 0x....\n"
+		"\t-o name:fields[:hz] print a stream of name: lines with these fields at most hz times\n"
+		"\t                    per second, fields is 'all' or a comma separated list of\n"
+		"\t                    tmp,acc,gyr,mag,ori,pos,vel.  Can be repeated. (default imu:all)\n"
 		"Default mode and settings are defined in mtcp.h\n"
 		, argv0);
 	exit(2);
 }
 
-static float
-decode_float(uint8_t** dd)
-{
-	uint8_t* d = *dd;
-	uint8_t f[4] = { d[3], d[2], d[1], d[0] };
-	if(debug>1) fprintf(stderr, "decode float: %02x %02x %02x %02x  : %lf\n", d[0],d[1],d[2],d[3], *(float*)f);
-	(*dd) += 4;
-	return *(float*) f;
-}
+// TODO(lvd) MOVE THIS TO HELMSMAN OR ELSEWHERE
+// Convert speed components from NED in boat coordinate system.
+void ConvertSpeed(struct IMUProto* vars) {
+	if (isnan(vars->vel_x_m_s) || isnan(vars->vel_y_m_s) || isnan(vars->yaw_deg))
+		return;
 
-// decode an MTData message assuming mode and settings.
-// Returns 0 on success, -1 on error.
-static int
-imu_decode_variables(uint8_t* b, int len, uint16_t mode, uint32_t settings,
-                     struct IMUProto* vars, uint8_t* status)
-{
-	uint8_t *e = b + len;
+	double phi_z = vars->yaw_deg * (M_PI / 180.0);
+	double s = sin(phi_z);
+	double c = cos(phi_z);
 
-#define checklen(x, n)							\
-	if (e - b < n) {  if (debug) fprintf(stderr, "checklen %s\n", #x); return -1; }
+	double v_x =  c * vars->vel_x_m_s + s * vars->vel_y_m_s;
+	double v_y = -s * vars->vel_x_m_s + c * vars->vel_y_m_s;
 
-	if (mode & IMU_OM_TMP) {
-		checklen(IMU_OM_TMP, 4);
-		vars->temp_c = decode_float(&b);
-	}
+	// 0.8 is an empirical cheating factor derived from test results in January 2012.
+	const double cheating_factor = 0.8;
+	vars->vel_x_m_s = cheating_factor * v_x;
+	vars->vel_y_m_s = cheating_factor * v_y;
+}
 
-	if (mode & IMU_OM_CAL) {
-		if (!(settings & IMU_OS_CM_DISACC)) {
-			checklen(IMU_OS_CM_DISACC, 3*4);
-			vars->acc_x_m_s2  = decode_float(&b);
-			vars->acc_y_m_s2  = decode_float(&b);
-			vars->acc_z_m_s2  = decode_float(&b);
-		}
-		if (!(settings & IMU_OS_CM_DISGYR)) {
-			checklen(IMU_OS_CM_DISGYR, 3*4);
-			vars->gyr_x_rad_s = decode_float(&b);
-			vars->gyr_y_rad_s = decode_float(&b);
-			vars->gyr_z_rad_s = decode_float(&b);
-		}
-		if (!(settings & IMU_OS_CM_DISMAG)) {
-			checklen(IMU_OS_CM_DISMAG, 3*4);
-			vars->mag_x_au = decode_float(&b);
-			vars->mag_y_au = decode_float(&b);
-			vars->mag_z_au = decode_float(&b);
-		}
 
-		if (mode & IMU_OM_ORI) {
-			switch (settings & IMU_OS_OR_MASK) {
-			case 0: // quaternions
-				checklen(IMU_OS_OR_MASK, 4*4);
-				b += 4*4;
-				break;
-			case IMU_OS_OR_EULER:
-				checklen(IMU_OS_OR_EULER, 3*4);
-				vars->roll_deg  = decode_float(&b);
-				vars->pitch_deg = decode_float(&b);
-				vars->yaw_deg   = decode_float(&b);
-				break;
-			case IMU_OS_OR_MATRIX:
-				checklen(IMU_OS_OR_MATRIX, 9*4);
-				b += 9*4;
-				break;
-			}
-		}
-	}
+static int alarm_s = 10;
+static void timeout() { crash("No valid imu signal for %d seconds.", alarm_s); }
 
-	if (mode & IMU_OM_AUX) {
-		if (!(settings & IMU_OS_AU_DIS1)) { checklen(IMU_OS_AU_DIS1,2); b += 2; }
-		if (!(settings & IMU_OS_AU_DIS2)) { checklen(IMU_OS_AU_DIS1,2); b += 2; }
-	}
+// -----------------------------------------------------------------------------
+//   Output streams
 
-	if (mode & IMU_OM_POS) {
-		checklen( IMU_OM_POS, 3*4);
-		vars->lat_deg = decode_float(&b);
-		vars->lng_deg = decode_float(&b);
-		vars->alt_m   = decode_float(&b);
-	}
+struct Output {
+	const char* name;
+	int fields;		// MT_ bits
+	int64_t period_ms;	// 0: every message
+	int64_t next_ms;	// CLOCK_MONOTONIC
+};
 
-	if (mode & IMU_OM_VEL) {
-		checklen( IMU_OM_VEL,3*4);
-		vars->vel_x_m_s = decode_float(&b);
-		vars->vel_y_m_s = decode_float(&b);
-		vars->vel_z_m_s = decode_float(&b);
-	}
+enum { MAXOUTPUTS = 8 };
+static struct Output outputs[MAXOUTPUTS];
+static int noutputs = 0;
+
+static const struct { const char* name; int bit; } fieldnames[] = {
+	{ "tmp", MT_TEMP }, { "acc", MT_ACC }, { "gyr", MT_GYR }, { "mag", MT_MAG },
+	{ "ori", MT_EULER }, { "pos", MT_POS }, { "vel", MT_VEL }, { "all", MT_ALL },
+};
 
-	if (mode & IMU_OM_STS) {
-		checklen( IMU_OM_STS, 1);
-		*status = *b++;
+// name:fields[:hz]
+static void
+parse_output(char* arg)
+{
+	if (noutputs == MAXOUTPUTS) crash("Too many outputs");
+	struct Output* o = &outputs[noutputs++];
+	memset(o, 0, sizeof *o);
+
+	char* fields = strchr(arg, ':');
+	if (!fields || fields == arg) usage();
+	*fields++ = 0;
+	o->name = arg;
+
+	char* hz = strchr(fields, ':');
+	if (hz) {
+		*hz++ = 0;
+		double f = atof(hz);
+		if (f < 0) usage();
+		if (f > 0) o->period_ms = 1000.0 / f;
 	}
 
-	uint16_t samplecounter;  // unused
-	if (settings & IMU_OS_TS_SC) {
-		checklen(IMU_OS_TS_SC, 2);
-		samplecounter = b[0];  // big endian
-		samplecounter = (samplecounter<<8) + b[1];
-		b += 2;
+	char* tok;
+	for (tok = strtok(fields, ","); tok; tok = strtok(NULL, ",")) {
+		int i;
+		for (i = 0; i < sizeof fieldnames / sizeof fieldnames[0]; i++)
+			if (!strcmp(tok, fieldnames[i].name)) break;
+		if (i == sizeof fieldnames / sizeof fieldnames[0]) crash("Unknown field group '%s'", tok);
+		o->fields |= fieldnames[i].bit;
 	}
+	if (!o->fields) usage();
+}
 
-	if (settings & IMU_OS_TS_UTC) {
-		checklen( IMU_OS_TS_UTC, 12);
-		if (debug || forcetime || (b[11] & 0x4)) {  // valid utc
-			/*
-			  0 Nanoseconds of second, range 0 .. 1.000.000.000
-			  4 Year, range 1999 .. 2099
-			  6 Month, range 1..12
-			  7 Day of Month, range 1..31
-			  8 Hour of Day, range 0..23
-			  9 Minute of Hour, range 0..59
-			  10 Seconds of Minute, range 0..59
-			  11 0x01 = Valid Time of Week
-			  0x02 = Valid Week Number
-			  0x04 = Valid UTC
-			*/
-
-			struct tm t = {
-				b[10],   // int tm_sec,   seconds
-				b[9],    // int tm_min,   minutes
-				b[8],    // int tm_hour,  hours
-				b[7],    // int tm_mday,  day of the month
-				b[6]-1,  // int tm_mon,   month
-				(b[4]<<8) + b[5] - 1900, // int tm_year, year
-				0,       // int tm_wday,  day of the week
-				0,       // int tm_yday,  day in the year
-				0,       // int tm_isdst, daylight saving time
-			};
-			if (debug)
-				fprintf(stderr, "\ns:%d m:%d h:%d d:%d m:%d y:%d utc:%s",
-					b[10], b[9], b[8], b[7], b[6], (b[4]<<8) + b[5], asctime(&t)+4);
-			int64_t time_s = timegm(&t);
-			int64_t ns = (b[0]<<24) + (b[1]<<16) + (b[2]<<8) + b[3];
-			time_s *= 1000;
-			ns /= 1E6;
-			vars->gps_timestamp_ms = time_s + ns;
-		}
-		b += 12;
+static void
+print_output(const struct Output* o, const struct IMUProto* v)
+{
+	if (o->fields == MT_ALL && !strcmp(o->name, "imu")) {
+		printf(OFMT_IMUPROTO(*v));
+		return;
 	}
 
-	if (debug && e!=b) fprintf(stderr, "bytes left: %d\n", (int)(e-b));
+	// Same keys and formats as OFMT_IMUPROTO, formatted in one go.
+	char line[1024];
+	int n = snprintf(line, sizeof line, "%s: timestamp_ms:%lld gps_timestamp_ms:%lld",
+			 o->name, v->timestamp_ms, v->gps_timestamp_ms);
+	if (o->fields & MT_TEMP)
+		n += snprintf(line + n, sizeof line - n, " temp_c:%.3lf", v->temp_c);
+	if (o->fields & MT_ACC)
+		n += snprintf(line + n, sizeof line - n, " acc_x_m_s2:%.3lf acc_y_m_s2:%.3lf acc_z_m_s2:%.3lf",
+			      v->acc_x_m_s2, v->acc_y_m_s2, v->acc_z_m_s2);
+	if (o->fields & MT_GYR)
+		n += snprintf(line + n, sizeof line - n, " gyr_x_rad_s:%.3lf gyr_y_rad_s:%.3lf gyr_z_rad_s:%.3lf",
+			      v->gyr_x_rad_s, v->gyr_y_rad_s, v->gyr_z_rad_s);
+	if (o->fields & MT_MAG)
+		n += snprintf(line + n, sizeof line - n, " mag_x_au:%.3lf mag_y_au:%.3lf mag_z_au:%.3lf",
+			      v->mag_x_au, v->mag_y_au, v->mag_z_au);
+	if (o->fields & MT_EULER)
+		n += snprintf(line + n, sizeof line - n, " roll_deg:%.3lf pitch_deg:%.3lf yaw_deg:%.3lf",
+			      v->roll_deg, v->pitch_deg, v->yaw_deg);
+	if (o->fields & MT_POS)
+		n += snprintf(line + n, sizeof line - n, " lat_deg:%.7lf lng_deg:%.7lf alt_m:%.3lf",
+			      v->lat_deg, v->lng_deg, v->alt_m);
+	if (o->fields & MT_VEL)
+		n += snprintf(line + n, sizeof line - n, " vel_x_m_s:%.3lf vel_y_m_s:%.3lf vel_z_m_s:%.3lf",
+			      v->vel_x_m_s, v->vel_y_m_s, v->vel_z_m_s);
+	printf("%s mono_timestamp_ms:%lld\n", line, v->mono_timestamp_ms);
+}
 
-	return 0;
+// Returns whether o is due at mono_ms and if so, schedules the next line.
+static int
+output_due(struct Output* o, int64_t mono_ms)
+{
+	if (o->period_ms == 0) return 1;
+	if (mono_ms < o->next_ms) return 0;
+	o->next_ms += o->period_ms;
+	if (o->next_ms <= mono_ms) o->next_ms = mono_ms + o->period_ms;  // fell behind, or first
+	return 1;
 }
 
-// TODO(lvd) MOVE THIS TO HELMSMAN OR ELSEWHERE
-// Convert speed components from NED in boat coordinate system.
-void ConvertSpeed(struct IMUProto* vars) {
-	if (isnan(vars->vel_x_m_s) || isnan(vars->vel_y_m_s) || isnan(vars->yaw_deg))
-		return;
+static void
+handle_mtdata(const struct MTLayout* layout, const uint8_t* buf, int len, uint16_t mode,
+	      int64_t now, int64_t mono)
+{
+	int due[MAXOUTPUTS];
+	int want = 0;
+	int i;
+	for (i = 0; i < noutputs; i++) {
+		due[i] = output_due(&outputs[i], mono);
+		if (due[i]) want |= outputs[i].fields;
+	}
+	if (!want) return;
+	if (want & MT_VEL) want |= MT_EULER;  // to rotate the speed into the boat frame
 
-	double phi_z = vars->yaw_deg * (M_PI / 180.0);
-	double s = sin(phi_z);
-	double c = cos(phi_z);
+	struct IMUProto vars = INIT_IMUPROTO;
+	memset(&vars, 0, sizeof vars);
+	vars.timestamp_ms = now;  // time we got this packet
+	vars.mono_timestamp_ms = mono;
 
-	double v_x =  c * vars->vel_x_m_s + s * vars->vel_y_m_s;
-	double v_y = -s * vars->vel_x_m_s + c * vars->vel_y_m_s;
+	uint8_t status = 0;
+	if (mt_decode(layout, buf, len, want, debug || forcetime, &vars, &status) != 0) {
+		if (debug) fprintf(stderr, "Could not decode MTData, discarding %d bytes\n", len);
+		return;
+	}
+	if (debug && len != layout->len) fprintf(stderr, "bytes left: %d\n", len - layout->len);
 
-	// 0.8 is an empirical cheating factor derived from test results in January 2012.
-	const double cheating_factor = 0.8;
-	vars->vel_x_m_s = cheating_factor * v_x;
-	vars->vel_y_m_s = cheating_factor * v_y;
-}
+	// unless in debug mode, if we have the status byte, clear fields that are not reliable
+	if(!debug && (mode & IMU_OM_STS)) {
+		if (!(status&IMU_STS_XKF)) {
+			vars.roll_deg  = vars.pitch_deg = vars.yaw_deg = NAN;
+			vars.vel_x_m_s = vars.vel_y_m_s = vars.vel_z_m_s = NAN;
+		}
 
+		if (!(status & (IMU_STS_XKF|IMU_STS_GPS))) {
+			vars.lat_deg = vars.lng_deg = vars.alt_m = NAN;
+			vars.gps_timestamp_ms = 0;  // the time is derived from the GPS signal and goes away with that signal.
+		}
+	}
 
-static int alarm_s = 10;
-static void timeout() { crash("No valid imu signal for %d seconds.", alarm_s); }
+	if(debug)
+		fprintf(stderr, "status:0x%x:%s%s%s\n", status,
+			(status&IMU_STS_SELFTEST) ? " selftest" : "",
+			(status&IMU_STS_XKF) ? " XKF" : "",
+			(status&IMU_STS_GPS) ? " GPS" : "");
+
+	ConvertSpeed(&vars);
 
+	for (i = 0; i < noutputs; i++)
+		if (due[i]) print_output(&outputs[i], &vars);
+}
 
 // -----------------------------------------------------------------------------
 
@@ -224,7 +241,7 @@ int main(int argc, char* argv[]) {
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "b:dfg:hm:s:")) != -1){
+	while ((ch = getopt(argc, argv, "b:dfg:hm:o:s:")) != -1){
 		switch (ch) {
 		case 'b': baudrate = atoi(optarg); break;
 		case 'd': ++debug; break;
@@ -234,6 +251,7 @@ int main(int argc, char* argv[]) {
 			mode = strtol(optarg, NULL, 0);
 			if (errno == ERANGE) crash("can't parse %s as a number\n", optarg);
 			break;
+		case 'o': parse_output(optarg); break;
 		case 's':
 			settings = strtoul(optarg, NULL, 0);
 			if (errno == ERANGE) crash("can't parse %s as a number\n", optarg);
@@ -255,6 +273,15 @@ int main(int argc, char* argv[]) {
 
 	if (settings & IMU_OS_FF_MASK) crash("Can't decode non ieee floats");;
 
+	struct MTLayout layout;
+	if (mt_layout(&layout, mode, settings) != 0)
+		crash("Can't decode output settings 0x%x", settings);
+
+	if (noutputs == 0) {
+		static char imu[] = "imu:all";
+		parse_output(imu);
+	}
+
 	openlog(argv0, debug?LOG_PERROR:0, LOG_DAEMON);
 
 	if(setvbuf(stdout, NULL, _IOLBF, 0))
@@ -289,88 +316,45 @@ int main(int argc, char* argv[]) {
 		if (tcsetattr(port, TCSANOW, &t) < 0) crash("tcsetattr(%s)", argv[0]);
 	}
 
-	FILE* imu = fdopen(port, "r");
-
-	int garbage = 0;
-
-	while(!feof(imu)) {
-
-		if (ferror(imu))
-			clearerr(imu);
-
-		if (garbage++ > 500)
-			crash("Read only garbage from imu");
+	struct MTReader reader;
+	memset(&reader, 0, sizeof reader);
+	int64_t errors = 0;   // reader counters at the last valid message
+	int64_t garbage = 0;
+
+	for (;;) {
+		uint8_t buf[512];
+		int n = read(port, buf, sizeof buf);
+		if (n == 0) break;
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			crash("read(%s)", argv[0]);
+		}
 
+		// All messages completed by this read get its time.
 		int64_t now = now_ms();
+		int64_t mono = now_mono_ms();
 
-		if (fgetc(imu) != 0xfa) continue;
-		if (fgetc(imu) != 0xff) continue;
-		uint8_t chk = 0xff;
-		uint8_t mid = fgetc(imu);  chk += mid;
-		uint16_t len = fgetc(imu); chk += len;
-		if (len == 255) {
-			len = fgetc(imu) << 8;
-			len += fgetc(imu);
-			chk += len >> 8;
-			chk += len;
-		}
-		uint8_t buf[2048];
 		int i;
-		for (i = 0; i < len; ++i) {
-			buf[i] = fgetc(imu);
-			chk += buf[i];
-			if (feof(imu)) break;
-			if (ferror(imu)) break;
-		}
-		chk += fgetc(imu);
-		if (feof(imu)) break;
-		if (ferror(imu)) continue;
-
-		if (chk != 0) {
-			if (debug) fprintf(stderr, "invalid checksum %0x, discarding %d bytes\n", chk, len);
-			continue;
-		}
-
-		garbage = 0;
-		if (alarm_s) alarm(alarm_s);
-
-		if (mid != IMU_MTDATA) {
-			if (debug) fprintf(stderr, "non MTData message, discarding %d bytes\n", len);
-			continue;
-		}
-
-		struct IMUProto vars = INIT_IMUPROTO;
-		memset(&vars, 0, sizeof vars);
-		vars.timestamp_ms = now;  // time we got this packet
-
-		uint8_t status = 0;
-		if (imu_decode_variables(buf, len, mode, settings, &vars, &status) != 0) {
-			if (debug) fprintf(stderr, "Could not decode MTData, discarding %d bytes\n", len);
-			continue;
-		}
-
-		// unless in debug mode, if we have the status byte, clear fields that are not reliable
-		if(!debug && (mode & IMU_OM_STS)) {
-			if (!(status&IMU_STS_XKF)) {
-				vars.roll_deg  = vars.pitch_deg = vars.yaw_deg = NAN;
-				vars.vel_x_m_s = vars.vel_y_m_s = vars.vel_z_m_s = NAN;
+		for (i = 0; i < n; i++) {
+			if (!mt_putc(&reader, buf[i]))
+				continue;
+
+			if (debug && reader.errors > errors)
+				fprintf(stderr, "invalid checksums: %lld\n", reader.errors - errors);
+			errors = reader.errors;
+			garbage = reader.garbage;
+			if (alarm_s) alarm(alarm_s);
+
+			if (reader.mid != IMU_MTDATA) {
+				if (debug) fprintf(stderr, "non MTData message, discarding %d bytes\n", reader.len);
+				continue;
 			}
 
-			if (!(status & (IMU_STS_XKF|IMU_STS_GPS))) {
-				vars.lat_deg = vars.lng_deg = vars.alt_m = NAN;
-				vars.gps_timestamp_ms = 0;  // the time is derived from the GPS signal and goes away with that signal.
-			}
+			handle_mtdata(&layout, reader.buf, reader.len, mode, now, mono);
 		}
 
-		if(debug)
-			fprintf(stderr, "status:0x%x:%s%s%s\n", status,
-				(status&IMU_STS_SELFTEST) ? " selftest" : "",
-				(status&IMU_STS_XKF) ? " XKF" : "",
-				(status&IMU_STS_GPS) ? " GPS" : "");
-
-		ConvertSpeed(&vars);
-
-		printf(OFMT_IMUPROTO(vars));
+		if (reader.errors - errors + (reader.garbage - garbage) > 500)
+			crash("Read only garbage from imu");
 	}
 
 	crash("Terminating.");
@@ -20,6 +20,7 @@
 
 #include "proto/imu.h"
 #include "proto/gps.h"
+#include "proto/mono_timestamp.h"
 #include "lib/log.h"
 
 // -----------------------------------------------------------------------------
@@ -96,7 +97,7 @@ int main(int argc, char* argv[]) {
 			int64_t sys_timestamp_ms;
 			int64_t gps_timestamp_ms;
 
-			if (sscanf(line, IFMT_IMUPROTO(&imu, &nn)) >= 2 && imu.gps_timestamp_ms != 0) {
+			if (MONO_LINE_VALID(sscanf(line, IFMT_IMUPROTO(&imu, &nn)), IFMT_IMUPROTO_ITEMS) && imu.gps_timestamp_ms != 0) {
 
 				if (alarm_s) alarm(alarm_s);
 
@@ -106,7 +107,7 @@ int main(int argc, char* argv[]) {
 				if (usegps) syslog(LOG_NOTICE, "imu time source is back.");
 				usegps = 0;
 
-			} else if (sscanf(line, IFMT_GPSPROTO(&gps, &nn)) >= 2 && gps.gps_timestamp_ms != 0) {
+			} else if (MONO_LINE_VALID(sscanf(line, IFMT_GPSPROTO(&gps, &nn)), IFMT_GPSPROTO_ITEMS) && gps.gps_timestamp_ms != 0) {
 
 				if (alarm_s) alarm(alarm_s);
 
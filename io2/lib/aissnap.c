@@ -0,0 +1,141 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "aissnap.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct AISSnap* aissnap_create(const char* path) {
+	char tmppath[1024];
+	snprintf(tmppath, sizeof tmppath, "%s.tmp", path);
+	int fd = open(tmppath, O_RDWR|O_CREAT|O_TRUNC, 0644);
+	if (fd < 0) return NULL;
+	if (ftruncate(fd, sizeof(struct AISSnap)) < 0) {
+		close(fd);
+		unlink(tmppath);
+		return NULL;
+	}
+	void* p = mmap(NULL, sizeof(struct AISSnap), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		unlink(tmppath);
+		return NULL;
+	}
+	// The file is all zeroes, i.e. all records are free.
+	struct AISSnap* snap = p;
+	snap->h.magic = AISSNAP_MAGIC;
+	snap->h.version = AISSNAP_VERSION;
+	snap->h.nrecords = AISSNAP_RECORDS;
+	snap->h.recsize = sizeof(struct AISSnapRecord);
+	if (rename(tmppath, path) < 0) {
+		munmap(p, sizeof(struct AISSnap));
+		unlink(tmppath);
+		return NULL;
+	}
+	return snap;
+}
+
+const struct AISSnap* aissnap_open(const char* path) {
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return NULL;
+	struct stat st;
+	if (fstat(fd, &st) < 0 || st.st_size != sizeof(struct AISSnap)) {
+		close(fd);
+		return NULL;
+	}
+	void* p = mmap(NULL, sizeof(struct AISSnap), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) return NULL;
+	const struct AISSnap* snap = p;
+	if (snap->h.magic != AISSNAP_MAGIC || snap->h.version != AISSNAP_VERSION ||
+	    snap->h.nrecords != AISSNAP_RECORDS || snap->h.recsize != sizeof(struct AISSnapRecord)) {
+		munmap(p, sizeof(struct AISSnap));
+		return NULL;
+	}
+	return snap;
+}
+
+void aissnap_close(const struct AISSnap* snap) {
+	munmap((void*)snap, sizeof(struct AISSnap));
+}
+
+int aissnap_parse(const char* line, struct AISSnapRecord* r) {
+	memset(r, 0, sizeof *r);
+	r->lat_deg = r->lng_deg = r->speed_m_s = r->cog_deg = NAN;
+	if (snprintf(r->line, sizeof r->line, "%s", line) >= sizeof r->line)
+		r->line[sizeof r->line - 2] = '\n';
+
+	long long timestamp_ms;
+	int msgtype;
+	int skip = 0;
+	if (sscanf(line, "ais: timestamp_ms:%lld mmsi:%d msgtype:%d %n",
+		   &timestamp_ms, &r->mmsi, &msgtype, &skip) < 3 || !skip)
+		return 0;
+	r->timestamp_ms = timestamp_ms;
+	r->msgclass = (msgtype >= 1 && msgtype <= 3) ? 1 : msgtype;
+
+	for (line += skip; *line; line += skip) {
+		char key[16];
+		double value;
+		skip = 0;
+		if (sscanf(line, "%15[a-z_]:%lf %n", key, &value, &skip) < 2 || !skip) {
+			// Skip fields like shipname:'...' that aren't numbers.
+			const char* sp = strchr(line, ' ');
+			if (!sp) break;
+			skip = sp + 1 - line;
+			continue;
+		}
+		if (!strcmp(key, "lat_deg"))   r->lat_deg = value;
+		if (!strcmp(key, "lng_deg"))   r->lng_deg = value;
+		if (!strcmp(key, "speed_m_s")) r->speed_m_s = value;
+		if (!strcmp(key, "cog_deg"))   r->cog_deg = value;
+	}
+	return 1;
+}
+
+void aissnap_put(struct AISSnap* snap, int i, const struct AISSnapRecord* r) {
+	struct AISSnapRecord* dst = &snap->rec[i];
+	uint32_t seq = dst->seq;
+	dst->seq = seq + 1;
+	__sync_synchronize();
+	memcpy((char*)dst + sizeof dst->seq, (const char*)r + sizeof r->seq,
+	       sizeof *r - sizeof r->seq);
+	__sync_synchronize();
+	dst->seq = seq + 2;
+	snap->h.generation++;
+}
+
+void aissnap_clear(struct AISSnap* snap, int i) {
+	struct AISSnapRecord* dst = &snap->rec[i];
+	uint32_t seq = dst->seq;
+	dst->seq = seq + 1;
+	__sync_synchronize();
+	dst->mmsi = 0;
+	__sync_synchronize();
+	dst->seq = seq + 2;
+	snap->h.generation++;
+}
+
+int aissnap_get(const struct AISSnap* snap, int i, struct AISSnapRecord* r) {
+	const struct AISSnapRecord* src = &snap->rec[i];
+	// Bounded, in case the writer died in the middle of an update.
+	int tries;
+	for (tries = 0; tries < 1000; ++tries) {
+		uint32_t seq = src->seq;
+		if (seq & 1) continue;
+		__sync_synchronize();
+		memcpy(r, (const char*)src, sizeof *r);
+		__sync_synchronize();
+		if (src->seq == seq)
+			return r->mmsi != 0;
+	}
+	return 0;
+}
@@ -0,0 +1,87 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef LIB_AISSNAP_H_
+#define LIB_AISSNAP_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Memory mapped snapshot of the last AIS message per vessel and message
+// class, written in place by aisbuf and mapped read only by its readers
+// (skipper, aisdump).
+//
+// The file is a header followed by AISSNAP_RECORDS fixed size records,
+// in host byte order.  A record with mmsi 0 is free.  Each record has its
+// own sequence lock: the writer makes seq odd, updates the record and
+// makes seq even again.  Readers copy the record and retry if seq was
+// odd or changed meanwhile, so they never see a torn record and never
+// block the writer.  The header generation is bumped after every update,
+// readers can use it to skip a scan when nothing changed.
+//
+// The numeric fields are parsed once by the writer, NAN if the message
+// did not carry them. The original ais: line is kept for humans, see
+// aisdump.  AISSNAP_LINE is the longest line aisbuf reads, so only lines
+// put by other writers can be truncated.
+
+#define AISSNAP_MAGIC   0x50534941   // "AISP"
+#define AISSNAP_VERSION 2
+#define AISSNAP_RECORDS 4096
+#define AISSNAP_LINE    1024
+
+struct AISSnapRecord {
+	volatile uint32_t seq;
+	int32_t mmsi;
+	int32_t msgclass;	// msgtype, with 1, 2 and 3 all mapped to 1
+	int32_t pad;
+	int64_t timestamp_ms;
+	double lat_deg;
+	double lng_deg;
+	double speed_m_s;
+	double cog_deg;
+	char line[AISSNAP_LINE];
+};
+
+struct AISSnapHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nrecords;
+	uint32_t recsize;
+	volatile uint32_t generation;
+	uint32_t pad;
+};
+
+struct AISSnap {
+	struct AISSnapHeader h;
+	struct AISSnapRecord rec[AISSNAP_RECORDS];
+};
+
+// Writer: create an empty snapshot in a temporary file, map it read/write
+// and rename it to path.  Returns NULL and sets errno on failure.
+struct AISSnap* aissnap_create(const char* path);
+
+// Reader: map path read only.  Returns NULL if it can't be mapped or is
+// not a snapshot of this version.
+const struct AISSnap* aissnap_open(const char* path);
+
+void aissnap_close(const struct AISSnap* snap);
+
+// Fill the numeric fields and line of r from an "ais: ..." line.
+// Returns 0 if the line has no timestamp_ms, mmsi and msgtype.
+int aissnap_parse(const char* line, struct AISSnapRecord* r);
+
+// Writer: overwrite or clear record i.
+void aissnap_put(struct AISSnap* snap, int i, const struct AISSnapRecord* r);
+void aissnap_clear(struct AISSnap* snap, int i);
+
+// Reader: consistent copy of record i.  Returns 0 if it is free.
+int aissnap_get(const struct AISSnap* snap, int i, struct AISSnapRecord* r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_AISSNAP_H_
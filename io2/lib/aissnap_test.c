@@ -0,0 +1,80 @@
+#include "aissnap.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+int main(int argc, char* argv[]) {
+
+	const char* path = "/tmp/aissnap_test.snap";
+	struct AISSnap* snap = aissnap_create(path);
+	assert(snap);
+	assert(access("/tmp/aissnap_test.snap.tmp", F_OK) < 0);
+
+	const struct AISSnap* rd = aissnap_open(path);
+	assert(rd);
+	assert(rd->h.generation == 0);
+
+	struct AISSnapRecord r;
+	assert(!aissnap_get(rd, 0, &r));
+
+	assert(!aissnap_parse("garbage\n", &r));
+	assert(aissnap_parse("ais: timestamp_ms:1325376000123 mmsi:244670000 msgtype:3 status:5 "
+			     "speed_m_s:5.1 lat_deg:43.123456 lng_deg:-9.500000 cog_deg:271.3 heading_deg:270\n", &r));
+	assert(r.timestamp_ms == 1325376000123LL);
+	assert(r.mmsi == 244670000);
+	assert(r.msgclass == 1);
+	assert(r.lat_deg == 43.123456);
+	assert(r.lng_deg == -9.5);
+	assert(r.speed_m_s == 5.1);
+	assert(r.cog_deg == 271.3);
+
+	aissnap_put(snap, 7, &r);
+	assert(rd->h.generation == 1);
+
+	struct AISSnapRecord out;
+	assert(aissnap_get(rd, 7, &out));
+	assert(out.mmsi == 244670000);
+	assert(out.lng_deg == -9.5);
+	assert(!(out.seq & 1));
+	assert(!strcmp(out.line, r.line));
+
+	// Static data: no position, names are skipped.
+	assert(aissnap_parse("ais: timestamp_ms:1325376000200 mmsi:244670000 msgtype:5 size_m:120 "
+			     "shipname:'SEA CLOUD' \n", &r));
+	assert(r.msgclass == 5);
+	assert(isnan(r.lat_deg) && isnan(r.speed_m_s));
+
+	// The longest line aisbuf reads is kept whole.
+	char line[2048];
+	int n = snprintf(line, sizeof line, "ais: timestamp_ms:1 mmsi:2 msgtype:1 ");
+	memset(line + n, 'x', 1022 - n);
+	strcpy(line + 1022, "\n");
+	assert(aissnap_parse(line, &r));
+	assert(!strcmp(r.line, line));
+
+	// Longer lines are truncated but stay lines.
+	memset(line + n, 'x', 1500);
+	strcpy(line + n + 1500, "\n");
+	assert(aissnap_parse(line, &r));
+	assert(strlen(r.line) == AISSNAP_LINE - 1);
+	assert(r.line[AISSNAP_LINE - 2] == '\n');
+
+	aissnap_clear(snap, 7);
+	assert(!aissnap_get(rd, 7, &out));
+	assert(rd->h.generation == 2);
+
+	// Not a snapshot.
+	FILE* fp = fopen("/tmp/aissnap_test.txt", "w");
+	fputs("ais: timestamp_ms:1 mmsi:2 msgtype:1\n", fp);
+	fclose(fp);
+	assert(!aissnap_open("/tmp/aissnap_test.txt"));
+
+	aissnap_close(rd);
+	aissnap_close(snap);
+
+	puts("OK");
+	return 0;
+}
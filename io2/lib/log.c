@@ -4,6 +4,7 @@
 
 #include "log.h"
 
+#include <ctype.h>
 #include <errno.h>
 #include <stdarg.h>
 #include <stdint.h>
@@ -12,14 +13,20 @@
 #include <string.h>
 #include <sys/time.h>
 
+static void flush_crash(const char* msg);
+
 void crash(const char* fmt, ...) {
 	va_list ap;
 	char buf[1000];
+	char msg[1100];
+	int err = errno;
 	va_start(ap, fmt);
 	vsnprintf(buf, sizeof(buf), fmt, ap);
-	syslog(LOG_CRIT, "%s%s%s\n", buf,
-	       (errno) ? ": " : "",
-	       (errno) ? strerror(errno):"" );
+	snprintf(msg, sizeof(msg), "%s%s%s", buf,
+	       (err) ? ": " : "",
+	       (err) ? strerror(err):"" );
+	flush_crash(msg);
+	syslog(LOG_CRIT, "%s\n", msg);
 	exit(1);
 	va_end(ap);
 	return;
@@ -28,21 +35,20 @@ void crash(const char* fmt, ...) {
 
 void fault(int i) { crash("fault"); }
 
-static int64_t now_ms() {
+static int64_t now_us() {
         struct timeval tv;
         if (gettimeofday(&tv, NULL) < 0) crash("no working clock");
 
-        int64_t ms1 = tv.tv_sec;  ms1 *= 1000;
-        int64_t ms2 = tv.tv_usec; ms2 /= 1000;
-        return ms1 + ms2;
+        int64_t us1 = tv.tv_sec;  us1 *= 1000000;
+        return us1 + tv.tv_usec;
 }
 
 struct TokenBucket {
 	int size;  // burst size
 	int rate;  // max per second
 	int val;   // current value
-	int discarded;  // discarded since last limiting 
-	int64_t last_ms;  // time of last 
+	int discarded;  // discarded since last flush
+	int64_t last_ms;  // time of last
 } buckets[] = {
 	[LOG_EMERG]   = { 100, 10, 0, 0 },
 	[LOG_ALERT]   = { 100, 10, 0, 0 },
@@ -58,29 +64,377 @@ struct TokenBucket {
 
 int min(int64_t x, int64_t y) { return (x < y) ? x : y; }
 
+// -----------------------------------------------------------------------------
+//   Records
+
+enum {
+	RING = 256,		// records, a power of 2
+	MAXARGS = 12,
+	STRLEN = 128,		// for all string arguments of a record
+	REPEAT_US = 10*1000*1000,  // repeats of the last message are summed up this long
+	MAGIC = 0x5347,		// of a binary record
+};
+
+// Argument types.  Everything smaller than an int is promoted, long
+// doubles are stored as doubles.
+enum { ARG_NONE = -1, ARG_INT, ARG_LONG, ARG_LLONG, ARG_SIZE, ARG_DOUBLE, ARG_LDOUBLE,
+       ARG_STR, ARG_ERRNO, ARG_PTR, ARG_COUNT };
+
+union Arg {
+	long long i;	// also the offset in str of strings, and pointers
+	double d;
+};
+
+struct Record {
+	int64_t us;
+	int priority;
+	int count;	// times this message was logged
+	const char* fmt;
+	int nargs;
+	union Arg arg[MAXARGS];
+	int nstr;
+	char str[STRLEN];
+};
+
+static struct Record ring[RING];
+static unsigned int head, tail;  // head - tail records are pending
+static struct Record last;	// the last one written, last.count repeats since
+static int deferred;		// the program calls slog_flush itself
+static FILE* binary;
+
+// Parse the conversion at p, right after the '%'.  Returns the end of
+// it, the type of the argument in *type and the number of '*' width and
+// precision arguments before it in *stars.
+static const char*
+conversion(const char* p, int* type, int* stars)
+{
+	int l = 0, size = 0, ldouble = 0;
+	*stars = 0;
+	while (*p && strchr("#0- +'", *p)) p++;
+	if (*p == '*') { ++*stars; p++; } else while (isdigit(*p)) p++;
+	if (*p == '.') {
+		p++;
+		if (*p == '*') { ++*stars; p++; } else while (isdigit(*p)) p++;
+	}
+	for (;; p++) {
+		if (*p == 'h') continue;
+		else if (*p == 'l') l++;
+		else if (*p == 'q') l = 2;
+		else if (*p == 'L') ldouble = 1;
+		else if (*p == 'j') l = 2;
+		else if (*p == 'z' || *p == 't') size = 1;
+		else break;
+	}
+	switch (*p) {
+	case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+		*type = size ? ARG_SIZE : (l >= 2) ? ARG_LLONG : l ? ARG_LONG : ARG_INT;
+		break;
+	case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+		*type = ldouble ? ARG_LDOUBLE : ARG_DOUBLE;
+		break;
+	case 's': *type = ARG_STR; break;
+	case 'm': *type = ARG_ERRNO; break;
+	case 'p': *type = ARG_PTR; break;
+	case 'n': *type = ARG_COUNT; break;
+	default:  *type = ARG_NONE; return p;
+	}
+	return p + 1;
+}
+
+static void
+addstr(struct Record* r, const char* s)
+{
+	if (!s) s = "(null)";
+	int n = strlen(s);
+	if (n > STRLEN - 1 - r->nstr) n = STRLEN - 1 - r->nstr;
+	r->arg[r->nargs++].i = r->nstr;
+	memmove(r->str + r->nstr, s, n);
+	r->nstr += n;
+	r->str[r->nstr] = 0;
+	if (r->nstr < STRLEN - 1) r->nstr++;  // past the terminator
+}
+
+// Copy the arguments of fmt, up to MAXARGS.
+static void
+capture(struct Record* r, const char* fmt, va_list ap, int err)
+{
+	const char* p = fmt;
+	r->fmt = fmt;
+	r->nargs = 0;
+	r->nstr = 0;
+	while (*p) {
+		if (*p++ != '%') continue;
+		if (*p == '%') { p++; continue; }
+		int type, stars;
+		p = conversion(p, &type, &stars);
+		if (type == ARG_NONE) continue;
+		if (r->nargs + stars + 1 > MAXARGS) return;
+		while (stars--)
+			r->arg[r->nargs++].i = va_arg(ap, int);
+		switch (type) {
+		case ARG_INT:	  r->arg[r->nargs++].i = va_arg(ap, int); break;
+		case ARG_LONG:	  r->arg[r->nargs++].i = va_arg(ap, long); break;
+		case ARG_LLONG:	  r->arg[r->nargs++].i = va_arg(ap, long long); break;
+		case ARG_SIZE:	  r->arg[r->nargs++].i = va_arg(ap, size_t); break;
+		case ARG_DOUBLE:  r->arg[r->nargs++].d = va_arg(ap, double); break;
+		case ARG_LDOUBLE: r->arg[r->nargs++].d = va_arg(ap, long double); break;
+		case ARG_STR:	  addstr(r, va_arg(ap, const char*)); break;
+		case ARG_ERRNO:	  addstr(r, strerror(err)); break;
+		case ARG_PTR:	  r->arg[r->nargs++].i = (uintptr_t)va_arg(ap, void*); break;
+		case ARG_COUNT:	  va_arg(ap, void*); r->arg[r->nargs++].i = 0; break;
+		}
+	}
+}
+
+// Format a record like vsnprintf would have, one conversion at a time,
+// without a trailing newline.  What is beyond MAXARGS is copied as it is.
+static void
+format(const struct Record* r, char* buf, int size)
+{
+	const char* p = r->fmt;
+	int n = 0, a = 0;
+	while (*p && n < size - 1) {
+		if (*p != '%') { buf[n++] = *p++; continue; }
+		const char* s = p++;
+		if (*p == '%') { buf[n++] = *p++; continue; }
+		int type, stars;
+		p = conversion(p, &type, &stars);
+		if (type == ARG_NONE || a + stars + 1 > r->nargs) {
+			while (s < p && n < size - 1) buf[n++] = *s++;
+			continue;
+		}
+
+		// The conversion spec, with '*'s replaced and long doubles as doubles.
+		char spec[64];
+		int k = 0;
+		for (; s < p && k < sizeof spec - 12; s++) {
+			if (*s == '*')
+				k += snprintf(spec + k, sizeof spec - k, "%d", (int)r->arg[a++].i);
+			else if (*s == 'L' && type == ARG_LDOUBLE)
+				continue;
+			else if (*s == 'm' && type == ARG_ERRNO)
+				spec[k++] = 's';
+			else
+				spec[k++] = *s;
+		}
+		spec[k] = 0;
+
+		const union Arg* v = &r->arg[a++];
+		int m = 0;
+		switch (type) {
+		case ARG_INT:	  m = snprintf(buf + n, size - n, spec, (int)v->i); break;
+		case ARG_LONG:	  m = snprintf(buf + n, size - n, spec, (long)v->i); break;
+		case ARG_LLONG:	  m = snprintf(buf + n, size - n, spec, v->i); break;
+		case ARG_SIZE:	  m = snprintf(buf + n, size - n, spec, (size_t)v->i); break;
+		case ARG_DOUBLE:
+		case ARG_LDOUBLE: m = snprintf(buf + n, size - n, spec, v->d); break;
+		case ARG_STR:
+		case ARG_ERRNO:	  m = snprintf(buf + n, size - n, spec, r->str + v->i); break;
+		case ARG_PTR:	  m = snprintf(buf + n, size - n, spec, (void*)(uintptr_t)v->i); break;
+		case ARG_COUNT:	  break;
+		}
+		if (m > 0) n += min(m, size - 1 - n);
+	}
+	if (n > 0 && buf[n-1] == '\n') n--;  // syslog drops it anyway
+	buf[n] = 0;
+}
+
+static int
+same(const struct Record* a, const struct Record* b)
+{
+	return a->fmt == b->fmt && a->priority == b->priority &&
+		a->nargs == b->nargs && a->nstr == b->nstr &&
+		!memcmp(a->arg, b->arg, a->nargs * sizeof a->arg[0]) &&
+		!memcmp(a->str, b->str, a->nstr);
+}
+
+// -----------------------------------------------------------------------------
+//   Output
+
+// The same size with and without -m32.
+struct BinaryHeader {
+	int64_t us;
+	int32_t count;
+	uint16_t magic;
+	uint8_t priority;
+	uint8_t nargs;
+	uint16_t fmtlen;
+	uint16_t nstr;
+	uint32_t unused;
+};
+
+static void
+write_record(const struct Record* r)
+{
+	if (binary) {
+		struct BinaryHeader h = { r->us, r->count, MAGIC, r->priority, r->nargs,
+					  strlen(r->fmt), r->nstr, 0 };
+		fwrite(&h, sizeof h, 1, binary);
+		fwrite(r->fmt, h.fmtlen, 1, binary);
+		fwrite(r->arg, sizeof r->arg[0], r->nargs, binary);
+		fwrite(r->str, 1, r->nstr, binary);
+		return;
+	}
+
+	char buf[1000];
+	format(r, buf, sizeof buf);
+	if (r->count > 1)
+		syslog(r->priority, "%s [repeated %d times]", buf, r->count);
+	else
+		syslog(r->priority, "%s", buf);
+}
+
+static void
+write_discarded(void)
+{
+	int i;
+	for (i = 0; i < nelem(buckets); i++) {
+		if (!buckets[i].discarded) continue;
+		struct Record r;
+		memset(&r, 0, sizeof r);
+		r.us = now_us();
+		r.priority = i;
+		r.count = 1;
+		r.fmt = "discarded %d log messages";
+		r.nargs = 1;
+		r.arg[0].i = buckets[i].discarded;
+		write_record(&r);
+		buckets[i].discarded = 0;
+	}
+}
+
+static void
+flush(void)
+{
+	static int flushing;
+	if (flushing) return;  // a crash while flushing
+	flushing = 1;
+
+	int64_t now = now_us();
+	if (last.count > 0 && (head != tail || now > last.us + REPEAT_US)) {
+		write_record(&last);
+		last.count = 0;
+		last.us = now;
+	}
+	write_discarded();
+	while (tail != head) {
+		struct Record* r = &ring[tail % RING];
+		write_record(r);
+		last = *r;
+		last.count = 0;
+		last.us = now;
+		tail++;
+	}
+	if (binary) fflush(binary);
+	flushing = 0;
+}
+
+// Write what is pending, and the crash message to the binary log.
+static void
+flush_crash(const char* msg)
+{
+	flush();
+	if (!binary) return;
+	struct Record r;
+	memset(&r, 0, sizeof r);
+	r.us = now_us();
+	r.priority = LOG_CRIT;
+	r.count = 1;
+	r.fmt = "%s";
+	addstr(&r, msg);
+	write_record(&r);
+	fflush(binary);
+}
+
+void slog_flush(void) {
+	deferred = 1;
+	flush();
+}
+
+int slog_binary(const char* path) {
+	flush();
+	FILE* f = fopen(path, "a");
+	if (!f) return -1;
+	if (binary) fclose(binary);
+	binary = f;
+	return 0;
+}
+
+int slog_decode(FILE* f, int64_t* us, int* priority, char* buf, int size) {
+	struct BinaryHeader h;
+	char fmt[1024];
+	struct Record r;
+
+	if (fread(&h, sizeof h, 1, f) != 1) return 0;
+	if (h.magic != MAGIC || h.nargs > MAXARGS || h.fmtlen >= sizeof fmt || h.nstr > STRLEN)
+		return -1;
+	memset(&r, 0, sizeof r);
+	if (fread(fmt, 1, h.fmtlen, f) != h.fmtlen ||
+	    fread(r.arg, sizeof r.arg[0], h.nargs, f) != h.nargs ||
+	    fread(r.str, 1, h.nstr, f) != h.nstr)
+		return -1;
+	fmt[h.fmtlen] = 0;
+	r.fmt = fmt;
+	r.nargs = h.nargs;
+	r.nstr = h.nstr;
+
+	*us = h.us;
+	*priority = h.priority;
+	format(&r, buf, size);
+	if (h.count > 1) {
+		int n = strlen(buf);
+		snprintf(buf + n, size - n, " [repeated %d times]", h.count);
+	}
+	return 1;
+}
+
+// -----------------------------------------------------------------------------
+
 void slog(int priority, const char *message, ...) {
 	if (priority < 0 || priority >= nelem(buckets)) crash("invalid priority");
 
+	static int atexit_done;
+	if (!atexit_done) {
+		atexit(flush);
+		atexit_done = 1;
+	}
+
+	int err = errno;
 	va_list ap;
 	va_start(ap, message);
 
-	struct TokenBucket* b = buckets + priority;
-	int64_t now = now_ms();
-	if (b->last_ms > now) b->last_ms = now;  // guard against clock jump;
-	b->val = min(b->val + ((now - b->last_ms) * b->rate / 1000), b->size);
+	// When the ring is full the message can only be counted as a repeat.
+	static struct Record full;
+	struct Record* r = (head - tail < RING) ? &ring[head % RING] : &full;
+	r->us = now_us();
+	r->priority = priority;
+	r->count = 1;
+	capture(r, message, ap, err);
+	va_end(ap);
 
-	if (b->val > 0) {
-		if (b->discarded) {
-			syslog(priority, "discarded %d log messages", b->discarded);
-			b->discarded = 0;
-		}
-		b->val--;
-		b->last_ms = now;
-		vsyslog(priority, message, ap);
+	// Repeats are only counted.
+	if (head != tail && same(r, &ring[(head - 1) % RING])) {
+		ring[(head - 1) % RING].count++;
+	} else if (head == tail && last.fmt && same(r, &last)) {
+		last.count++;
 	} else {
-		b->discarded++;
+		struct TokenBucket* b = buckets + priority;
+		int64_t now = r->us / 1000;
+		if (b->last_ms > now) b->last_ms = now;  // guard against clock jump;
+		b->val = min(b->val + ((now - b->last_ms) * b->rate / 1000), b->size);
+
+		if (b->val > 0 && r != &full) {
+			b->val--;
+			b->last_ms = now;
+			head++;
+		} else {
+			b->discarded++;
+		}
 	}
 
-	va_end(ap);
+	if (!deferred)
+		flush();
+
+	errno = err;
 	return;
 }
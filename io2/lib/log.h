@@ -4,18 +4,48 @@
 //
 // Rate limiting on syslog.
 //
+// slog() doesn't format or write anything, it copies the format and the
+// arguments into a preallocated ring, and slog_flush() formats the
+// records and passes them to syslog.  Programs with a control loop call
+// slog_flush() once at the start and then whenever they would block in
+// select anyway; from the first call on slog() makes no system calls,
+// and if the ring is full the message is counted as discarded.  For
+// programs that never call slog_flush(), slog() flushes right away.
+// The format is kept by pointer, so it has to be a string literal.
+//
+// A message repeating the previous one with the same arguments is not
+// stored again but counted, and logged as "... [repeated n times]" with
+// the next message, or after 10 seconds.
+//
+// With slog_binary() the records are appended to a file instead,
+// unformatted, to be formatted later with slog_decode(), see slogcat.
+//
 #ifndef _IO_LOG_H
 #define _IO_LOG_H
 
+#include <stdint.h>
+#include <stdio.h>
 #include <syslog.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Log to syslog with per-priority tokenbucket rate limiting
+// Log to syslog with per-priority tokenbucket rate limiting.
+// String arguments are truncated to some 100 characters.
 void slog(int priority, const char *message, ...);
 
+// Format and write the pending messages.
+void slog_flush(void);
+
+// Write the messages to path instead of syslog, in binary.  Returns 0
+// on success, -1 if the file can't be opened.
+int slog_binary(const char* path);
+
+// Read the next binary record from f and format it into buf.
+// Returns 1, 0 at the end of the file or -1 if the record is corrupt.
+int slog_decode(FILE* f, int64_t* us, int* priority, char* buf, int size);
+
 // LOG_CRIT the message and exit(1)
 void crash(const char* fmt, ...);
 
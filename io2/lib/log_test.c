@@ -0,0 +1,96 @@
+#include "log.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static FILE* f;
+
+// The next message from the binary log.
+static const char*
+next(int priority)
+{
+	static char buf[1000];
+	int64_t us;
+	int p;
+	assert(slog_decode(f, &us, &p, buf, sizeof buf) == 1);
+	assert(p == priority && us > 0);
+	return buf;
+}
+
+int main(int argc, char* argv[]) {
+	char path[] = "/tmp/log_testXXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	close(fd);
+
+	assert(slog_binary(path) == 0);
+	f = fopen(path, "r");
+	assert(f);
+
+	// Once we flush ourselves, nothing is written until we flush.
+	slog_flush();
+	slog(LOG_INFO, "plain");
+	slog(LOG_WARNING, "%d %5.2lf %s %lld %x %-4s| %c %% %*d %zu", -3, 3.14159, "str", 1LL << 40, 255, "ab", 'c', 4, 7, sizeof(int));
+	errno = ENOENT;
+	slog(LOG_ERR, "open: %m %s", "again");
+	assert(slog_decode(f, NULL, NULL, NULL, 0) == 0);
+	clearerr(f);
+	slog_flush();
+
+	assert(!strcmp(next(LOG_INFO), "plain"));
+	char want[1000];
+	snprintf(want, sizeof want, "%d %5.2lf %s %lld %x %-4s| %c %% %*d %zu", -3, 3.14159, "str", 1LL << 40, 255, "ab", 'c', 4, 7, sizeof(int));
+	assert(!strcmp(next(LOG_WARNING), want));
+	assert(!strcmp(next(LOG_ERR), "open: No such file or directory again"));
+
+	// Repeats are counted, pending ones and the last one written.
+	int i;
+	for (i = 0; i < 5; i++)
+		slog(LOG_INFO, "slow cycle %d", 1);
+	slog(LOG_INFO, "slow cycle %d", 2);
+	slog_flush();
+	assert(!strcmp(next(LOG_INFO), "slow cycle 1 [repeated 5 times]"));
+	assert(!strcmp(next(LOG_INFO), "slow cycle 2"));
+	for (i = 0; i < 3; i++)
+		slog(LOG_INFO, "slow cycle %d", 2);
+	slog_flush();
+	slog(LOG_INFO, "done");
+	slog_flush();
+	assert(!strcmp(next(LOG_INFO), "slow cycle 2 [repeated 3 times]"));
+	assert(!strcmp(next(LOG_INFO), "done"));
+
+	// syslog drops the trailing newline.
+	slog(LOG_INFO, "newline\n");
+	slog(LOG_INFO, "newline\n");
+	slog_flush();
+	assert(!strcmp(next(LOG_INFO), "newline [repeated 2 times]"));
+
+	// Rate limiting, the burst size is 10.
+	for (i = 0; i < 20; i++)
+		slog(LOG_DEBUG, "burst %d", i);
+	slog_flush();
+	assert(!strcmp(next(LOG_DEBUG), "discarded 10 log messages"));
+	for (i = 0; i < 10; i++)
+		next(LOG_DEBUG);
+
+	// Long strings are truncated, arguments beyond the 12th are not formatted.
+	char longstr[300];
+	memset(longstr, 'x', sizeof longstr - 1);
+	longstr[sizeof longstr - 1] = 0;
+	slog(LOG_NOTICE, "%s|%s|", longstr, "y");
+	slog(LOG_NOTICE, "%d %d %d %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13);
+	slog_flush();
+	const char* s = next(LOG_NOTICE);
+	assert(strlen(s) < 150 && s[0] == 'x' && !strcmp(s + strlen(s) - 2, "||"));
+	assert(!strcmp(next(LOG_NOTICE), "1 2 3 4 5 6 7 8 9 10 11 12 %d"));
+
+	assert(slog_decode(f, NULL, NULL, NULL, 0) == 0);
+	fclose(f);
+	unlink(path);
+	puts("OK");
+	return 0;
+}
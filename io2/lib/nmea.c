@@ -0,0 +1,169 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "nmea.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum { IDLE = 0, BODY, CHK1, CHK2, EOL };
+
+static int
+hexnibble(int c)
+{
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	return -1;
+}
+
+static void
+drop(struct NMEAReader* r)
+{
+	r->errors++;
+	r->state = IDLE;
+}
+
+int nmea_putc(struct NMEAReader* r, int c) {
+	struct NMEASentence* s = &r->s;
+	int x;
+
+	if (c == '$' || c == '!') {
+		if (r->state != IDLE) r->errors++;
+		s->buf[0] = c;
+		s->len = 1;
+		s->nfields = 0;
+		s->field[0] = 1;
+		r->sum = 0;
+		r->state = BODY;
+		return 0;
+	}
+
+	switch (r->state) {
+	case IDLE:
+		if (c != '\r' && c != '\n') r->garbage++;
+		return 0;
+
+	case BODY:
+		if (c == '*') {
+			s->buf[s->len] = 0;
+			s->field[++s->nfields] = s->len + 1;
+			r->state = CHK1;
+			return 0;
+		}
+		if (c < ' ' || c > '~' || s->len >= NMEA_MAXLEN - 1) {
+			drop(r);
+			return 0;
+		}
+		if (c == ',') {
+			if (s->nfields >= NMEA_MAXFIELDS - 1) {
+				drop(r);
+				return 0;
+			}
+			s->field[++s->nfields] = s->len + 1;
+		}
+		s->buf[s->len++] = c;
+		r->sum ^= c;
+		return 0;
+
+	case CHK1:
+		if ((x = hexnibble(c)) < 0) {
+			drop(r);
+			return 0;
+		}
+		r->chk = x << 4;
+		r->state = CHK2;
+		return 0;
+
+	case CHK2:
+		if ((x = hexnibble(c)) < 0 || (r->chk | x) != r->sum) {
+			drop(r);
+			return 0;
+		}
+		r->state = EOL;
+		return 0;
+
+	case EOL:
+		if (c != '\r' && c != '\n') {
+			drop(r);
+			return 0;
+		}
+		r->state = IDLE;
+		r->sentences++;
+		return 1;
+	}
+	return 0;
+}
+
+int nmea_fieldlen(const struct NMEASentence* s, int i) {
+	if (i < 0 || i >= s->nfields) return 0;
+	return s->field[i + 1] - s->field[i] - 1;
+}
+
+const char* nmea_field(const struct NMEASentence* s, int i) {
+	if (i < 0 || i >= s->nfields) return "";
+	return s->buf + s->field[i];
+}
+
+double nmea_double(const struct NMEASentence* s, int i) {
+	int len = nmea_fieldlen(s, i);
+	if (len == 0) return NAN;
+	const char* f = nmea_field(s, i);
+	char* end;
+	double v = strtod(f, &end);
+	if (end != f + len) return NAN;
+	return v;
+}
+
+char nmea_char(const struct NMEASentence* s, int i) {
+	return nmea_fieldlen(s, i) ? nmea_field(s, i)[0] : 0;
+}
+
+// Up to 5 leading upper case letters, 5 bits each.
+static uint32_t
+key(const char* address, int len)
+{
+	uint32_t k = 0;
+	int i;
+	for (i = 0; i < 5 && i < len && address[i] >= 'A' && address[i] <= 'Z'; i++)
+		k = (k << 5) | (address[i] - 'A' + 1);
+	return k;
+}
+
+static int
+slotof(uint32_t mult, uint32_t k)
+{
+	return (k * mult) >> (32 - NMEA_DISPATCH_BITS);
+}
+
+int nmea_dispatch_init(struct NMEADispatch* d, const struct NMEAHandler* handlers, int n) {
+	if (n > NMEA_DISPATCH_SIZE) return 0;
+	uint32_t mult;
+	int tries;
+	// Odd multipliers from a fixed sequence, the first one without collisions wins.
+	for (tries = 0, mult = 2654435761u; tries < 100000; tries++, mult += 2 * 40503u) {
+		memset(d->slot, 0, sizeof d->slot);
+		int i;
+		for (i = 0; i < n; i++) {
+			int k = slotof(mult, key(handlers[i].address, strlen(handlers[i].address)));
+			if (d->slot[k]) break;
+			d->slot[k] = &handlers[i];
+		}
+		if (i == n) {
+			d->mult = mult;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int nmea_dispatch(const struct NMEADispatch* d, const struct NMEASentence* s, void* arg) {
+	const char* address = nmea_field(s, 0);
+	int len = nmea_fieldlen(s, 0);
+	uint32_t k = key(address, len);
+	const struct NMEAHandler* h = d->slot[slotof(d->mult, k)];
+	if (!h || key(h->address, strlen(h->address)) != k) return -1;
+	return h->handler(s, arg);
+}
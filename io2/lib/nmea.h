@@ -0,0 +1,83 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// NMEA 0183 sentences: a streaming tokenizer that checks the checksum
+// as the characters come in, field accessors that cope with empty
+// fields, and a dispatcher from the address field (talker + sentence,
+// e.g. GPRMC) to a parser.
+//
+#ifndef LIB_NMEA_H_
+#define LIB_NMEA_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { NMEA_MAXLEN = 100, NMEA_MAXFIELDS = 32 };
+
+// A complete sentence: buf holds it from the '$' or '!' up to the '*'
+// (len characters, NUL terminated), field i starts at buf + field[i]
+// and ends at the next ',' or the '*'. Field 0 is the address.
+struct NMEASentence {
+	char buf[NMEA_MAXLEN];
+	int len;
+	int nfields;
+	uint8_t field[NMEA_MAXFIELDS + 1];	// field[nfields] is one past the '*'
+};
+
+// A zeroed structure is ready for use.
+struct NMEAReader {
+	struct NMEASentence s;
+	int state;
+	uint8_t sum;		// running xor of the sentence body
+	uint8_t chk;		// checksum as received
+	int64_t sentences;	// complete sentences
+	int64_t errors;		// sentences dropped for checksum, length or format
+	int64_t garbage;	// characters outside of any sentence
+};
+
+// Feed one character.  Returns 1 when it completed a sentence with a
+// valid checksum, which is then in r->s until the next call.
+int nmea_putc(struct NMEAReader* r, int c);
+
+// Fields, all return 0 / NAN for empty or missing fields.
+// nmea_double also returns NAN if the field is not entirely a number.
+int nmea_fieldlen(const struct NMEASentence* s, int i);
+const char* nmea_field(const struct NMEASentence* s, int i);
+double nmea_double(const struct NMEASentence* s, int i);
+char nmea_char(const struct NMEASentence* s, int i);
+
+// Handlers are registered by address, e.g. "GPRMC".  Addresses are up to
+// 5 upper case letters, the key of a sentence is the leading upper case
+// letters of its first field, so the OS500 compass' "$C123.4P..." has
+// key "C".  A handler returns 0 if the sentence was invalid.
+typedef int (*nmea_handler)(const struct NMEASentence* s, void* arg);
+
+struct NMEAHandler {
+	const char* address;
+	nmea_handler handler;
+};
+
+enum { NMEA_DISPATCH_BITS = 6, NMEA_DISPATCH_SIZE = 1 << NMEA_DISPATCH_BITS };
+
+// Perfect hash: key * mult >> (32 - NMEA_DISPATCH_BITS) is different for
+// every registered address, so a dispatch is one multiply and compare.
+struct NMEADispatch {
+	uint32_t mult;
+	const struct NMEAHandler* slot[NMEA_DISPATCH_SIZE];
+};
+
+// Returns 0 if no perfect hash was found (too many or duplicate addresses).
+int nmea_dispatch_init(struct NMEADispatch* d, const struct NMEAHandler* handlers, int n);
+
+// Returns the handler's result, or -1 if there is none for the sentence.
+int nmea_dispatch(const struct NMEADispatch* d, const struct NMEASentence* s, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_NMEA_H_
@@ -0,0 +1,107 @@
+#include "nmea.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static int
+feed(struct NMEAReader* r, const char* str)
+{
+	int n = 0;
+	for (; *str; str++)
+		n += nmea_putc(r, *str);
+	return n;
+}
+
+static int calls[3];
+
+static int handle_rmc(const struct NMEASentence* s, void* arg) { calls[0]++; return 1; }
+static int handle_mwv(const struct NMEASentence* s, void* arg) { calls[1]++; return *(int*)arg; }
+static int handle_c(const struct NMEASentence* s, void* arg) { calls[2]++; return 1; }
+
+int main(int argc, char* argv[]) {
+
+	struct NMEAReader r;
+	memset(&r, 0, sizeof r);
+
+	// Complete sentence, fed in pieces.
+	assert(feed(&r, "$WIMWV,100,R,") == 0);
+	assert(feed(&r, "10.5,N,A*08\r") == 1);
+	assert(!strcmp(r.s.buf, "$WIMWV,100,R,10.5,N,A"));
+	assert(r.s.nfields == 6);
+	assert(nmea_fieldlen(&r.s, 0) == 5);
+	assert(!strncmp(nmea_field(&r.s, 0), "WIMWV", 5));
+	assert(nmea_double(&r.s, 1) == 100);
+	assert(nmea_char(&r.s, 2) == 'R');
+	assert(nmea_double(&r.s, 3) == 10.5);
+	assert(nmea_char(&r.s, 5) == 'A');
+	assert(feed(&r, "\n") == 0);
+	assert(r.sentences == 1 && r.errors == 0 && r.garbage == 0);
+
+	// Empty and missing fields.
+	assert(feed(&r, "$WIMWV,,R,,N,A*23\r\n") == 1);
+	assert(isnan(nmea_double(&r.s, 1)));
+	assert(isnan(nmea_double(&r.s, 3)));
+	assert(nmea_char(&r.s, 4) == 'N');
+	assert(isnan(nmea_double(&r.s, 7)));
+	assert(nmea_char(&r.s, 7) == 0);
+	assert(nmea_fieldlen(&r.s, 7) == 0);
+
+	// Not a number.
+	assert(feed(&r, "$GPRMC,12x,A*71\r\n") == 1);
+	assert(isnan(nmea_double(&r.s, 1)));
+
+	// Bad checksum, lower case hex, garbage, truncated and overlong sentences.
+	assert(feed(&r, "$WIMWV,100,R,10.5,N,A*09\r\n") == 0);
+	assert(r.errors == 1);
+	assert(feed(&r, "!AIVDM,1,1,,A,13@oS`GP1=11tD0OhAo=VOw40HCj,0*1c\r\n") == 1);
+	assert(feed(&r, "xx\r\n") == 0);
+	assert(r.garbage == 2);
+	assert(feed(&r, "$WIMWV,100,R,1$WIMWV,100,R,10.5,N,A*08\n") == 1);
+	assert(r.errors == 2);
+	char longline[200];
+	memset(longline, 'A', sizeof longline);
+	longline[0] = '$';
+	strcpy(longline + 150, "*00\r\n");
+	assert(feed(&r, longline) == 0);
+	assert(r.errors == 3);
+	assert(feed(&r, "$WIMWV,100,R,10.5,N,A*08 \r\n") == 0);
+	assert(r.errors == 4);
+
+	// OS500 compass.
+	assert(feed(&r, "$C309.8P4.0R-2.9T25.1*03\r\n") == 1);
+	assert(r.s.nfields == 1);
+
+	// Dispatch.
+	const struct NMEAHandler handlers[] = {
+		{ "GPRMC", handle_rmc },
+		{ "WIMWV", handle_mwv },
+		{ "C", handle_c },
+	};
+	struct NMEADispatch d;
+	assert(nmea_dispatch_init(&d, handlers, 3));
+	int ok = 1;
+	assert(nmea_dispatch(&d, &r.s, &ok) == 1);
+	assert(calls[2] == 1);
+	feed(&r, "$WIMWV,100,R,10.5,N,A*08\r\n");
+	ok = 0;
+	assert(nmea_dispatch(&d, &r.s, &ok) == 0);
+	assert(calls[1] == 1);
+	feed(&r, "$GPGGA,1*4B\r\n");
+	assert(nmea_dispatch(&d, &r.s, &ok) == -1);
+	feed(&r, "$CA,1*1F\r\n");
+	assert(r.s.nfields == 2);
+	assert(nmea_dispatch(&d, &r.s, &ok) == -1);
+	assert(calls[0] == 0 && calls[1] == 1 && calls[2] == 1);
+
+	// Duplicates can't be told apart.
+	const struct NMEAHandler dups[] = {
+		{ "GPRMC", handle_rmc },
+		{ "GPRMC", handle_mwv },
+	};
+	assert(!nmea_dispatch_init(&d, dups, 2));
+
+	puts("OK");
+	return 0;
+}
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <time.h>
 
 int64_t now_ms() { return now_us()/1000; }
 int64_t now_us() {
@@ -24,6 +25,15 @@ int64_t now_us() {
         return us;
 }
 
+int64_t now_mono_ms() {
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0) {
+		fprintf(stderr, "no working monotonic clock");
+		exit(1);
+	}
+	return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+}
+
 // TODO handle restart 
 int64_t timer_tick(struct Timer* t,  int64_t now, int start) {
 	start = start ? 0 : 1;
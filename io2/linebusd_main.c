@@ -67,6 +67,7 @@ usage(void)
 		"options:\n"
 		"\t-d debug   (don't go daemon, don't syslog)\n"
 		"\t-c cmdchar command prefix character (default '$')\n"
+		"\t-L file    log to file in binary, see slogcat\n"
 		, argv0);
 	exit(2);
 }
@@ -115,7 +116,7 @@ reap_filters()
 	while (*prevp) {
 		struct Filter* curr = *prevp;
 		if(curr->refcount < 0) {
-			syslog(LOG_DEBUG, "deleting filter '%s'", curr->pfx);
+			slog(LOG_DEBUG, "deleting filter '%s'", curr->pfx);
 			*prevp = curr->next;
 			free(curr);
 		} else {
@@ -190,11 +191,11 @@ new_client(int sck)
 	cl->fd = accept(sck, (struct sockaddr*)&cl->addr, &cl->addrlen);
 	if (cl->fd < 0) {
 		// probably hung up before we got here, no reason to crash.
-		syslog(LOG_INFO, "accept:%s", strerror(errno));
+		slog(LOG_INFO, "accept:%s", strerror(errno));
 		free(cl);
 		return NULL;
 	}
-	syslog(LOG_INFO, "New client: %d", cl->fd);
+	slog(LOG_INFO, "New client: %d", cl->fd);
         if (fcntl(cl->fd,  F_SETFL, O_NONBLOCK) < 0) crash("fcntl(in)");
 	cl->next = clients;
 	clients = cl;
@@ -248,10 +249,10 @@ reap_clients()
 		struct Client* curr = *prevp;
 		if (curr->fd < 0) {
 			if (curr->precious) {
-				syslog(LOG_WARNING, "Closed precious client %s, shutting down.\n", curr->name ? curr->name : "<anon>");
+				slog(LOG_WARNING, "Closed precious client %s, shutting down.\n", curr->name ? curr->name : "<anon>");
 				crash("lost precious client.");
 			}
-			syslog(LOG_NOTICE, "Closed client %s.\n", curr->name ? curr->name : "<anon>");
+			slog(LOG_NOTICE, "Closed client %s.\n", curr->name ? curr->name : "<anon>");
 			*prevp = curr->next;
 			free_filters(curr->filters);
 			free(curr);
@@ -278,17 +279,17 @@ handle_cmd(struct Client* client, char* line) {
 
 	if (strncmp("name ", line, 5) == 0) {
 		if(client->name) {
-			syslog(LOG_NOTICE, "Client %d renamed '%s' from '%s'", client->fd, line + 5, client->name);
+			slog(LOG_NOTICE, "Client %d renamed '%s' from '%s'", client->fd, line + 5, client->name);
 			free(client->name);
 		} else {
-			syslog(LOG_NOTICE, "Client %d named '%s'", client->fd, line + 5);
+			slog(LOG_NOTICE, "Client %d named '%s'", client->fd, line + 5);
 		}
 		client->name = strndup(line+5, 20);
 		return;
 	}
 
 	if (strncmp("kill ", line, 5) == 0) {
-		syslog(LOG_NOTICE, "Client %d killing '%s'", client->fd, line + 5);
+		slog(LOG_NOTICE, "Client %d killing '%s'", client->fd, line + 5);
 		struct Client* cl;
 		for(cl = clients; cl; cl=cl->next) {
 			if (cl->name && !strcmp(cl->name, line+5)) {
@@ -301,19 +302,19 @@ handle_cmd(struct Client* client, char* line) {
 
 	if (strcmp("xoff", line) == 0) {
 		client->xoff = 1;
-		syslog(LOG_NOTICE, "Client %s (%d) set xoff\n", client_name(client), client->fd);
+		slog(LOG_NOTICE, "Client %s (%d) set xoff\n", client_name(client), client->fd);
 		return;
 	}
 
 	if (strcmp("xon", line) == 0) {
 		client->xoff = 0;
-		syslog(LOG_NOTICE, "Client %s (%d) set xon\n", client_name(client), client->fd);
+		slog(LOG_NOTICE, "Client %s (%d) set xon\n", client_name(client), client->fd);
 		return;
 	}
 
 	if (strcmp("precious", line) == 0) {
 		client->precious = 1;
-		syslog(LOG_NOTICE, "Client %s (%d) set precious\n", client_name(client), client->fd);
+		slog(LOG_NOTICE, "Client %s (%d) set precious\n", client_name(client), client->fd);
 		return;
 	}
 
@@ -329,7 +330,7 @@ handle_cmd(struct Client* client, char* line) {
 	}
 
 	if (strncmp("subscribe ", line, 10) == 0) {
-		syslog(LOG_NOTICE, "Client %s (%d) subscribed:'%s'\n", client_name(client), client->fd, line + 10);
+		slog(LOG_NOTICE, "Client %s (%d) subscribed:'%s'\n", client_name(client), client->fd, line + 10);
 		client->filters = add_filter(client->filters, new_filter(line+10));
 		return;
 	}
@@ -350,9 +351,12 @@ int main(int argc, char* argv[]) {
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "c:dhtv")) != -1){
+	const char* logfile = NULL;
+
+	while ((ch = getopt(argc, argv, "c:dhL:tv")) != -1){
 		switch (ch) {
 		case 'c': cmdchar = optarg[0]; break;
+		case 'L': logfile = optarg; break;
 		case 'd': ++debug; break;
 		case 't': ++timing; break;
 		case 'v': ++verbose; break;
@@ -375,6 +379,8 @@ int main(int argc, char* argv[]) {
 
 	openlog(argv0, debug?LOG_PERROR:0, LOG_DAEMON);
 	if(!debug) setlogmask(LOG_UPTO(LOG_NOTICE));
+	if (logfile && slog_binary(logfile) < 0) crash("opening %s", logfile);
+	slog_flush();  // from now on only when idle
 
 	// Set up socket.
 	unlink(argv[0]);
@@ -401,7 +407,7 @@ int main(int argc, char* argv[]) {
 		free(path_to_pidfile);
 	}
 
-	syslog(LOG_NOTICE, "Started on socket %s", argv[0]);
+	slog(LOG_NOTICE, "Started on socket %s", argv[0]);
 
 	if (signal(SIGPIPE, SIG_IGN) == SIG_ERR) crash("signal");
 
@@ -433,10 +439,20 @@ int main(int argc, char* argv[]) {
 			slog((debug?LOG_DEBUG:LOG_WARNING), "slow cycle: " OFMT_TIMER_STATS(stats));
 		}
 
-		int r = pselect(max_fd + 1, &rfds, &wfds, NULL, NULL, &empty_mask);
+		// Write the log only if we would block anyway.
+		fd_set rfds_idle = rfds;
+		fd_set wfds_idle = wfds;
+		struct timespec nowait = { 0, 0 };
+		int r = pselect(max_fd + 1, &rfds, &wfds, NULL, &nowait, &empty_mask);
+		if (r == 0) {
+			slog_flush();
+			rfds = rfds_idle;
+			wfds = wfds_idle;
+			r = pselect(max_fd + 1, &rfds, &wfds, NULL, NULL, &empty_mask);
+		}
 		if (r == -1 && errno != EINTR) crash("pselect");
 		timer_tick_now(&timer, 1);
-		if(debug > 1) syslog(LOG_DEBUG, "woke up %d\n", r);
+		if(debug > 1) slog(LOG_DEBUG, "woke up %d\n", r);
 
 		int notdonewriting = 0;
 		for (cl = clients; cl; cl = cl->next)
@@ -445,7 +461,7 @@ int main(int argc, char* argv[]) {
 					++notdonewriting;
 
 		if(notdonewriting) { 		// blocked ones won't have been counted
-			syslog(LOG_DEBUG, "Not done writing: %d", notdonewriting);
+			slog(LOG_DEBUG, "Not done writing: %d", notdonewriting);
 			continue;
 		}
 
@@ -480,9 +496,9 @@ int main(int argc, char* argv[]) {
 					if (client_puts(cl, buf) < 0) {
 						cl->dropped++;
 						if (cl->dropped % 10 == 0)
-							syslog(LOG_DEBUG, "Client %s (%d) dropped %d messages\n", client_name(cl), cl->fd, cl->dropped);
+							slog(LOG_DEBUG, "Client %s (%d) dropped %d messages\n", client_name(cl), cl->fd, cl->dropped);
 						if (cl->precious && cl->dropped > 100) { // drop 100 messages and you're hung
-							syslog(LOG_WARNING, "Assuming client %s (%d) is hung\n", client_name(cl), cl->fd);
+							slog(LOG_WARNING, "Assuming client %s (%d) is hung\n", client_name(cl), cl->fd);
 							close(cl->fd);
 							cl->fd = -1;
 						}
@@ -0,0 +1,198 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+#include "mtdata.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "mtcp.h"
+
+int
+mt_layout(struct MTLayout* l, uint16_t mode, uint32_t settings)
+{
+	memset(l, 0xff, sizeof *l);  // all -1
+	if (settings & IMU_OS_FF_MASK) return -1;
+
+	// In the order of the Low Level Communication Guide, section MTData.
+	int n = 0;
+	if (mode & IMU_OM_TMP) { l->temp = n; n += 4; }
+
+	if (mode & IMU_OM_CAL) {
+		if (!(settings & IMU_OS_CM_DISACC)) { l->acc = n; n += 3*4; }
+		if (!(settings & IMU_OS_CM_DISGYR)) { l->gyr = n; n += 3*4; }
+		if (!(settings & IMU_OS_CM_DISMAG)) { l->mag = n; n += 3*4; }
+	}
+
+	if (mode & IMU_OM_ORI) {
+		switch (settings & IMU_OS_OR_MASK) {
+		case 0:                n += 4*4; break;  // quaternions
+		case IMU_OS_OR_EULER:  l->euler = n; n += 3*4; break;
+		case IMU_OS_OR_MATRIX: n += 9*4; break;
+		default: return -1;
+		}
+	}
+
+	if (mode & IMU_OM_AUX) {
+		if (!(settings & IMU_OS_AU_DIS1)) n += 2;
+		if (!(settings & IMU_OS_AU_DIS2)) n += 2;
+	}
+
+	if (mode & IMU_OM_POS) { l->pos = n; n += 3*4; }
+	if (mode & IMU_OM_VEL) { l->vel = n; n += 3*4; }
+	if (mode & IMU_OM_STS) { l->status = n; n += 1; }
+	if (settings & IMU_OS_TS_SC) n += 2;  // sample counter, unused
+	if (settings & IMU_OS_TS_UTC) { l->utc = n; n += 12; }
+
+	l->len = n;
+	return 0;
+}
+
+static float
+decode_float(const uint8_t* d)
+{
+	union { uint32_t u; float f; } v;
+	v.u = (uint32_t)d[0] << 24 | (uint32_t)d[1] << 16 | (uint32_t)d[2] << 8 | d[3];
+	return v.f;
+}
+
+static void
+decode3(const uint8_t* d, double* x, double* y, double* z)
+{
+	*x = decode_float(d);
+	*y = decode_float(d + 4);
+	*z = decode_float(d + 8);
+}
+
+int
+mt_decode(const struct MTLayout* l, const uint8_t* b, int len, int want, int forcetime,
+	  struct IMUProto* vars, uint8_t* status)
+{
+	if (len < l->len) return -1;
+
+	if ((want & MT_TEMP) && l->temp >= 0)
+		vars->temp_c = decode_float(b + l->temp);
+	if ((want & MT_ACC) && l->acc >= 0)
+		decode3(b + l->acc, &vars->acc_x_m_s2, &vars->acc_y_m_s2, &vars->acc_z_m_s2);
+	if ((want & MT_GYR) && l->gyr >= 0)
+		decode3(b + l->gyr, &vars->gyr_x_rad_s, &vars->gyr_y_rad_s, &vars->gyr_z_rad_s);
+	if ((want & MT_MAG) && l->mag >= 0)
+		decode3(b + l->mag, &vars->mag_x_au, &vars->mag_y_au, &vars->mag_z_au);
+	if ((want & MT_EULER) && l->euler >= 0)
+		decode3(b + l->euler, &vars->roll_deg, &vars->pitch_deg, &vars->yaw_deg);
+	if ((want & MT_POS) && l->pos >= 0)
+		decode3(b + l->pos, &vars->lat_deg, &vars->lng_deg, &vars->alt_m);
+	if ((want & MT_VEL) && l->vel >= 0)
+		decode3(b + l->vel, &vars->vel_x_m_s, &vars->vel_y_m_s, &vars->vel_z_m_s);
+
+	if (l->status >= 0)
+		*status = b[l->status];
+
+	if (l->utc >= 0) {
+		/*
+		  0 Nanoseconds of second, range 0 .. 1.000.000.000
+		  4 Year, range 1999 .. 2099
+		  6 Month, range 1..12
+		  7 Day of Month, range 1..31
+		  8 Hour of Day, range 0..23
+		  9 Minute of Hour, range 0..59
+		  10 Seconds of Minute, range 0..59
+		  11 0x01 = Valid Time of Week
+		  0x02 = Valid Week Number
+		  0x04 = Valid UTC
+		*/
+		const uint8_t* u = b + l->utc;
+		if (forcetime || (u[11] & 0x4)) {
+			struct tm t;
+			memset(&t, 0, sizeof t);
+			t.tm_sec  = u[10];
+			t.tm_min  = u[9];
+			t.tm_hour = u[8];
+			t.tm_mday = u[7];
+			t.tm_mon  = u[6] - 1;
+			t.tm_year = (u[4]<<8) + u[5] - 1900;
+			int64_t ns = (uint32_t)u[0] << 24 | (uint32_t)u[1] << 16 | (uint32_t)u[2] << 8 | u[3];
+			vars->gps_timestamp_ms = timegm(&t) * 1000LL + ns / 1000000;
+		}
+	}
+
+	return 0;
+}
+
+enum { PREAMBLE, BID, MID, LEN, EXTLENHI, EXTLENLO, DATA, CHECKSUM };
+
+int
+mt_putc(struct MTReader* r, uint8_t c)
+{
+	switch (r->state) {
+	case PREAMBLE:
+		if (c == 0xfa) r->state = BID;
+		else r->garbage++;
+		return 0;
+
+	case BID:
+		if (c == 0xff) {
+			r->chk = c;
+			r->state = MID;
+		} else if (c != 0xfa) {
+			r->garbage += 2;
+			r->state = PREAMBLE;
+		} else {
+			r->garbage++;
+		}
+		return 0;
+
+	case MID:
+		r->mid = c;
+		r->chk += c;
+		r->state = LEN;
+		return 0;
+
+	case LEN:
+		r->chk += c;
+		if (c == 0xff) {
+			r->state = EXTLENHI;
+			return 0;
+		}
+		r->len = c;
+		break;
+
+	case EXTLENHI:
+		r->chk += c;
+		r->len = c << 8;
+		r->state = EXTLENLO;
+		return 0;
+
+	case EXTLENLO:
+		r->chk += c;
+		r->len |= c;
+		break;
+
+	case DATA:
+		r->chk += c;
+		r->buf[r->pos++] = c;
+		if (r->pos == r->len) r->state = CHECKSUM;
+		return 0;
+
+	case CHECKSUM:
+		r->state = PREAMBLE;
+		r->chk += c;
+		if (r->chk != 0) {
+			r->errors++;
+			return 0;
+		}
+		r->messages++;
+		return 1;
+	}
+
+	// Got the length.
+	if (r->len > MT_MAXLEN) {
+		r->errors++;
+		r->state = PREAMBLE;
+		return 0;
+	}
+	r->pos = 0;
+	r->state = r->len ? DATA : CHECKSUM;
+	return 0;
+}
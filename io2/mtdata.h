@@ -0,0 +1,85 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Streaming decoder for MT Communication Protocol messages (see mtcp.h)
+// and MTData payloads.
+//
+// The MTData payload has no tags, the presence and position of every
+// variable follows from the output mode and settings the device was
+// configured with.  mt_layout computes the offsets once, after that
+// decoding a message is a handful of loads at fixed offsets.
+//
+#ifndef _IO_MTDATA_H_
+#define _IO_MTDATA_H_
+
+#include <stdint.h>
+
+#include "proto/imu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { MT_MAXLEN = 2048 };  // largest payload we accept
+
+// Byte offsets of the variables in an MTData payload, -1 if not present.
+struct MTLayout {
+	int len;	// payload length implied by mode and settings
+	int temp;	// float
+	int acc;	// 3 floats
+	int gyr;	// 3 floats
+	int mag;	// 3 floats
+	int euler;	// 3 floats, only if the orientation is sent as euler angles
+	int pos;	// 3 floats
+	int vel;	// 3 floats
+	int status;	// 1 byte
+	int utc;	// 12 bytes
+};
+
+// Returns 0, or -1 if the settings use a float format we can't decode.
+int mt_layout(struct MTLayout* l, uint16_t mode, uint32_t settings);
+
+// Groups of IMUProto fields, to select what to decode and print.
+enum {
+	MT_TEMP  = 1<<0,
+	MT_ACC   = 1<<1,
+	MT_GYR   = 1<<2,
+	MT_MAG   = 1<<3,
+	MT_EULER = 1<<4,
+	MT_POS   = 1<<5,
+	MT_VEL   = 1<<6,
+	MT_ALL   = (1<<7) - 1,
+};
+
+// Fill the fields in want from payload b of length len.  Fields that are
+// not wanted or not in the layout are left alone.  The status byte and the
+// utc time are always decoded, the latter only if the device flags it valid
+// or forcetime is set.
+// Returns 0 on success, -1 if the payload is shorter than the layout.
+int mt_decode(const struct MTLayout* l, const uint8_t* b, int len, int want, int forcetime,
+	      struct IMUProto* vars, uint8_t* status);
+
+// Frame assembler with incremental checksum. Feed it bytes as they are
+// read, it returns 1 when mid, len and buf hold a complete message with
+// a valid checksum.
+struct MTReader {
+	int state;
+	uint8_t chk;
+	uint8_t mid;
+	int len;
+	int pos;
+	uint8_t buf[MT_MAXLEN];
+
+	int64_t messages;	// valid messages
+	int64_t errors;		// bad checksums and oversized messages
+	int64_t garbage;	// bytes skipped looking for a preamble
+};
+
+int mt_putc(struct MTReader* r, uint8_t c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IO_MTDATA_H_
@@ -0,0 +1,150 @@
+#include "mtdata.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mtcp.h"
+
+static uint8_t*
+put_float(uint8_t* p, float f)
+{
+	union { uint32_t u; float f; } v;
+	v.f = f;
+	*p++ = v.u >> 24; *p++ = v.u >> 16; *p++ = v.u >> 8; *p++ = v.u;
+	return p;
+}
+
+// Wrap payload into a complete message, returns its length.
+static int
+frame(uint8_t mid, const uint8_t* payload, int len, uint8_t* out)
+{
+	uint8_t* p = out;
+	*p++ = 0xfa;
+	*p++ = 0xff;
+	*p++ = mid;
+	if (len < 255) {
+		*p++ = len;
+	} else {
+		*p++ = 0xff;
+		*p++ = len >> 8;
+		*p++ = len;
+	}
+	memcpy(p, payload, len);
+	p += len;
+	uint8_t chk = 0;
+	const uint8_t* q;
+	for (q = out + 1; q < p; q++) chk += *q;
+	*p++ = -chk;
+	return p - out;
+}
+
+static int
+feed(struct MTReader* r, const uint8_t* b, int len)
+{
+	int i, n = 0;
+	for (i = 0; i < len; i++) n += mt_putc(r, b[i]);
+	return n;
+}
+
+int main(int argc, char* argv[]) {
+	struct MTLayout l;
+	assert(mt_layout(&l, IMU_OUTPUT_MODE, IMU_OUTPUT_SETTINGS) == 0);
+	assert(l.temp == 0 && l.acc == 4 && l.gyr == 16 && l.mag == 28 && l.euler == 40);
+	assert(l.pos == 52 && l.vel == 64 && l.status == 76 && l.utc == 77 && l.len == 89);
+
+	// Orientation does not depend on the calibrated data being sent.
+	assert(mt_layout(&l, IMU_OM_TMP|IMU_OM_ORI, IMU_OS_OR_EULER) == 0);
+	assert(l.euler == 4 && l.acc == -1 && l.len == 16);
+	assert(mt_layout(&l, IMU_OM_CAL|IMU_OM_ORI|IMU_OM_STS, IMU_OS_CM_DISGYR|IMU_OS_OR_MATRIX|IMU_OS_TS_SC) == 0);
+	assert(l.acc == 0 && l.gyr == -1 && l.mag == 12 && l.euler == -1 && l.status == 60 && l.len == 63);
+	assert(mt_layout(&l, IMU_OUTPUT_MODE, IMU_OUTPUT_SETTINGS|IMU_OS_FF_MASK) == -1);
+
+	// A default MTData payload.
+	uint8_t payload[MT_MAXLEN];
+	memset(payload, 0, sizeof payload);
+	uint8_t* p = payload;
+	p = put_float(p, 21.5);
+	int i;
+	for (i = 0; i < 9; i++) p = put_float(p, i + 1);	// acc, gyr, mag
+	p = put_float(p, 1.5); p = put_float(p, -2.5); p = put_float(p, 90);  // roll pitch yaw
+	p = put_float(p, 48.25); p = put_float(p, -4.75); p = put_float(p, 12);
+	p = put_float(p, 1); p = put_float(p, 0); p = put_float(p, 0);
+	*p++ = IMU_STS_XKF|IMU_STS_GPS;
+	uint8_t utc[12] = { 0, 0x0f, 0x42, 0x40, 2012>>8, 2012&0xff, 5, 1, 12, 30, 15, 0x04 };  // 1ms
+	memcpy(p, utc, 12);
+	p += 12;
+	assert(p - payload == 89);
+
+	uint8_t msg[MT_MAXLEN + 8];
+	int n = frame(IMU_MTDATA, payload, 89, msg);
+
+	struct MTReader r;
+	memset(&r, 0, sizeof r);
+	uint8_t junk[] = { 0x12, 0xfa, 0x34, 0xfa };
+	assert(feed(&r, junk, sizeof junk) == 0);
+	assert(feed(&r, msg, n) == 1);
+	assert(r.mid == IMU_MTDATA && r.len == 89 && r.messages == 1 && r.errors == 0);
+	assert(r.garbage == 4);
+
+	assert(mt_layout(&l, IMU_OUTPUT_MODE, IMU_OUTPUT_SETTINGS) == 0);
+	struct IMUProto vars = INIT_IMUPROTO;
+	uint8_t status = 0;
+	assert(mt_decode(&l, r.buf, r.len, MT_ALL, 0, &vars, &status) == 0);
+	assert(status == (IMU_STS_XKF|IMU_STS_GPS));
+	assert(vars.temp_c == 21.5);
+	assert(vars.acc_x_m_s2 == 1 && vars.gyr_y_rad_s == 5 && vars.mag_z_au == 9);
+	assert(vars.roll_deg == 1.5 && vars.pitch_deg == -2.5 && vars.yaw_deg == 90);
+	assert(vars.lat_deg == 48.25 && vars.lng_deg == -4.75 && vars.alt_m == 12);
+	assert(vars.vel_x_m_s == 1);
+	assert(vars.gps_timestamp_ms == 1335875415001LL);  // 2012-05-01 12:30:15.001 UTC
+
+	// Only what is wanted is touched.
+	struct IMUProto pos = INIT_IMUPROTO;
+	assert(mt_decode(&l, r.buf, r.len, MT_POS, 0, &pos, &status) == 0);
+	assert(pos.lat_deg == 48.25 && isnan(pos.temp_c) && isnan(pos.yaw_deg));
+
+	// Invalid utc is ignored unless forced.
+	r.buf[l.utc + 11] = 0;
+	pos.gps_timestamp_ms = 0;
+	assert(mt_decode(&l, r.buf, r.len, 0, 0, &pos, &status) == 0);
+	assert(pos.gps_timestamp_ms == 0);
+	assert(mt_decode(&l, r.buf, r.len, 0, 1, &pos, &status) == 0);
+	assert(pos.gps_timestamp_ms == 1335875415001LL);
+
+	// Short payloads are refused.
+	assert(mt_decode(&l, r.buf, 88, MT_ALL, 0, &vars, &status) == -1);
+
+	// Bad checksum, then resync on the next message.
+	msg[10] ^= 1;
+	assert(feed(&r, msg, n) == 0);
+	assert(r.errors == 1);
+	msg[10] ^= 1;
+	assert(feed(&r, msg, n) == 1);
+	assert(r.messages == 2);
+
+	// Byte by byte and back to back.
+	uint8_t two[2 * sizeof msg];
+	memcpy(two, msg, n);
+	memcpy(two + n, msg, n);
+	assert(feed(&r, two, 2 * n) == 2);
+
+	// Extended length.
+	n = frame(IMU_MTDATA, payload, 300, msg);
+	assert(feed(&r, msg, n) == 1);
+	assert(r.len == 300);
+
+	// Too long for us.
+	uint8_t big[] = { 0xfa, 0xff, IMU_MTDATA, 0xff, 0xff, 0xff };
+	assert(feed(&r, big, sizeof big) == 0);
+	assert(r.errors == 2);
+
+	// Empty message, e.g. an ack.
+	n = frame(IMU_GOTOMEASUREMENTACK, payload, 0, msg);
+	assert(feed(&r, msg, n) == 1);
+	assert(r.mid == IMU_GOTOMEASUREMENTACK && r.len == 0);
+
+	puts("OK");
+	return 0;
+}
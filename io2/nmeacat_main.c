@@ -2,9 +2,15 @@
 // Use of this source code is governed by the Apache License 2.0
 // that can be found in the LICENSE file.
 //
-// Open serial port, decode NMEA messages and print in the various
+// Open serial ports, decode NMEA messages and print in the various
 // ../proto/*.h formats.
 //
+// Several ports can be read by one process, e.g.
+//   nmeacat -s /var/run/lbus /dev/compass:19200 /dev/wind:4800 /dev/gps:4800
+// Each port has its own watchdog and garbage counters, so a dead or
+// noisy sensor is still reported by name.  The watchdog is only fed by
+// sentences a parser accepted, valid but unhandled ones don't count.
+//
 // NMEA 0183 official page:
 // http://www.nmea.org/content/nmea_standards/nmea_083_v_400.asp
 //
@@ -23,9 +29,8 @@
 //  AIS: 38400
 //  Compass: 19200
 //  Wind, GPS: 4800
-// TODO: auto sensing, read a couple of times until valid_nmea
+// TODO: auto sensing, read a couple of times until a valid sentence
 //
-#include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <stdarg.h>
@@ -37,7 +42,10 @@
 #include <termios.h>
 #include <time.h>
 #include <signal.h>
+#include <poll.h>
+#include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/un.h>
 #include <unistd.h>
 
 #include "proto/compass.h"
@@ -45,6 +53,7 @@
 #include "proto/wind.h"
 
 #include "lib/log.h"
+#include "lib/nmea.h"
 #include "lib/timer.h"
 
 #include "ais.h"
@@ -58,18 +67,22 @@ static void
 usage(void)
 {
 	fprintf(stderr,
-		"usage: %s [options] [/dev/ttyXX]\n"
+		"usage: %s [options] [/dev/ttyXX[:baudrate[:seconds]] ...]\n"
 		"options:\n"
 		"\t-a bias	add this many degrees to measured angle\n"
 		"\t-b baudrate  (default 4800). Use 19200 for compass, 38400 for AIS\n"
 		"\t-d debug     -dd is open serial as plain file\n"
 		"\t-g seconds   default 10, use 0 to disable:if no signal for this many seconds, exit.\n"
+		"\t-n name      name to register with linebusd (default nmeacat)\n"
+		"\t-s /path/to/socket  write to linebusd directly instead of stdout\n"
+		"Baudrate and guard time can be given per port, they default to -b and -g.\n"
+		"Without ports, reads stdin.  kill -USR1 logs per port statistics.\n"
 		, argv0);
 	exit(2);
 }
 
 static void
-setserial(int port, int baudrate, char* dev)
+setserial(int port, int baudrate, const char* dev)
 {
 	struct termios t;
 	if (tcgetattr(port, &t) < 0) crash("tcgetattr(%s)", dev);
@@ -94,75 +107,97 @@ setserial(int port, int baudrate, char* dev)
 }
 
 // -----------------------------------------------------------------------------
-// Return NULL if not valid, or a pointer to the '*' checksum delimiter
-static char*
-valid_nmea(char* line)
-{
-	if (line[0] != '!' && line[0] != '$') return NULL;
-	char* chk = strchr(line, '*');
-	if (!chk) return NULL;
-
-	char* p;
-	char x = 0;
-	for (p = line + 1; p < chk; p++) x ^= *p;
-	char chkstr[3];
-	snprintf(chkstr, sizeof chkstr, "%02X", x);
-	if (chk[1] != chkstr[0]) return 0;
-	if (chk[2] != chkstr[1]) return 0;
-#if 1
-	if (chk[3] != '\r' && chk[3] != '\n') return NULL;
-	if (chk[4] != '\n' && chk[4] != 0) return NULL;
-#endif
-	return chk;
-}
+
+struct Port {
+	const char* dev;
+	int fd;
+	int baudrate;
+	int alarm_s;		// 0: no watchdog
+	struct NMEAReader reader;
+	int64_t errors;		// reader counters at the last valid sentence
+	int64_t garbage;
+	int64_t deadline_ms;	// watchdog expiry
+	int64_t now_ms;		// time the current sentence was read
+	int64_t mono_ms;	// same, CLOCK_MONOTONIC
+	struct Timer timer;	// start: read returned, stop: done parsing
+	struct aivdm_context_t ais_contexts[AIVDM_CHANNELS];
+};
+
+enum { MAXPORTS = 8 };
+static struct Port ports[MAXPORTS];
+static int nports = 0;
+
+// -----------------------------------------------------------------------------
+// The parsers get the sentence and the port it was received on.
+
+static double wind_bias = WIND_ANGLE_BIAS_DEG;
 
 // $WIMWV,179,R,8.0,N,A
 static int
-parse_wimvx(char* sentence, struct WindProto* p)
+parse_wimwv(const struct NMEASentence* s, void* arg)
 {
-	char rel = 0;
-	char units = 0;
-	char valid = 0;
- 	double speed = NAN;
-	int n = sscanf(sentence, "WIMWV,%lf,%c,%lf,%c,%c,", &p->angle_deg, &rel, &speed, &units, &valid);
-	if (n != 5) {
-		p->angle_deg = NAN;
-		speed = NAN;
-		n = sscanf(sentence, "WIMWV,,%c,,%c,%c,", &rel, &units, &valid);
-		if (n != 3) return 0;
-	}
-
-	p->relative = rel == 'R';
-	switch(units) {
-	case 'K': p->speed_m_s = speed * (1000.0/3600.0); break;// 1 km/h == 1000m / 3600s
-	case 'M': p->speed_m_s = speed; break;
-	case 'N': p->speed_m_s = speed * (1852.0/3600.0); break; // 1 knot == 1852m / 3600s
+	struct WindProto vars = INIT_WINDPROTO;
+	vars.angle_deg = nmea_double(s, 1);
+	double speed = nmea_double(s, 3);
+
+	vars.relative = nmea_char(s, 2) == 'R';
+	switch(nmea_char(s, 4)) {
+	case 'K': vars.speed_m_s = speed * (1000.0/3600.0); break;// 1 km/h == 1000m / 3600s
+	case 'M': vars.speed_m_s = speed; break;
+	case 'N': vars.speed_m_s = speed * (1852.0/3600.0); break; // 1 knot == 1852m / 3600s
 	default: return 0;
 	}
 
-	p->valid = valid == 'A';
+	vars.valid = nmea_char(s, 5) == 'A';
 
+	if (wind_bias  != 0.0) {
+		vars.angle_deg += wind_bias;
+		while(vars.angle_deg >= 360.0) vars.angle_deg -= 360.0;
+		while(vars.angle_deg <    0.0) vars.angle_deg += 360.0;
+	}
+	vars.timestamp_ms = ((struct Port*)arg)->now_ms;
+	vars.mono_timestamp_ms = ((struct Port*)arg)->mono_ms;
+	printf(OFMT_WINDPROTO(vars));
 	return 1;
 }
 
 // $WIXDR, C,35.2,C,2, U,28.3,N,0, U,28.6,V,1, U,3.520,V,2 *7F
 static int
-parse_wixdr(char* sentence, struct WixdrProto* p) {
-	char dumc;
-	int dumd;
-	int n = sscanf(sentence, "WIXDR,%c,%lf,%c,%d,%c,%lf,%c,%d,%c,%lf,%c,%d,%c,%lf,%c,%d,", 
-		       &dumc, &p->temp_c, &dumc, &dumd,
-		       &dumc, &p->vheat_v, &dumc, &dumd,
-		       &dumc, &p->vsupply_v, &dumc, &dumd,
-		       &dumc, &p->vref_v, &dumc, &dumd);
-	return n == 16;
+parse_wixdr(const struct NMEASentence* s, void* arg)
+{
+	struct WixdrProto vars = INIT_WIXDRPROTO;
+	if (s->nfields < 17) return 0;
+	vars.temp_c    = nmea_double(s, 2);
+	vars.vheat_v   = nmea_double(s, 6);
+	vars.vsupply_v = nmea_double(s, 10);
+	vars.vref_v    = nmea_double(s, 14);
+	if (isnan(vars.temp_c) || isnan(vars.vheat_v) || isnan(vars.vsupply_v) || isnan(vars.vref_v))
+		return 0;
+	vars.timestamp_ms = ((struct Port*)arg)->now_ms;
+	printf(OFMT_WIXDRPROTO(vars));
+	return 1;
 }
 
+// $C123.4P-1.2R3.4T25.0*xx
 static int
-parse_compass(char* sentence, struct CompassProto* p)
+parse_compass(const struct NMEASentence* s, void* arg)
 {
-	int n = sscanf(sentence, "C%lfP%lfR%lfT%lf", &p->yaw_deg, &p->pitch_deg, &p->roll_deg, &p->temp_c);
-	return n == 4;
+	struct CompassProto vars = INIT_COMPASSPROTO;
+	double* values[4] = { &vars.yaw_deg, &vars.pitch_deg, &vars.roll_deg, &vars.temp_c };
+	const char* tags = "CPRT";
+	const char* p = nmea_field(s, 0);
+	int i;
+	for (i = 0; i < 4; i++) {
+		char* end;
+		if (*p != tags[i]) return 0;
+		*values[i] = strtod(p + 1, &end);
+		if (end == p + 1) return 0;
+		p = end;
+	}
+	vars.timestamp_ms = ((struct Port*)arg)->now_ms;
+	vars.mono_timestamp_ms = ((struct Port*)arg)->mono_ms;
+	printf(OFMT_COMPASSPROTO(vars));
+	return 1;
 }
 
 // $GPRMC,043356.000,A,3158.7599,S,11552.8689,E,0.24,54.42,101008,,*20
@@ -177,31 +212,27 @@ parse_compass(char* sentence, struct CompassProto* p)
 // Date   120598  ddmmyy
 // Magnetic Variation degrees E=east or W=west
 static int
-parse_gprmc(char* sentence, struct GPSProto *p)
+parse_gprmc(const struct NMEASentence* s, void* arg)
 {
-	double time_dc = NAN;
-	char status = 0;
-	double lat_dc = NAN;
-	char N = 0;
-	double lng_dc = NAN;
-	char E = 0;
-	double sog_k = NAN;
-	double cog_deg = NAN;
-	int64_t date_dc = 0;
-	int n = sscanf(sentence, "GPRMC,%lf,%c,%lf,%c,%lf,%c,%lf,%lf,%lld,",
-		       &time_dc, &status, &lat_dc, &N, &lng_dc, &E, &sog_k, &cog_deg, &date_dc);
-	if (n != 9) {
-		sog_k = NAN;
-		cog_deg = NAN;
-	 	n = sscanf(sentence, "GPRMC,%lf,%c,%lf,%c,%lf,%c,,,%lld,",
-		       &time_dc, &status, &lat_dc, &N, &lng_dc, &E, &date_dc);
-		if (n != 7) return 0;
-	}
+	struct GPSProto vars = INIT_GPSPROTO;
+	double time_dc = nmea_double(s, 1);
+	char status = nmea_char(s, 2);
+	double lat_dc = nmea_double(s, 3);
+	char N = nmea_char(s, 4);
+	double lng_dc = nmea_double(s, 5);
+	char E = nmea_char(s, 6);
+	double sog_k = nmea_double(s, 7);
+	double cog_deg = nmea_double(s, 8);
+	double date = nmea_double(s, 9);
 
 	if (status != 'A' && status != 'V') return 0;
+	// Without a fix there is nothing to print, but the receiver is alive.
+	if (status == 'V' && (isnan(lat_dc) || isnan(lng_dc))) return 1;
+	if (isnan(time_dc) || isnan(lat_dc) || isnan(lng_dc) || isnan(date)) return 0;
 
 	if (status == 'A') {
-	
+
+		int64_t date_dc = date;
 		struct tm t;
 		t.tm_hour = time_dc / 10000;  time_dc -= 10000 * t.tm_hour;
 		t.tm_min  = time_dc / 100;    time_dc -= 100 * t.tm_min;
@@ -210,123 +241,215 @@ parse_gprmc(char* sentence, struct GPSProto *p)
 		t.tm_mday = date_dc / 10000; date_dc %= 10000;
 		t.tm_mon = date_dc / 100; date_dc %= 100;  t.tm_mon--;
 		t.tm_year = 100 + date_dc;
-		p->gps_timestamp_ms = timegm(&t) * 1000LL + ms;
+		vars.gps_timestamp_ms = timegm(&t) * 1000LL + ms;
 	
-		p->lat_deg = trunc(lat_dc / 100.0);  lat_dc -= 100*p->lat_deg;  p->lat_deg += lat_dc / 60.0;
-		if (N == 'S') p->lat_deg *= -1;
+		vars.lat_deg = trunc(lat_dc / 100.0);  lat_dc -= 100*vars.lat_deg;  vars.lat_deg += lat_dc / 60.0;
+		if (N == 'S') vars.lat_deg *= -1;
 
-		p->lng_deg = trunc(lng_dc / 100.0);  lng_dc -= 100*p->lng_deg;  p->lng_deg += lng_dc / 60.0;
-		if (E == 'W') p->lng_deg *= -1;
-		p->speed_m_s = sog_k * (1852.0/3600.0);
-		p->cog_deg = cog_deg;
+		vars.lng_deg = trunc(lng_dc / 100.0);  lng_dc -= 100*vars.lng_deg;  vars.lng_deg += lng_dc / 60.0;
+		if (E == 'W') vars.lng_deg *= -1;
+		vars.speed_m_s = sog_k * (1852.0/3600.0);
+		vars.cog_deg = cog_deg;
 
 	}
+	vars.timestamp_ms = ((struct Port*)arg)->now_ms;
+	vars.mono_timestamp_ms = ((struct Port*)arg)->mono_ms;
+	printf(OFMT_GPSPROTO(vars));
 	return 1;
 }
 
-
-static struct aivdm_context_t ais_contexts[AIVDM_CHANNELS];
+// Fields that are not available are left out, for class B (types 18
+// and 19) as for class A.  Class B positions have the class A scale and
+// not available values (181 and 91 degrees), not those of type 17.
+static void
+print_position(const struct ais_position_t* pos)
+{
+	printf("ais: timestamp_ms:%lld mmsi:%d msgtype:%d ", now_ms(), pos->mmsi, pos->type);
+	if (pos->status != 0)
+		printf("status:%d ", pos->status);		/* navigation status */
+	if (pos->turn != AIS_TURN_NOT_AVAILABLE)
+		printf("rot_deg_min:%d ", pos->turn);	/* rate of turn in deg/minute*/
+	if (pos->speed != AIS_SPEED_NOT_AVAILABLE)
+		printf("speed_m_s:%.1f ", pos->speed *(1852.0/36000.0)); /* speed over ground in deciknots */
+	if (pos->accuracy != 0)
+		printf("accuracy:%d ", pos->accuracy); /* position accuracy */
+	if (pos->lon != AIS_LON_NOT_AVAILABLE && pos->lat != AIS_LAT_NOT_AVAILABLE)
+		printf("lat_deg:%.6f lng_deg:%.6f ",    /* longitude latitude */
+		       pos->lat / AIS_LATLON_SCALE,
+		       pos->lon /  AIS_LATLON_SCALE);
+	if (pos->course != AIS_COURSE_NOT_AVAILABLE)
+		printf("cog_deg:%3.1f ", pos->course*.1);  	/* course over ground */
+	if (pos->heading != AIS_HEADING_NOT_AVAILABLE)
+		printf("heading_deg:%3.0f ",   pos->heading*1.0); /* true heading */
+	if (pos->type == 19)
+		printf("size_m:%d shipname:'%s' ", pos->size_m, pos->shipname);
+	putchar('\n');
+}
 
 static int
-parse_ais(const char* start, const char* end)
+parse_ais(const struct NMEASentence* s, void* arg)
 {
-			struct ais_t ais;
-			if (!aivdm_decode(start, end-start, ais_contexts, &ais)) {
-				if (debug) fprintf(stderr, "Incomplete AIVDM NMEA sentence:%s", start);
-				return 0;
-			}
+	const char* start = s->buf;
+	const char* end = s->buf + s->len;
+	struct ais_position_t pos;
+	switch (aivdm_decode_position(start, end-start, AIS_POS_ALL, &pos)) {
+	case AIVDM_POSITION:
+		if (debug) fprintf(stderr, "#AIVDM:%s\n",start);
+		print_position(&pos);
+		return 1;
+	case AIVDM_INVALID:
+		return 0;
+	}
 
-			if (debug) fprintf(stderr, "#AIVDM:%s",start);
-		  
-			printf("ais: timestamp_ms:%lld mmsi:%d msgtype:%d ", now_ms(), ais.mmsi, ais.type);
-
-			switch(ais.type) {
-			case 1: case 2: case 3:
-				if (ais.type1.status != 0)
-					printf("status:%d ", ais.type1.status);		/* navigation status */
-				if (ais.type1.turn != AIS_TURN_NOT_AVAILABLE)
-					printf("rot_deg_min:%d ", ais.type1.turn);	/* rate of turn in deg/minute*/
-				if (ais.type1.speed != AIS_SPEED_NOT_AVAILABLE)
-					printf("speed_m_s:%.1f ", ais.type1.speed *(1852.0/36000.0)); /* speed over ground in deciknots */
-				if (ais.type1.accuracy != 0)
-					printf("accuracy:%d ", ais.type1.accuracy); /* position accuracy */
-				if (ais.type1.lon != AIS_LON_NOT_AVAILABLE && ais.type1.lat != AIS_LAT_NOT_AVAILABLE)
-					printf("lat_deg:%.6f lng_deg:%.6f ",    /* longitude latitude */
-					       ais.type1.lat / AIS_LATLON_SCALE,
-					       ais.type1.lon /  AIS_LATLON_SCALE);
-				if (ais.type1.course != AIS_COURSE_NOT_AVAILABLE)
-					printf("cog_deg:%3.1f ", ais.type1.course*.1);  	/* course over ground */
-				if (ais.type1.heading != AIS_HEADING_NOT_AVAILABLE)
-					printf("heading_deg:%3.0f ",   ais.type1.heading*1.0); /* true heading */
-				break;
-
-			case 5:
-				printf("size_m:%d shipname:'%s' ", ais.type5.to_bow + ais.type5.to_stern, ais.type5.shipname);
-				break;
-
-			case 18:
-				printf("speed_m_s:%.1f ", ais.type18.speed *(1852.0/36000.0)); /* speed over ground in deciknots */
-				if (ais.type18.accuracy != 0)
-					printf("accuracy:%d ", ais.type18.accuracy); /* position accuracy */
-				if (ais.type18.lon != AIS_GNS_LON_NOT_AVAILABLE && ais.type18.lat != AIS_GNS_LAT_NOT_AVAILABLE)
-					printf("lat_deg:%.6f lng_deg:%.6f ",    /* longitude latitude */
-					       ais.type18.lat / AIS_LATLON_SCALE,
-					       ais.type18.lon /  AIS_LATLON_SCALE);
-				if (ais.type18.course != AIS_COURSE_NOT_AVAILABLE)
-					printf("cog_deg:%3.1f ", ais.type18.course*.1);  	/* course over ground */
-				if (ais.type18.heading != AIS_HEADING_NOT_AVAILABLE)
-					printf("heading_deg:%3.0f ",   ais.type18.heading*1.0); /* true heading */
-
-				break;
-
-			case 19:
-				printf("speed_m_s:%.1f ", ais.type19.speed *(1852.0/36000.0)); /* speed over ground in deciknots */
-				if (ais.type19.accuracy != 0)
-					printf("accuracy:%d ", ais.type19.accuracy); /* position accuracy */
-				if (ais.type19.lon != AIS_GNS_LON_NOT_AVAILABLE && ais.type19.lat != AIS_GNS_LAT_NOT_AVAILABLE)
-					printf("lat_deg:%.6f lng_deg:%.6f ",    /* longitude latitude */
-					       ais.type19.lat / AIS_LATLON_SCALE,
-					       ais.type19.lon /  AIS_LATLON_SCALE);
-				if (ais.type19.course != AIS_COURSE_NOT_AVAILABLE)
-					printf("cog_deg:%3.1f ", ais.type19.course*.1);  	/* course over ground */
-				if (ais.type19.heading != AIS_HEADING_NOT_AVAILABLE)
-					printf("heading_deg:%3.0f ",   ais.type19.heading*1.0); /* true heading */
-
-				printf("size_m:%d shipname:'%s' ", ais.type19.to_bow + ais.type19.to_stern, ais.type19.shipname);
-				break;
-				
-			case 24:
-				printf("size_m:%d shipname:'%s' ", ais.type24.dim.to_bow + ais.type24.dim.to_stern, ais.type24.shipname);
-				break;
+	// Fragments and the less frequent message types.
+	struct ais_t ais;
+	if (!aivdm_decode(start, end-start, ((struct Port*)arg)->ais_contexts, &ais)) {
+		if (debug) fprintf(stderr, "Incomplete AIVDM NMEA sentence:%s\n", start);
+		return 1;
+	}
 
-			}
-			putchar('\n');
+	if (debug) fprintf(stderr, "#AIVDM:%s\n",start);
 
-			return 1;
-		}
-		
+	if (aivdm_position(&ais, &pos)) {
+		print_position(&pos);
+		return 1;
+	}
+
+	printf("ais: timestamp_ms:%lld mmsi:%d msgtype:%d ", now_ms(), ais.mmsi, ais.type);
+
+	switch(ais.type) {
+	case 5:
+		printf("size_m:%d shipname:'%s' ", ais.type5.to_bow + ais.type5.to_stern, ais.type5.shipname);
+		break;
+
+	case 24:
+		printf("size_m:%d shipname:'%s' ", ais.type24.dim.to_bow + ais.type24.dim.to_stern, ais.type24.shipname);
+		break;
+
+	}
+	putchar('\n');
 
+	return 1;
+}
+
+// To support another sentence, add its parser here.
+static const struct NMEAHandler handlers[] = {
+	{ "AIVDM", parse_ais },
+	{ "GPRMC", parse_gprmc },
+	{ "WIMWV", parse_wimwv },
+	{ "WIXDR", parse_wixdr },
+	{ "C",     parse_compass },
+};
 
 // -----------------------------------------------------------------------------
 
-static int alarm_s = 10;
-static void timeout() { crash("No valid nmea sentence for %d seconds.", alarm_s); }
+// dev[:baudrate[:seconds]]
+static void
+parse_port(struct Port* p, char* arg, int baudrate, int alarm_s)
+{
+	memset(p, 0, sizeof *p);
+	p->dev = arg;
+	p->fd = -1;
+	p->baudrate = baudrate;
+	p->alarm_s = alarm_s;
+	char* colon = strchr(arg, ':');
+	if (!colon) return;
+	*colon++ = 0;
+	p->baudrate = atoi(colon);
+	colon = strchr(colon, ':');
+	if (colon) p->alarm_s = atoi(colon + 1);
+}
+
+static int
+connect_linebus(const char* path, const char* name)
+{
+	int s = socket(AF_LOCAL, SOCK_STREAM, 0);
+	if (s < 0) crash("socket");
+
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof addr);
+	addr.sun_family = AF_LOCAL;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	if (connect(s, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+		crash("connect(%s)", path);
+
+	// We only talk, linebusd need not send us anything.
+	char cmd[128];
+	int n = snprintf(cmd, sizeof cmd, "$name %s\n$xoff\n", name);
+	if (write(s, cmd, n) != n) crash("write(%s)", path);
+	return s;
+}
+
+static void
+log_stats(void)
+{
+	int i;
+	for (i = 0; i < nports; i++) {
+		struct Port* p = &ports[i];
+		struct TimerStats stats;
+		if (timer_stats(&p->timer, &stats))
+			slog(LOG_INFO, "port:%s sentences:%lld errors:%lld garbage:%lld reads:%lld",
+			     p->dev, p->reader.sentences, p->reader.errors, p->reader.garbage, stats.count);
+		else
+			slog(LOG_INFO, "port:%s sentences:%lld errors:%lld garbage:%lld reads:" OFMT_TIMER_STATS(stats),
+			     p->dev, p->reader.sentences, p->reader.errors, p->reader.garbage);
+	}
+}
+
+static int sigflg = 0;
+static void setflg(int sig) { sigflg = sig; }
+
+// Feed what was read from p to its reader and dispatch complete sentences.
+static void
+process(struct Port* p, const struct NMEADispatch* dispatch, const char* buf, int n)
+{
+	int i;
+	for (i = 0; i < n; i++) {
+		if (!nmea_putc(&p->reader, buf[i]))
+			continue;
+
+		p->errors = p->reader.errors;
+		p->garbage = p->reader.garbage;
+
+		// Only sentences we can use keep the watchdog quiet.
+		switch (nmea_dispatch(dispatch, &p->reader.s, p)) {
+		case 1:
+			if (p->alarm_s) p->deadline_ms = p->now_ms + 1000LL * p->alarm_s;
+			break;
+		case 0:
+			if (debug) fprintf(stderr, "%s: Invalid NMEA sentence: '%s'\n", p->dev, p->reader.s.buf);
+			break;
+		case -1:
+			if (debug) fprintf(stderr, "%s: Ignoring NMEA sentence: '%s'\n", p->dev, p->reader.s.buf);
+			break;
+		}
+	}
+
+	if (debug && p->reader.errors > p->errors)
+		fprintf(stderr, "%s: Invalid NMEA sentences: %lld\n", p->dev, p->reader.errors - p->errors);
+	if (p->reader.errors - p->errors > 100 || p->reader.garbage - p->garbage > 100 * NMEA_MAXLEN)
+		crash("Only garbage from nmea producer %s", p->dev);
+}
 
 int main(int argc, char* argv[]) {
 
 	int ch;
 	int baudrate = 4800; // Compass: 19200, AIS: 38400
-	double wind_bias =  WIND_ANGLE_BIAS_DEG;
+	int alarm_s = 10;
+	const char* lbus = NULL;
+	const char* name = "nmeacat";
 
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "a:b:dg:h")) != -1){
+	while ((ch = getopt(argc, argv, "a:b:dg:hn:s:")) != -1){
 		switch (ch) {
 		case 'a': wind_bias = atof(optarg); break;
 		case 'b': baudrate = atoi(optarg); break;
 		case 'd': ++debug; break;
 		case 'g': alarm_s = atoi(optarg); break;
+		case 'n': name = optarg; break;
+		case 's': lbus = optarg; break;
 		case 'h': 
 		default:
 			usage();
@@ -336,116 +459,96 @@ int main(int argc, char* argv[]) {
 	argv += optind;
 	argc -= optind;
 
-	if (argc > 1) usage();
+	if (argc > MAXPORTS) usage();
 	
 	if (signal(SIGBUS, fault) == SIG_ERR)  crash("signal(SIGBUS)");
 	if (signal(SIGSEGV, fault) == SIG_ERR)  crash("signal(SIGSEGV)");
-	if (signal(SIGALRM, timeout) == SIG_ERR)  crash("signal(SIGSALRM)");
+	if (signal(SIGUSR1, setflg) == SIG_ERR)  crash("signal(SIGUSR1)");
+	if (signal(SIGPIPE, SIG_IGN) == SIG_ERR)  crash("signal(SIGPIPE)");
 
 	openlog(argv0, debug?LOG_PERROR:0, LOG_DAEMON);
 
+	if (lbus) {
+		int s = connect_linebus(lbus, name);
+		if (dup2(s, fileno(stdout)) < 0) crash("dup2");
+		close(s);
+	}
+
 	if(setvbuf(stdout, NULL, _IOLBF, 0))
 		syslog(LOG_WARNING, "Failed to make stdout line-buffered.");
-	
-	if (alarm_s) alarm(2*alarm_s);
 
-	FILE* nmea = stdin;
-	if (argc == 1) {
-		int port = -1;
-		if ((port = open(argv[0], O_RDWR | O_NOCTTY)) == -1)
-			crash("open(%s, ...)", argv[0]);
+	if (argc == 0) {
+		parse_port(&ports[0], "stdin", baudrate, alarm_s);
+		ports[0].fd = fileno(stdin);
+		nports = 1;
+	}
+	for (; nports < argc; nports++) {
+		struct Port* p = &ports[nports];
+		parse_port(p, argv[nports], baudrate, alarm_s);
+		if ((p->fd = open(p->dev, O_RDWR | O_NOCTTY)) == -1)
+			crash("open(%s, ...)", p->dev);
 
 		// Set serial parameters.
-		if (debug < 2) setserial(port, baudrate, argv[0]);
-
-		nmea = fdopen(port, "r");
+		if (debug < 2) setserial(p->fd, p->baudrate, p->dev);
 	}
 
-	int garbage = 0;
+	struct NMEADispatch dispatch;
+	if (!nmea_dispatch_init(&dispatch, handlers, sizeof handlers / sizeof handlers[0]))
+		crash("No perfect hash for the NMEA handlers");
+
+	struct pollfd fds[MAXPORTS];
+	int i;
+	int64_t now = now_ms();
+	for (i = 0; i < nports; i++) {
+		fds[i].fd = ports[i].fd;
+		fds[i].events = POLLIN;
+		ports[i].deadline_ms = now + 2000LL * ports[i].alarm_s;  // grace period for startup
+	}
 
-	while(!feof(nmea)) {
-		if (ferror(nmea)) {
-			clearerr(nmea);
+	for (;;) {
+		if (sigflg) {
+			sigflg = 0;
+			log_stats();
 		}
-		
- 		if (garbage++ > 100)
-			crash("Only garbage from nmea producer");
 
-		char line[100];
-		if (!fgets(line, sizeof line, nmea)) {
-			if (debug) fprintf(stderr, "Read error: %s\n", strerror(errno));
-			continue;
-		}
-
-		char* start = line + strcspn(line, "!$");
-		char* end = valid_nmea(start);
-		if (!end) {
-			if (debug) fprintf(stderr, "Invalid NMEA sentence: '%s'\n", line);
-			continue;
+		// Sleep until data arrives or the first watchdog expires.
+		int timeout = -1;
+		for (i = 0; i < nports; i++) {
+			if (!ports[i].alarm_s) continue;
+			int64_t dt = ports[i].deadline_ms - now;
+			if (dt < 0) dt = 0;
+			if (timeout < 0 || dt < timeout) timeout = dt;
 		}
 
-		garbage = 0;
-		if (alarm_s) alarm(alarm_s);
+		int r = poll(fds, nports, timeout);
+		if (r < 0 && errno != EINTR) crash("poll");
+		now = now_ms();
 
-		int64_t now = now_ms();
-
-		if (strncmp(start, "!AIVDM", 6) == 0) {
-			parse_ais(start, end);
-			continue;
-		}
-
-		if (strncmp(start, "$GPRMC", 6) == 0) {
-			struct GPSProto vars = INIT_GPSPROTO;
-			if (!parse_gprmc(start+1, &vars)) {
-				if (debug) fprintf(stderr, "Invalid GPRMC sentence: '%s'\n", line);
-				continue;
-			}
-			vars.timestamp_ms = now;
-			printf(OFMT_GPSPROTO(vars));
-			continue;
-		}
+		for (i = 0; r > 0 && i < nports; i++) {
+			struct Port* p = &ports[i];
+			if (!fds[i].revents) continue;
 
-		if (strncmp(start, "$WIMWV", 6) == 0) {
-			struct WindProto vars = INIT_WINDPROTO;
-			if (!parse_wimvx(start+1, &vars)) {
-				if (debug) fprintf(stderr, "Invalid WIMWV sentence: '%s'\n", line);
-				continue;
-			}
-			if (wind_bias  != 0.0) {
-				vars.angle_deg += wind_bias;
-				while(vars.angle_deg >= 360.0) vars.angle_deg -= 360.0;
-				while(vars.angle_deg <    0.0) vars.angle_deg += 360.0;
+			char buf[256];
+			int n = read(p->fd, buf, sizeof buf);
+			if (n == 0) crash("EOF on %s", p->dev);
+			if (n < 0) {
+				if (errno == EINTR || errno == EAGAIN) continue;
+				crash("read(%s)", p->dev);
 			}
-			vars.timestamp_ms = now;
-                        printf(OFMT_WINDPROTO(vars));
-			continue;
-		}
 
-		if (strncmp(start, "$WIXDR", 6) == 0) {
-			struct WixdrProto vars = INIT_WIXDRPROTO;
-			if (!parse_wixdr(start+1, &vars)) {
-				if (debug) fprintf(stderr, "Invalid WIXDR sentence: '%s'\n", line);
-				continue;
-			}		
-			vars.timestamp_ms = now;
-                        printf(OFMT_WIXDRPROTO(vars));	
-			continue;
-		}
-
-		if (strncmp(start, "$C", 2) == 0 && isdigit(start[2])) { 
-			struct CompassProto vars = INIT_COMPASSPROTO;
-			if (!parse_compass(start+1, &vars)) {
-				if (debug) fprintf(stderr, "Invalid C sentence: '%s'\n", line);
-				continue;
-			}
-			vars.timestamp_ms = now;
-			printf(OFMT_COMPASSPROTO(vars));
-			continue;
+			// Stamp the data as close to its arrival as we can get.
+			int64_t t = now_us();
+			p->mono_ms = now_mono_ms();
+			timer_tick(&p->timer, t, TIMER_START);
+			p->now_ms = t / 1000;
+			process(p, &dispatch, buf, n);
+			timer_tick_now(&p->timer, TIMER_STOP);
 		}
 
-		if (debug) fprintf(stderr, "Ignoring NMEA sentence: '%s'\n", line);
+		for (i = 0; i < nports; i++)
+			if (ports[i].alarm_s && now >= ports[i].deadline_ms)
+				crash("No usable nmea sentence on %s for %d seconds.", ports[i].dev, ports[i].alarm_s);
 	}
 
-	crash("Terminating.");
 	return 0;
 }
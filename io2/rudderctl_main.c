@@ -4,8 +4,14 @@
 //
 // Issue epos commands to keep one rudder (-l[eft] or -r[ight])
 // homed and close to the reference value
+//
+// The reference is followed as a trajectory: the setpoint plus its rate,
+// from the rudderctl: message or, if it has none, estimated from the
+// timestamps of the last two (see setpoint.h), and limited to what the
+// drive can do, see rudder_control().
 // 
 
+#include <math.h>
 #include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -21,6 +27,7 @@
 #include "lib/timer.h"
 #include "actuator.h"
 #include "eposclient.h"
+#include "setpoint.h"
 
 // -----------------------------------------------------------------------------
 // static const char* version = "$Id: $";
@@ -29,7 +36,7 @@ static int verbose = 0;
 static int debug = 0;
 
 static void usage(void) {
-	fprintf(stderr,	"usage: plug /path/to/ebus -- %s {-l | -r} \n", argv0);
+	fprintf(stderr,	"usage: plug /path/to/ebus -- %s {-l | -r} [-B client]\n", argv0);
 	exit(2);
 }
 
@@ -37,10 +44,61 @@ static Bus* bus = NULL;
 static MotorParams* params = NULL;
 static Device* dev = NULL;
 static double target_angle_deg = NAN;
+static double target_rate_deg_s = 0;
+static int64_t target_us = 0;		// when target_angle_deg was valid
+static int64_t target_ms = 0;		// its timestamp_ms
+static double max_rate_deg_s = 20;	// until rudder_control knows the encoder
+
+// Trajectory following in profile position mode.  Instead of a new
+// move per setpoint, which stops at every step, the drive is sent to
+// where the trajectory will be LOOKAHEAD_S later, at the velocity of the
+// trajectory.  It moves continuously and needs a new target only when
+// the trajectory leaves a window around the current one.
+const double LOOKAHEAD_S = 0.5;
+const double VELOCITY_MARGIN = 1.1;	// to catch up on a lag
+const double VELOCITY_HYSTERESIS = 1.5;	// keep a profile velocity up to this much too fast
+enum {
+	MIN_VELOCITY_RPM = 100,
+	MAX_VELOCITY_RPM = 3000,	// the profile velocity of rudder_init
+	VELOCITY_STEP_RPM = 50,
+	STATS_PERIOD_US = 10*1000*1000,
+};
+
+// Tracking statistics, from the positions streamed by eposcom -P.
+static struct {
+	int64_t start_us;
+	int64_t requests;	// at start_us
+	int n;
+	double sum_sq_deg2;
+	double max_deg;
+} track;
 
 const double TOLERANCE_DEG = .05;  // aiming precision in targetting rudder
 const int64_t BUSLATENCY_WARN_THRESH_US = 200*1000;  // 200ms
 
+// Where the rudder should be at time us, within its range.
+static double desired_deg(int64_t us) {
+	double lo = fmin(params->home_angle_deg, params->extr_angle_deg);
+	double hi = fmax(params->home_angle_deg, params->extr_angle_deg);
+	double a = target_angle_deg + target_rate_deg_s * (us - target_us) / 1E6;
+	return fmax(lo, fmin(hi, a));
+}
+
+// Log the requests per second and the tracking error every STATS_PERIOD_US.
+static void report_tracking(int64_t now) {
+	if (now < track.start_us + STATS_PERIOD_US) return;
+	int64_t requests = bus_requests(bus);
+	if (track.start_us) {
+		double dt = (now - track.start_us) / 1E6;
+		slog(LOG_INFO, "requests/s: %.1lf tracking error (deg) rms: %.3lf max: %.3lf samples: %d",
+		     (requests - track.requests) / dt,
+		     track.n ? sqrt(track.sum_sq_deg2 / track.n) : NAN, track.max_deg, track.n);
+	}
+	memset(&track, 0, sizeof track);
+	track.start_us = now;
+	track.requests = requests;
+}
+
 // Read 1 line of input from stdin.
 // rudderctl: we handle here, the epos messages are handled by bus_receive.
 // return 1 if something (target_angle_deg or a register cache in the bus) changed, 0 otherwise.
@@ -57,7 +115,39 @@ static int processinput() {
 		if (n != IFMT_RUDDERPROTO_CTL_ITEMS)
 			return 0;
 
-		target_angle_deg = (params == &motor_params[LEFT]) ? msg.rudder_l_deg : msg.rudder_r_deg;
+		int left = (params == &motor_params[LEFT]);
+		double angle = left ? msg.rudder_l_deg : msg.rudder_r_deg;
+		double rates[2] = { NAN, NAN };
+		int nr;
+		double rate = NAN;
+		if (sscanf(line + nn, IFMT_RUDDERPROTO_RATES(&rates[0], &rates[1], &nr)) == IFMT_RUDDERPROTO_RATES_ITEMS)
+			rate = left ? rates[0] : rates[1];
+		if (isnan(rate))
+			target_rate_deg_s = setpoint_rate(target_angle_deg, target_ms, angle, msg.timestamp_ms, max_rate_deg_s);
+		else
+			target_rate_deg_s = isnan(angle) ? 0 : fmax(-max_rate_deg_s, fmin(max_rate_deg_s, rate));
+		target_angle_deg = angle;
+		target_ms = msg.timestamp_ms;
+		target_us = now_us();
+
+	} else if (line[0] == 's') {  // status_left: or status_right: from eposcom -P
+
+		struct RudderProto msg = INIT_RUDDERPROTO;
+		int nn;
+		double actual;
+		if (params == &motor_params[LEFT] && sscanf(line, IFMT_STATUS_LEFT(&msg, &nn)) == 2)
+			actual = msg.rudder_l_deg;
+		else if (params == &motor_params[RIGHT] && sscanf(line, IFMT_STATUS_RIGHT(&msg, &nn)) == 2)
+			actual = msg.rudder_r_deg;
+		else
+			return 0;
+		if (!isnan(actual) && !isnan(target_angle_deg)) {
+			double err = fabs(actual - desired_deg(msg.timestamp_ms * 1000));
+			track.n++;
+			track.sum_sq_deg2 += err * err;
+			if (err > track.max_deg) track.max_deg = err;
+		}
+		return 0;
 
 	} else {
 		int64_t lat_us = bus_receive(bus, line);
@@ -270,6 +360,8 @@ static int rudder_control(void)
         uint32_t opmode;
 	int32_t curr_targ_qc;
 	int32_t new_targ_qc;
+	uint32_t profvel;
+	uint32_t encpulses;
 
         if (!device_get_register(dev, REG_STATUS, &status))
                 return DEFUNCT;
@@ -287,6 +379,8 @@ static int rudder_control(void)
 	// these will be read from the bus register cache if possible
         r  = device_get_register(dev, REG_OPMODE,  &opmode);
         r &= device_get_register(dev, REG_TARGPOS, (uint32_t*)&curr_targ_qc);
+        r &= device_get_register(dev, REG_PROFVEL, &profvel);
+        r &= device_get_register(dev, REG_ENCPULSES, &encpulses);
 
         if (!r) return DEFUNCT;
 
@@ -295,10 +389,33 @@ static int rudder_control(void)
 
 	if (isnan(target_angle_deg)) return REACHED;
 
-	new_targ_qc = angle_to_qc(params, target_angle_deg);
-
-	if (new_targ_qc != curr_targ_qc) {
+	// Without a rate this is a step, made at full speed.
+	int64_t now = now_us();
+	double qc_per_deg = fabs((params->extr_pos_qc - params->home_pos_qc) /
+				 (params->extr_angle_deg - params->home_angle_deg));
+	// The fastest the trajectory can be followed.
+	if (encpulses > 0) {
+		max_rate_deg_s = MAX_VELOCITY_RPM * 4.0 * encpulses / 60 / qc_per_deg;
+		target_rate_deg_s = fmax(-max_rate_deg_s, fmin(max_rate_deg_s, target_rate_deg_s));
+	}
+	double rate = fabs(target_rate_deg_s);
+	new_targ_qc = angle_to_qc(params, desired_deg(now + (rate > 0 ? LOOKAHEAD_S*1E6 : 0)));
+	int32_t window_qc = qc_per_deg * (TOLERANCE_DEG + rate * LOOKAHEAD_S / 2);
+
+	if (abs(new_targ_qc - curr_targ_qc) > window_qc) {
+		// The velocity only changes with a new target, and only if the
+		// current one is too slow or much too fast for the trajectory.
+		uint32_t velocity = MAX_VELOCITY_RPM;
+		if (rate > 0 && encpulses > 0) {
+			double rpm = VELOCITY_MARGIN * rate * qc_per_deg * 60 / (4 * encpulses);
+			rpm = fmax(MIN_VELOCITY_RPM, fmin(MAX_VELOCITY_RPM, rpm));
+			if (profvel >= rpm && profvel <= VELOCITY_HYSTERESIS * rpm)
+				velocity = profvel;
+			else
+				velocity = VELOCITY_STEP_RPM * ceil(rpm / VELOCITY_STEP_RPM);
+		}
                 status &= ~STATUS_TARGETREACHED;
+		device_set_register(dev, REG_PROFVEL, velocity);
                 device_invalidate_register(dev, REG_CONTROL);
 		device_set_register(dev, REG_TARGPOS, new_targ_qc);
 		device_set_register(dev, REG_CONTROL, CONTROL_START);
@@ -314,17 +431,19 @@ int main(int argc, char* argv[]) {
 
 	int ch;
 	int dotimestamps = 0;
+	char client = 0;
 
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "dhlrTv")) != -1){
+	while ((ch = getopt(argc, argv, "dhlrTvB:")) != -1){
 		switch (ch) {
 		case 'd': ++debug; break;
 		case 'l': params = &motor_params[LEFT]; break;
 		case 'r': params = &motor_params[RIGHT]; break;
 		case 'v': ++verbose; break;
 		case 'T': ++dotimestamps; break;
+		case 'B': client = optarg[0]; break;  // binary ebus framing
 		case 'h': 
 		default:
 			usage();
@@ -348,12 +467,17 @@ int main(int argc, char* argv[]) {
 
 	// ask linebusd to install filters
 	printf("$name %s\n", params->label);
-	printf("$subscribe 0x%x\n", params->serial_number);
+	if (client)
+		printf("$subscribe %c%c\n", EBUS_BIN_RSP, client);  // only our own responses
+	else
+		printf("$subscribe 0x%x\n", params->serial_number);
 	printf("$subscribe rudderctl:\n");  // must match IFMT_RUDDER_CTL
+	printf("$subscribe %s\n", (params == &motor_params[LEFT]) ? "status_left:" : "status_right:");  // from eposcom -P
 	fflush(stdout);
 
 	bus = bus_new(stdout);	
 	bus_enable_timestamp(bus, dotimestamps);
+	bus_enable_binary(bus, client);
 	dev = bus_open_device(bus, params->serial_number);
 
 	struct Timer reach;
@@ -379,6 +503,8 @@ int main(int argc, char* argv[]) {
 			if (processinput())
 				state = rudder_control();
 
+			report_tracking(now_us());
+
 			if (isnan(target_angle_deg))
 			    continue;
 
@@ -28,7 +28,7 @@ static int verbose = 0;
 static int debug = 0;
 
 static void usage(void) {
-	fprintf(stderr,	"usage: plug /path/to/ebus | %s\n", argv0);
+	fprintf(stderr,	"usage: plug /path/to/ebus | %s [-B client]\n", argv0);
 	exit(2);
 }
 
@@ -225,15 +225,17 @@ int main(int argc, char* argv[]) {
 
 	int ch;
 	int dotimestamps = 0;
+	char client = 0;
 
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "dhTv")) != -1){
+	while ((ch = getopt(argc, argv, "dhTvB:")) != -1){
 		switch (ch) {
 		case 'd': ++debug; break;
 		case 'v': ++verbose; break;
 		case 'T': ++dotimestamps; break;
+		case 'B': client = optarg[0]; break;  // binary ebus framing
 		case 'h': 
 		default:
 			usage();
@@ -254,13 +256,17 @@ int main(int argc, char* argv[]) {
 
 	// ask linebusd to install filters
 	printf("$name sail\n");
-	printf("$subscribe 0x%x\n", motor_params[SAIL].serial_number);
+	if (client)
+		printf("$subscribe %c%c\n", EBUS_BIN_RSP, client);  // only our own responses
+	else
+		printf("$subscribe 0x%x\n", motor_params[SAIL].serial_number);
 	printf("$subscribe rudderctl:\n");  // must match IFMT_RUDDER_CTL
 	printf("$subscribe skew:\n");  // must match IFMT_SKEW
 	fflush(stdout);
 
 	bus = bus_new(stdout);
 	bus_enable_timestamp(bus, dotimestamps);
+	bus_enable_binary(bus, client);
 	motor = bus_open_device(bus, motor_params[SAIL].serial_number);
 
 	struct Timer reach;
@@ -0,0 +1,19 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+#include "setpoint.h"
+
+#include <math.h>
+
+double
+setpoint_rate(double prev_deg, int64_t prev_ms, double deg, int64_t ms, double max_rate_deg_s)
+{
+	int64_t dt_ms = ms - prev_ms;
+	if (isnan(prev_deg) || isnan(deg) || dt_ms < 0 || dt_ms > SETPOINT_MAX_DT_MS)
+		return 0;
+	if (dt_ms < SETPOINT_MIN_DT_MS)
+		dt_ms = SETPOINT_MIN_DT_MS;
+	double rate = (deg - prev_deg) / (dt_ms / 1E3);
+	return fmax(-max_rate_deg_s, fmin(max_rate_deg_s, rate));
+}
@@ -0,0 +1,29 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Rate of a rudder setpoint, estimated from the last two rudderctl:
+// messages for rudderctl's trajectory following, if the message did not
+// bring its rate.
+//
+// The time between the setpoints is taken from their timestamp_ms, not
+// from when they arrived: the linebus delivers in bursts, so two
+// messages may arrive milliseconds apart, and the rate would explode.
+// The interval is at least SETPOINT_MIN_DT_MS, one helmsman period, and
+// the rate is clipped to what the drive can do.
+//
+#ifndef IO_SETPOINT_H
+#define IO_SETPOINT_H
+
+#include <stdint.h>
+
+enum {
+	SETPOINT_MIN_DT_MS = 100,	// helmsman's kSamplingPeriod
+	SETPOINT_MAX_DT_MS = 1000,	// older setpoints don't make a rate
+};
+
+// Rate in deg/s from setpoint prev_deg at prev_ms to deg at ms, within
+// +/- max_rate_deg_s.  0 if either is NAN or they are too far apart.
+double setpoint_rate(double prev_deg, int64_t prev_ms, double deg, int64_t ms, double max_rate_deg_s);
+
+#endif // IO_SETPOINT_H
@@ -0,0 +1,28 @@
+#include "setpoint.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+int main(int argc, char* argv[]) {
+	// Regular 10Hz setpoints.
+	assert(fabs(setpoint_rate(10, 1000, 11, 1100, 50) - 10) < 1e-9);
+	assert(fabs(setpoint_rate(10, 1000, 9, 1100, 50) + 10) < 1e-9);
+
+	// Two commands a few ms apart don't make a huge rate.
+	assert(fabs(setpoint_rate(10, 1000, 11, 1003, 50) - 10) < 1e-9);
+	assert(setpoint_rate(10, 1000, 11, 1000, 50) == 10);
+
+	// Clipped to what the drive can do.
+	assert(setpoint_rate(-30, 1000, 30, 1100, 50) == 50);
+	assert(setpoint_rate(30, 1000, -30, 1100, 50) == -50);
+
+	// No rate from stale, reordered or unknown setpoints.
+	assert(setpoint_rate(10, 1000, 11, 2100, 50) == 0);
+	assert(setpoint_rate(10, 1100, 11, 1000, 50) == 0);
+	assert(setpoint_rate(NAN, 1000, 11, 1100, 50) == 0);
+	assert(setpoint_rate(10, 1000, NAN, 1100, 50) == 0);
+
+	puts("OK");
+	return 0;
+}
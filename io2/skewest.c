@@ -0,0 +1,86 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+#include "skewest.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const double GAIN = 0.1;		// of the estimate, per sample
+static const double SCALE_GAIN = 0.05;	// of the scale, per sample
+static const double CLIP = 2.5;		// residuals beyond CLIP*scale are clipped
+static const double MIN_SCALE_DEG = 0.2;  // about the BMMH resolution
+
+double
+skewest_wrap(double deg)
+{
+	while (deg < -180.0) deg += 360.0;
+	while (deg >= 180.0) deg -= 360.0;
+	return deg;
+}
+
+void
+skewest_init(struct SkewEstimator* e)
+{
+	memset(e, 0, sizeof *e);
+	e->angle_deg = NAN;
+}
+
+static int
+cmp(const void* a, const void* b)
+{
+	double d = *(const double*)a - *(const double*)b;
+	return (d > 0) - (d < 0);
+}
+
+static double
+median(double* v, int n)
+{
+	qsort(v, n, sizeof v[0], cmp);
+	return (n & 1) ? v[n/2] : 0.5 * (v[n/2 - 1] + v[n/2]);
+}
+
+int
+skewest_add(struct SkewEstimator* e, double sample_deg)
+{
+	if (isnan(sample_deg))
+		return !isnan(e->angle_deg);
+
+	if (e->n < SKEWEST_INIT) {
+		e->init_deg[e->n++] = sample_deg;
+		if (e->n < SKEWEST_INIT)
+			return 0;
+
+		// Relative to the first sample, against the wrap around.
+		double rel[SKEWEST_INIT];
+		int i;
+		for (i = 0; i < SKEWEST_INIT; i++)
+			rel[i] = skewest_wrap(e->init_deg[i] - e->init_deg[0]);
+		double med = median(rel, SKEWEST_INIT);
+		for (i = 0; i < SKEWEST_INIT; i++)
+			rel[i] = fabs(rel[i] - med);
+		e->angle_deg = skewest_wrap(e->init_deg[0] + med);
+		e->scale_deg = 1.4826 * median(rel, SKEWEST_INIT);  // MAD of a normal distribution
+		if (e->scale_deg < MIN_SCALE_DEG) e->scale_deg = MIN_SCALE_DEG;
+		return 1;
+	}
+
+	e->n++;
+	double r = skewest_wrap(sample_deg - e->angle_deg);
+	double c = CLIP * e->scale_deg;
+	double psi = r;
+	if (psi > c) psi = c;
+	if (psi < -c) psi = -c;
+	if (psi != r) e->outliers++;
+	e->angle_deg = skewest_wrap(e->angle_deg + GAIN * psi);
+
+	// The mean absolute deviation is 0.8 sigma.  Clipped less than the
+	// estimate so the scale opens up when the residuals stay large.
+	double a = fabs(r);
+	if (a > 2 * c) a = 2 * c;
+	e->scale_deg += SCALE_GAIN * (1.25 * a - e->scale_deg);
+	if (e->scale_deg < MIN_SCALE_DEG) e->scale_deg = MIN_SCALE_DEG;
+	return 1;
+}
@@ -0,0 +1,36 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Running robust estimate of the skew between the BMMH sensor angle and
+// the sail motor angle, for skewmon.
+//
+// The first SKEWEST_INIT samples are reduced to their median and the
+// median absolute deviation.  After that every sample moves the estimate
+// by a fraction of its residual, clipped to a few times the scale
+// (a Huber M-estimator), so single bad pairings hardly move it, but a
+// real slip of the sail on the mast is followed within some 20 samples.
+// All angles are in degrees and wrap at +/-180.
+//
+#ifndef IO_SKEWEST_H
+#define IO_SKEWEST_H
+
+enum { SKEWEST_INIT = 5 };
+
+struct SkewEstimator {
+	double angle_deg;	// the estimate, NAN until initialized
+	double scale_deg;	// of the residuals
+	int n;			// samples so far
+	double init_deg[SKEWEST_INIT];
+	int outliers;		// clipped samples
+};
+
+void skewest_init(struct SkewEstimator* e);
+
+// Add a sample, returns 1 if the estimate is valid.
+int skewest_add(struct SkewEstimator* e, double sample_deg);
+
+// Wrap an angle to [-180, 180).
+double skewest_wrap(double deg);
+
+#endif // IO_SKEWEST_H
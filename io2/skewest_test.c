@@ -0,0 +1,55 @@
+#include "skewest.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static double
+noise(double sigma)
+{
+	return sigma * sqrt(3.0) * (2.0 * rand() / RAND_MAX - 1);  // uniform
+}
+
+int main(int argc, char* argv[]) {
+	struct SkewEstimator e;
+	int i;
+
+	assert(skewest_wrap(190) == -170 && skewest_wrap(-190) == 170 && skewest_wrap(180) == -180);
+
+	// Not valid before SKEWEST_INIT samples, and NANs don't count.
+	skewest_init(&e);
+	assert(isnan(e.angle_deg));
+	for (i = 0; i < SKEWEST_INIT - 1; i++)
+		assert(!skewest_add(&e, 3));
+	assert(!skewest_add(&e, NAN));
+	assert(skewest_add(&e, 3));
+	assert(e.angle_deg == 3);
+
+	// Initialized with the median across the wrap around, one outlier.
+	skewest_init(&e);
+	double init[SKEWEST_INIT] = { 179, -179, 178, -178, 90 };
+	for (i = 0; i < SKEWEST_INIT; i++)
+		skewest_add(&e, init[i]);
+	assert(fabs(skewest_wrap(e.angle_deg - 179)) < 1e-9);
+
+	// Noisy samples with 5% gross errors.
+	srand(1);
+	skewest_init(&e);
+	for (i = 0; i < 1000; i++)
+		skewest_add(&e, 2 + noise(0.5) + ((rand() % 20 == 0) ? 90 : 0));
+	assert(fabs(e.angle_deg - 2) < 0.3);
+	assert(e.scale_deg < 1.5);
+	assert(e.outliers > 30);
+
+	// A slip of 15 degrees is followed within 50 samples.
+	for (i = 0; i < 50; i++)
+		skewest_add(&e, 17 + noise(0.5));
+	assert(fabs(e.angle_deg - 17) < 1);
+	for (i = 0; i < 200; i++)
+		skewest_add(&e, 17 + noise(0.5));
+	assert(fabs(e.angle_deg - 17) < 0.3);
+
+	puts("OK");
+	return 0;
+}
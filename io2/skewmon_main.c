@@ -2,11 +2,21 @@
 // Use of this source code is governed by the Apache License 2.0
 // that can be found in the LICENSE file.
 //
-// Once every 2 seconds, issue 2 sail motor current possition reads and in between
-// one bmmh read, update 'skew' and send that to stdout.
+// Estimate the skew between the BMMH absolute sensor and the sail's Epos
+// position from the samples on the bus, and send 'skew:' to stdout when
+// it changed.
+//
+// We issue no requests of our own.  The BMMH position comes from the
+// responses to eposprobe, the sail position from those responses and,
+// much more often, from the status_sail: messages streamed by eposcom -P.
+// Each BMMH sample is paired with the sail position interpolated between
+// the samples before and after it, and fed to a robust running estimate
+// (skewest.h).  A change of more than -t degrees is reported at once,
+// the estimate is repeated every -x seconds for controllers that start
+// later.
+//
+//    plug -n skew $EBUS -- ./skewmon
 //
-//    plug -n skew $EBUS -- ./skew
-// 
 
 #include <math.h>
 #include <signal.h>
@@ -18,38 +28,54 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include "proto/rudder.h"
 #include "proto/skew.h"
 #include "lib/timer.h"
 #include "lib/log.h"
 #include "ebus.h"
 #include "actuator.h"
+#include "skewest.h"
 
 // static const char* version = "$Id: $";
 static const char* argv0;
 static int debug = 0;
 
 static void usage(void) {
-	fprintf(stderr,	"usage: plug  /path/to/ebus -- %s [-T] \n", argv0);
+	fprintf(stderr,
+		"usage: plug /path/to/ebus -- %s [options]\n"
+		"options:\n"
+		"\t-t threshold [deg] of a change to report (default 0.5)\n"
+		"\t-x maXimum time [s] between reports (default 60)\n"
+		, argv0);
 	exit(2);
 }
 
 const double BMMH_BIAS_DEG = 3.25;  // if the boom is at 0, the BMMH reports 3.25 degrees
 
-const int64_t REPORT_TIMEOUT_US = 8*1000*1000; // force new measurement if last report is 8s old.
-const int64_t MOTOR_MAX_INTERVAL_US = 250*1000; // 250ms between motor currpos samples
+// Sail samples to interpolate between must be close in time, unless the
+// sail didn't move in between.
+const int64_t MOTOR_MAX_INTERVAL_US = 250*1000;
+const double MOTOR_STILL_DEG = 0.2;
+
+struct Sample {
+	int64_t us;
+	double deg;
+};
 
 int main(int argc, char* argv[]) {
-	
+
 	int ch;
-	int dotimestamps = 0;
+	double threshold_deg = 0.5;
+	int64_t max_us = 60*1000*1000;
 
 	argv0 = strrchr(argv[0], '/');
 	if (argv0) ++argv0; else argv0 = argv[0];
 
-	while ((ch = getopt(argc, argv, "dhT")) != -1){
+	while ((ch = getopt(argc, argv, "dht:x:")) != -1){
 		switch (ch) {
 		case 'd': ++debug; break;
-		case 'T': ++dotimestamps; break;
+		case 't': threshold_deg = atof(optarg); break;
+		case 'x': max_us = 1000000LL*atoi(optarg); break;
 		case 'h': 
 		default:
 			usage();
@@ -69,14 +95,16 @@ int main(int argc, char* argv[]) {
 	printf("$name skewmon\n");
 	printf("$subscribe 0x%x:0x%x[%d] = \n", motor_params[SAIL].serial_number, INDEX(REG_CURRPOS), SUBINDEX(REG_CURRPOS));
 	printf("$subscribe 0x%x:0x%x[%d] = \n", motor_params[BMMH].serial_number, INDEX(REG_BMMHPOS), SUBINDEX(REG_BMMHPOS));
+	printf("$subscribe status_sail:\n");
+	fflush(stdout);
 
 	struct SkewProto skew = INIT_SKEWPROTO;
+	struct SkewEstimator est;
+	skewest_init(&est);
 
-	int64_t mc = 0;
-	int32_t motor_currpos_qc[2] = { 0, 0 };
-	int64_t motor_us[2] = { 0, 0 };
-	int32_t bmmh_currpos_qc = 0;
-	int64_t bmmh_us 	= 0;
+	struct Sample motor[2];		// the last two, [1] is the latest
+	struct Sample bmmh = { 0, NAN };  // waiting for the next motor sample
+	memset(motor, 0, sizeof motor);
 
 	while(!feof(stdin)) {
 		char line[1024];
@@ -88,70 +116,68 @@ int main(int argc, char* argv[]) {
 		char op 	= 0;
 		int32_t value 	= 0;
 		uint64_t us 	= 0;
-
-		if (ebus_parse_rsp(line, &op, &serial, &reg, &value, &us)) {
+		struct Sample m = { 0, NAN };
+
+		struct RudderProto sts = INIT_RUDDERPROTO;
+		int nn = 0;
+		if (sscanf(line, IFMT_STATUS_SAIL(&sts, &nn)) == 2) {
+			m.us = sts.timestamp_ms * 1000;
+			m.deg = sts.sail_deg;
+		} else if (ebus_parse_rsp(line, &op, &serial, &reg, &value, &us) && op == '=') {
 			if (us == 0) us = now_us();
 
 			if (serial == motor_params[SAIL].serial_number && reg == REG_CURRPOS) {
-				if(debug) slog(LOG_DEBUG, "Got sail 0x%x: %.2lf\n", value, qc_to_angle(&motor_params[SAIL], value));
-				motor_currpos_qc[mc&1] = value;
-				motor_us[mc&1] = us;
-				++mc;
+				m.us = us;
+				m.deg = qc_to_angle(&motor_params[SAIL], value);
 			}
 
 			if (serial == motor_params[BMMH].serial_number && reg == REG_BMMHPOS) {
+				// bmmh position is 30 bit signed,0 .. 0x4000 0000 -> 0x2000 0000 => -0x2000 0000
 				if(value > (1<<29)) value -= (1<<30);
 				value &= 4095;
-				if(debug) slog(LOG_DEBUG, "Got bmmh 0x%x %d: %.2lf\n", value, value, qc_to_angle(&motor_params[BMMH], value));
-				// bmmh position is 30 bit signed,0 .. 0x4000 0000 -> 0x2000 0000 => -0x2000 0000
-				bmmh_currpos_qc = value;
-				bmmh_us = us;
+				bmmh.us = us;
+				bmmh.deg = qc_to_angle(&motor_params[BMMH], value);
+				if(debug) slog(LOG_DEBUG, "Got bmmh 0x%x: %.2lf\n", value, bmmh.deg);
 			}
 		}
 
-		if (us == 0) us = now_us();
-		if (us - 1000*skew.timestamp_ms < REPORT_TIMEOUT_US/4) // limit at 1/4 of max period
+		if (isnan(m.deg) || m.us <= motor[1].us)
 			continue;
 
-		double alpha = -1.0;
-		int32_t motor_qc = 0;
-		if (motor_us[0] < bmmh_us && bmmh_us < motor_us[1] && (motor_us[1] - motor_us[0] < MOTOR_MAX_INTERVAL_US) ) {
-			alpha = bmmh_us - motor_us[0];
-			alpha /= motor_us[1] - motor_us[0];
-			motor_qc = (1.0-alpha)*motor_currpos_qc[0] + alpha*motor_currpos_qc[1];
-			if(debug) slog(LOG_DEBUG, "< alpha %.3lf qc: 0x%x", alpha, motor_qc);
-		} else if (motor_us[1] < bmmh_us && bmmh_us < motor_us[0] && (motor_us[0] - motor_us[1] < MOTOR_MAX_INTERVAL_US) ) {
-			alpha = bmmh_us - motor_us[1];
-			alpha /= motor_us[0] - motor_us[1];
-			motor_qc = (1.0-alpha)*motor_currpos_qc[1] + alpha*motor_currpos_qc[0];
-			if(debug) slog(LOG_DEBUG, "> alpha %.3lf qc: 0x%x", alpha, motor_qc);
-		}
+		motor[0] = motor[1];
+		motor[1] = m;
 
-		if (alpha >= 0.0) {
-			if(debug) slog(LOG_DEBUG, "average motor pos %.3lf", qc_to_angle(&motor_params[SAIL], motor_qc));
-			skew.angle_deg = qc_to_angle(&motor_params[BMMH], bmmh_currpos_qc) - qc_to_angle(&motor_params[SAIL], motor_qc) - BMMH_BIAS_DEG;
-			while(skew.angle_deg < -180.0) skew.angle_deg += 360.0;
-			while(skew.angle_deg >  180.0) skew.angle_deg -= 360.0;
-			skew.timestamp_ms = bmmh_us / 1000;
-			printf(OFMT_SKEWPROTO(skew));
-			fflush(stdout);
-		}
+		if (isnan(bmmh.deg) || bmmh.us < motor[0].us || bmmh.us > motor[1].us)
+			continue;
 
-		if (us - 1000*skew.timestamp_ms > REPORT_TIMEOUT_US) {
-			// pretend we sent a bit ago to avoid flooding the bus
-			skew.timestamp_ms = (us - REPORT_TIMEOUT_US/2)/1000;
-			if (dotimestamps) {
-				us = now_us();
-				printf(EBUS_GET_T_OFMT(motor_params[SAIL].serial_number, REG_CURRPOS, us));
-				printf(EBUS_GET_T_OFMT(motor_params[BMMH].serial_number, REG_BMMHPOS, us));
-				printf(EBUS_GET_T_OFMT(motor_params[SAIL].serial_number, REG_CURRPOS, us));
-			} else {
-				printf(EBUS_GET_OFMT(motor_params[SAIL].serial_number, REG_CURRPOS));
-				printf(EBUS_GET_OFMT(motor_params[BMMH].serial_number, REG_BMMHPOS));
-				printf(EBUS_GET_OFMT(motor_params[SAIL].serial_number, REG_CURRPOS));
-			}
-			fflush(stdout);
+		double d_deg = skewest_wrap(motor[1].deg - motor[0].deg);
+		if (motor[1].us - motor[0].us > MOTOR_MAX_INTERVAL_US && fabs(d_deg) > MOTOR_STILL_DEG) {
+			bmmh.deg = NAN;
+			continue;
 		}
+
+		double alpha = (double)(bmmh.us - motor[0].us) / (motor[1].us - motor[0].us);
+		double motor_deg = motor[0].deg + alpha * d_deg;
+		if(debug) slog(LOG_DEBUG, "alpha %.3lf sail %.2lf bmmh %.2lf", alpha, motor_deg, bmmh.deg);
+
+		int valid = skewest_add(&est, skewest_wrap(bmmh.deg - motor_deg - BMMH_BIAS_DEG));
+		bmmh.deg = NAN;
+		if (!valid)
+			continue;
+
+		if (!isnan(skew.angle_deg) &&
+		    fabs(skewest_wrap(est.angle_deg - skew.angle_deg)) < threshold_deg &&
+		    motor[1].us < 1000*skew.timestamp_ms + max_us)
+			continue;
+
+		if (!isnan(skew.angle_deg) && fabs(skewest_wrap(est.angle_deg - skew.angle_deg)) >= threshold_deg)
+			slog(LOG_INFO, "skew %.2lf -> %.2lf deg, scale %.2lf deg, %d of %d samples clipped",
+			     skew.angle_deg, est.angle_deg, est.scale_deg, est.outliers, est.n);
+
+		skew.angle_deg = est.angle_deg;
+		skew.timestamp_ms = motor[1].us / 1000;
+		printf(OFMT_SKEWPROTO(skew));
+		fflush(stdout);
 	}
 
 	crash("main loop exit");
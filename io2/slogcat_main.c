@@ -0,0 +1,98 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Format binary logs written by slog in binary mode (lib/log.h), like
+//
+//   eposcom -L /var/log/eposcom.slog /dev/ttyUSB0
+//   slogcat /var/log/eposcom.slog
+//
+// One line per message: time, priority and the message.
+//
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lib/log.h"
+
+static const char* argv0;
+
+static const char* priorities[] = {
+	[LOG_EMERG]   = "emerg",
+	[LOG_ALERT]   = "alert",
+	[LOG_CRIT]    = "crit",
+	[LOG_ERR]     = "err",
+	[LOG_WARNING] = "warning",
+	[LOG_NOTICE]  = "notice",
+	[LOG_INFO]    = "info",
+	[LOG_DEBUG]   = "debug",
+};
+
+static void
+usage(void)
+{
+	fprintf(stderr,
+		"usage: %s [options] [file...]\n"
+		"options:\n"
+		"\t-p prio   only messages up to priority (0..7, default 7)\n"
+		, argv0);
+	exit(2);
+}
+
+static int
+cat(FILE* f, const char* name, int maxprio)
+{
+	char buf[1000];
+	int64_t us;
+	int prio, r;
+	while ((r = slog_decode(f, &us, &prio, buf, sizeof buf)) == 1) {
+		if (prio > maxprio) continue;
+		time_t t = us / 1000000;
+		char date[32];
+		strftime(date, sizeof date, "%Y-%m-%d %H:%M:%S", gmtime(&t));
+		printf("%s.%03d %s %s\n", date, (int)(us % 1000000) / 1000,
+		       (prio >= 0 && prio <= LOG_DEBUG) ? priorities[prio] : "?", buf);
+	}
+	if (r < 0) {
+		fprintf(stderr, "%s: %s: corrupt record\n", argv0, name);
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+
+	int ch;
+	int maxprio = LOG_DEBUG;
+
+	argv0 = strrchr(argv[0], '/');
+	if (argv0) ++argv0; else argv0 = argv[0];
+
+	while ((ch = getopt(argc, argv, "hp:")) != -1){
+		switch (ch) {
+		case 'p': maxprio = atoi(optarg); break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argv += optind;
+	argc -= optind;
+
+	if (argc == 0)
+		return cat(stdin, "stdin", maxprio);
+
+	int err = 0;
+	for (; argc; argc--, argv++) {
+		FILE* f = fopen(argv[0], "r");
+		if (!f) crash("open(%s)", argv[0]);
+		err |= cat(f, argv[0], maxprio);
+		fclose(f);
+	}
+	return err;
+}
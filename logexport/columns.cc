@@ -0,0 +1,235 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "logexport/columns.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+
+namespace {
+
+const int kMaxLine = 4096;
+const int kMaxTokens = 256;
+
+// Names end up in file names.
+bool IsName(const char* s, int len) {
+  if (len <= 0) return false;
+  for (int i = 0; i < len; ++i) {
+    char c = s[i];
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9') || c == '_'))
+      return false;
+  }
+  return true;
+}
+
+// A "key:value" token, returns the colon or NULL.
+char* KeyValue(char* token) {
+  char* colon = strchr(token, ':');
+  if (!colon || !colon[1] || !IsName(token, colon - token)) return NULL;
+  return colon;
+}
+
+bool IsMs(const std::string& name) {
+  return name.size() >= 3 && name.compare(name.size() - 3, 3, "_ms") == 0;
+}
+
+}  // namespace
+
+Column::Column(const std::string& name) : name(name), integer(IsMs(name)) {}
+
+void Column::Pad(int rows) {
+  if (integer)
+    ints.resize(rows, 0);
+  else
+    doubles.resize(rows, NAN);
+}
+
+ColumnBatch::ColumnBatch() : last_(-1), lines_(0) {}
+
+Table* ColumnBatch::FindTable(const char* type) {
+  if (last_ >= 0 && tables_[last_].type == type)
+    return &tables_[last_];
+  std::map<std::string, int>::const_iterator it = index_.find(type);
+  if (it != index_.end()) {
+    last_ = it->second;
+  } else {
+    last_ = tables_.size();
+    index_[type] = last_;
+    tables_.push_back(Table());
+    tables_.back().type = type;
+    tables_.back().rows = 0;
+    tables_.back().columns.push_back(Column("time_ms"));
+  }
+  return &tables_[last_];
+}
+
+bool ColumnBatch::AddLine(const char* line, int len, int64_t arrival_ms) {
+  char buf[kMaxLine];
+  if (len >= kMaxLine) len = kMaxLine - 1;
+  memcpy(buf, line, len);
+  buf[len] = 0;
+
+  char* tokens[kMaxTokens];
+  int n = 0;
+  char* save;
+  for (char* p = strtok_r(buf, " \t\r\n", &save); p && n < kMaxTokens;
+       p = strtok_r(NULL, " \t\r\n", &save))
+    tokens[n++] = p;
+
+  // The type is followed by a key:value, unlike a syslog "prog[pid]:".
+  int t;
+  for (t = 0; t + 1 < n; ++t) {
+    int l = strlen(tokens[t]);
+    if (l >= 2 && tokens[t][l - 1] == ':' && IsName(tokens[t], l - 1) &&
+        KeyValue(tokens[t + 1])) {
+      tokens[t][l - 1] = 0;
+      break;
+    }
+  }
+  if (t + 1 >= n) return false;
+
+  Table* table = FindTable(tokens[t]);
+  std::vector<Column>& columns = table->columns;
+  const int row = table->rows;
+  int64_t timestamp_ms = -1;
+  size_t hint = 1;
+  for (int i = t + 1; i < n; ++i) {
+    char* colon = KeyValue(tokens[i]);
+    if (!colon) continue;
+    *colon = 0;
+    const char* value = colon + 1;
+
+    // The fields come in the same order most of the time.
+    size_t c = hint;
+    if (c >= columns.size() || columns[c].name != tokens[i]) {
+      for (c = 0; c < columns.size(); ++c)
+        if (columns[c].name == tokens[i]) break;
+      if (c == 0) continue;  // time_ms is ours
+      if (c == columns.size()) {
+        columns.push_back(Column(tokens[i]));
+        columns.back().Pad(row);
+      }
+    }
+    hint = c + 1;
+    Column& column = columns[c];
+    if (column.size() > row) continue;  // repeated key
+
+    char* end;
+    if (column.integer) {
+      int64_t v = strtoll(value, &end, 10);
+      column.ints.push_back(v);
+      if (column.name == "timestamp_ms") timestamp_ms = v;
+    } else {
+      double v = strtod(value, &end);
+      column.doubles.push_back((end == value || *end) ? NAN : v);
+    }
+  }
+
+  columns[0].ints.push_back(arrival_ms >= 0 ? arrival_ms : timestamp_ms);
+  table->rows++;
+  for (size_t c = 1; c < columns.size(); ++c)
+    columns[c].Pad(table->rows);
+  lines_++;
+  return true;
+}
+
+ColumnWriter::ColumnWriter(const char* dir) : dir_(dir), ok_(true) {}
+
+ColumnWriter::~ColumnWriter() {
+  Close();
+}
+
+bool ColumnWriter::Pad(File* file, int64_t rows) {
+  static const std::vector<int64_t> zeros(1024, 0);
+  static const std::vector<double> nans(1024, NAN);
+  while (file->rows < rows) {
+    int64_t n = rows - file->rows;
+    if (n > 1024) n = 1024;
+    const void* values = file->integer ? (const void*)&zeros[0] : (const void*)&nans[0];
+    if (fwrite(values, 8, n, file->fp) != (size_t)n) return false;
+    file->rows += n;
+  }
+  return true;
+}
+
+bool ColumnWriter::Append(const ColumnBatch& batch) {
+  const std::vector<Table>& tables = batch.tables();
+  for (size_t t = 0; t < tables.size() && ok_; ++t) {
+    const Table& table = tables[t];
+    Type& type = types_[table.type];  // rows start at 0
+    std::vector<bool> written(type.files.size(), false);
+    for (size_t c = 0; c < table.columns.size() && ok_; ++c) {
+      const Column& column = table.columns[c];
+      size_t f = c;
+      if (f >= type.files.size() || type.files[f].name != column.name) {
+        for (f = 0; f < type.files.size(); ++f)
+          if (type.files[f].name == column.name) break;
+      }
+      if (f == type.files.size()) {
+        std::string path = dir_ + "/" + table.type + "." + column.name;
+        File file = { column.name, column.integer, fopen(path.c_str(), "w"), 0 };
+        if (!file.fp) {
+          syslog(LOG_ERR, "Could not open %s", path.c_str());
+          ok_ = false;
+          break;
+        }
+        type.files.push_back(file);
+        written.push_back(false);
+      }
+      File* file = &type.files[f];
+      written[f] = true;
+      bool ok = Pad(file, type.rows);
+      if (column.integer)
+        ok = ok && fwrite(&column.ints[0], 8, table.rows, file->fp) == (size_t)table.rows;
+      else
+        ok = ok && fwrite(&column.doubles[0], 8, table.rows, file->fp) == (size_t)table.rows;
+      file->rows += table.rows;
+      if (!ok) {
+        syslog(LOG_ERR, "Could not write %s.%s", table.type.c_str(), column.name.c_str());
+        ok_ = false;
+      }
+    }
+    type.rows += table.rows;
+    for (size_t f = 0; f < type.files.size() && ok_; ++f) {
+      if (!written[f] && !Pad(&type.files[f], type.rows)) {
+        syslog(LOG_ERR, "Could not write %s.%s",
+               table.type.c_str(), type.files[f].name.c_str());
+        ok_ = false;
+      }
+    }
+  }
+  return ok_;
+}
+
+bool ColumnWriter::Close() {
+  if (types_.empty()) return ok_;
+  std::string path = dir_ + "/columns.txt";
+  FILE* fp = fopen(path.c_str(), "w");
+  if (!fp) {
+    syslog(LOG_ERR, "Could not open %s", path.c_str());
+    ok_ = false;
+  }
+  for (std::map<std::string, Type>::iterator it = types_.begin();
+       it != types_.end(); ++it) {
+    for (size_t f = 0; f < it->second.files.size(); ++f) {
+      File& file = it->second.files[f];
+      if (fp)
+        fprintf(fp, "%s.%s %s %lld\n", it->first.c_str(), file.name.c_str(),
+                file.integer ? "int64" : "double", (long long)file.rows);
+      if (fclose(file.fp) != 0) {
+        syslog(LOG_ERR, "Could not write %s.%s", it->first.c_str(), file.name.c_str());
+        ok_ = false;
+      }
+    }
+  }
+  if (fp && fclose(fp) != 0) {
+    syslog(LOG_ERR, "Could not write %s", path.c_str());
+    ok_ = false;
+  }
+  types_.clear();
+  return ok_;
+}
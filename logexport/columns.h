@@ -0,0 +1,108 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef LOGEXPORT_COLUMNS_H
+#define LOGEXPORT_COLUMNS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+Bus messages split into columns, one array per field of a message type.
+
+A bus message is "type: key:value key:value ...", as written by the
+OFMT_ macros of the protos in proto/, on a line by itself (lbus.log, linelog,
+busplay output) or after a syslog header. The first token ending in ':'
+that is followed by a key:value token starts the message. Tokens that are
+not key:value are ignored.
+
+Every type gets a column time_ms, the time the line arrived on the bus if
+known, else its timestamp_ms field, else -1. Fields ending in _ms are
+int64, all others double, NaN if the value isn't a number. All columns of
+a type have the same number of rows: fields missing in a message are
+NaN (double) or 0 (int64), like the INIT_ macros of the protos.
+
+The ColumnWriter stores column type.field as the file dir/type.field, the
+raw values in native byte order without any header, so the files can be
+memory mapped, e.g. numpy.memmap("imu.yaw_deg", dtype="float64"). The
+file dir/columns.txt lists "type.field int64|double rows" per column,
+see simulation/read_logs/load_columns.m.
+*/
+
+struct Column {
+  explicit Column(const std::string& name);
+  int size() const { return integer ? ints.size() : doubles.size(); }
+  // Append missing values until there are rows.
+  void Pad(int rows);
+
+  std::string name;
+  bool integer;
+  std::vector<int64_t> ints;
+  std::vector<double> doubles;
+};
+
+struct Table {
+  std::string type;
+  int rows;
+  std::vector<Column> columns;  // columns[0] is time_ms
+};
+
+// The messages of a piece of log, parsed independently of the others.
+class ColumnBatch {
+ public:
+  ColumnBatch();
+
+  // Adds the bus message in line, received at arrival_ms, or -1 if
+  // unknown. Returns false if there is none.
+  bool AddLine(const char* line, int len, int64_t arrival_ms);
+
+  // In the order of the first message of each type.
+  const std::vector<Table>& tables() const { return tables_; }
+  int64_t lines() const { return lines_; }
+
+ private:
+  Table* FindTable(const char* type);
+
+  std::vector<Table> tables_;
+  std::map<std::string, int> index_;
+  int last_;  // Table of the previous message.
+  int64_t lines_;
+};
+
+// Appends batches to the column files in a directory.
+class ColumnWriter {
+ public:
+  // dir has to exist, column files in it are overwritten.
+  explicit ColumnWriter(const char* dir);
+  ~ColumnWriter();
+
+  // Returns false if a file could not be written.
+  bool Append(const ColumnBatch& batch);
+
+  // Closes all files and writes columns.txt.
+  bool Close();
+
+ private:
+  struct File {
+    std::string name;
+    bool integer;
+    FILE* fp;
+    int64_t rows;
+  };
+  struct Type {
+    Type() : rows(0) {}
+    int64_t rows;
+    std::vector<File> files;
+  };
+
+  bool Pad(File* file, int64_t rows);
+
+  std::string dir_;
+  std::map<std::string, Type> types_;
+  bool ok_;
+};
+
+#endif  // LOGEXPORT_COLUMNS_H
@@ -0,0 +1,127 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "logexport/columns.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "lib/testing/testing.h"
+
+namespace {
+const char* kDir = "/tmp/columns_test";
+
+bool Add(ColumnBatch* batch, const char* line, int64_t arrival_ms) {
+  return batch->AddLine(line, strlen(line), arrival_ms);
+}
+
+// Reads a whole column file.
+template <typename T>
+std::vector<T> ReadColumn(const char* name) {
+  std::vector<T> values;
+  std::string path = std::string(kDir) + "/" + name;
+  FILE* fp = fopen(path.c_str(), "r");
+  T v;
+  while (fp && fread(&v, sizeof v, 1, fp) == 1)
+    values.push_back(v);
+  if (fp) fclose(fp);
+  return values;
+}
+}  // namespace
+
+ATEST(ColumnBatch, Messages) {
+  ColumnBatch batch;
+  EXPECT_TRUE(Add(&batch, "imu: timestamp_ms:1000 yaw_deg:12.5 roll_deg:-1.0", -1));
+  EXPECT_TRUE(Add(&batch, "wind: timestamp_ms:1005 angle_deg:270.0 valid:1", -1));
+  // From syslog, with a field missing and a new one.
+  EXPECT_TRUE(Add(&batch, "Apr 12 10:00:00 boat helmsman[123]: imu: timestamp_ms:1010 "
+                  "yaw_deg:13.0 mono_timestamp_ms:7", -1));
+  // Not a number, a repeated key and a token that isn't a field.
+  EXPECT_TRUE(Add(&batch, "imu: timestamp_ms:1020 yaw_deg:nan roll_deg:x roll_deg:2 junk", 999));
+  EXPECT_FALSE(Add(&batch, "Apr 12 10:00:00 boat helmsman[123]: Helmsman started", -1));
+  EXPECT_FALSE(Add(&batch, "", -1));
+  EXPECT_EQ(4, batch.lines());
+
+  const std::vector<Table>& tables = batch.tables();
+  EXPECT_EQ(2, tables.size());
+  const Table& imu = tables[0];
+  EXPECT_EQ(std::string("imu"), imu.type);
+  EXPECT_EQ(3, imu.rows);
+  EXPECT_EQ(5, imu.columns.size());
+  for (size_t c = 0; c < imu.columns.size(); ++c)
+    EXPECT_EQ(3, imu.columns[c].size());
+
+  const Column& time = imu.columns[0];
+  EXPECT_EQ(std::string("time_ms"), time.name);
+  EXPECT_EQ(1000, time.ints[0]);
+  EXPECT_EQ(1010, time.ints[1]);
+  EXPECT_EQ(999, time.ints[2]);
+
+  const Column& yaw = imu.columns[2];
+  EXPECT_EQ(std::string("yaw_deg"), yaw.name);
+  EXPECT_FALSE(yaw.integer);
+  EXPECT_FLOAT_EQ(12.5, yaw.doubles[0]);
+  EXPECT_FLOAT_EQ(13.0, yaw.doubles[1]);
+  EXPECT_TRUE(isnan(yaw.doubles[2]));
+
+  const Column& roll = imu.columns[3];
+  EXPECT_FLOAT_EQ(-1, roll.doubles[0]);
+  EXPECT_TRUE(isnan(roll.doubles[1]));
+  EXPECT_TRUE(isnan(roll.doubles[2]));
+
+  const Column& mono = imu.columns[4];
+  EXPECT_EQ(std::string("mono_timestamp_ms"), mono.name);
+  EXPECT_TRUE(mono.integer);
+  EXPECT_EQ(0, mono.ints[0]);
+  EXPECT_EQ(7, mono.ints[1]);
+  EXPECT_EQ(0, mono.ints[2]);
+
+  EXPECT_EQ(std::string("wind"), tables[1].type);
+  EXPECT_EQ(1, tables[1].rows);
+}
+
+ATEST(ColumnWriter, Batches) {
+  mkdir(kDir, 0755);
+  ColumnWriter writer(kDir);
+  ColumnBatch first;
+  Add(&first, "imu: timestamp_ms:1 yaw_deg:1.5", -1);
+  Add(&first, "imu: timestamp_ms:2 yaw_deg:2.5", -1);
+  EXPECT_TRUE(writer.Append(first));
+  // The columns of the batches don't match.
+  ColumnBatch second;
+  Add(&second, "imu: timestamp_ms:3 pitch_deg:-3", -1);
+  Add(&second, "skew: timestamp_ms:4 angle_deg:0.5", -1);
+  EXPECT_TRUE(writer.Append(second));
+  EXPECT_TRUE(writer.Close());
+
+  std::vector<int64_t> time = ReadColumn<int64_t>("imu.time_ms");
+  EXPECT_EQ(3, time.size());
+  EXPECT_EQ(3, time[2]);
+  std::vector<double> yaw = ReadColumn<double>("imu.yaw_deg");
+  EXPECT_EQ(3, yaw.size());
+  EXPECT_FLOAT_EQ(2.5, yaw[1]);
+  EXPECT_TRUE(isnan(yaw[2]));
+  std::vector<double> pitch = ReadColumn<double>("imu.pitch_deg");
+  EXPECT_EQ(3, pitch.size());
+  EXPECT_TRUE(isnan(pitch[0]));
+  EXPECT_FLOAT_EQ(-3, pitch[2]);
+  EXPECT_EQ(1, ReadColumn<double>("skew.angle_deg").size());
+
+  std::string path = std::string(kDir) + "/columns.txt";
+  FILE* fp = fopen(path.c_str(), "r");
+  EXPECT_TRUE(fp != NULL);
+  char line[100];
+  EXPECT_TRUE(fgets(line, sizeof line, fp) != NULL);
+  EXPECT_EQ(std::string("imu.time_ms int64 3\n"), std::string(line));
+  int n = 1;
+  while (fgets(line, sizeof line, fp)) n++;
+  fclose(fp);
+  EXPECT_EQ(7, n);
+}
+
+int main(int argc, char* argv[]) {
+  return testing::RunAllTests();
+}
@@ -0,0 +1,297 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Converts bus logs into column files for offline analysis (see
+// logexport/columns.h), like
+//
+//   logexport -o /tmp/day3 /var/log/lbus /var/log/lbus.log
+//   octave> c = load_columns("/tmp/day3"); plot(c.imu.time_ms, c.imu.yaw_deg)
+//
+// The inputs are text logs (lbus.log, linelog or syslog output) and
+// buslog recordings, directories or single chunks. They are cut into
+// pieces that are parsed on all cores, and the pieces are appended to the
+// columns in order.
+//
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "io2/busrec.h"
+#include "logexport/columns.h"
+
+namespace {
+const char* argv0;
+
+const int kMaxThreads = 16;
+const int64_t kPieceBytes = 16 << 20;
+
+void usage(void) {
+  fprintf(stderr,
+    "usage: %s [options] log...\n"
+    "options:\n"
+    "\t-o dir  write the columns into dir (default .)\n"
+    "\t-j n    parse on n threads (default: all cores)\n"
+    "\tlogs are text, buslog directories or buslog chunks (.brc)\n"
+    , argv0);
+  exit(2);
+}
+
+// A piece of text or a buslog chunk.
+struct Job {
+  Job() : begin(NULL), end(NULL), errors(0) {}
+  const char* begin;
+  const char* end;
+  std::string chunk;
+  ColumnBatch batch;
+  int errors;
+};
+
+void ParseText(Job* job) {
+  const char* p = job->begin;
+  while (p < job->end) {
+    const char* eol = static_cast<const char*>(memchr(p, '\n', job->end - p));
+    if (!eol) eol = job->end;
+    job->batch.AddLine(p, eol - p, -1);
+    p = eol + 1;
+  }
+}
+
+// Walks the block headers up to the index, if there is one.
+void ParseChunk(Job* job) {
+  FILE* fp = fopen(job->chunk.c_str(), "r");
+  if (!fp) {
+    syslog(LOG_ERR, "Could not open %s", job->chunk.c_str());
+    job->errors++;
+    return;
+  }
+  struct BusrecTrailer trailer;
+  off_t end = -1;
+  if (fseeko(fp, -(off_t)sizeof trailer, SEEK_END) == 0 &&
+      fread(&trailer, sizeof trailer, 1, fp) == 1 &&
+      trailer.magic == BUSREC_INDEX_MAGIC)
+    end = trailer.offset;
+  rewind(fp);
+  struct BusrecCodec* codec = new BusrecCodec;
+  std::vector<uint8_t> payload(BUSREC_BLOCKSIZE);
+  char line[BUSREC_MAXLINE];
+  struct BusrecBlock hdr;
+  while ((end < 0 || ftello(fp) < end) && fread(&hdr, sizeof hdr, 1, fp) == 1) {
+    if (hdr.magic != BUSREC_BLOCK_MAGIC || hdr.size > BUSREC_BLOCKSIZE ||
+        fread(&payload[0], 1, hdr.size, fp) != hdr.size ||
+        busrec_start(codec, &hdr, &payload[0]) < 0) {
+      syslog(LOG_ERR, "Bad block in %s", job->chunk.c_str());
+      job->errors++;
+      break;
+    }
+    int64_t us;
+    int n;
+    while ((n = busrec_next(codec, &us, line, sizeof line)) >= 0)
+      job->batch.AddLine(line, n, us / 1000);
+    if (n == -2) {
+      syslog(LOG_ERR, "Corrupt block in %s", job->chunk.c_str());
+      job->errors++;
+    }
+  }
+  delete codec;
+  fclose(fp);
+}
+
+void* Worker(void* arg) {
+  Job* job = static_cast<Job*>(arg);
+  if (job->chunk.empty())
+    ParseText(job);
+  else
+    ParseChunk(job);
+  return NULL;
+}
+
+struct Stats {
+  Stats() : lines(0), errors(0) {}
+  int64_t lines;
+  int errors;
+};
+
+// Parses the jobs in parallel and appends them in order.
+bool Run(std::vector<Job>* jobs, ColumnWriter* writer, Stats* stats) {
+  const int n = jobs->size();
+  pthread_t tid[kMaxThreads];
+  bool started[kMaxThreads];
+  for (int i = 1; i < n; ++i)
+    started[i] = pthread_create(&tid[i], NULL, Worker, &(*jobs)[i]) == 0;
+  // The calling thread does the first job and any job whose thread
+  // could not be started.
+  Worker(&(*jobs)[0]);
+  for (int i = 1; i < n; ++i) {
+    if (started[i])
+      pthread_join(tid[i], NULL);
+    else
+      Worker(&(*jobs)[i]);
+  }
+  for (int i = 0; i < n; ++i) {
+    if (!writer->Append((*jobs)[i].batch))
+      return false;
+    stats->lines += (*jobs)[i].batch.lines();
+    stats->errors += (*jobs)[i].errors;
+  }
+  return true;
+}
+
+// Maps the file a window at a time and cuts each window into a piece of
+// whole lines per thread.
+bool ExportText(const char* path, int threads, ColumnWriter* writer, Stats* stats) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd == -1 || fstat(fd, &st) == -1) {
+    syslog(LOG_ERR, "Could not open %s", path);
+    if (fd != -1) close(fd);
+    return false;
+  }
+  const off_t page = sysconf(_SC_PAGESIZE);
+  off_t pos = 0;
+  bool ok = true;
+  while (ok && pos < st.st_size) {
+    const off_t base = pos - pos % page;
+    off_t size = std::min<off_t>(st.st_size - pos, threads * kPieceBytes);
+    void* map = mmap(NULL, pos - base + size, PROT_READ, MAP_PRIVATE, fd, base);
+    if (map == MAP_FAILED) {
+      syslog(LOG_ERR, "Could not map %s", path);
+      ok = false;
+      break;
+    }
+    const char* begin = static_cast<const char*>(map) + (pos - base);
+    const char* end = begin + size;
+    // A line cut by the window goes with the next one.
+    if (pos + size < st.st_size) {
+      const char* eol = static_cast<const char*>(memrchr(begin, '\n', size));
+      if (eol) end = eol + 1;
+    }
+
+    std::vector<Job> jobs(threads);
+    const char* p = begin;
+    for (int i = 0; i < threads; ++i) {
+      jobs[i].begin = p;
+      p = begin + (end - begin) * (i + 1) / threads;
+      if (p < jobs[i].begin) p = jobs[i].begin;
+      const char* eol = (p < end) ? static_cast<const char*>(memchr(p, '\n', end - p)) : NULL;
+      p = eol ? eol + 1 : end;
+      jobs[i].end = p;
+    }
+    ok = Run(&jobs, writer, stats);
+    munmap(map, pos - base + size);
+    pos += end - begin;
+  }
+  close(fd);
+  return ok;
+}
+
+bool ExportChunks(const std::vector<std::string>& chunks, int threads,
+                  ColumnWriter* writer, Stats* stats) {
+  for (size_t i = 0; i < chunks.size(); i += threads) {
+    std::vector<Job> jobs(std::min<size_t>(threads, chunks.size() - i));
+    for (size_t j = 0; j < jobs.size(); ++j)
+      jobs[j].chunk = chunks[i + j];
+    if (!Run(&jobs, writer, stats))
+      return false;
+  }
+  return true;
+}
+
+// The chunks of a recording, in time order.
+bool ListChunks(const char* dir, std::vector<std::string>* chunks) {
+  DIR* d = opendir(dir);
+  if (!d) {
+    syslog(LOG_ERR, "Could not open %s", dir);
+    return false;
+  }
+  struct dirent* e;
+  while ((e = readdir(d)) != NULL) {
+    int len = strlen(e->d_name);
+    if (len > 4 && !strcmp(e->d_name + len - 4, ".brc"))
+      chunks->push_back(std::string(dir) + "/" + e->d_name);
+  }
+  closedir(d);
+  std::sort(chunks->begin(), chunks->end());
+  return true;
+}
+
+bool IsChunk(const char* path) {
+  int len = strlen(path);
+  return len > 4 && !strcmp(path + len - 4, ".brc");
+}
+
+double Now() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int ch;
+  argv0 = strrchr(argv[0], '/');
+  if (argv0) ++argv0; else argv0 = argv[0];
+
+  const char* dir = ".";
+  int threads = sysconf(_SC_NPROCESSORS_ONLN);
+  while ((ch = getopt(argc, argv, "hj:o:")) != -1){
+    switch (ch) {
+    case 'j': threads = atoi(optarg); break;
+    case 'o': dir = optarg; break;
+    case 'h':
+    default:
+      usage();
+    }
+  }
+  argv += optind;
+  argc -= optind;
+  if (argc == 0) usage();
+  if (threads < 1) threads = 1;
+  if (threads > kMaxThreads) threads = kMaxThreads;
+
+  openlog(argv0, LOG_PERROR, LOG_LOCAL0);
+
+  if (mkdir(dir, 0755) == -1 && errno != EEXIST) {
+    syslog(LOG_ERR, "Could not create %s", dir);
+    return 1;
+  }
+
+  const double start = Now();
+  ColumnWriter writer(dir);
+  Stats stats;
+  bool ok = true;
+  for (int i = 0; i < argc && ok; ++i) {
+    struct stat st;
+    if (stat(argv[i], &st) == -1) {
+      syslog(LOG_ERR, "Could not open %s", argv[i]);
+      ok = false;
+    } else if (S_ISDIR(st.st_mode)) {
+      std::vector<std::string> chunks;
+      ok = ListChunks(argv[i], &chunks) &&
+           ExportChunks(chunks, threads, &writer, &stats);
+    } else if (IsChunk(argv[i])) {
+      ok = ExportChunks(std::vector<std::string>(1, argv[i]), threads, &writer, &stats);
+    } else {
+      ok = ExportText(argv[i], threads, &writer, &stats);
+    }
+  }
+  ok = writer.Close() && ok;
+
+  fprintf(stderr, "%lld messages in %.1f s, %d errors\n",
+          (long long)stats.lines, Now() - start, stats.errors);
+  return ok ? 0 : 1;
+}
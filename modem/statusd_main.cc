@@ -14,6 +14,7 @@
 #include "proto/helmsman_status.h"
 #include "proto/imu.h"
 #include "proto/modem.h"
+#include "proto/mono_timestamp.h"
 #include "proto/remote.h"
 #include "proto/wind.h"
 
@@ -152,17 +153,25 @@ int main(int argc, char** argv) {
       }
 
       {  // Check if this is a IMU status.
-        IMUProto status;
+        IMUProto status = INIT_IMUPROTO;
         unsigned int n = 0;
-        if (sscanf(in, IFMT_IMUPROTO(&status, &n)) > 0 && n == strlen(in)) {
+        int items = sscanf(in, IFMT_IMUPROTO(&status, &n));
+        if (MONO_LINE_VALID(items, IFMT_IMUPROTO_ITEMS)) {
+          if (!MONO_TIMESTAMP_VALID(items, IFMT_IMUPROTO_ITEMS,
+                                    status.mono_timestamp_ms))
+            status.mono_timestamp_ms = 0;
           imu_status = status;
           imu_counter++;
         }
       }
       {  // Check if this is a wind sensor status.
-        WindProto status;
+        WindProto status = INIT_WINDPROTO;
         unsigned int n = 0;
-        if (sscanf(in, IFMT_WINDPROTO(&status, &n)) > 0 && n == strlen(in)) {
+        int items = sscanf(in, IFMT_WINDPROTO(&status, &n));
+        if (MONO_LINE_VALID(items, IFMT_WINDPROTO_ITEMS)) {
+          if (!MONO_TIMESTAMP_VALID(items, IFMT_WINDPROTO_ITEMS,
+                                    status.mono_timestamp_ms))
+            status.mono_timestamp_ms = 0;
           wind_status = status;
           wind_counter++;
         }
@@ -16,18 +16,20 @@ struct CompassProto {
   double pitch_deg;
   double roll_deg;
   double temp_c;
+  int64_t mono_timestamp_ms;  // CLOCK_MONOTONIC when the data was read, 0 if unknown
 };
 
 #define INIT_COMPASSPROTO \
-  {0, NAN, NAN, NAN, NAN}
+  {0, NAN, NAN, NAN, NAN, 0}
 
 // For use in printf and friends.
 #define OFMT_COMPASSPROTO(x)                                                           \
-  "compass: timestamp_ms:%lld roll_deg:%.3lf pitch_deg:%.3lf yaw_deg:%.3lf temp_c:%.3lf\n",     \
-  (x).timestamp_ms, (x).roll_deg, (x).pitch_deg, (x).yaw_deg, (x).temp_c
+  "compass: timestamp_ms:%lld roll_deg:%.3lf pitch_deg:%.3lf yaw_deg:%.3lf temp_c:%.3lf mono_timestamp_ms:%lld\n",     \
+  (x).timestamp_ms, (x).roll_deg, (x).pitch_deg, (x).yaw_deg, (x).temp_c, (x).mono_timestamp_ms
 
 #define IFMT_COMPASSPROTO(x, n)                                                        \
-  "compass: timestamp_ms:%lld roll_deg:%lf pitch_deg:%lf yaw_deg:%lf temp_c:%lf\n%n",           \
-  &(x)->timestamp_ms, &(x)->roll_deg, &(x)->pitch_deg, &(x)->yaw_deg, &(x)->temp_c, (n)
+  "compass: timestamp_ms:%lld roll_deg:%lf pitch_deg:%lf yaw_deg:%lf temp_c:%lf mono_timestamp_ms:%lld\n%n",           \
+  &(x)->timestamp_ms, &(x)->roll_deg, &(x)->pitch_deg, &(x)->yaw_deg, &(x)->temp_c, &(x)->mono_timestamp_ms, (n)
+#define IFMT_COMPASSPROTO_ITEMS 6
 
 #endif  // PROTO_COMPASS_H
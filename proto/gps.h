@@ -17,17 +17,19 @@ struct GPSProto {
 	double lng_deg;
 	double speed_m_s;
 	double cog_deg;
+	int64_t mono_timestamp_ms;  // CLOCK_MONOTONIC when the data was read, 0 if unknown
 };
 
-#define INIT_GPSPROTO {0,0,NAN,NAN,NAN,NAN}
+#define INIT_GPSPROTO {0,0,NAN,NAN,NAN,NAN,0}
 
 // For use in printf and friends.
 #define OFMT_GPSPROTO(x)						\
-	"gps: timestamp_ms:%lld gps_timestamp_ms:%lld lat_deg:%.7lf lng_deg:%.7lf speed_m_s:%.3lf cog_deg:%.2lf\n", \
-		(x).timestamp_ms, (x).gps_timestamp_ms, (x).lat_deg, (x).lng_deg, (x).speed_m_s, (x).cog_deg
+	"gps: timestamp_ms:%lld gps_timestamp_ms:%lld lat_deg:%.7lf lng_deg:%.7lf speed_m_s:%.3lf cog_deg:%.2lf mono_timestamp_ms:%lld\n", \
+		(x).timestamp_ms, (x).gps_timestamp_ms, (x).lat_deg, (x).lng_deg, (x).speed_m_s, (x).cog_deg, (x).mono_timestamp_ms
 
 #define IFMT_GPSPROTO(x, n)				 \
-	"gps: timestamp_ms:%lld gps_timestamp_ms:%lld lat_deg:%lf lng_deg:%lf speed_m_s:%lf cog_deg:%lf%n", \
-		&(x)->timestamp_ms, &(x)->gps_timestamp_ms, &(x)->lat_deg, &(x)->lng_deg, &(x)->speed_m_s, &(x)->cog_deg, (n)
+	"gps: timestamp_ms:%lld gps_timestamp_ms:%lld lat_deg:%lf lng_deg:%lf speed_m_s:%lf cog_deg:%lf mono_timestamp_ms:%lld%n", \
+		&(x)->timestamp_ms, &(x)->gps_timestamp_ms, &(x)->lat_deg, &(x)->lng_deg, &(x)->speed_m_s, &(x)->cog_deg, &(x)->mono_timestamp_ms, (n)
+#define IFMT_GPSPROTO_ITEMS 7
 
 #endif  // PROTO_GPS_H
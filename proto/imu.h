@@ -26,10 +26,11 @@ struct IMUProto {
 	double vel_x_m_s;  // in boat coordinates
 	double vel_y_m_s;
 	double vel_z_m_s;
+	int64_t mono_timestamp_ms;  // CLOCK_MONOTONIC when the data was read, 0 if unknown
 };
 
 #define INIT_IMUPROTO \
-	{0,0,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN}
+	{0,0,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, NAN,NAN,NAN, 0}
 
 // For use in printf and friends.
 #define OFMT_IMUPROTO(x)						\
@@ -39,14 +40,16 @@ struct IMUProto {
 	"mag_x_au:%.3lf mag_y_au:%.3lf mag_z_au:%.3lf "			\
 	"roll_deg:%.3lf pitch_deg:%.3lf yaw_deg:%.3lf "			\
 	"lat_deg:%.7lf lng_deg:%.7lf alt_m:%.3lf "			\
-	"vel_x_m_s:%.3lf vel_y_m_s:%.3lf vel_z_m_s:%.3lf\n",		\
+	"vel_x_m_s:%.3lf vel_y_m_s:%.3lf vel_z_m_s:%.3lf "		\
+	"mono_timestamp_ms:%lld\n",					\
 		(x).timestamp_ms, (x).gps_timestamp_ms, (x).temp_c,	\
 		(x).acc_x_m_s2, (x).acc_y_m_s2, (x).acc_z_m_s2,		\
 		(x).gyr_x_rad_s, (x).gyr_y_rad_s, (x).gyr_z_rad_s,	\
 		(x).mag_x_au, (x).mag_y_au, (x).mag_z_au,		\
 		(x).roll_deg, (x).pitch_deg, (x).yaw_deg,		\
 		(x).lat_deg, (x).lng_deg, (x).alt_m,			\
-		(x).vel_x_m_s, (x).vel_y_m_s, (x).vel_z_m_s
+		(x).vel_x_m_s, (x).vel_y_m_s, (x).vel_z_m_s,		\
+		(x).mono_timestamp_ms
 
 #define IFMT_IMUPROTO(x, n)						\
 	"imu: timestamp_ms:%lld gps_timestamp_ms:%lld temp_c:%lf "	\
@@ -55,13 +58,16 @@ struct IMUProto {
 	"mag_x_au:%lf mag_y_au:%lf mag_z_au:%lf "			\
 	"roll_deg:%lf pitch_deg:%lf yaw_deg:%lf "			\
 	"lat_deg:%lf lng_deg:%lf alt_m:%lf "				\
-	"vel_x_m_s:%lf vel_y_m_s:%lf vel_z_m_s:%lf%n",			\
+	"vel_x_m_s:%lf vel_y_m_s:%lf vel_z_m_s:%lf "			\
+	"mono_timestamp_ms:%lld%n",					\
 		&(x)->timestamp_ms, &(x)->gps_timestamp_ms, &(x)->temp_c, \
 		&(x)->acc_x_m_s2, &(x)->acc_y_m_s2, &(x)->acc_z_m_s2,	\
 		&(x)->gyr_x_rad_s, &(x)->gyr_y_rad_s, &(x)->gyr_z_rad_s, \
 		&(x)->mag_x_au, &(x)->mag_y_au, &(x)->mag_z_au,		\
 		&(x)->roll_deg, &(x)->pitch_deg, &(x)->yaw_deg,		\
 		&(x)->lat_deg, &(x)->lng_deg, &(x)->alt_m,		\
-		&(x)->vel_x_m_s, &(x)->vel_y_m_s, &(x)->vel_z_m_s, (n)
+		&(x)->vel_x_m_s, &(x)->vel_y_m_s, &(x)->vel_z_m_s,	\
+		&(x)->mono_timestamp_ms, (n)
+#define IFMT_IMUPROTO_ITEMS 22
 
 #endif  // PROTO_IMU_H
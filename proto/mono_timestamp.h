@@ -0,0 +1,19 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// The imu:, compass:, gps: and wind: lines end with mono_timestamp_ms,
+// the CLOCK_MONOTONIC time (now_mono_ms) when the data was read.
+// Producers from before it leave the field out, sscanf then returns one
+// item less and does not touch the struct member.
+//
+// All readers of these lines accept a line with MONO_LINE_VALID and use
+// its stamp only if MONO_TIMESTAMP_VALID, otherwise it is 0 (unknown).
+// n is what sscanf returned, items the IFMT_..._ITEMS of the format.
+#ifndef PROTO_MONO_TIMESTAMP_H
+#define PROTO_MONO_TIMESTAMP_H
+
+#define MONO_LINE_VALID(n, items) ((n) >= (items) - 1)
+#define MONO_TIMESTAMP_VALID(n, items, ms) ((n) == (items) && (ms) > 0)
+
+#endif  // PROTO_MONO_TIMESTAMP_H
@@ -0,0 +1,41 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// The helmsman's position estimate, dead reckoned between GPS fixes
+// (see helmsman/position_estimator.h), with its covariance in a local
+// north/east frame.
+
+#ifndef PROTO_POSITION_H
+#define PROTO_POSITION_H
+
+#include <math.h>
+#include <stdint.h>
+
+struct PositionProto {
+	int64_t timestamp_ms;
+	double lat_deg;
+	double lng_deg;
+	double var_north_m2;
+	double var_east_m2;
+	double cov_north_east_m2;
+};
+
+#define INIT_POSITIONPROTO {0, NAN, NAN, NAN, NAN, NAN}
+
+// For use in printf and friends.
+#define OFMT_POSITIONPROTO(x)						\
+	"position: timestamp_ms:%lld lat_deg:%.6lf lng_deg:%.6lf "	\
+	"var_north_m2:%.1lf var_east_m2:%.1lf cov_north_east_m2:%.1lf\n", \
+	(x).timestamp_ms, (x).lat_deg, (x).lng_deg,			\
+	(x).var_north_m2, (x).var_east_m2, (x).cov_north_east_m2
+
+// For use in scanf.
+#define IFMT_POSITIONPROTO(x, n)					\
+	"position: timestamp_ms:%lld lat_deg:%lf lng_deg:%lf "		\
+	"var_north_m2:%lf var_east_m2:%lf cov_north_east_m2:%lf\n%n",	\
+	&(x)->timestamp_ms, &(x)->lat_deg, &(x)->lng_deg,		\
+	&(x)->var_north_m2, &(x)->var_east_m2, &(x)->cov_north_east_m2, (n)
+#define IFMT_POSITIONPROTO_ITEMS 6
+
+#endif // PROTO_POSITION_H
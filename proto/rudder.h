@@ -31,6 +31,17 @@ struct RudderProto {
 	, &(x)->timestamp_ms, &(x)->rudder_l_deg, &(x)->rudder_r_deg, &(x)->sail_deg, (n)
 #define IFMT_RUDDERPROTO_CTL_ITEMS 4
 
+// The rudderctl: message with the rates of the rudder setpoints appended.
+// Readers of IFMT_RUDDERPROTO_CTL ignore them, IFMT_RUDDERPROTO_RATES
+// reads them from where IFMT_RUDDERPROTO_CTL stopped (n).
+#define OFMT_RUDDERPROTO_CTL_RATES(x, rate_l, rate_r) \
+	"rudderctl: timestamp_ms:%lld rudder_l_deg:%.3lf rudder_r_deg:%.3lf sail_deg:%.1lf rate_l_deg_s:%.3lf rate_r_deg_s:%.3lf\n" \
+	, (x).timestamp_ms, (x).rudder_l_deg, (x).rudder_r_deg, (x).sail_deg, (rate_l), (rate_r)
+
+#define IFMT_RUDDERPROTO_RATES(rate_l, rate_r, n) \
+	"rate_l_deg_s:%lf rate_r_deg_s:%lf\n%n", (rate_l), (rate_r), (n)
+#define IFMT_RUDDERPROTO_RATES_ITEMS 2
+
 // Variants that only touch one field
 #define OFMT_STATUS_LEFT(x) \
   "status_left: timestamp_ms:%lld angle_deg:%.1lf\n", (x).timestamp_ms, (x).rudder_l_deg
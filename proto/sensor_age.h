@@ -0,0 +1,43 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Histogram of the age of one sensor's data when the helmsman used it,
+// i.e. control time minus the mono_timestamp_ms stamped at read().
+// Bucket i counts ages below SENSOR_AGE_LIMITS_MS[i], the last bucket
+// everything older.
+
+#ifndef PROTO_SENSOR_AGE_H
+#define PROTO_SENSOR_AGE_H
+
+#include <stdint.h>
+
+enum { SENSOR_AGE_BUCKETS = 8 };
+#define SENSOR_AGE_LIMITS_MS { 10, 20, 50, 100, 200, 500, 1000 }
+
+struct SensorAgeProto {
+	int64_t timestamp_ms;
+	char sensor[16];
+	int count;
+	int max_ms;
+	int bucket[SENSOR_AGE_BUCKETS];
+};
+
+#define INIT_SENSORAGEPROTO { 0, "", 0, 0, { 0, 0, 0, 0, 0, 0, 0, 0 } }
+
+// For use in printf and friends.
+#define OFMT_SENSORAGEPROTO(x)						\
+	"sensor_age: timestamp_ms:%lld sensor:%s count:%d max_ms:%d "	\
+	"lt10:%d lt20:%d lt50:%d lt100:%d lt200:%d lt500:%d lt1000:%d ge1000:%d\n", \
+		(x).timestamp_ms, (x).sensor, (x).count, (x).max_ms,	\
+		(x).bucket[0], (x).bucket[1], (x).bucket[2], (x).bucket[3], \
+		(x).bucket[4], (x).bucket[5], (x).bucket[6], (x).bucket[7]
+
+#define IFMT_SENSORAGEPROTO(x, n)					\
+	"sensor_age: timestamp_ms:%lld sensor:%15s count:%d max_ms:%d "	\
+	"lt10:%d lt20:%d lt50:%d lt100:%d lt200:%d lt500:%d lt1000:%d ge1000:%d\n%n", \
+		&(x)->timestamp_ms, (x)->sensor, &(x)->count, &(x)->max_ms, \
+		&(x)->bucket[0], &(x)->bucket[1], &(x)->bucket[2], &(x)->bucket[3], \
+		&(x)->bucket[4], &(x)->bucket[5], &(x)->bucket[6], &(x)->bucket[7], (n)
+
+#endif  // PROTO_SENSOR_AGE_H
@@ -10,18 +10,20 @@ struct WindProto {
 	int relative;
 	double speed_m_s;
 	int valid;
+	int64_t mono_timestamp_ms;  // CLOCK_MONOTONIC when the data was read, 0 if unknown
 };
 
-#define INIT_WINDPROTO {0, NAN, -1, NAN, 0}
+#define INIT_WINDPROTO {0, NAN, -1, NAN, 0, 0}
 
 // For use in printf and friends.
 #define OFMT_WINDPROTO(x) \
-	"wind: timestamp_ms:%lld angle_deg:%.3lf speed_m_s:%.2lf valid:%d\n", \
-	(x).timestamp_ms, (x).angle_deg, (x).speed_m_s, (x).valid
+	"wind: timestamp_ms:%lld angle_deg:%.3lf speed_m_s:%.2lf valid:%d mono_timestamp_ms:%lld\n", \
+	(x).timestamp_ms, (x).angle_deg, (x).speed_m_s, (x).valid, (x).mono_timestamp_ms
 
 #define IFMT_WINDPROTO(x, n) \
-	"wind: timestamp_ms:%lld angle_deg:%lf speed_m_s:%lf valid:%d\n%n", \
-	&(x)->timestamp_ms, &(x)->angle_deg, &(x)->speed_m_s, &(x)->valid, (n)
+	"wind: timestamp_ms:%lld angle_deg:%lf speed_m_s:%lf valid:%d mono_timestamp_ms:%lld\n%n", \
+	&(x)->timestamp_ms, &(x)->angle_deg, &(x)->speed_m_s, &(x)->valid, &(x)->mono_timestamp_ms, (n)
+#define IFMT_WINDPROTO_ITEMS 5
 
 
 
@@ -0,0 +1,28 @@
+% Load the column files written by logexport (see logexport/columns.h)
+% into a struct of structs, one per message type, e.g.
+%
+%   c = load_columns("/tmp/day3");
+%   plot(c.imu.time_ms - c.imu.time_ms(1), c.imu.yaw_deg)
+%
+% Every column is read with a single fread, which is much faster than
+% parsing the text logs. Optional types is a cell array of the message
+% types to load, e.g. {"imu", "wind"}.
+
+function c = load_columns(dir, types)
+  [names, formats, rows] = textread([dir "/columns.txt"], "%s %s %d");
+  c = struct();
+  for i = 1:numel(names)
+    [type, field] = strtok(names{i}, ".");
+    field = field(2:end);
+    if nargin > 1 && !any(strcmp(type, types))
+      continue
+    endif
+    fid = fopen([dir "/" names{i}], "r");
+    if fid < 0
+      error("load_columns: cannot open %s/%s", dir, names{i});
+    endif
+    values = fread(fid, rows(i), [formats{i} "=>" formats{i}]);
+    fclose(fid);
+    c.(type).(field) = values;
+  endfor
+endfunction
@@ -0,0 +1,230 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "skipper/isochrone_router.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "common/convert.h"
+#include "common/normalize.h"
+#include "common/now.h"
+#include "common/polar_table.h"
+#include "skipper/lat_lon.h"
+
+extern int debug;
+
+namespace {
+
+const int kMaxThreads = 8;
+
+struct Job {
+  const IsochroneRouter* router;
+  int begin;
+  int end;
+  double time_s;
+  std::vector<IsochroneRouter::Point> sectors;
+};
+
+void* Worker(void* arg) {
+  Job* job = static_cast<Job*>(arg);
+  job->router->Expand(job->begin, job->end, job->time_s, &job->sectors);
+  return NULL;
+}
+
+// Flat distance in degrees (latitude scale) squared.
+double Distance2(double lat, double lon,
+                 double lat0, double lon0, double lon_factor) {
+  double dx = lat - lat0;
+  double dy = (lon - lon0) * lon_factor;
+  return dx * dx + dy * dy;
+}
+
+}  // namespace
+
+IsochroneRouterParams::IsochroneRouterParams()
+    : time_step_s(3600),
+      max_steps(240),
+      heading_step_deg(5),
+      sector_deg(2),
+      threads(sysconf(_SC_NPROCESSORS_ONLN)),
+      budget_ms(500) {
+  if (threads < 1) threads = 1;
+}
+
+IsochroneRouter::IsochroneRouter(const WindField* wind,
+                                 const IsochroneRouterParams& params)
+    : wind_(wind), params_(params), start_lat_(0), start_lon_(0),
+      lon_factor_(1), steps_(0), best_steps_(0), reached_(false) {
+  n_sectors_ = (int)ceil(360.0 / params_.sector_deg);
+  if (params_.threads > kMaxThreads) params_.threads = kMaxThreads;
+  if (params_.threads < 1) params_.threads = 1;
+}
+
+// Moves the front points [begin, end) and keeps the farthest new point
+// per sector.
+void IsochroneRouter::Expand(int begin, int end, double time_s,
+                             std::vector<Point>* sectors) const {
+  const double dt = params_.time_step_s;
+  const PolarTable& polar = DefaultPolarTable();
+  for (int k = begin; k < end; ++k) {
+    const Point& p = front_[k];
+    double wind_from_deg;
+    double wind_m_s;
+    wind_->Get(p.lat, p.lon, time_s, &wind_from_deg, &wind_m_s);
+    const double meters_per_deg_lon = to_cartesian_meters * cos(Deg2Rad(p.lat));
+    for (double h = 0; h < 360; h += params_.heading_step_deg) {
+      double speed_m_s = polar.Speed(wind_from_deg - h, wind_m_s);
+      if (speed_m_s <= 0)
+        continue;
+      double h_rad = Deg2Rad(h);
+      Point n;
+      n.lat = p.lat + speed_m_s * dt * cos(h_rad) / to_cartesian_meters;
+      n.lon = p.lon + speed_m_s * dt * sin(h_rad) / meters_per_deg_lon;
+      n.first_heading = p.first_heading < 0 ? h : p.first_heading;
+      n.distance2 = Distance2(n.lat, n.lon, start_lat_, start_lon_, lon_factor_);
+
+      int s = Sector(n.lat, n.lon);
+      if (n.distance2 > (*sectors)[s].distance2)
+        (*sectors)[s] = n;
+    }
+  }
+}
+
+void IsochroneRouter::ExpandParallel(double time_s, std::vector<Point>* next) {
+  Point empty;
+  empty.distance2 = -1;
+  const int size = front_.size();
+  int threads = params_.threads;
+  // Not worth a thread for a handful of points.
+  if (size < 4 * threads) threads = 1;
+
+  Job jobs[kMaxThreads];
+  pthread_t tid[kMaxThreads];
+  bool started[kMaxThreads];
+  for (int i = 0; i < threads; ++i) {
+    jobs[i].router = this;
+    jobs[i].begin = size * i / threads;
+    jobs[i].end = size * (i + 1) / threads;
+    jobs[i].time_s = time_s;
+    jobs[i].sectors.assign(n_sectors_, empty);
+    started[i] = false;
+  }
+  for (int i = 1; i < threads; ++i)
+    started[i] = pthread_create(&tid[i], NULL, Worker, &jobs[i]) == 0;
+  // The calling thread does the first chunk and any chunk whose thread
+  // could not be started.
+  Worker(&jobs[0]);
+  for (int i = 1; i < threads; ++i) {
+    if (started[i])
+      pthread_join(tid[i], NULL);
+    else
+      Worker(&jobs[i]);
+  }
+
+  // Merge in thread order, ties go to the lower chunk.
+  std::vector<Point>& merged = jobs[0].sectors;
+  for (int i = 1; i < threads; ++i)
+    for (int s = 0; s < n_sectors_; ++s)
+      if (jobs[i].sectors[s].distance2 > merged[s].distance2)
+        merged[s] = jobs[i].sectors[s];
+
+  next->clear();
+  for (int s = 0; s < n_sectors_; ++s)
+    if (merged[s].distance2 >= 0)
+      next->push_back(merged[s]);
+}
+
+int IsochroneRouter::Sector(double lat, double lon) const {
+  double bearing = NormalizeDeg(Rad2Deg(atan2((lon - start_lon_) * lon_factor_,
+                                              lat - start_lat_)));
+  int s = (int)(bearing / params_.sector_deg);
+  return s < n_sectors_ ? s : n_sectors_ - 1;
+}
+
+// Whether the front reaches beyond the target in its or a neighbouring
+// sector.
+bool IsochroneRouter::SweptOver(double lat, double lon) const {
+  const int target = Sector(lat, lon);
+  const double distance2 = Distance2(lat, lon, start_lat_, start_lon_, lon_factor_);
+  for (size_t k = 0; k < front_.size(); ++k) {
+    int d = abs(Sector(front_[k].lat, front_[k].lon) - target);
+    if ((d <= 1 || d == n_sectors_ - 1) && front_[k].distance2 >= distance2)
+      return true;
+  }
+  return false;
+}
+
+bool IsochroneRouter::Route(double lat_deg, double lon_deg,
+                            double target_lat_deg, double target_lon_deg,
+                            double target_radius_deg, double time_s,
+                            double* heading_deg) {
+  int64_t start_us = now_micros();
+  start_lat_ = lat_deg;
+  start_lon_ = lon_deg;
+  lon_factor_ = cos(Deg2Rad(lat_deg));
+  const double target_lon_factor = cos(Deg2Rad(target_lat_deg));
+  steps_ = 0;
+  best_steps_ = 0;
+  reached_ = false;
+
+  Point start;
+  start.lat = lat_deg;
+  start.lon = lon_deg;
+  start.first_heading = -1;
+  start.distance2 = 0;
+  front_.assign(1, start);
+
+  Point best = start;
+  double best_distance2 = Distance2(lat_deg, lon_deg, target_lat_deg,
+                                    target_lon_deg, target_lon_factor);
+  std::vector<Point> next;
+  while (steps_ < params_.max_steps) {
+    ExpandParallel(time_s + steps_ * params_.time_step_s, &next);
+    if (next.empty())
+      break;
+    front_.swap(next);
+    ++steps_;
+
+    // The front point nearest to the target.
+    double front_distance2 = 1E9;
+    int nearest = 0;
+    for (int k = 0; k < (int)front_.size(); ++k) {
+      double d2 = Distance2(front_[k].lat, front_[k].lon, target_lat_deg,
+                            target_lon_deg, target_lon_factor);
+      if (d2 < front_distance2) {
+        front_distance2 = d2;
+        nearest = k;
+      }
+    }
+    // A front that doesn't get nearer may still get around a slow patch,
+    // so we go on until it has swept over the target or time runs out.
+    if (front_distance2 < best_distance2) {
+      best = front_[nearest];
+      best_distance2 = front_distance2;
+      best_steps_ = steps_;
+    }
+    if (best_distance2 <= target_radius_deg * target_radius_deg ||
+        SweptOver(target_lat_deg, target_lon_deg)) {
+      reached_ = true;
+      break;
+    }
+    if ((now_micros() - start_us) / 1000.0 > params_.budget_ms) {
+      if (debug) fprintf(stderr, "Isochrone router out of time after %d steps\n", steps_);
+      break;
+    }
+  }
+  if (debug) {
+    fprintf(stderr, "Isochrone router: %d steps, %s, %d points, %lld us\n",
+            steps_, reached_ ? "reached" : "not reached", (int)front_.size(),
+            (long long)(now_micros() - start_us));
+  }
+  if (best.first_heading < 0)
+    return false;
+  *heading_deg = best.first_heading;
+  return true;
+}
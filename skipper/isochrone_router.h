@@ -0,0 +1,92 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef SKIPPER_ISOCHRONE_ROUTER_H
+#define SKIPPER_ISOCHRONE_ROUTER_H
+
+#include <vector>
+
+#include "skipper/wind_field.h"
+
+/*
+Weather routing with isochrones.
+
+Starting at our position, every point of the current front (the isochrone)
+is moved for one time step into a fan of headings, with the boat speed from
+the DefaultPolarTable and the wind from the WindField at that place and time.
+The new points are sorted into sectors by their bearing from the start and
+only the point farthest from the start survives in each sector, all the
+others are dominated by it. This is repeated until a point of the front lies
+within the target radius, or the front has swept over the target, i.e. it
+reaches farther than the target in the target's sector. The answer is the
+heading of the first leg of the route to the front point that came nearest
+to the target.
+
+The expansion of a front is split over several threads. Each thread fills
+its own sector table, the tables are merged in thread order, so the result
+does not depend on the number of threads.
+
+If the time budget or max_steps run out first, e.g. because the target is
+behind a calm, the route to the nearest point so far is used and reached()
+is false.
+*/
+
+struct IsochroneRouterParams {
+  IsochroneRouterParams();
+  double time_step_s;
+  int max_steps;
+  double heading_step_deg;
+  double sector_deg;   // Angular width of the pruning sectors.
+  int threads;
+  double budget_ms;    // Wall clock limit for one Route() call.
+};
+
+class IsochroneRouter {
+ public:
+  IsochroneRouter(const WindField* wind, const IsochroneRouterParams& params);
+
+  // Returns false if no route could be found, e.g. we are becalmed.
+  // All positions in degrees, time in seconds since the epoch.
+  bool Route(double lat_deg, double lon_deg,
+             double target_lat_deg, double target_lon_deg,
+             double target_radius_deg, double time_s,
+             double* heading_deg);
+
+  // Statistics of the last Route() call.
+  int steps() const { return steps_; }
+  bool reached() const { return reached_; }
+  // To the front point nearest to the target.
+  double eta_s() const { return best_steps_ * params_.time_step_s; }
+
+  // Public for the worker threads only.
+  struct Point {
+    double lat;
+    double lon;
+    double first_heading;  // degrees
+    double distance2;      // from the start, flat deg^2
+  };
+  void Expand(int begin, int end, double time_s,
+              std::vector<Point>* sectors) const;
+
+ private:
+  void ExpandParallel(double time_s, std::vector<Point>* next);
+  // The pruning sector of a position.
+  int Sector(double lat, double lon) const;
+  bool SweptOver(double lat, double lon) const;
+
+  const WindField* wind_;
+  IsochroneRouterParams params_;
+  int n_sectors_;
+
+  // The current isochrone.
+  std::vector<Point> front_;
+  double start_lat_;
+  double start_lon_;
+  double lon_factor_;  // cos(start latitude)
+
+  int steps_;
+  int best_steps_;
+  bool reached_;
+};
+
+#endif  // SKIPPER_ISOCHRONE_ROUTER_H
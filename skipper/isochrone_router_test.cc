@@ -0,0 +1,153 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "skipper/isochrone_router.h"
+
+#include <stdio.h>
+
+#include "common/delta_angle.h"
+#include "lib/testing/testing.h"
+
+int debug = 0;
+
+namespace {
+const char* kWindFile = "/tmp/isochrone_router_test_wind.txt";
+
+// Writes a synthetic wind field between 38 and 44 N, 24 and 14 W with a
+// 0.5 degree grid and two time slices 12h apart. The wind comes from
+// from_deg everywhere, with speed_south_m_s south of 40.5N and
+// speed_north_m_s north of it.
+void WriteWindFile(double from_deg,
+                   double speed_south_m_s, double speed_north_m_s) {
+  FILE* fp = fopen(kWindFile, "w");
+  fprintf(fp, "# synthetic wind field for isochrone_router_test\n");
+  fprintf(fp, "38 -24 0.5 0.5 13 21 2 0 43200\n");
+  for (int t = 0; t < 2; ++t) {
+    for (int i = 0; i < 13; ++i) {
+      double lat = 38 + i * 0.5;
+      for (int j = 0; j < 21; ++j) {
+        fprintf(fp, "%lf %lf\n", from_deg,
+                lat < 40.5 ? speed_south_m_s : speed_north_m_s);
+      }
+    }
+  }
+  fclose(fp);
+}
+}  // namespace
+
+ATEST(WindField, Load) {
+  WriteWindFile(45, 2, 8);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  EXPECT_TRUE(wind.Valid());
+  EXPECT_TRUE(wind.Covers(40, -20));
+  EXPECT_FALSE(wind.Covers(37, -20));
+  double from_deg;
+  double speed_m_s;
+  wind.Get(42, -20, 1000, &from_deg, &speed_m_s);
+  EXPECT_FLOAT_EQ(45, from_deg);
+  EXPECT_FLOAT_EQ(8, speed_m_s);
+  // Half way between the grid lines at 40 and 40.5
+  wind.Get(40.25, -20, 1000, &from_deg, &speed_m_s);
+  EXPECT_FLOAT_EQ(5, speed_m_s);
+  // Clamped outside of the grid
+  wind.Get(10, -100, -1000, &from_deg, &speed_m_s);
+  EXPECT_FLOAT_EQ(2, speed_m_s);
+
+  EXPECT_FALSE(wind.Load("/nonexistent/wind.txt"));
+  EXPECT_FALSE(wind.Valid());
+}
+
+ATEST(IsochroneRouter, BeamReach) {
+  WriteWindFile(0, 6, 6);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouterParams params;
+  params.threads = 1;
+  IsochroneRouter router(&wind, params);
+  double heading = -1;
+  // Wind from North, target due East.
+  EXPECT_TRUE(router.Route(40, -20, 40, -17, 0.01, 0, &heading));
+  EXPECT_TRUE(router.reached());
+  EXPECT_LT(fabs(DeltaOldNewDeg(90, heading)), 15);
+  // 2.3 degrees of longitude at 40N are about 190km, at < 2.6 m/s.
+  EXPECT_GT(router.eta_s(), 190000 / 2.6);
+}
+
+ATEST(IsochroneRouter, SeekStrongerWind) {
+  // Nearly calm on the direct path, fresh wind 50km to the North.
+  WriteWindFile(0, 1, 8);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouterParams params;
+  params.threads = 1;
+  IsochroneRouter router(&wind, params);
+  double heading = -1;
+  EXPECT_TRUE(router.Route(40, -22, 40, -16, 0.01, 0, &heading));
+  EXPECT_TRUE(router.reached());
+  // Go north-east into the stronger wind instead of straight east.
+  EXPECT_LT(heading, 80);
+}
+
+ATEST(IsochroneRouter, ThreadsGiveSameResult) {
+  WriteWindFile(300, 2, 9);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouterParams params;
+  params.threads = 1;
+  params.budget_ms = 1E6;
+  IsochroneRouter single(&wind, params);
+  params.threads = 4;
+  IsochroneRouter parallel(&wind, params);
+  double heading1 = -1;
+  double heading4 = -2;
+  EXPECT_TRUE(single.Route(39, -23, 43, -15, 0.01, 0, &heading1));
+  EXPECT_TRUE(parallel.Route(39, -23, 43, -15, 0.01, 0, &heading4));
+  EXPECT_EQ(heading1, heading4);
+  EXPECT_EQ(single.steps(), parallel.steps());
+}
+
+ATEST(IsochroneRouter, Budget) {
+  WriteWindFile(0, 6, 6);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouterParams params;
+  params.time_step_s = 60;
+  params.budget_ms = 0;
+  IsochroneRouter router(&wind, params);
+  double heading = -1;
+  // Far away target, stops after the first step.
+  EXPECT_TRUE(router.Route(40, -20, 40, -15, 0.01, 0, &heading));
+  EXPECT_FALSE(router.reached());
+  EXPECT_EQ(1, router.steps());
+  EXPECT_LT(fabs(DeltaOldNewDeg(90, heading)), 30);
+}
+
+ATEST(IsochroneRouter, Becalmed) {
+  WriteWindFile(0, 0, 0);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouter router(&wind, IsochroneRouterParams());
+  double heading = -1;
+  EXPECT_FALSE(router.Route(40, -20, 40, -17, 0.01, 0, &heading));
+}
+
+ATEST(IsochroneRouter, CalmBeforeTarget) {
+  // Wind up to 40N, calm from 40.5N on, the target at 42N can't be reached.
+  WriteWindFile(90, 6, 0);
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouterParams params;
+  params.threads = 1;
+  params.budget_ms = 1E6;
+  IsochroneRouter router(&wind, params);
+  double heading = -1;
+  EXPECT_TRUE(router.Route(39, -20, 42, -20, 0.01, 0, &heading));
+  EXPECT_FALSE(router.reached());
+  EXPECT_LT(fabs(DeltaOldNewDeg(0, heading)), 30);
+}
+
+int main(int argc, char* argv[]) {
+  return testing::RunAllTests();
+}
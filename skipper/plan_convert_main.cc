@@ -0,0 +1,82 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Converts route plans between the TCP(...) text tables written by the
+// generate_target_circles_*.m scripts and the binary plan files the
+// skipper loads at runtime (see plan_file.h).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <unistd.h>
+
+#include "skipper/plan_file.h"
+
+int debug = 0;
+
+namespace {
+const char* argv0;
+
+void usage(void) {
+  fprintf(stderr,
+    "usage: %s [options] input output\n"
+    "options:\n"
+    "\t-d  binary input, write a text table (- for stdout)\n"
+    "\t    default: text table input (- for stdin), write a binary plan\n"
+    , argv0);
+  exit(2);
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int ch;
+  argv0 = strrchr(argv[0], '/');
+  if (argv0) ++argv0; else argv0 = argv[0];
+
+  bool dump = false;
+  while ((ch = getopt(argc, argv, "dh")) != -1){
+    switch (ch) {
+    case 'd': dump = true; break;
+    case 'h':
+    default:
+      usage();
+    }
+  }
+  argv += optind;
+  argc -= optind;
+  if (argc != 2) usage();
+
+  openlog(argv0, LOG_PERROR, LOG_LOCAL0);
+
+  std::vector<PlanFileRecord> plan;
+  if (dump) {
+    if (!ReadPlanFile(argv[0], &plan))
+      return 1;
+    FILE* out = strcmp(argv[1], "-") ? fopen(argv[1], "w") : stdout;
+    if (!out) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+    WriteTextPlan(out, plan);
+    if (out != stdout) fclose(out);
+  } else {
+    FILE* in = strcmp(argv[0], "-") ? fopen(argv[0], "r") : stdin;
+    if (!in) {
+      fprintf(stderr, "Could not open %s\n", argv[0]);
+      return 1;
+    }
+    bool ok = ReadTextPlan(in, &plan);
+    if (in != stdin) fclose(in);
+    if (!ok) {
+      fprintf(stderr, "No TCP(lat, lon, radius) lines found in %s\n", argv[0]);
+      return 1;
+    }
+    if (!WritePlanFile(argv[1], plan))
+      return 1;
+  }
+  fprintf(stderr, "%d circles\n", (int)plan.size());
+  return 0;
+}
@@ -0,0 +1,161 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "skipper/plan_file.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <syslog.h>
+#include <unistd.h>
+
+#include "skipper/target_circle.h"
+
+namespace {
+const char kMagic[4] = { 'A', 'V', 'P', 'L' };
+
+uint32_t Checksum(const std::vector<PlanFileRecord>& plan) {
+  uint32_t h = 2166136261u;
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(&plan[0]);
+  const unsigned char* end = p + plan.size() * sizeof(PlanFileRecord);
+  for (; p < end; ++p) {
+    h ^= *p;
+    h *= 16777619u;
+  }
+  return h;
+}
+}  // namespace
+
+bool ValidatePlan(const std::vector<PlanFileRecord>& plan) {
+  if (plan.empty()) {
+    syslog(LOG_ERR, "Empty plan");
+    return false;
+  }
+  for (size_t i = 0; i < plan.size(); ++i) {
+    const PlanFileRecord& r = plan[i];
+    // Same limits as LatLon, checked here to avoid its CHECKs.
+    if (!(r.lat_deg >= -75 && r.lat_deg <= 75 &&
+          r.lon_deg >= -180 && r.lon_deg <= 180 &&
+          r.radius_deg > 0 && r.radius_deg < 90)) {
+      syslog(LOG_ERR, "Bad plan circle %d: %lf %lf %lf",
+             (int)i, r.lat_deg, r.lon_deg, r.radius_deg);
+      return false;
+    }
+    if (i > 0) {
+      const PlanFileRecord& s = plan[i - 1];
+      TargetCircle successor(s.lat_deg, s.lon_deg, s.radius_deg);
+      if (!successor.In(r.lat_deg, r.lon_deg)) {
+        syslog(LOG_ERR, "Center of plan circle %d is not in circle %d",
+               (int)i, (int)i - 1);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void PlanToPoints(const std::vector<PlanFileRecord>& plan,
+                  std::vector<TargetCirclePoint>* points) {
+  points->clear();
+  for (size_t i = 0; i < plan.size(); ++i)
+    points->push_back(TargetCirclePoint(plan[i].lat_deg, plan[i].lon_deg,
+                                        plan[i].radius_deg));
+  points->push_back(TargetCirclePoint(0, 0, 0));  // end marker
+}
+
+bool ReadPlanFile(const char* filename, std::vector<PlanFileRecord>* plan) {
+  plan->clear();
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    syslog(LOG_ERR, "Could not open plan file %s", filename);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(PlanFileHeader)) {
+    syslog(LOG_ERR, "Plan file %s too short", filename);
+    close(fd);
+    return false;
+  }
+  void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    syslog(LOG_ERR, "Could not map plan file %s", filename);
+    return false;
+  }
+  const PlanFileHeader* header = static_cast<const PlanFileHeader*>(map);
+  bool ok = memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+      header->version == kPlanFileVersion &&
+      header->count <= st.st_size / sizeof(PlanFileRecord) &&
+      st.st_size == (off_t)(sizeof(PlanFileHeader) +
+                            header->count * sizeof(PlanFileRecord));
+  if (ok) {
+    const PlanFileRecord* records =
+        reinterpret_cast<const PlanFileRecord*>(header + 1);
+    plan->assign(records, records + header->count);
+    ok = header->count > 0 && Checksum(*plan) == header->checksum;
+  }
+  munmap(map, st.st_size);
+  if (!ok) {
+    syslog(LOG_ERR, "Plan file %s is corrupt", filename);
+    plan->clear();
+    return false;
+  }
+  if (!ValidatePlan(*plan)) {
+    plan->clear();
+    return false;
+  }
+  return true;
+}
+
+bool WritePlanFile(const char* filename, const std::vector<PlanFileRecord>& plan) {
+  if (!ValidatePlan(plan))
+    return false;
+  PlanFileHeader header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kPlanFileVersion;
+  header.count = plan.size();
+  header.checksum = Checksum(plan);
+
+  char tmp[1024];
+  snprintf(tmp, sizeof(tmp), "%s.tmp", filename);
+  FILE* fp = fopen(tmp, "wb");
+  if (!fp) {
+    syslog(LOG_ERR, "Could not open %s", tmp);
+    return false;
+  }
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+      fwrite(&plan[0], sizeof(PlanFileRecord), plan.size(), fp) == plan.size();
+  ok = (fclose(fp) == 0) && ok;
+  if (!ok || rename(tmp, filename) < 0) {
+    syslog(LOG_ERR, "Could not write plan file %s", filename);
+    unlink(tmp);
+    return false;
+  }
+  return true;
+}
+
+bool ReadTextPlan(FILE* fp, std::vector<PlanFileRecord>* plan) {
+  plan->clear();
+  char line[1024];
+  while (fgets(line, sizeof(line), fp)) {
+    const char* tcp = strstr(line, "TCP(");
+    if (!tcp)
+      continue;
+    PlanFileRecord r;
+    if (3 != sscanf(tcp, "TCP(%lf ,%lf ,%lf", &r.lat_deg, &r.lon_deg, &r.radius_deg))
+      return false;
+    if (r.radius_deg == 0)
+      break;  // end marker
+    plan->push_back(r);
+  }
+  return !plan->empty();
+}
+
+void WriteTextPlan(FILE* fp, const std::vector<PlanFileRecord>& plan) {
+  for (size_t i = 0; i < plan.size(); ++i)
+    fprintf(fp, "TCP(%10.8g, %10.8g, %10.8g),\n",
+            plan[i].lat_deg, plan[i].lon_deg, plan[i].radius_deg);
+  fprintf(fp, "TCP(       0,         0,         0)};  // end marker\n");
+}
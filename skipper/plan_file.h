@@ -0,0 +1,69 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef SKIPPER_PLAN_FILE_H
+#define SKIPPER_PLAN_FILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include "skipper/target_circle_cascade.h"
+
+/*
+Route plans that can be loaded at runtime instead of the compiled-in
+TargetCirclePoint tables.
+
+The binary plan file is a header followed by one record per circle, in the
+same order as the tables (index 0 is the circle around the target), in
+host byte order (little endian on all our boards):
+
+  PlanFileHeader  magic "AVPL", version, number of circles, checksum
+  PlanFileRecord  lat_deg, lon_deg, radius_deg
+  ...
+
+The checksum is the 32 bit FNV-1a hash of all record bytes. It protects
+against files that got truncated or garbled on their way to the boat.
+Files are read through mmap and written to a temporary file that is
+renamed into place, so a running skipper never sees half a plan.
+
+Text plans are the "TCP(lat, lon, radius)," lines written by the
+generate_target_circles_*.m scripts and used in the target_circle_points
+tables. plan_convert converts between both formats.
+*/
+
+struct PlanFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t count;
+  uint32_t checksum;
+};
+
+struct PlanFileRecord {
+  double lat_deg;
+  double lon_deg;
+  double radius_deg;
+};
+
+static const uint32_t kPlanFileVersion = 1;
+
+// Checks what TargetCircleCascade::Build would CHECK: sane coordinates,
+// positive radii and each center lying within the circle with the next
+// lower index, i.e. its successor on the way to the target.
+// Returns false and logs the first violation.
+bool ValidatePlan(const std::vector<PlanFileRecord>& plan);
+
+// The plan as end marker terminated array for TargetCircleCascade::Build.
+void PlanToPoints(const std::vector<PlanFileRecord>& plan,
+                  std::vector<TargetCirclePoint>* points);
+
+// Both return false if the file is unreadable, corrupt or invalid.
+bool ReadPlanFile(const char* filename, std::vector<PlanFileRecord>* plan);
+bool WritePlanFile(const char* filename, const std::vector<PlanFileRecord>& plan);
+
+// Reads TCP(lat, lon, radius) lines up to the end marker (radius 0) or the
+// end of the file. Other lines are ignored.
+bool ReadTextPlan(FILE* fp, std::vector<PlanFileRecord>* plan);
+void WriteTextPlan(FILE* fp, const std::vector<PlanFileRecord>& plan);
+
+#endif  // SKIPPER_PLAN_FILE_H
@@ -0,0 +1,127 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "skipper/plan_file.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "lib/testing/testing.h"
+
+int debug = 0;
+
+namespace {
+const char* kPlanFile = "/tmp/plan_file_test.plan";
+const char* kTextFile = "/tmp/plan_file_test.txt";
+
+PlanFileRecord Record(double lat, double lon, double radius) {
+  PlanFileRecord r = { lat, lon, radius };
+  return r;
+}
+
+// A short leg along 40N, each circle containing the center of the next
+// lower one.
+void ThreeCircles(std::vector<PlanFileRecord>* plan) {
+  plan->clear();
+  plan->push_back(Record(40, -10, 0.5));
+  plan->push_back(Record(40, -10.5, 0.6));
+  plan->push_back(Record(40, -11, 0.6));
+}
+}  // namespace
+
+ATEST(PlanFile, RoundTrip) {
+  std::vector<PlanFileRecord> plan;
+  ThreeCircles(&plan);
+  EXPECT_TRUE(WritePlanFile(kPlanFile, plan));
+  std::vector<PlanFileRecord> read;
+  EXPECT_TRUE(ReadPlanFile(kPlanFile, &read));
+  EXPECT_EQ(3, read.size());
+  for (size_t i = 0; i < read.size(); ++i) {
+    EXPECT_EQ(plan[i].lat_deg, read[i].lat_deg);
+    EXPECT_EQ(plan[i].lon_deg, read[i].lon_deg);
+    EXPECT_EQ(plan[i].radius_deg, read[i].radius_deg);
+  }
+
+  std::vector<TargetCirclePoint> points;
+  PlanToPoints(read, &points);
+  EXPECT_EQ(4, points.size());
+  TargetCircleCascade cascade;
+  cascade.Build(&points[0]);
+  EXPECT_EQ(40, cascade.FinalTarget().x0());
+  TCStatus status;
+  cascade.ToDeg(40, -11.4, &status);
+  EXPECT_EQ(2, status.index);
+}
+
+ATEST(PlanFile, DetectsCorruption) {
+  std::vector<PlanFileRecord> plan;
+  ThreeCircles(&plan);
+  EXPECT_TRUE(WritePlanFile(kPlanFile, plan));
+  // Flip one byte in the last record.
+  FILE* fp = fopen(kPlanFile, "r+b");
+  fseek(fp, -3, SEEK_END);
+  int c = fgetc(fp);
+  fseek(fp, -3, SEEK_END);
+  fputc(c ^ 0x10, fp);
+  fclose(fp);
+  std::vector<PlanFileRecord> read;
+  EXPECT_FALSE(ReadPlanFile(kPlanFile, &read));
+  EXPECT_EQ(0, read.size());
+
+  // Truncated.
+  EXPECT_TRUE(WritePlanFile(kPlanFile, plan));
+  EXPECT_EQ(0, truncate(kPlanFile, sizeof(PlanFileHeader) + sizeof(PlanFileRecord)));
+  EXPECT_FALSE(ReadPlanFile(kPlanFile, &read));
+
+  EXPECT_FALSE(ReadPlanFile("/tmp/plan_file_test_does_not_exist", &read));
+}
+
+ATEST(PlanFile, Validation) {
+  std::vector<PlanFileRecord> plan;
+  ThreeCircles(&plan);
+  EXPECT_TRUE(ValidatePlan(plan));
+  // A gap in the cascade: circle 2 does not contain the center of circle 1.
+  plan[2].lon_deg = -12;
+  EXPECT_FALSE(ValidatePlan(plan));
+  EXPECT_FALSE(WritePlanFile(kPlanFile, plan));
+
+  ThreeCircles(&plan);
+  plan[1].radius_deg = 0;
+  EXPECT_FALSE(ValidatePlan(plan));
+  plan.clear();
+  EXPECT_FALSE(ValidatePlan(plan));
+}
+
+ATEST(PlanFile, TextPlan) {
+  FILE* fp = fopen(kTextFile, "w");
+  fprintf(fp, "// generated\n"
+              "TargetCirclePoint plan[] = {\n"
+              "TCP(        40,        -10,        0.5),\n"
+              "TCP( 40, -10.5, 0.6),\n"
+              "TCP(40,-11,0.6),\n"
+              "TCP(       0,         0,         0)};  // end marker\n"
+              "TCP(1, 1, 1),\n");
+  fclose(fp);
+  fp = fopen(kTextFile, "r");
+  std::vector<PlanFileRecord> plan;
+  EXPECT_TRUE(ReadTextPlan(fp, &plan));
+  fclose(fp);
+  EXPECT_EQ(3, plan.size());
+  EXPECT_EQ(-10.5, plan[1].lon_deg);
+  EXPECT_EQ(0.6, plan[2].radius_deg);
+
+  fp = fopen(kTextFile, "w");
+  WriteTextPlan(fp, plan);
+  fclose(fp);
+  fp = fopen(kTextFile, "r");
+  std::vector<PlanFileRecord> again;
+  EXPECT_TRUE(ReadTextPlan(fp, &again));
+  fclose(fp);
+  EXPECT_EQ(3, again.size());
+  EXPECT_EQ(plan[1].lon_deg, again[1].lon_deg);
+}
+
+int main(int argc, char* argv[]) {
+  return testing::RunAllTests();
+}
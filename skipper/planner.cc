@@ -4,22 +4,44 @@
 // Steffen Grundmann, May 2011
 
 #include "skipper/planner.h"
+#include <math.h>
 #include <stdio.h>
 #include <syslog.h>
 
+#include "common/convert.h"
 #include "helmsman/normal_controller.h"
 #include "lib/util/stopwatch.h"
+#include "skipper/isochrone_router.h"
 #include "skipper/plans.h"
 
 
+extern int debug;
+
 double NowSeconds() {
   return StopWatch::GetTimestampMicros()/1E6;
 }
 
 bool Planner::initialized_ = false;
 TargetCircleCascade Planner::plan_;
+std::vector<TargetCirclePoint> Planner::loaded_plan_;
 double Planner::alpha_star_ = 225;
 double Planner::last_turn_time_ = 0;
+WindField Planner::wind_field_;
+bool Planner::route_valid_ = false;
+double Planner::routed_deg_ = 0;
+double Planner::last_route_time_ = 0;
+double Planner::route_lat_deg_ = 0;
+double Planner::route_lon_deg_ = 0;
+
+namespace {
+// The route is recalculated every 10 minutes.
+const double kReroutePeriod = 600;
+// or when we are more than about 5km from where it was calculated, e.g.
+// after a GPS outage, because its first leg may lead elsewhere from here.
+const double kRerouteDistanceDeg = 0.05;
+// The router must not delay the skipper's answer to the helmsman much.
+const double kRouterBudgetMs = 300;
+}  // namespace
 
 
 // We may start from
@@ -31,6 +53,11 @@ double Planner::last_turn_time_ = 0;
 // At the target of the real journey we will also
 // sail criss-cross.
 void Planner::Init(const LatLon& lat_lon) {
+  if (!loaded_plan_.empty()) {
+    plan_.Build(&loaded_plan_[0]);
+    fprintf(stderr, "Built the loaded plan\n");
+    return;
+  }
   fprintf(stderr, "According to our GPS we are not on lake zuerich.\n");
   fprintf(stderr, "lat %8.6lg lon %8.6lg \n", lat_lon.lat, lat_lon.lon);
   fprintf(stderr, "Toulon plan\n");
@@ -64,10 +91,61 @@ double Planner::ToDeg(double lat_deg, double lon_deg, TCStatus* tc_status) {
   } else {
     alpha_star_ = plan_.ToDeg(lat_deg, lon_deg, tc_status);
     // fprintf(stderr, "Planner alpha_star %lf.\n", alpha_star_);
+    if (wind_field_.Covers(lat_deg, lon_deg)) {
+      // The wind forecast knows nothing about land, the target circles do.
+      // Until the next reroute the boat sails at most kRerouteDistanceDeg
+      // on the routed heading, that leg must stay within our circle.
+      double routed_deg = WeatherRouteDeg(lat_deg, lon_deg, alpha_star_);
+      if (plan_.LegInside(lat_deg, lon_deg, routed_deg, kRerouteDistanceDeg))
+        alpha_star_ = routed_deg;
+      else if (debug)
+        fprintf(stderr, "Weather route %lf leaves the target circle, "
+                "following the plan.\n", routed_deg);
+    }
   }
   return alpha_star_;
 }
 
+double Planner::WeatherRouteDeg(double lat_deg, double lon_deg,
+                                double default_deg) {
+  const double dlat = lat_deg - route_lat_deg_;
+  const double dlon = (lon_deg - route_lon_deg_) * cos(Deg2Rad(lat_deg));
+  if (NowSeconds() > last_route_time_ + kReroutePeriod ||
+      dlat * dlat + dlon * dlon > kRerouteDistanceDeg * kRerouteDistanceDeg) {
+    last_route_time_ = NowSeconds();
+    route_lat_deg_ = lat_deg;
+    route_lon_deg_ = lon_deg;
+    const TargetCircle& target = plan_.FinalTarget();
+    IsochroneRouterParams params;
+    params.budget_ms = kRouterBudgetMs;
+    IsochroneRouter router(&wind_field_, params);
+    route_valid_ = router.Route(lat_deg, lon_deg,
+                                target.x0(), target.y0(), target.radius(),
+                                NowSeconds(), &routed_deg_);
+    if (route_valid_)
+      syslog(LOG_NOTICE, "Weather route: %6.2lf deg, eta %6.1lf h%s\n",
+             routed_deg_, router.eta_s() / 3600,
+             router.reached() ? "" : " (incomplete)");
+    else
+      syslog(LOG_NOTICE, "No weather route found, following the plan.\n");
+  }
+  return route_valid_ ? routed_deg_ : default_deg;
+}
+
+void Planner::LoadPlan(const std::vector<PlanFileRecord>& plan) {
+  PlanToPoints(plan, &loaded_plan_);
+  plan_.Build(&loaded_plan_[0]);
+  initialized_ = true;
+  route_valid_ = false;
+  last_route_time_ = 0;
+}
+
+bool Planner::LoadWindField(const char* wind_filename) {
+  route_valid_ = false;
+  last_route_time_ = 0;
+  return wind_field_.Load(wind_filename);
+}
+
 bool Planner::TargetReached(const LatLon& lat_lon){
   return plan_.TargetReached(lat_lon);
 }
@@ -78,6 +156,8 @@ bool Planner::Initialized() {
 
 void Planner::Reset() {
   initialized_ = false;
+  route_valid_ = false;
+  last_route_time_ = 0;
 }
 
 void Planner::SimplePlan(double lat_deg, double lon_deg) {
@@ -86,4 +166,6 @@ void Planner::SimplePlan(double lat_deg, double lon_deg) {
   TargetCirclePoint end_marker = TargetCirclePoint(0, 0, 0);
   TargetCirclePoint management_summary[3] = {exact, cover_all, end_marker};
   plan_.Build(management_summary);
+  route_valid_ = false;
+  last_route_time_ = 0;
 }
@@ -2,7 +2,11 @@
 // Use of this source code is governed by the Apache License 2.0
 // that can be found in the LICENSE file.
 // Steffen Grundmann, July 2011
+#include <vector>
+
+#include "skipper/plan_file.h"
 #include "skipper/target_circle_cascade.h"
+#include "skipper/wind_field.h"
 
 class Planner {
  public:
@@ -14,11 +18,28 @@ class Planner {
   static bool Initialized();
   static void Reset();
   static void SimplePlan(double lat_deg, double lon_deg);
+  // Replaces the compiled-in plan, also after a Reset(). The plan must
+  // have passed ValidatePlan.
+  static void LoadPlan(const std::vector<PlanFileRecord>& plan);
+  // With a wind forecast loaded, the way to the final target of the plan
+  // is found by the isochrone router. The target circles remain the
+  // fallback outside of the forecast area and wherever the routed heading
+  // would leave the target circle we are in, e.g. towards land.
+  static bool LoadWindField(const char* wind_filename);
  private:
+  static double WeatherRouteDeg(double lat_deg, double lon_deg,
+                                double default_deg);
   static bool initialized_;
   static TargetCircleCascade plan_;
+  static std::vector<TargetCirclePoint> loaded_plan_;
   static double alpha_star_;
   static double last_turn_time_;
+  static WindField wind_field_;
+  static bool route_valid_;
+  static double routed_deg_;
+  static double last_route_time_;
+  static double route_lat_deg_;  // where the route was calculated
+  static double route_lon_deg_;
 };
 
 
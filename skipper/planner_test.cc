@@ -0,0 +1,74 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "skipper/planner.h"
+
+#include <stdio.h>
+#include <vector>
+
+#include "lib/testing/testing.h"
+#include "skipper/isochrone_router.h"
+
+int debug = 0;
+
+namespace {
+const char* kWindFile = "/tmp/planner_test_wind.txt";
+
+// Wind from the North between 38 and 44 N, 24 and 14 W, nearly calm south
+// of 40.5N and fresh north of it, as in isochrone_router_test.
+void WriteWindFile() {
+  FILE* fp = fopen(kWindFile, "w");
+  fprintf(fp, "38 -24 0.5 0.5 13 21 2 0 43200\n");
+  for (int t = 0; t < 2; ++t)
+    for (int i = 0; i < 13; ++i)
+      for (int j = 0; j < 21; ++j)
+        fprintf(fp, "0 %d\n", 38 + i * 0.5 < 40.5 ? 1 : 8);
+  fclose(fp);
+}
+
+// A chain of small circles along 39.5N to the target at 16W, the coast
+// is just north of them.
+void LoadCoastalPlan() {
+  std::vector<PlanFileRecord> plan;
+  for (int i = 0; i < 7; ++i) {
+    PlanFileRecord r = {39.5, -16 - 0.7 * i, 0.6};
+    plan.push_back(r);
+  }
+  Planner::LoadPlan(plan);
+}
+}  // namespace
+
+ATEST(Planner, WeatherRouteStaysInTargetCircle) {
+  LoadCoastalPlan();
+  // On the northern edge of the last circle, it leads south.
+  EXPECT_FLOAT_EQ(180, Planner::ToDeg(40.09, -20.2, NULL));
+
+  // The fresh wind further north tempts the router across the coast.
+  WriteWindFile();
+  WindField wind;
+  EXPECT_TRUE(wind.Load(kWindFile));
+  IsochroneRouterParams params;
+  params.threads = 1;
+  IsochroneRouter router(&wind, params);
+  double routed = -1;
+  EXPECT_TRUE(router.Route(40.09, -20.2, 39.5, -16, 0.6, 0, &routed));
+  EXPECT_LT(routed, 90);
+
+  EXPECT_TRUE(Planner::LoadWindField(kWindFile));
+  EXPECT_FLOAT_EQ(180, Planner::ToDeg(40.09, -20.2, NULL));
+
+  // In the middle of a circle the routed heading is followed, not the
+  // one towards the center.
+  Planner::LoadWindField("/nonexistent/wind.txt");
+  double to_center = Planner::ToDeg(39.3, -20, NULL);
+  EXPECT_TRUE(Planner::LoadWindField(kWindFile));
+  EXPECT_TRUE(router.Route(39.3, -20, 39.5, -16, 0.6, 0, &routed));
+  double planned = Planner::ToDeg(39.3, -20, NULL);
+  EXPECT_EQ_TOL(routed, planned, 10);
+  EXPECT_GT(fabs(planned - to_center), 10);
+}
+
+int main(int argc, char* argv[]) {
+  return testing::RunAllTests();
+}
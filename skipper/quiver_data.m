@@ -0,0 +1,450 @@
+x = [ ...
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+5.800000
+5.820000
+5.840000
+5.860000
+5.880000
+5.900000
+5.920000
+5.940000
+];
+y = [ ...
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+];
+u = [ ...
+0.660226
+0.505609
+0.281194
+0.000000
+0.000000
+0.000000
+-0.144961
+-0.402375
+0.825944
+0.698732
+0.438828
+0.000000
+0.000000
+0.000000
+-0.237212
+-0.590949
+0.975081
+0.946404
+0.825944
+0.825944
+0.825944
+0.590949
+-0.590949
+-0.910198
+0.997829
+0.995136
+0.825944
+0.825944
+0.825944
+0.590949
+-0.590949
+-0.910198
+0.996472
+0.992115
+0.969534
+0.000000
+-0.969534
+-0.992115
+-0.237212
+-0.590949
+0.994791
+0.988392
+0.831024
+0.000000
+-0.831024
+-0.988392
+-0.994791
+-0.402375
+0.999834
+0.999627
+0.686599
+0.000000
+-0.686599
+-0.999627
+-0.999834
+-0.999907
+0.991959
+0.982176
+0.575424
+0.000000
+-0.575424
+-0.982176
+-0.991959
+-0.995453
+0.975003
+0.946243
+0.825518
+0.000000
+-0.825518
+-0.946243
+-0.975003
+-0.985706
+0.825518
+0.698151
+0.438252
+0.000000
+-0.438252
+-0.698151
+-0.825518
+-0.889844
+0.659621
+0.504997
+0.280774
+0.000000
+-0.280774
+-0.504997
+-0.659621
+-0.760219
+];
+v = [ ...
+0.751067
+0.862763
+0.959651
+1.000000
+1.000000
+1.000000
+0.989437
+0.915475
+0.563752
+0.715383
+0.898571
+1.000000
+1.000000
+1.000000
+0.971458
+0.806709
+0.221848
+0.322986
+0.563752
+0.563752
+0.563752
+0.806709
+0.806709
+0.414173
+0.065851
+0.098510
+-0.563752
+-0.563752
+-0.563752
+-0.806709
+-0.806709
+-0.414173
+-0.083920
+-0.125330
+-0.244955
+-1.000000
+-0.244955
+-0.125330
+-0.971458
+-0.806709
+0.101940
+0.151926
+-0.556237
+-1.000000
+-0.556237
+0.151926
+0.101940
+-0.915475
+-0.018219
+-0.027323
+-0.727036
+-1.000000
+-0.727036
+-0.027323
+-0.018219
+-0.013665
+-0.126559
+-0.187966
+-0.817855
+-1.000000
+-0.817855
+-0.187966
+-0.126559
+-0.095254
+-0.222191
+-0.323456
+-0.564376
+-1.000000
+-0.564376
+-0.323456
+-0.222191
+-0.168473
+-0.564376
+-0.715951
+-0.898852
+-1.000000
+-0.898852
+-0.715951
+-0.564376
+-0.456265
+-0.751598
+-0.863121
+-0.959774
+-1.000000
+-0.959774
+-0.863121
+-0.751598
+-0.649667
+];
+c = [ ...
+5.000000
+5.000000
+5.000000
+5.000000
+3.000000
+1.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+3.000000
+1.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+3.000000
+1.000000
+0.000000
+0.000000
+0.000000
+6.000000
+6.000000
+5.000000
+3.000000
+1.000000
+0.000000
+0.000000
+0.000000
+7.000000
+7.000000
+7.000000
+6.000000
+7.000000
+7.000000
+0.000000
+0.000000
+9.000000
+9.000000
+8.000000
+8.000000
+8.000000
+9.000000
+9.000000
+0.000000
+10.000000
+10.000000
+9.000000
+9.000000
+9.000000
+10.000000
+10.000000
+10.000000
+11.000000
+11.000000
+10.000000
+10.000000
+10.000000
+11.000000
+11.000000
+11.000000
+12.000000
+12.000000
+12.000000
+11.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+];
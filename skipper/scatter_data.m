@@ -0,0 +1,6365 @@
+x = [ ...
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+5.800000
+5.805000
+5.810000
+5.815000
+5.820000
+5.825000
+5.830000
+5.835000
+5.840000
+5.845000
+5.850000
+5.855000
+5.860000
+5.865000
+5.870000
+5.875000
+5.880000
+5.885000
+5.890000
+5.895000
+5.900000
+5.905000
+5.910000
+5.915000
+5.920000
+5.925000
+5.930000
+5.935000
+5.940000
+5.945000
+5.950000
+];
+y = [ ...
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.850000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.855000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.860000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.865000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.870000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.875000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.880000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.885000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.890000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.895000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.900000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.905000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.910000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.915000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.920000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.925000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.930000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.935000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.940000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.945000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.950000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.955000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.960000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.965000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.970000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.975000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.980000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.985000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.990000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+42.995000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.000000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.005000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.010000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.015000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.020000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.025000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.030000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.035000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.040000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.045000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+43.050000
+];
+u = [ ...
+0.660226
+0.627444
+0.590949
+0.550428
+0.505609
+0.456288
+0.402375
+0.343928
+0.281194
+0.214641
+0.144961
+0.073059
+0.000000
+-0.073059
+0.000000
+-0.073059
+0.000000
+-0.073059
+0.000000
+-0.073059
+0.000000
+-0.073059
+0.000000
+-0.073059
+-0.144961
+-0.214641
+-0.281194
+-0.343928
+-0.402375
+-0.456288
+-0.505609
+0.698732
+0.667040
+0.631263
+0.590949
+0.545665
+0.495043
+0.438828
+0.376948
+0.309580
+0.237212
+0.160672
+0.081125
+0.000000
+-0.081125
+0.000000
+-0.081125
+0.000000
+-0.081125
+0.000000
+-0.081125
+0.000000
+-0.081125
+0.000000
+-0.081125
+-0.160672
+-0.237212
+-0.309580
+-0.376948
+-0.438828
+-0.495043
+-0.545665
+0.739579
+0.709655
+0.675329
+0.635975
+0.590949
+0.539636
+0.481520
+0.416283
+0.343928
+0.264891
+0.180140
+0.091186
+0.000000
+-0.091186
+0.000000
+-0.091186
+0.000000
+-0.091186
+0.000000
+-0.091186
+0.000000
+-0.091186
+0.000000
+-0.091186
+-0.180140
+-0.264891
+-0.343928
+-0.416283
+-0.481520
+-0.539636
+-0.590949
+0.782274
+0.754927
+0.722984
+0.685621
+0.641929
+0.590949
+0.531760
+0.463614
+0.386131
+0.299532
+0.204859
+0.104081
+0.000000
+-0.104081
+0.000000
+-0.104081
+0.000000
+-0.104081
+0.000000
+-0.104081
+0.000000
+-0.104081
+0.000000
+-0.104081
+-0.204859
+-0.299532
+-0.386131
+-0.463614
+-0.531760
+-0.590949
+-0.641929
+0.825944
+0.802073
+0.773622
+0.739579
+0.698732
+0.649691
+0.590949
+0.521041
+0.438828
+0.343928
+0.237212
+0.121191
+0.000000
+-0.121191
+0.000000
+-0.121191
+0.000000
+-0.121191
+0.000000
+-0.121191
+0.000000
+-0.121191
+0.000000
+-0.121191
+-0.237212
+-0.343928
+-0.438828
+-0.521041
+-0.590949
+-0.649691
+-0.698732
+0.869228
+0.849711
+0.825944
+0.796779
+0.760740
+0.715973
+0.660226
+0.590949
+0.505609
+0.402375
+0.281194
+0.144961
+0.000000
+-0.144961
+0.000000
+-0.144961
+0.000000
+-0.144961
+0.000000
+-0.144961
+0.000000
+-0.144961
+0.000000
+-0.144961
+-0.281194
+-0.402375
+-0.505609
+-0.590949
+-0.660226
+-0.715973
+-0.760740
+0.910198
+0.895712
+0.877678
+0.854950
+0.825944
+0.788479
+0.739579
+0.675329
+0.590949
+0.481520
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.000000
+-0.180140
+-0.343928
+-0.481520
+-0.590949
+-0.675329
+-0.739579
+-0.788479
+-0.825944
+0.946404
+0.937158
+0.925404
+0.910198
+0.890144
+0.863135
+0.825944
+0.773622
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.438828
+0.237212
+0.000000
+-0.237212
+-0.438828
+-0.590949
+-0.698732
+-0.773622
+-0.825944
+-0.863135
+-0.890144
+0.975081
+0.970552
+0.964692
+0.956938
+0.946404
+0.931645
+0.910198
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.739579
+0.590949
+0.343928
+0.000000
+-0.343928
+-0.590949
+-0.739579
+-0.825944
+-0.877678
+-0.910198
+-0.931645
+-0.946404
+0.993592
+0.992387
+0.990811
+0.988692
+0.985752
+0.981510
+0.975081
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.910198
+0.825944
+0.590949
+0.000000
+-0.590949
+-0.825944
+-0.910198
+-0.946404
+-0.964692
+-0.975081
+-0.981510
+-0.985752
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+0.068515
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+0.993592
+0.992387
+0.990811
+0.988692
+0.985752
+0.981510
+0.975081
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.964692
+0.946404
+0.910198
+0.825944
+0.590949
+0.000000
+-0.590949
+-0.825944
+-0.910198
+-0.946404
+-0.964692
+-0.975081
+-0.981510
+-0.985752
+0.997829
+0.997419
+0.996879
+0.996151
+0.995136
+0.993661
+0.991402
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.877678
+0.825944
+0.739579
+0.590949
+0.343928
+0.000000
+-0.343928
+-0.590949
+-0.739579
+-0.825944
+-0.877678
+-0.910198
+-0.931645
+-0.946404
+0.998860
+0.998644
+0.998360
+0.997976
+0.997441
+0.996661
+0.995464
+0.993487
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.698732
+0.590949
+0.438828
+0.237212
+0.000000
+-0.237212
+-0.438828
+-0.590949
+-0.698732
+-0.773622
+-0.825944
+-0.863135
+-0.890144
+0.989874
+0.987984
+0.985516
+0.982208
+0.977640
+0.971089
+0.961249
+0.932356
+0.899861
+0.839866
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.343928
+0.180140
+0.000000
+-0.180140
+-0.343928
+-0.481520
+-0.590949
+-0.675329
+-0.739579
+-0.788479
+-0.825944
+0.999563
+0.999479
+0.999370
+0.999223
+0.999016
+0.998716
+0.998253
+0.834283
+0.770971
+0.672198
+0.517814
+0.289666
+0.000000
+-0.289666
+-0.517814
+-0.672198
+-0.770971
+-0.834283
+-0.998253
+-0.144961
+0.000000
+-0.144961
+0.000000
+-0.144961
+-0.281194
+-0.402375
+-0.505609
+-0.590949
+-0.660226
+-0.715973
+-0.760740
+0.996472
+0.995806
+0.994932
+0.993754
+0.992115
+0.989738
+0.986110
+0.980179
+0.969534
+0.540513
+0.393707
+0.209401
+0.000000
+-0.209401
+-0.393707
+-0.540513
+-0.969534
+-0.980179
+-0.986110
+-0.989738
+-0.992115
+-0.121191
+0.000000
+-0.121191
+-0.237212
+-0.343928
+-0.438828
+-0.521041
+-0.590949
+-0.649691
+-0.698732
+0.993065
+0.991763
+0.990059
+0.987770
+0.984596
+0.980021
+0.973095
+0.903186
+0.859732
+0.783880
+0.643929
+0.387876
+0.000000
+-0.387876
+-0.643929
+-0.783880
+-0.859732
+-0.903186
+-0.973095
+-0.980021
+-0.984596
+-0.987770
+0.000000
+-0.104081
+-0.204859
+-0.299532
+-0.386131
+-0.463614
+-0.531760
+-0.590949
+-0.641929
+0.999990
+0.999988
+0.999985
+0.999982
+0.999977
+0.999970
+0.999959
+0.800615
+0.730266
+0.625509
+0.471372
+0.258177
+0.000000
+-0.258177
+-0.471372
+-0.625509
+-0.730266
+-0.800615
+-0.999959
+-0.999970
+-0.999977
+-0.999982
+-0.999985
+-0.091186
+-0.180140
+-0.264891
+-0.343928
+-0.416283
+-0.481520
+-0.539636
+-0.590949
+0.994082
+0.992969
+0.991511
+0.989551
+0.986830
+0.982901
+0.976939
+0.967285
+0.950238
+0.506453
+0.364611
+0.192136
+0.000000
+-0.192136
+-0.364611
+-0.506453
+-0.950238
+-0.967285
+-0.976939
+-0.982901
+-0.986830
+-0.989551
+-0.991511
+-0.992969
+-0.994082
+-0.237212
+-0.309580
+-0.376948
+-0.438828
+-0.495043
+-0.545665
+0.994791
+0.993810
+0.992524
+0.990795
+0.988392
+0.984918
+0.979638
+0.881569
+0.831024
+0.746088
+0.598463
+0.349893
+0.000000
+-0.349893
+-0.598463
+-0.746088
+-0.831024
+-0.881569
+-0.979638
+-0.984918
+-0.988392
+-0.990795
+-0.992524
+-0.993810
+-0.994791
+-0.995556
+-0.996165
+-0.343928
+-0.402375
+-0.456288
+-0.505609
+0.999935
+0.999923
+0.999907
+0.999885
+0.999854
+0.999810
+0.999741
+0.777569
+0.703285
+0.595859
+0.443365
+0.240086
+0.000000
+-0.240086
+-0.443365
+-0.595859
+-0.703285
+-0.777569
+-0.999741
+-0.999810
+-0.999854
+-0.999885
+-0.999907
+-0.999923
+-0.999935
+-0.999945
+-0.999952
+-0.999959
+-0.999964
+-0.422511
+-0.470193
+0.992248
+0.990795
+0.988894
+0.986341
+0.982807
+0.977718
+0.970030
+0.957671
+0.936102
+0.485001
+0.346786
+0.181785
+0.000000
+-0.181785
+-0.346786
+-0.485001
+-0.936102
+-0.957671
+-0.970030
+-0.977718
+-0.982807
+-0.986341
+-0.988894
+-0.990795
+-0.992248
+-0.993383
+-0.994287
+-0.995018
+-0.995617
+-0.996115
+-0.996532
+0.995455
+0.994598
+0.993475
+0.991963
+0.989861
+0.986818
+0.902152
+0.867336
+0.812567
+0.722678
+0.571833
+0.329106
+0.000000
+-0.329106
+-0.571833
+-0.722678
+-0.812567
+-0.867336
+-0.902152
+-0.986818
+-0.989861
+-0.991963
+-0.993475
+-0.994598
+-0.995455
+-0.996124
+-0.996655
+-0.997084
+-0.997436
+-0.997728
+-0.997972
+0.999834
+0.999802
+0.999761
+0.999705
+0.999627
+0.999512
+0.999337
+0.763024
+0.686599
+0.577991
+0.426983
+0.229778
+0.000000
+-0.229778
+-0.426983
+-0.577991
+-0.686599
+-0.763024
+-0.999337
+-0.999512
+-0.999627
+-0.999705
+-0.999761
+-0.999802
+-0.999834
+-0.999859
+-0.999878
+-0.999894
+-0.999907
+-0.999917
+-0.999926
+0.991386
+0.989774
+0.987666
+0.984838
+0.980926
+0.975301
+0.966822
+0.953234
+0.929650
+0.472097
+0.336235
+0.175733
+0.000000
+-0.175733
+-0.336235
+-0.472097
+-0.929650
+-0.953234
+-0.966822
+-0.975301
+-0.980926
+-0.984838
+-0.987666
+-0.989774
+-0.991386
+-0.992646
+-0.993650
+-0.994461
+-0.995127
+-0.995680
+-0.996144
+0.995013
+0.994073
+0.992842
+0.991185
+0.988883
+0.985553
+0.897283
+0.861122
+0.804616
+0.712792
+0.560905
+0.320849
+0.000000
+-0.320849
+-0.560905
+-0.712792
+-0.804616
+-0.861122
+-0.897283
+-0.985553
+-0.988883
+-0.991185
+-0.992842
+-0.994073
+-0.995013
+-0.995746
+-0.996329
+-0.996800
+-0.997186
+-0.997506
+-0.997774
+0.999907
+0.999889
+0.999865
+0.999834
+0.999790
+0.999726
+0.999626
+0.756792
+0.679527
+0.570521
+0.420236
+0.225588
+0.000000
+-0.225588
+-0.420236
+-0.570521
+-0.679527
+-0.756792
+-0.999626
+-0.999726
+-0.999790
+-0.999834
+-0.999865
+-0.999889
+-0.999907
+-0.999920
+-0.999931
+-0.999940
+-0.999947
+-0.999953
+-0.999958
+0.991959
+0.990452
+0.988482
+0.985837
+0.982176
+0.976907
+0.968952
+0.956178
+0.575424
+0.466693
+0.331853
+0.173235
+0.000000
+-0.173235
+-0.331853
+-0.466693
+-0.575424
+-0.956178
+-0.968952
+-0.976907
+-0.982176
+-0.985837
+-0.988482
+-0.990452
+-0.991959
+-0.993136
+-0.994073
+-0.994831
+-0.995453
+-0.995969
+-0.996402
+0.993571
+0.992363
+0.990781
+0.988655
+0.985706
+0.981452
+0.900467
+0.865181
+0.809803
+0.719228
+0.567999
+0.326192
+0.000000
+-0.326192
+-0.567999
+-0.719228
+-0.809803
+-0.865181
+-0.900467
+-0.981452
+-0.985706
+-0.988655
+-0.990781
+-0.992363
+-0.993571
+-0.994514
+-0.995265
+-0.995871
+-0.996368
+-0.996781
+-0.997127
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+1.000000
+0.760813
+0.684085
+0.575329
+0.424572
+0.228277
+0.000000
+-0.228277
+-0.424572
+-0.575329
+-0.684085
+-0.760813
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+-1.000000
+0.993571
+0.992363
+0.990781
+0.988655
+0.985706
+0.981452
+0.975003
+0.964583
+0.579048
+0.470135
+0.334642
+0.174824
+0.000000
+-0.174824
+-0.334642
+-0.470135
+-0.579048
+-0.964583
+-0.975003
+-0.981452
+-0.985706
+-0.988655
+-0.990781
+-0.992363
+-0.993571
+-0.994514
+-0.995265
+-0.995871
+-0.996368
+-0.996781
+-0.997127
+0.975003
+0.970460
+0.964583
+0.956806
+0.946243
+0.931445
+0.909944
+0.877350
+0.825518
+0.739034
+0.590324
+0.141442
+0.000000
+-0.141442
+-0.590324
+-0.739034
+-0.825518
+-0.877350
+-0.909944
+-0.931445
+-0.946243
+-0.956806
+-0.964583
+-0.970460
+-0.975003
+-0.978583
+-0.981452
+-0.983785
+-0.985706
+-0.987308
+-0.988655
+0.946243
+0.936972
+0.925188
+0.909944
+0.889844
+0.862777
+0.825518
+0.773117
+0.698151
+0.590324
+0.438252
+0.236848
+0.000000
+-0.236848
+-0.438252
+-0.590324
+-0.698151
+-0.773117
+-0.825518
+-0.862777
+-0.889844
+-0.909944
+-0.925188
+-0.936972
+-0.946243
+-0.953652
+-0.959656
+-0.964583
+-0.968672
+-0.972101
+-0.975003
+0.909944
+0.895424
+0.877350
+0.854576
+0.825518
+0.787994
+0.739034
+0.674732
+0.590324
+0.480919
+0.343435
+0.179857
+0.000000
+-0.179857
+-0.343435
+-0.480919
+-0.590324
+-0.674732
+-0.739034
+-0.787994
+-0.825518
+-0.854576
+-0.877350
+-0.895424
+-0.909944
+-0.921746
+-0.931445
+-0.939496
+-0.946243
+-0.951947
+-0.956806
+0.868882
+0.849327
+0.825518
+0.796306
+0.760219
+0.715405
+0.659621
+0.590324
+0.504997
+0.401827
+0.280774
+0.144731
+0.000000
+-0.144731
+-0.280774
+-0.401827
+-0.504997
+-0.590324
+-0.659621
+-0.715405
+-0.760219
+-0.796306
+-0.825518
+-0.849327
+-0.868882
+-0.885072
+-0.898582
+-0.909944
+-0.919571
+-0.927786
+-0.934842
+0.825518
+0.801607
+0.773117
+0.739034
+0.698151
+0.649081
+0.590324
+0.520424
+0.438252
+0.343435
+0.236848
+0.120997
+0.000000
+-0.120997
+-0.236848
+-0.343435
+-0.438252
+-0.520424
+-0.590324
+-0.649081
+-0.698151
+-0.739034
+-0.773117
+-0.801607
+-0.825518
+-0.845682
+-0.862777
+-0.877350
+-0.889844
+-0.900612
+-0.909944
+0.781780
+0.754399
+0.722423
+0.685031
+0.641316
+0.590324
+0.531141
+0.463023
+0.385598
+0.299090
+0.204540
+0.103913
+0.000000
+-0.103913
+-0.204540
+-0.299090
+-0.385598
+-0.463023
+-0.531141
+-0.590324
+-0.641316
+-0.685031
+-0.722423
+-0.754399
+-0.781780
+-0.805282
+-0.825518
+-0.843003
+-0.858171
+-0.871383
+-0.882937
+0.739034
+0.709082
+0.674732
+0.635359
+0.590324
+0.539015
+0.480919
+0.415725
+0.343435
+0.264491
+0.179857
+0.091040
+0.000000
+-0.091040
+-0.179857
+-0.264491
+-0.343435
+-0.415725
+-0.480919
+-0.539015
+-0.590324
+-0.635359
+-0.674732
+-0.709082
+-0.739034
+-0.765165
+-0.787994
+-0.807979
+-0.825518
+-0.840952
+-0.854576
+0.698151
+0.666439
+0.630646
+0.590324
+0.545043
+0.494436
+0.438252
+0.376423
+0.309126
+0.236848
+0.160418
+0.080995
+0.000000
+-0.080995
+-0.160418
+-0.236848
+-0.309126
+-0.376423
+-0.438252
+-0.494436
+-0.545043
+-0.590324
+-0.630646
+-0.666439
+-0.698151
+-0.726227
+-0.751087
+-0.773117
+-0.792666
+-0.810042
+-0.825518
+0.659621
+0.626825
+0.590324
+0.549805
+0.504997
+0.455701
+0.401827
+0.343435
+0.280774
+0.214308
+0.144731
+0.072941
+0.000000
+-0.072941
+-0.144731
+-0.214308
+-0.280774
+-0.343435
+-0.401827
+-0.455701
+-0.504997
+-0.549805
+-0.590324
+-0.626825
+-0.659621
+-0.689039
+-0.715405
+-0.739034
+-0.760219
+-0.779228
+-0.796306
+];
+v = [ ...
+0.751067
+0.778662
+0.806709
+0.834882
+0.862763
+0.889832
+0.915475
+0.938996
+0.959651
+0.976693
+0.989437
+0.997328
+1.000000
+0.997328
+1.000000
+0.997328
+1.000000
+0.997328
+1.000000
+0.997328
+1.000000
+0.997328
+1.000000
+0.997328
+0.989437
+0.976693
+0.959651
+0.938996
+0.915475
+0.889832
+0.862763
+0.715383
+0.745022
+0.775568
+0.806709
+0.838003
+0.868869
+0.898571
+0.926234
+0.950873
+0.971458
+0.987008
+0.996704
+1.000000
+0.996704
+1.000000
+0.996704
+1.000000
+0.996704
+1.000000
+0.996704
+1.000000
+0.996704
+1.000000
+0.996704
+0.987008
+0.971458
+0.950873
+0.926234
+0.898571
+0.868869
+0.838003
+0.673070
+0.704549
+0.737517
+0.771710
+0.806709
+0.841898
+0.876435
+0.909235
+0.938996
+0.964278
+0.983641
+0.995834
+1.000000
+0.995834
+1.000000
+0.995834
+1.000000
+0.995834
+1.000000
+0.995834
+1.000000
+0.995834
+1.000000
+0.995834
+0.983641
+0.964278
+0.938996
+0.909235
+0.876435
+0.841898
+0.806709
+0.622935
+0.655809
+0.690865
+0.727959
+0.766764
+0.806709
+0.846895
+0.886037
+0.922444
+0.954086
+0.978791
+0.994569
+1.000000
+0.994569
+1.000000
+0.994569
+1.000000
+0.994569
+1.000000
+0.994569
+1.000000
+0.994569
+1.000000
+0.994569
+0.978791
+0.954086
+0.922444
+0.886037
+0.846895
+0.806709
+0.766764
+0.563752
+0.597227
+0.633647
+0.673070
+0.715383
+0.760198
+0.806709
+0.853532
+0.898571
+0.938996
+0.971458
+0.992629
+1.000000
+0.992629
+1.000000
+0.992629
+1.000000
+0.992629
+1.000000
+0.992629
+1.000000
+0.992629
+1.000000
+0.992629
+0.971458
+0.938996
+0.898571
+0.853532
+0.806709
+0.760198
+0.715383
+0.494412
+0.527249
+0.563752
+0.604271
+0.649057
+0.698128
+0.751067
+0.806709
+0.862763
+0.915475
+0.959651
+0.989437
+1.000000
+0.989437
+1.000000
+0.989437
+1.000000
+0.989437
+1.000000
+0.989437
+1.000000
+0.989437
+1.000000
+0.989437
+0.959651
+0.915475
+0.862763
+0.806709
+0.751067
+0.698128
+0.649057
+0.414173
+0.444634
+0.479250
+0.518711
+0.563752
+0.615062
+0.673070
+0.737517
+0.806709
+0.876435
+0.938996
+0.983641
+0.938996
+0.983641
+0.938996
+0.983641
+0.938996
+0.983641
+0.938996
+0.983641
+0.938996
+0.983641
+1.000000
+0.983641
+0.938996
+0.876435
+0.806709
+0.737517
+0.673070
+0.615062
+0.563752
+0.322986
+0.348906
+0.378983
+0.414173
+0.455679
+0.504974
+0.563752
+0.633647
+0.715383
+0.806709
+0.715383
+0.806709
+0.715383
+0.806709
+0.715383
+0.806709
+0.715383
+0.806709
+0.715383
+0.806709
+0.898571
+0.971458
+1.000000
+0.971458
+0.898571
+0.806709
+0.715383
+0.633647
+0.563752
+0.504974
+0.455679
+0.221848
+0.240892
+0.263382
+0.290294
+0.322986
+0.363370
+0.414173
+0.479250
+0.563752
+0.479250
+0.563752
+0.479250
+0.563752
+0.479250
+0.563752
+0.479250
+0.563752
+0.479250
+0.563752
+0.673070
+0.806709
+0.938996
+1.000000
+0.938996
+0.806709
+0.673070
+0.563752
+0.479250
+0.414173
+0.363370
+0.322986
+0.113030
+0.123156
+0.135256
+0.149963
+0.168207
+0.191410
+0.221848
+0.263382
+0.322986
+0.263382
+0.322986
+0.263382
+0.322986
+0.263382
+0.322986
+0.263382
+0.322986
+0.263382
+0.322986
+0.414173
+0.563752
+0.806709
+1.000000
+0.806709
+0.563752
+0.414173
+0.322986
+0.263382
+0.221848
+0.191410
+0.168207
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.997650
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.113030
+-0.123156
+-0.135256
+-0.149963
+-0.168207
+-0.191410
+-0.221848
+-0.263382
+-0.322986
+-0.263382
+-0.322986
+-0.263382
+-0.322986
+-0.263382
+-0.322986
+-0.263382
+-0.322986
+-0.263382
+-0.322986
+-0.414173
+-0.563752
+-0.806709
+-1.000000
+-0.806709
+-0.563752
+-0.414173
+-0.322986
+-0.263382
+-0.221848
+-0.191410
+-0.168207
+0.065851
+0.071808
+0.078946
+0.087653
+0.098510
+0.112415
+0.130853
+-0.479250
+-0.563752
+-0.479250
+-0.563752
+-0.479250
+-0.563752
+-0.479250
+-0.563752
+-0.479250
+-0.563752
+-0.479250
+-0.563752
+-0.673070
+-0.806709
+-0.938996
+-1.000000
+-0.938996
+-0.806709
+-0.673070
+-0.563752
+-0.479250
+-0.414173
+-0.363370
+-0.322986
+-0.047734
+-0.052063
+-0.057252
+-0.063589
+-0.071500
+-0.081650
+-0.095144
+-0.113946
+-0.715383
+-0.806709
+-0.715383
+-0.806709
+-0.715383
+-0.806709
+-0.715383
+-0.806709
+-0.715383
+-0.806709
+-0.715383
+-0.806709
+-0.898571
+-0.971458
+-1.000000
+-0.971458
+-0.898571
+-0.806709
+-0.715383
+-0.633647
+-0.563752
+-0.504974
+-0.455679
+0.141946
+0.154554
+0.169585
+0.187795
+0.210287
+0.238717
+0.275681
+-0.361541
+-0.436176
+-0.542794
+-0.938996
+-0.983641
+-0.938996
+-0.983641
+-0.938996
+-0.983641
+-0.938996
+-0.983641
+-0.938996
+-0.983641
+-0.938996
+-0.983641
+-1.000000
+-0.983641
+-0.938996
+-0.876435
+-0.806709
+-0.737517
+-0.673070
+-0.615062
+-0.563752
+0.029577
+0.032263
+0.035486
+0.039423
+0.044341
+0.050661
+0.059077
+-0.551336
+-0.636870
+-0.740371
+-0.855493
+-0.957128
+-1.000000
+-0.957128
+-0.855493
+-0.740371
+-0.636870
+-0.551336
+0.059077
+-0.989437
+-1.000000
+-0.989437
+-1.000000
+-0.989437
+-0.959651
+-0.915475
+-0.862763
+-0.806709
+-0.751067
+-0.698128
+-0.649057
+-0.083920
+-0.091488
+-0.100549
+-0.111589
+-0.125330
+-0.142891
+-0.166096
+-0.198116
+-0.244955
+-0.841335
+-0.919236
+-0.977830
+-1.000000
+-0.977830
+-0.919236
+-0.841335
+-0.244955
+-0.198116
+-0.166096
+-0.142891
+-0.125330
+-0.992629
+-1.000000
+-0.992629
+-0.971458
+-0.938996
+-0.898571
+-0.853532
+-0.806709
+-0.760198
+-0.715383
+0.117566
+0.128085
+0.140652
+0.155918
+0.174844
+0.198894
+0.230403
+-0.429249
+-0.510746
+-0.620912
+-0.765085
+-0.921711
+-1.000000
+-0.921711
+-0.765085
+-0.620912
+-0.510746
+-0.429249
+0.230403
+0.198894
+0.174844
+0.155918
+-1.000000
+-0.994569
+-0.978791
+-0.954086
+-0.922444
+-0.886037
+-0.846895
+-0.806709
+-0.766764
+0.004553
+0.004967
+0.005464
+0.006071
+0.006830
+0.007805
+0.009106
+-0.599179
+-0.683163
+-0.780217
+-0.881935
+-0.966098
+-1.000000
+-0.966098
+-0.881935
+-0.780217
+-0.683163
+-0.599179
+0.009106
+0.007805
+0.006830
+0.006071
+0.005464
+-0.995834
+-0.983641
+-0.964278
+-0.938996
+-0.909235
+-0.876435
+-0.841898
+-0.806709
+-0.108633
+-0.118376
+-0.130023
+-0.144184
+-0.161761
+-0.184134
+-0.213520
+-0.253692
+-0.311526
+-0.862267
+-0.931160
+-0.981368
+-1.000000
+-0.981368
+-0.931160
+-0.862267
+-0.311526
+-0.253692
+-0.213520
+-0.184134
+-0.161761
+-0.144184
+-0.130023
+-0.118376
+-0.108633
+-0.971458
+-0.950873
+-0.926234
+-0.898571
+-0.868869
+-0.838003
+0.101940
+0.111097
+0.122049
+0.135374
+0.151926
+0.173020
+0.200774
+-0.472055
+-0.556237
+-0.665848
+-0.801150
+-0.936790
+-1.000000
+-0.936790
+-0.801150
+-0.665848
+-0.556237
+-0.472055
+0.200774
+0.173020
+0.151926
+0.135374
+0.122049
+0.111097
+0.101940
+0.094171
+0.087498
+-0.938996
+-0.915475
+-0.889832
+-0.862763
+-0.011385
+-0.012420
+-0.013662
+-0.015180
+-0.017076
+-0.019515
+-0.022766
+-0.628798
+-0.710908
+-0.803089
+-0.896341
+-0.970752
+-1.000000
+-0.970752
+-0.896341
+-0.803089
+-0.710908
+-0.628798
+-0.022766
+-0.019515
+-0.017076
+-0.015180
+-0.013662
+-0.012420
+-0.011385
+-0.010510
+-0.009759
+-0.009108
+-0.008539
+-0.906358
+-0.882564
+-0.124275
+-0.135374
+-0.148626
+-0.164713
+-0.184638
+-0.209923
+-0.242984
+-0.287866
+-0.351728
+-0.874514
+-0.937944
+-0.983338
+-1.000000
+-0.983338
+-0.937944
+-0.874514
+-0.351728
+-0.287866
+-0.242984
+-0.209923
+-0.184638
+-0.164713
+-0.148626
+-0.135374
+-0.124275
+-0.114846
+-0.106740
+-0.099697
+-0.093523
+-0.088065
+-0.083208
+0.095230
+0.103798
+0.114049
+0.126528
+0.142042
+0.161835
+-0.431419
+-0.497723
+-0.582867
+-0.691185
+-0.820370
+-0.944293
+-1.000000
+-0.944293
+-0.820370
+-0.691185
+-0.582867
+-0.497723
+-0.431419
+0.161835
+0.142042
+0.126528
+0.114049
+0.103798
+0.095230
+0.087964
+0.081724
+0.076309
+0.071565
+0.067375
+0.063647
+-0.018219
+-0.019875
+-0.021861
+-0.024289
+-0.027323
+-0.031222
+-0.036420
+-0.646370
+-0.727036
+-0.816043
+-0.904260
+-0.973243
+-1.000000
+-0.973243
+-0.904260
+-0.816043
+-0.727036
+-0.646370
+-0.036420
+-0.031222
+-0.027323
+-0.024289
+-0.021861
+-0.019875
+-0.018219
+-0.016818
+-0.015617
+-0.014576
+-0.013665
+-0.012861
+-0.012147
+-0.130971
+-0.142645
+-0.156575
+-0.173474
+-0.194383
+-0.220879
+-0.255451
+-0.302233
+-0.368445
+-0.881546
+-0.941778
+-0.984438
+-1.000000
+-0.984438
+-0.941778
+-0.881546
+-0.368445
+-0.302233
+-0.255451
+-0.220879
+-0.194383
+-0.173474
+-0.156575
+-0.142645
+-0.130971
+-0.121050
+-0.112517
+-0.105102
+-0.098599
+-0.092850
+-0.087733
+0.099745
+0.108710
+0.119433
+0.132482
+0.148696
+0.169366
+-0.441456
+-0.508398
+-0.593796
+-0.701375
+-0.827880
+-0.947130
+-1.000000
+-0.947130
+-0.827880
+-0.701375
+-0.593796
+-0.508398
+-0.441456
+0.169366
+0.148696
+0.132482
+0.119433
+0.108710
+0.099745
+0.092140
+0.085609
+0.079940
+0.074972
+0.070585
+0.066681
+-0.013669
+-0.014911
+-0.016402
+-0.018223
+-0.020500
+-0.023428
+-0.027329
+-0.653655
+-0.733650
+-0.821283
+-0.907415
+-0.974223
+-1.000000
+-0.974223
+-0.907415
+-0.821283
+-0.733650
+-0.653655
+-0.027329
+-0.023428
+-0.020500
+-0.018223
+-0.016402
+-0.014911
+-0.013669
+-0.012617
+-0.011716
+-0.010935
+-0.010252
+-0.009649
+-0.009113
+-0.126559
+-0.137855
+-0.151338
+-0.167704
+-0.187966
+-0.213666
+-0.247247
+-0.292785
+-0.817855
+-0.884419
+-0.943331
+-0.984881
+-1.000000
+-0.984881
+-0.943331
+-0.884419
+-0.817855
+-0.292785
+-0.247247
+-0.213666
+-0.187966
+-0.167704
+-0.151338
+-0.137855
+-0.126559
+-0.116962
+-0.108710
+-0.101540
+-0.095254
+-0.089697
+-0.084751
+0.113211
+0.123353
+0.135472
+0.150202
+0.168473
+0.191709
+-0.434925
+-0.501459
+-0.586702
+-0.694774
+-0.823030
+-0.945304
+-1.000000
+-0.945304
+-0.823030
+-0.694774
+-0.586702
+-0.501459
+-0.434925
+0.191709
+0.168473
+0.150202
+0.135472
+0.123353
+0.113211
+0.104602
+0.097204
+0.090779
+0.085148
+0.080172
+0.075744
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.648971
+-0.729402
+-0.817922
+-0.905394
+-0.973596
+-1.000000
+-0.973596
+-0.905394
+-0.817922
+-0.729402
+-0.648971
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.000000
+-0.113211
+-0.123353
+-0.135472
+-0.150202
+-0.168473
+-0.191709
+-0.222191
+-0.263780
+-0.815294
+-0.882594
+-0.942345
+-0.984600
+-1.000000
+-0.984600
+-0.942345
+-0.882594
+-0.815294
+-0.263780
+-0.222191
+-0.191709
+-0.168473
+-0.150202
+-0.135472
+-0.123353
+-0.113211
+-0.104602
+-0.097204
+-0.090779
+-0.085148
+-0.080172
+-0.075744
+-0.222191
+-0.241261
+-0.263780
+-0.290726
+-0.323456
+-0.363883
+-0.414731
+-0.479850
+-0.564376
+-0.673668
+-0.807166
+-0.989946
+-1.000000
+-0.989946
+-0.807166
+-0.673668
+-0.564376
+-0.479850
+-0.414731
+-0.363883
+-0.323456
+-0.290726
+-0.263780
+-0.241261
+-0.222191
+-0.205853
+-0.191709
+-0.179354
+-0.168473
+-0.158820
+-0.150202
+-0.323456
+-0.349404
+-0.379510
+-0.414731
+-0.456265
+-0.505585
+-0.564376
+-0.634263
+-0.715951
+-0.807166
+-0.898852
+-0.971547
+-1.000000
+-0.971547
+-0.898852
+-0.807166
+-0.715951
+-0.634263
+-0.564376
+-0.505585
+-0.456265
+-0.414731
+-0.379510
+-0.349404
+-0.323456
+-0.300913
+-0.281178
+-0.263780
+-0.248342
+-0.234561
+-0.222191
+-0.414731
+-0.445214
+-0.479850
+-0.519327
+-0.564376
+-0.615683
+-0.673668
+-0.738063
+-0.807166
+-0.876765
+-0.939176
+-0.983693
+-1.000000
+-0.983693
+-0.939176
+-0.876765
+-0.807166
+-0.738063
+-0.673668
+-0.615683
+-0.564376
+-0.519327
+-0.479850
+-0.445214
+-0.414731
+-0.387794
+-0.363883
+-0.342560
+-0.323456
+-0.306264
+-0.290726
+-0.495019
+-0.527867
+-0.564376
+-0.604895
+-0.649667
+-0.698710
+-0.751598
+-0.807166
+-0.863121
+-0.915716
+-0.959774
+-0.989471
+-1.000000
+-0.989471
+-0.959774
+-0.915716
+-0.863121
+-0.807166
+-0.751598
+-0.698710
+-0.649667
+-0.604895
+-0.564376
+-0.527867
+-0.495019
+-0.465455
+-0.438806
+-0.414731
+-0.392923
+-0.373114
+-0.355065
+-0.564376
+-0.597851
+-0.634263
+-0.673668
+-0.715951
+-0.760719
+-0.807166
+-0.853908
+-0.898852
+-0.939176
+-0.971547
+-0.992653
+-1.000000
+-0.992653
+-0.971547
+-0.939176
+-0.898852
+-0.853908
+-0.807166
+-0.760719
+-0.715951
+-0.673668
+-0.634263
+-0.597851
+-0.564376
+-0.533688
+-0.505585
+-0.479850
+-0.456265
+-0.434623
+-0.414731
+-0.623554
+-0.656416
+-0.691452
+-0.728514
+-0.767277
+-0.807166
+-0.847284
+-0.886346
+-0.922667
+-0.954225
+-0.978858
+-0.994586
+-1.000000
+-0.994586
+-0.978858
+-0.954225
+-0.922667
+-0.886346
+-0.847284
+-0.807166
+-0.767277
+-0.728514
+-0.691452
+-0.656416
+-0.623554
+-0.592892
+-0.564376
+-0.537909
+-0.513363
+-0.490604
+-0.469492
+-0.673668
+-0.705126
+-0.738063
+-0.772217
+-0.807166
+-0.842296
+-0.876765
+-0.909491
+-0.939176
+-0.964388
+-0.983693
+-0.995847
+-1.000000
+-0.995847
+-0.983693
+-0.964388
+-0.939176
+-0.909491
+-0.876765
+-0.842296
+-0.807166
+-0.772217
+-0.738063
+-0.705126
+-0.673668
+-0.643834
+-0.615683
+-0.589212
+-0.564376
+-0.541109
+-0.519327
+-0.715951
+-0.745560
+-0.776070
+-0.807166
+-0.838408
+-0.869214
+-0.898852
+-0.926448
+-0.951021
+-0.971547
+-0.987049
+-0.996715
+-1.000000
+-0.996715
+-0.987049
+-0.971547
+-0.951021
+-0.926448
+-0.898852
+-0.869214
+-0.838408
+-0.807166
+-0.776070
+-0.745560
+-0.715951
+-0.687455
+-0.660203
+-0.634263
+-0.609656
+-0.586372
+-0.564376
+-0.751598
+-0.779160
+-0.807166
+-0.835293
+-0.863121
+-0.890133
+-0.915716
+-0.939176
+-0.959774
+-0.976766
+-0.989471
+-0.997336
+-1.000000
+-0.997336
+-0.989471
+-0.976766
+-0.959774
+-0.939176
+-0.915716
+-0.890133
+-0.863121
+-0.835293
+-0.807166
+-0.779160
+-0.751598
+-0.724724
+-0.698710
+-0.673668
+-0.649667
+-0.626741
+-0.604895
+];
+c = [ ...
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+6.000000
+6.000000
+6.000000
+5.000000
+5.000000
+4.000000
+4.000000
+3.000000
+3.000000
+2.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+7.000000
+2.000000
+1.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+6.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+1.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+6.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+8.000000
+8.000000
+8.000000
+8.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+7.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+0.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+0.000000
+0.000000
+0.000000
+0.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+0.000000
+0.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+8.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+9.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+10.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+11.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+11.000000
+11.000000
+11.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+12.000000
+];
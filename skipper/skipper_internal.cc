@@ -8,6 +8,8 @@
 #include <syslog.h>
 #include <stdint.h>
 #include  <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 
 #include "common/unknown.h"
 #include "common/convert.h"
@@ -15,18 +17,25 @@
 #include "common/now.h"
 #include "common/polar_diagram.h"
 #include "helmsman/normal_controller.h"
+#include "io2/lib/aissnap.h"
 #include "skipper/planner.h"
 #include "vskipper/util.h"
 
 extern int debug;
 
 static const double kDefaultDirection = 225;  // SouthWest as an approximation of the whole journey.
+// Beyond this we can't plan, nor avoid collisions.
+static const double kMaxPositionSigmaM = 1000;
 
 double SkipperInternal::old_alpha_star_deg_ = kDefaultDirection;
 WindStrengthRange SkipperInternal::wind_strength_ = kCalmWind;
 bool SkipperInternal::storm_ = false;
 bool SkipperInternal::storm_sign_plus_ = false;
 bool SkipperInternal::full_plan_ = true;
+const char* SkipperInternal::plan_filename_ = NULL;
+struct timespec SkipperInternal::plan_mtim_ = {0, 0};
+off_t SkipperInternal::plan_size_ = 0;
+ino_t SkipperInternal::plan_ino_ = 0;
 
 void SkipperInternal::Run(const SkipperInput& in,
                           const vector<skipper::AisInfo>& ais,
@@ -44,7 +53,8 @@ void SkipperInternal::Run(const SkipperInput& in,
   // If there is a valid simple plan file then we go to the point specified there.
   // If the file exists, it shall contain just 2 numbers separated by a space character
   // like "44.66 6.3332" .
-  // Otherwise we follow the plan we prepared.
+  // Otherwise we follow the plan we prepared or got sent.
+  WatchPlanFile();
   ReadSimplePlanFile("/tmp/simple.txt");
 
   wind_strength_ = WindStrength(wind_strength_, KnotsToMeterPerSecond(in.mag_true_kn));
@@ -106,6 +116,26 @@ void SkipperInternal::Run(const SkipperInput& in,
   *alpha_star_deg = feasible;
 }
 
+void SkipperInternal::UsePositionEstimate(const PositionProto& pos,
+                                          SkipperInput* in) {
+  if (pos.timestamp_ms < in->timestamp_ms || isnan(pos.lat_deg) || isnan(pos.lng_deg))
+    return;
+  // The major axis of the error ellipse
+  double half_trace = (pos.var_north_m2 + pos.var_east_m2) / 2;
+  double half_diff = (pos.var_north_m2 - pos.var_east_m2) / 2;
+  double var_max = half_trace + sqrt(half_diff * half_diff +
+                                     pos.cov_north_east_m2 * pos.cov_north_east_m2);
+  if (!(var_max <= kMaxPositionSigmaM * kMaxPositionSigmaM)) {
+    syslog(LOG_NOTICE, "Position uncertain by %.0lf m, treated as unknown.\n",
+           sqrt(var_max));
+    in->latitude_deg = NAN;
+    in->longitude_deg = NAN;
+    return;
+  }
+  in->latitude_deg = pos.lat_deg;
+  in->longitude_deg = pos.lng_deg;
+}
+
 void SkipperInternal::Init(const SkipperInput& in) {
   Planner::Init(LatLon(in.latitude_deg, in.longitude_deg));
 }
@@ -190,12 +220,20 @@ double SkipperInternal::HandleStorm(WindStrengthRange wind_strength,
 
 namespace {
 
+// AIS sends 91 and 181 degrees for an unknown position.
+bool ValidPosition(double lat_deg, double lng_deg) {
+  return fabs(lat_deg) <= 90 && fabs(lng_deg) <= 180;  // false for NAN
+}
+
 int sscan_ais(const char *line, int64_t now_ms, skipper::AisInfo* s) {
   s->timestamp_ms = now_ms;
 
   if (!strncmp(line, "ais: ", 5))
     line += 5;
 
+  double lat_deg = NAN;
+  double lng_deg = NAN;
+
   while (*line) {
     char key[16];
     double value = NAN;
@@ -211,12 +249,12 @@ int sscan_ais(const char *line, int64_t now_ms, skipper::AisInfo* s) {
       s->timestamp_ms = int64_t(value);
       continue;
     }
-    if (!strcmp(key, "lat_deg")       && !isnan(value)) {
-      s->position = skipper::LatLon::Degrees(value, s->position.lon_deg());
+    if (!strcmp(key, "lat_deg")) {
+      lat_deg = value;
       continue;
     }
-    if (!strcmp(key, "lng_deg")       && !isnan(value)) {
-      s->position = skipper::LatLon::Degrees(s->position.lat_deg(), value);
+    if (!strcmp(key, "lng_deg")) {
+      lng_deg = value;
       continue;
     }
     if (!strcmp(key, "speed_m_s")     && !isnan(value)) {
@@ -230,14 +268,64 @@ int sscan_ais(const char *line, int64_t now_ms, skipper::AisInfo* s) {
     // ignore anything else
     // return 0;
   }
+  if (!ValidPosition(lat_deg, lng_deg))
+    return 0;
+  s->position = skipper::LatLon::Degrees(lat_deg, lng_deg);
   return 1;
 }
 
+// Returns false for records without a position, like the static data
+// of msgtype 5 and 24, which would be ships at the default LatLon.
+bool ais_from_record(const AISSnapRecord& r, skipper::AisInfo* s) {
+  if (!ValidPosition(r.lat_deg, r.lng_deg))
+    return false;
+  s->timestamp_ms = r.timestamp_ms;
+  s->position = skipper::LatLon::Degrees(r.lat_deg, r.lng_deg);
+  if (!isnan(r.speed_m_s))
+    s->speed_m_s = r.speed_m_s;
+  if (!isnan(r.cog_deg))
+    s->bearing = skipper::Bearing::Degrees(r.cog_deg);
+  return true;
+}
+
+// The snapshot stays mapped. aisbuf creates a new one when it restarts,
+// so it is mapped again when the file behind the name changed.
+bool ReadAisSnapshot(const char* ais_filename, std::vector<skipper::AisInfo>* ais) {
+  static const AISSnap* snap = NULL;
+  static ino_t snap_ino = 0;
+  struct stat st;
+  if (stat(ais_filename, &st) < 0)
+    return false;
+  if (snap && st.st_ino != snap_ino) {
+    aissnap_close(snap);
+    snap = NULL;
+  }
+  if (!snap) {
+    snap = aissnap_open(ais_filename);
+    if (!snap)
+      return false;
+    snap_ino = st.st_ino;
+  }
+  for (int i = 0; i < AISSNAP_RECORDS; ++i) {
+    AISSnapRecord r;
+    if (!aissnap_get(snap, i, &r))
+      continue;
+    skipper::AisInfo ai;
+    if (ais_from_record(r, &ai))
+      ais->push_back(ai);
+  }
+  return true;
+}
+
 } // namespace
 
 
+// Reads the aisbuf snapshot, or a text file with ais: lines as written
+// by the simulator.
 void SkipperInternal::ReadAisFile(
     const char* ais_filename, std::vector<skipper::AisInfo>* ais) {
+  if (ReadAisSnapshot(ais_filename, ais))
+    return;
   FILE* fp = fopen(ais_filename, "r");
   if (!fp) {
     // This failure is possible in the beginning, when the ais_buf
@@ -297,3 +385,45 @@ void SkipperInternal::ReadSimplePlanFile(const char* simple_target_filename) {
   }
   fclose(fp);
 }
+
+bool SkipperInternal::ReadWindFile(const char* wind_filename) {
+  bool ok = Planner::LoadWindField(wind_filename);
+  if (ok)
+    syslog(LOG_NOTICE, "Weather routing with wind field %s\n", wind_filename);
+  return ok;
+}
+
+void SkipperInternal::SetPlanFile(const char* plan_filename) {
+  plan_filename_ = plan_filename;
+  plan_mtim_.tv_sec = 0;
+  plan_mtim_.tv_nsec = 0;
+  plan_size_ = 0;
+  plan_ino_ = 0;
+  WatchPlanFile();
+}
+
+void SkipperInternal::WatchPlanFile() {
+  if (!plan_filename_)
+    return;
+  struct stat st;
+  if (stat(plan_filename_, &st) < 0)
+    return;  // Keep the current plan.
+  // A new plan is usually renamed into place, so it has a new inode even
+  // if it has the same size and was written in the same second.
+  if (st.st_ino == plan_ino_ && st.st_size == plan_size_ &&
+      st.st_mtim.tv_sec == plan_mtim_.tv_sec &&
+      st.st_mtim.tv_nsec == plan_mtim_.tv_nsec)
+    return;
+  plan_mtim_ = st.st_mtim;
+  plan_size_ = st.st_size;
+  plan_ino_ = st.st_ino;
+  std::vector<PlanFileRecord> plan;
+  if (!ReadPlanFile(plan_filename_, &plan)) {
+    syslog(LOG_ERR, "Rejected plan file %s, keeping the current plan\n",
+           plan_filename_);
+    return;
+  }
+  Planner::LoadPlan(plan);
+  syslog(LOG_NOTICE, "Following plan %s with %d circles\n",
+         plan_filename_, (int)plan.size());
+}
@@ -5,10 +5,13 @@
 #ifndef SKIPPER_SKIPPER_INTERNAL_H
 #define SKIPPER_SKIPPER_INTERNAL_H
 
+#include <sys/types.h>
+#include <time.h>
 #include <vector>
 
 #include "helmsman/skipper_input.h"  
 #include "helmsman/wind_strength.h"
+#include "proto/position.h"
 #include "skipper/lat_lon.h"
 #include "skipper/target_circle_cascade.h"  // TCStatus
 
@@ -22,6 +25,11 @@ class SkipperInternal {
                   double* alpha_star_deg,
                   TCStatus* tc_status);
   static void Init(const SkipperInput& in);
+  // The helmsman sends its position estimate every second, but the
+  // skipper_input only every minute. A newer estimate replaces the position
+  // in in, or makes it unknown if it is too uncertain to plan with, e.g.
+  // after hours of dead reckoning without GPS.
+  static void UsePositionEstimate(const PositionProto& pos, SkipperInput* in);
   static bool TargetReached(const ::LatLon& lat_lon);
   // public for test only
   static double HandleStorm(WindStrengthRange wind_strength,
@@ -29,6 +37,13 @@ class SkipperInternal {
                             double planned);
   static void ReadAisFile(const char* ais_filename, std::vector<skipper::AisInfo>* ais);
   static void ReadSimplePlanFile(const char* simple_target_filename);
+  // Follow the binary plan in plan_filename (see plan_file.h). The file is
+  // checked for changes on every Run and reloaded, so plans can be swapped
+  // at sea. Invalid plans are rejected and the current plan is kept.
+  static void SetPlanFile(const char* plan_filename);
+  static void WatchPlanFile();
+  // Enables weather routing with the forecast in wind_filename.
+  static bool ReadWindFile(const char* wind_filename);
 
  private:
   static double RunCollisionAvoider(double alpha_planner_deg,
@@ -39,6 +54,10 @@ class SkipperInternal {
   static bool storm_;
   static bool storm_sign_plus_;
   static bool full_plan_;
+  static const char* plan_filename_;
+  static struct timespec plan_mtim_;
+  static off_t plan_size_;
+  static ino_t plan_ino_;
 
 };
 
@@ -11,6 +11,7 @@
 #include "common/convert.h"
 #include "common/normalize.h"
 #include "common/unknown.h"
+#include "io2/lib/aissnap.h"
 #include "lib/testing/testing.h"
 #include "skipper/lat_lon.h"
 #include "skipper/target_circle.h"
@@ -257,8 +258,76 @@ TEST(SkipperInternal, ToulonDetailsPlan) {
   CloseKML();
 }
 
+ATEST(SkipperInternal, ReadAisFile) {
+  const char* snap_file = "/tmp/skipper_internal_test.snap";
+  AISSnap* snap = aissnap_create(snap_file);
+  EXPECT_TRUE(snap != NULL);
+  AISSnapRecord r;
+  aissnap_parse("ais: timestamp_ms:1325376000123 mmsi:244670000 msgtype:1 "
+                "speed_m_s:5.1 lat_deg:43.5 lng_deg:-9.5 cog_deg:271.3\n", &r);
+  aissnap_put(snap, 3, &r);
+  aissnap_parse("ais: timestamp_ms:1325376000200 mmsi:244670000 msgtype:5 "
+                "size_m:120 shipname:'SEA CLOUD' \n", &r);
+  aissnap_put(snap, 4, &r);
+  // Position not available.
+  aissnap_parse("ais: timestamp_ms:1325376000300 mmsi:244670001 msgtype:18 "
+                "speed_m_s:2.0 lat_deg:91 lng_deg:181\n", &r);
+  aissnap_put(snap, 5, &r);
+
+  // Only the ship with a position, the others are not ships at (0, 0).
+  std::vector<skipper::AisInfo> ais;
+  SkipperInternal::ReadAisFile(snap_file, &ais);
+  EXPECT_EQ(1, ais.size());
+  for (size_t i = 0; i < ais.size(); ++i)
+    EXPECT_FALSE(ais[i].position.lat_deg() == 0 && ais[i].position.lon_deg() == 0);
+  EXPECT_EQ(1325376000123LL, ais[0].timestamp_ms);
+  EXPECT_FLOAT_EQ(43.5, ais[0].position.lat_deg());
+  EXPECT_FLOAT_EQ(-9.5, ais[0].position.lon_deg());
+  EXPECT_FLOAT_EQ(5.1, ais[0].speed_m_s);
+  EXPECT_FLOAT_EQ(271.3, ais[0].bearing.deg());
+
+  // Removed by aisbuf, seen without reopening.
+  aissnap_clear(snap, 3);
+  ais.clear();
+  SkipperInternal::ReadAisFile(snap_file, &ais);
+  EXPECT_EQ(0, ais.size());
+  aissnap_close(snap);
+
+  // The simulator writes text files.
+  const char* text_file = "/tmp/skipper_internal_test_ais.txt";
+  FILE* fp = fopen(text_file, "w");
+  fprintf(fp, "ais: timestamp_ms:1325376000123 mmsi:244670000 msgtype:1 "
+              "speed_m_s:5.1 lat_deg:43.5 lng_deg:-9.5 cog_deg:271.3\n");
+  fprintf(fp, "ais: timestamp_ms:1325376000200 mmsi:244670000 msgtype:5 size_m:120\n");
+  fclose(fp);
+  ais.clear();
+  SkipperInternal::ReadAisFile(text_file, &ais);
+  EXPECT_EQ(1, ais.size());
+  EXPECT_FLOAT_EQ(-9.5, ais[0].position.lon_deg());
+}
+
+ATEST(SkipperInternal, UsePositionEstimate) {
+  SkipperInput in(1000, 43.5, 7.0, 90, 10);
+  PositionProto pos = {2000, 43.6, 7.1, 400, 100, 0};
+  SkipperInternal::UsePositionEstimate(pos, &in);
+  EXPECT_FLOAT_EQ(43.6, in.latitude_deg);
+  EXPECT_FLOAT_EQ(7.1, in.longitude_deg);
+
+  // Older than the skipper input.
+  SkipperInput newer(3000, 43.5, 7.0, 90, 10);
+  SkipperInternal::UsePositionEstimate(pos, &newer);
+  EXPECT_FLOAT_EQ(43.5, newer.latitude_deg);
+
+  // 1km north and east, but correlated: 1.4km along the diagonal.
+  PositionProto lost = {2000, 43.6, 7.1, 1E6, 1E6, 0.9E6};
+  SkipperInternal::UsePositionEstimate(lost, &in);
+  EXPECT_TRUE(isnan(in.latitude_deg));
+  EXPECT_TRUE(isnan(in.longitude_deg));
+}
 
 int main(int argc, char* argv[]) {
+  SkipperInternal_ReadAisFile();
+  SkipperInternal_UsePositionEstimate();
   SkipperInternal_Storm();
   SkipperInternal_ToulonPlan();
   //SkipperInternal_ToulonDetailsPlan();
@@ -24,8 +24,10 @@
 
 #include "io2/lib/linebuffer.h"
 #include "proto/helmsman.h"
+#include "proto/position.h"
 #include "common/convert.h"
 #include "common/now.h"
+#include "common/polar_table.h"
 #include "helmsman/sampling_period.h"
 #include "helmsman/skipper_input.h"
 #include "skipper/skipper_internal.h"
@@ -67,6 +69,9 @@ void usage(void) {
     "options:\n"
     "\t-d debug\n"
     "\t-v verbose\n"
+    "\t-p polar_file  measured polar diagram of the boat\n"
+    "\t-P plan_file  binary route plan, reloaded when it changes\n"
+    "\t-w wind_file  route with the isochrone router in this wind field\n"
     , argv0);
   exit(2);
 }
@@ -88,10 +93,16 @@ int main(int argc, char* argv[]) {
   argv0 = strrchr(argv[0], '/');
   if (argv0) ++argv0; else argv0 = argv[0];
 
-  while ((ch = getopt(argc, argv, "dhv")) != -1){
+  const char* polar_file = NULL;
+  const char* plan_file = NULL;
+  const char* wind_file = NULL;
+  while ((ch = getopt(argc, argv, "dhp:P:vw:")) != -1){
     switch (ch) {
     case 'd': ++debug; break;
     case 'v': ++verbose; break;
+    case 'p': polar_file = optarg; break;
+    case 'P': plan_file = optarg; break;
+    case 'w': wind_file = optarg; break;
     case 'h':
     default:
       usage();
@@ -114,8 +125,15 @@ int main(int argc, char* argv[]) {
   if (signal(SIGPIPE, SIG_IGN) == SIG_ERR) crash("signal");
 
   syslog(LOG_NOTICE, "Skipper started, read AIS from %s", argv[0]);
+  if (polar_file && !LoadDefaultPolarTable(polar_file))
+    syslog(LOG_WARNING, "Could not load polar file %s, using the default", polar_file);
+  if (wind_file && !SkipperInternal::ReadWindFile(wind_file))
+    syslog(LOG_WARNING, "Could not load wind file %s, no weather routing", wind_file);
+  if (plan_file)
+    SkipperInternal::SetPlanFile(plan_file);
 
   SkipperInput skipper_input;   // reported back from helmsman
+  PositionProto position = INIT_POSITIONPROTO;  // the helmsman's estimate
   double alpha_star_deg;
   TCStatus tc_status;
 
@@ -148,6 +166,11 @@ int main(int argc, char* argv[]) {
     bool new_input = false;
     while(lb_getline(line, sizeof line, &lbuf) > 0 && !new_input) {
       int nn = 0;
+      PositionProto pos = INIT_POSITIONPROTO;
+      if (sscanf(line, IFMT_POSITIONPROTO(&pos, &nn)) == IFMT_POSITIONPROTO_ITEMS) {
+        position = pos;
+        continue;
+      }
       nn = sscan_skipper_input(line, &skipper_input);
       new_input = nn > 0;
     }
@@ -157,7 +180,9 @@ int main(int argc, char* argv[]) {
 
     std::vector<skipper::AisInfo> ais;
     SkipperInternal::ReadAisFile(argv[0], &ais);
-    SkipperInternal::Run(skipper_input, ais, &alpha_star_deg, &tc_status);
+    SkipperInput in = skipper_input;
+    SkipperInternal::UsePositionEstimate(position, &in);
+    SkipperInternal::Run(in, ais, &alpha_star_deg, &tc_status);
 
     // send desired angle to helmsman
     HelmsmanCtlProto ctl = {now_ms(), alpha_star_deg,
@@ -75,3 +75,4 @@ double TargetCircle::ToDeg(LatLon lat_lon) const {
 double TargetCircle::x0() const {return x0_;}
 double TargetCircle::y0() const {return y0_;}
 double TargetCircle::radius() const {return sqrt(radius_squared_);}
+double TargetCircle::lon_factor() const {return lon_factor_;}
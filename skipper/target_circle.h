@@ -78,6 +78,8 @@ class TargetCircle {
   double x0() const;
   double y0() const;
   double radius() const;
+  // cos(x0), the scale of the longitude distances.
+  double lon_factor() const;
 
 
  private: 
@@ -3,12 +3,17 @@
 // that can be found in the LICENSE file.
 // Steffen Grundmann, July 2011
 
+#include <algorithm>
 #include <stdio.h>
 
 #include "skipper/target_circle_cascade.h"
 
+#include "common/convert.h"
+
 
 static const double kDefaultDirection = 225;  // SouthWest as an approximation of the whole journey.
+// Up to this many circles are scanned linearly in the leaves of the tree.
+static const int kLeafSize = 4;
 extern int debug;
 
 
@@ -16,6 +21,7 @@ TargetCircleCascade::TargetCircleCascade() {}
 
 void TargetCircleCascade::Build(const TargetCirclePoint* plan) {
   chain_.clear();
+  tree_.clear();
   // The last row has radius 0.
   while (plan->radius_deg > 0) {
     TargetCircle t(plan->lat_lon, plan->radius_deg);
@@ -24,6 +30,85 @@ void TargetCircleCascade::Build(const TargetCirclePoint* plan) {
   }
   if (debug) fprintf(stderr, "Built plan with %d circles.\n", (int)chain_.size());
   CHECK_GT(chain_.size(), 0);
+  BuildTree(0, chain_.size());
+}
+
+void TargetCircleCascade::Reset() {
+  chain_.clear();
+  tree_.clear();
+}
+
+// Returns the index of the new node, the root is tree_[0].
+int TargetCircleCascade::BuildTree(int lo, int hi) {
+  int index = tree_.size();
+  tree_.push_back(Node());
+  Node n;
+  n.lo = lo;
+  n.hi = hi;
+  n.left = -1;
+  n.right = -1;
+  n.lat_min = n.lon_min = n.center_lat_min = n.center_lon_min = 1E9;
+  n.lat_max = n.lon_max = n.center_lat_max = n.center_lon_max = -1E9;
+  n.lon_factor_min = 1;
+  for (int i = lo; i < hi; ++i) {
+    const TargetCircle& c = chain_[i];
+    double r = c.radius();
+    double r_lon = c.lon_factor() > 0 ? r / c.lon_factor() : 360;
+    n.lat_min = std::min(n.lat_min, c.x0() - r);
+    n.lat_max = std::max(n.lat_max, c.x0() + r);
+    n.lon_min = std::min(n.lon_min, c.y0() - r_lon);
+    n.lon_max = std::max(n.lon_max, c.y0() + r_lon);
+    n.center_lat_min = std::min(n.center_lat_min, c.x0());
+    n.center_lat_max = std::max(n.center_lat_max, c.x0());
+    n.center_lon_min = std::min(n.center_lon_min, c.y0());
+    n.center_lon_max = std::max(n.center_lon_max, c.y0());
+    n.lon_factor_min = std::min(n.lon_factor_min, c.lon_factor());
+  }
+  if (hi - lo > kLeafSize) {
+    int mid = lo + (hi - lo) / 2;
+    n.left = BuildTree(lo, mid);
+    n.right = BuildTree(mid, hi);
+  }
+  tree_[index] = n;
+  return index;
+}
+
+int TargetCircleCascade::FindIn(int node, double x, double y) const {
+  const Node& n = tree_[node];
+  if (x < n.lat_min || x > n.lat_max || y < n.lon_min || y > n.lon_max)
+    return -1;
+  if (n.left < 0) {
+    for (int i = n.lo; i < n.hi; ++i)
+      if (chain_[i].In(x, y, 1.0))
+        return i;
+    return -1;
+  }
+  // The left subtree has the lower indices.
+  int i = FindIn(n.left, x, y);
+  return i >= 0 ? i : FindIn(n.right, x, y);
+}
+
+void TargetCircleCascade::FindNearest(int node, double x, double y,
+                                      int* best, double* best_distance) const {
+  const Node& n = tree_[node];
+  double dx = std::max(0.0, std::max(n.center_lat_min - x, x - n.center_lat_max));
+  double dy = std::max(0.0, std::max(n.center_lon_min - y, y - n.center_lon_max));
+  dy *= n.lon_factor_min;
+  // Equal distances still need a look, the lower index wins.
+  if (sqrt(dx * dx + dy * dy) > *best_distance)
+    return;
+  if (n.left < 0) {
+    for (int i = n.lo; i < n.hi; ++i) {
+      double d = chain_[i].Distance(x, y);
+      if (d < *best_distance || (d == *best_distance && i < *best)) {
+        *best_distance = d;
+        *best = i;
+      }
+    }
+    return;
+  }
+  FindNearest(n.left, x, y, best, best_distance);
+  FindNearest(n.right, x, y, best, best_distance);
 }
 
 // The direction (in degrees) to follow.
@@ -42,24 +127,19 @@ double TargetCircleCascade::ToDeg(double x, double y, TCStatus* tc_status) {
   // If that happens, we increase the radius of all circles until one is
   // big enough to cover our current position. This leads
   // us back on track.
-  double min_distance = 1E9;
-  int best_tc = 0;
-  for (int i = 0; i < (int)chain_.size(); ++i) {
-    // if (debug) fprintf(stderr, "i : %d, expand: %lf\n", i, expand);
-    if (chain_[i].In(x, y, 1.0)) {
-      // if (debug) fprintf(stderr, "In target circle %d, dir %lf deg.\n", i, chain_[i].ToDeg(x, y));
-      if (tc_status) {
-        tc_status->target_lat_deg = chain_[i].x0();
-        tc_status->target_lon_deg = chain_[i].y0();
-        tc_status->index = i;
-      }
-      return chain_[i].ToDeg(x, y);
-    }
-    if (chain_[i].Distance(x, y) < min_distance) {
-      min_distance = chain_[i].Distance(x, y);
-      best_tc = i;
+  int i = FindIn(0, x, y);
+  if (i >= 0) {
+    // if (debug) fprintf(stderr, "In target circle %d, dir %lf deg.\n", i, chain_[i].ToDeg(x, y));
+    if (tc_status) {
+      tc_status->target_lat_deg = chain_[i].x0();
+      tc_status->target_lon_deg = chain_[i].y0();
+      tc_status->index = i;
     }
+    return chain_[i].ToDeg(x, y);
   }
+  double min_distance = 1E9;
+  int best_tc = 0;
+  FindNearest(0, x, y, &best_tc, &min_distance);
   if (debug) {
     fprintf(stderr, "Needed to expand target circles!\n");
   }
@@ -72,6 +152,21 @@ double TargetCircleCascade::ToDeg(double x, double y, TCStatus* tc_status) {
   return chain_[best_tc].ToDeg(x, y);
 }
 
+bool TargetCircleCascade::LegInside(double x, double y,
+                                    double heading_deg,
+                                    double distance_deg) const {
+  if (chain_.size() == 0)
+    return false;
+  int i = FindIn(0, x, y);
+  if (i < 0)
+    return false;
+  // A circle is convex, so the leg is in it if its end is.
+  const TargetCircle& c = chain_[i];
+  double end_x = x + distance_deg * cos(Deg2Rad(heading_deg));
+  double end_y = y + distance_deg * sin(Deg2Rad(heading_deg)) / c.lon_factor();
+  return c.In(end_x, end_y);
+}
+
 void TargetCircleCascade::Add(const TargetCircle t) {
   // check for invariant
   if (chain_.size() > 0)
@@ -85,6 +180,11 @@ bool TargetCircleCascade::TargetReached(LatLon lat_lon) {
   return chain_[0].In(lat_lon);
 }
 
+const TargetCircle& TargetCircleCascade::FinalTarget() const {
+  CHECK_GT(chain_.size(), 0);
+  return chain_[0];
+}
+
 // Use this to print the target circle chain and to visualize it.
 void TargetCircleCascade::Print() {
   printf("Target circle\n%d target circles\n index x y radius\n", (int)chain_.size());
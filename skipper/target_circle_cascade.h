@@ -21,6 +21,12 @@ heading. This leads to the target point.
 But what if a storm throughs us off course and we are
 outside of all our target circles? Then it is easy to
 pick the nearest one and try to get to its center.
+
+Both lookups use a bounding volume hierarchy over the chain. Its nodes
+cover contiguous index ranges, so consecutive circles of the route end up
+in the same compact boxes and a left-first descent finds the circle with
+the lowest index first. That makes ToDeg logarithmic in the number of
+circles for long plans.
 */
 using std::vector;
 
@@ -58,16 +64,47 @@ class TargetCircleCascade {
   // The direction (in degrees) to follow.
   double ToDeg(double x, double y, TCStatus* tc_status);
 
+  // True if the straight leg of distance_deg from [x, y] in the direction
+  // heading_deg stays within the first circle containing [x, y]. The circles
+  // are free of obstacles, so such a leg is safe even if it does not lead
+  // towards the center. False outside of all circles.
+  bool LegInside(double x, double y,
+                 double heading_deg, double distance_deg) const;
+
   bool TargetReached(LatLon lat_lon);
 
+  // The circle around the target point (index 0).
+  const TargetCircle& FinalTarget() const;
+
   // Use this to print the target circle chain and to visualize it.
   void Print();
  private:
+  // A node of the bounding volume hierarchy over chain_[lo, hi).
+  struct Node {
+    int lo;
+    int hi;
+    int left;   // child node indices, -1 for leaves
+    int right;
+    // Bounding box of the circles (In() can only be true inside).
+    double lat_min, lat_max, lon_min, lon_max;
+    // Bounding box of the centers and the smallest lon_factor, which
+    // give a lower bound of Distance().
+    double center_lat_min, center_lat_max, center_lon_min, center_lon_max;
+    double lon_factor_min;
+  };
+
   void Add(const TargetCircle t);
+  int BuildTree(int lo, int hi);
+  // Lowest index of a circle containing [x, y] in the subtree, or -1.
+  int FindIn(int node, double x, double y) const;
+  // Updates best and best_distance with the nearest circle in the subtree.
+  void FindNearest(int node, double x, double y,
+                   int* best, double* best_distance) const;
 
   // double WayToGo(x, y);
 
   std::vector<TargetCircle> chain_;
+  std::vector<Node> tree_;
 
 }; 
 
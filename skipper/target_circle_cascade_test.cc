@@ -7,6 +7,7 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <vector>
 
 
@@ -82,6 +83,56 @@ ATEST(TargetCircleCascade, Mesh) {
   fclose(fp);
 }
 
+// The linear scan the tree lookup has to agree with.
+double LinearToDeg(const vector<TargetCircle>& chain, double x, double y, int* index) {
+  double min_distance = 1E9;
+  int best_tc = 0;
+  for (int i = 0; i < (int)chain.size(); ++i) {
+    if (chain[i].In(x, y, 1.0)) {
+      *index = i;
+      return chain[i].ToDeg(x, y);
+    }
+    if (chain[i].Distance(x, y) < min_distance) {
+      min_distance = chain[i].Distance(x, y);
+      best_tc = i;
+    }
+  }
+  *index = best_tc;
+  return chain[best_tc].ToDeg(x, y);
+}
+
+ATEST(TargetCircleCascade, LongPlanMatchesLinearScan) {
+  // A winding route across the Atlantic with 3000 circles.
+  vector<TargetCirclePoint> plan;
+  vector<TargetCircle> chain;
+  const int kCircles = 3000;
+  for (int i = 0; i < kCircles; ++i) {
+    double lat = 17 + 25.0 * i / kCircles + 2 * sin(i * 0.01);
+    double lon = -60 + 55.0 * i / kCircles;
+    double radius = 0.05 + 0.001 * (i % 50);
+    plan.push_back(TargetCirclePoint(lat, lon, radius));
+    chain.push_back(TargetCircle(plan.back().lat_lon, radius));
+  }
+  plan.push_back(TargetCirclePoint(0, 0, 0));
+  TargetCircleCascade t;
+  t.Build(&plan[0]);
+
+  for (int k = 0; k < 20000; ++k) {
+    double lat = 10 + 40.0 * rand() / RAND_MAX;
+    double lon = -70 + 75.0 * rand() / RAND_MAX;
+    // Half of the points near the route.
+    if (k % 2) {
+      const TargetCircle& c = chain[rand() % kCircles];
+      lat = c.x0() + 0.2 * rand() / RAND_MAX - 0.1;
+      lon = c.y0() + 0.2 * rand() / RAND_MAX - 0.1;
+    }
+    TCStatus status;
+    int expected_index;
+    double expected = LinearToDeg(chain, lat, lon, &expected_index);
+    EXPECT_EQ(expected, t.ToDeg(lat, lon, &status));
+    EXPECT_EQ(expected_index, status.index);
+  }
+}
 
 int main(int argc, char* argv[]) {
   return testing::RunAllTests();
@@ -0,0 +1,132 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "skipper/wind_field.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <syslog.h>
+
+#include "common/convert.h"
+#include "common/normalize.h"
+
+WindField::WindField()
+    : lat_min_(0), lon_min_(0), lat_step_(1), lon_step_(1),
+      n_lat_(0), n_lon_(0), n_times_(0), time_0_s_(0), time_step_s_(1) {}
+
+bool WindField::Load(const char* filename) {
+  north_.clear();
+  east_.clear();
+  n_times_ = 0;
+  FILE* fp = fopen(filename, "r");
+  if (!fp) {
+    syslog(LOG_NOTICE, "Could not open wind file %s", filename);
+    return false;
+  }
+  char line[1024];
+  bool header = false;
+  int n_values = 0;
+  while (fgets(line, sizeof(line), fp)) {
+    if (line[0] == '#' || line[0] == '\n')
+      continue;
+    if (!header) {
+      int n = sscanf(line, "%lf %lf %lf %lf %d %d %d %lf %lf",
+                     &lat_min_, &lon_min_, &lat_step_, &lon_step_,
+                     &n_lat_, &n_lon_, &n_values, &time_0_s_, &time_step_s_);
+      if (n != 9 || lat_step_ <= 0 || lon_step_ <= 0 || time_step_s_ <= 0 ||
+          n_lat_ < 1 || n_lon_ < 1 || n_values < 1) {
+        syslog(LOG_ERR, "Bad wind file header in %s", filename);
+        break;
+      }
+      n_values *= n_lat_ * n_lon_;
+      north_.reserve(n_values);
+      east_.reserve(n_values);
+      header = true;
+      continue;
+    }
+    double from_deg = 0;
+    double speed_m_s = 0;
+    if (2 != sscanf(line, "%lf %lf", &from_deg, &speed_m_s))
+      break;
+    // Store the vector pointing where the wind blows to.
+    double to_rad = Deg2Rad(from_deg + 180);
+    north_.push_back(speed_m_s * cos(to_rad));
+    east_.push_back(speed_m_s * sin(to_rad));
+  }
+  fclose(fp);
+  if (!header || (int)north_.size() != n_values) {
+    syslog(LOG_ERR, "Wind file %s has %d of %d values", filename,
+           (int)north_.size(), n_values);
+    north_.clear();
+    east_.clear();
+    return false;
+  }
+  n_times_ = n_values / (n_lat_ * n_lon_);
+  return true;
+}
+
+bool WindField::Valid() const {
+  return n_times_ > 0;
+}
+
+bool WindField::Covers(double lat_deg, double lon_deg) const {
+  return Valid() &&
+      lat_deg >= lat_min_ && lat_deg <= lat_min_ + (n_lat_ - 1) * lat_step_ &&
+      lon_deg >= lon_min_ && lon_deg <= lon_min_ + (n_lon_ - 1) * lon_step_;
+}
+
+void WindField::Vector(int t, int i, int j, double* north, double* east) const {
+  if (t < 0) t = 0;
+  if (t >= n_times_) t = n_times_ - 1;
+  if (i < 0) i = 0;
+  if (i >= n_lat_) i = n_lat_ - 1;
+  if (j < 0) j = 0;
+  if (j >= n_lon_) j = n_lon_ - 1;
+  int k = (t * n_lat_ + i) * n_lon_ + j;
+  *north = north_[k];
+  *east = east_[k];
+}
+
+void WindField::Get(double lat_deg, double lon_deg, double time_s,
+                    double* direction_from_deg, double* speed_m_s) const {
+  if (!Valid()) {
+    *direction_from_deg = 0;
+    *speed_m_s = 0;
+    return;
+  }
+  // Fractional grid coordinates, clamped to the grid.
+  double x = (lat_deg - lat_min_) / lat_step_;
+  double y = (lon_deg - lon_min_) / lon_step_;
+  double z = (time_s - time_0_s_) / time_step_s_;
+  x = fmax(0, fmin(x, n_lat_ - 1));
+  y = fmax(0, fmin(y, n_lon_ - 1));
+  z = fmax(0, fmin(z, n_times_ - 1));
+  int i = (int)x;
+  int j = (int)y;
+  int t = (int)z;
+  double fx = x - i;
+  double fy = y - j;
+  double fz = z - t;
+
+  double north = 0;
+  double east = 0;
+  for (int dt = 0; dt < 2; ++dt) {
+    double wt = dt ? fz : 1 - fz;
+    for (int di = 0; di < 2; ++di) {
+      double wi = di ? fx : 1 - fx;
+      for (int dj = 0; dj < 2; ++dj) {
+        double w = wt * wi * (dj ? fy : 1 - fy);
+        if (w == 0)
+          continue;
+        double n, e;
+        Vector(t + dt, i + di, j + dj, &n, &e);
+        north += w * n;
+        east += w * e;
+      }
+    }
+  }
+  *speed_m_s = sqrt(north * north + east * east);
+  *direction_from_deg = *speed_m_s > 0 ?
+      NormalizeDeg(Rad2Deg(atan2(east, north)) + 180) : 0;
+}
@@ -0,0 +1,61 @@
+// Copyright 2012 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+#ifndef SKIPPER_WIND_FIELD_H
+#define SKIPPER_WIND_FIELD_H
+
+#include <vector>
+
+/*
+A gridded wind forecast, e.g. converted from a GRIB file on shore and
+uploaded to the boat. The text file format is
+
+  # comment lines start with '#'
+  lat_min lon_min lat_step lon_step n_lat n_lon n_times time_0_s time_step_s
+  direction_from_deg speed_m_s
+  ...
+
+The header line is followed by n_times * n_lat * n_lon data lines, time
+slice by time slice, each slice ordered by latitude, then longitude, i.e.
+the line for (t, i_lat, i_lon) is t * n_lat * n_lon + i_lat * n_lon + i_lon.
+The direction is where the wind comes FROM, 0 is North, clockwise.
+time_0_s is the time of the first slice in seconds since the epoch.
+
+Between grid points and time slices the wind vector is interpolated
+(bilinear in space, linear in time). Outside of the grid or the time range
+the nearest border value is used.
+*/
+class WindField {
+ public:
+  WindField();
+
+  // Returns false if the file could not be read or is inconsistent.
+  bool Load(const char* filename);
+  bool Valid() const;
+
+  // Wind at the given position and time (seconds since the epoch).
+  void Get(double lat_deg, double lon_deg, double time_s,
+           double* direction_from_deg, double* speed_m_s) const;
+
+  // True if the position lies within the grid.
+  bool Covers(double lat_deg, double lon_deg) const;
+
+ private:
+  // Wind vector components (pointing where the wind blows to) at grid
+  // point (t, i, j), with clamped indices.
+  void Vector(int t, int i, int j, double* north, double* east) const;
+
+  double lat_min_;
+  double lon_min_;
+  double lat_step_;
+  double lon_step_;
+  int n_lat_;
+  int n_lon_;
+  int n_times_;
+  double time_0_s_;
+  double time_step_s_;
+  std::vector<double> north_;  // m/s
+  std::vector<double> east_;   // m/s
+};
+
+#endif  // SKIPPER_WIND_FIELD_H
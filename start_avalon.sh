@@ -93,9 +93,7 @@ for attempt in 1 ; do
     # input subsystems
 
     plug -i $LBUS -- `which imucat` /dev/imu &
-    plug -i $LBUS -- `which nmeacat` -b 19200 /dev/compass &
-    plug -i $LBUS -- `which nmeacat` -b 4800  /dev/wind &
-    plug -i $LBUS -- `which nmeacat` -b 4800  /dev/gps &
+    nmeacat -s $LBUS /dev/compass:19200 /dev/wind:4800 /dev/gps:4800 &
     #plug -i $LBUS -- `which nmeacat` -b 38400 -g 0 /dev/ais &   # no guard time
     
     # imutime dies if imu's timestamp is zero for too long, taking down the bus
@@ -113,7 +111,7 @@ for attempt in 1 ; do
 
     plug -p $EBUS -- `which rudderctl` -l -T &		# homing and positioning of left rudder
     plug -p $EBUS -- `which rudderctl` -r -T &		# homing and positioning of right rudder
-    plug -p $EBUS -- `which skewmon` -T &		# monitor sail motor/bmmh sensor angle skew
+    plug -p $EBUS -- `which skewmon` &		# monitor sail motor/bmmh sensor angle skew
     plug -p $EBUS -- `which sailctl` -T &		# positioning for sail
     plug -pi $EBUS -- `which eposprobe` -f 2 -T &    # periodically (-f Hz) issue status register probe commands (needed by drivests and eposmon)
     plug -o -n "eposmon" $EBUS -- `which eposmon` & # summarize and report epos communication errors to syslog
@@ -0,0 +1,203 @@
+// Copyright 2011 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "batch_util.h"
+
+#include <math.h>
+
+namespace skipper {
+namespace {
+// Same mean radius as in util.cc.
+static const double kEarthRadius = 6371009.0;  // meters
+
+static const double kTwoOverPi = 6.36619772367581382433e-01;
+// pi/2 split into a 33 bit head and a tail (as in fdlibm), so that k * head
+// is exact for the quadrant numbers we see.
+static const double kPiOver2Hi = 1.57079632673412561417e+00;
+static const double kPiOver2Lo = 6.07710050650619224932e-11;
+static const double kPiOver2 = 1.57079632679489661923;
+static const double kPiOver4 = 7.85398163397448309616e-01;
+// The part of pi/2 that does not fit into kPiOver2.
+static const double kMoreBits = 6.123233995736765886130e-17;
+
+// Minimax polynomials for sin and cos on [-pi/4, pi/4] (fdlibm kernels),
+// error below 2^-58.
+static const double kS1 = -1.66666666666666324348e-01;
+static const double kS2 =  8.33333333332248946124e-03;
+static const double kS3 = -1.98412698298579493134e-04;
+static const double kS4 =  2.75573137070700676789e-06;
+static const double kS5 = -2.50507602534068634195e-08;
+static const double kS6 =  1.58969099521155010221e-10;
+
+static const double kC1 =  4.16666666666666019037e-02;
+static const double kC2 = -1.38888888888741095749e-03;
+static const double kC3 =  2.48015872894767294178e-05;
+static const double kC4 = -2.75573143513906633035e-07;
+static const double kC5 =  2.08757232129817482790e-09;
+static const double kC6 = -1.13596475577881948265e-11;
+
+// Rational approximation of atan(x) = x + x^3 P(x^2) / Q(x^2) for
+// |x| <= 0.66 (Cephes), relative error below 2e-16.
+static const double kP0 = -8.750608600031904122785e-01;
+static const double kP1 = -1.615753718733365076637e+01;
+static const double kP2 = -7.500855792314704667340e+01;
+static const double kP3 = -1.228866684490136173410e+02;
+static const double kP4 = -6.485021904942025371773e+01;
+
+static const double kQ0 =  2.485846490142306297962e+01;
+static const double kQ1 =  1.650270098316988542046e+02;
+static const double kQ2 =  4.328810604912902668951e+02;
+static const double kQ3 =  4.853903996359136964868e+02;
+static const double kQ4 =  1.945506571482613964425e+02;
+
+// atan(t) for t in [0, 1].
+inline double AtanUnit(double t) {
+  bool big = t > 0.66;
+  double x = big ? (t - 1.0) / (t + 1.0) : t;
+  double offset = big ? kPiOver4 + 0.5 * kMoreBits : 0.0;
+  double z = x * x;
+  double p = (((kP0 * z + kP1) * z + kP2) * z + kP3) * z + kP4;
+  double q = ((((z + kQ0) * z + kQ1) * z + kQ2) * z + kQ3) * z + kQ4;
+  return offset + (x + x * z * p / q);
+}
+
+inline void SinCosInline(double x, double* s, double* c) {
+  // Range reduction to r in [-pi/4, pi/4] and quadrant k.
+  int k = static_cast<int>(x * kTwoOverPi + (x >= 0 ? 0.5 : -0.5));
+  double r = (x - k * kPiOver2Hi) - k * kPiOver2Lo;
+  double z = r * r;
+  double sin_r = r + r * z * (kS1 + z * (kS2 + z * (kS3 + z * (kS4 +
+                 z * (kS5 + z * kS6)))));
+  double cos_r = 1.0 - 0.5 * z + z * z * (kC1 + z * (kC2 + z * (kC3 +
+                 z * (kC4 + z * (kC5 + z * kC6)))));
+  int q = k & 3;
+  double sin_x = (q & 1) ? cos_r : sin_r;
+  double cos_x = (q & 1) ? sin_r : cos_r;
+  *s = (q & 2) ? -sin_x : sin_x;
+  *c = ((q + 1) & 2) ? -cos_x : cos_x;
+}
+
+inline double Atan2Inline(double y, double x) {
+  double ax = fabs(x);
+  double ay = fabs(y);
+  bool swap = ay > ax;
+  double num = swap ? ax : ay;
+  double den = swap ? ay : ax;
+  double a = AtanUnit(den > 0 ? num / den : 0.0);
+  a = swap ? kPiOver2 - a + kMoreBits : a;
+  a = x < 0 ? 2 * kPiOver2 - a + 2 * kMoreBits : a;
+  return y < 0 ? -a : a;
+}
+
+inline double AsinInline(double x) {
+  return Atan2Inline(x, sqrt((1.0 - x) * (1.0 + x)));
+}
+
+}  // namespace
+
+double FastSin(double x) {
+  double s, c;
+  SinCosInline(x, &s, &c);
+  return s;
+}
+
+double FastCos(double x) {
+  double s, c;
+  SinCosInline(x, &s, &c);
+  return c;
+}
+
+void FastSinCos(double x, double* s, double* c) {
+  SinCosInline(x, s, c);
+}
+
+double FastAtan2(double y, double x) {
+  return Atan2Inline(y, x);
+}
+
+double FastAsin(double x) {
+  return AsinInline(x);
+}
+
+void SphericalShortestPathBatch(double from_lat, double from_lon,
+                                const double* to_lat, const double* to_lon,
+                                int n,
+                                double* bearing_rad, double* distance_m) {
+  double sin_from, cos_from;
+  SinCosInline(from_lat, &sin_from, &cos_from);
+  for (int i = 0; i < n; ++i) {
+    double sin_to, cos_to;
+    double sin_hlat, cos_hlat;
+    double sin_hlon, cos_hlon;
+    SinCosInline(to_lat[i], &sin_to, &cos_to);
+    SinCosInline((to_lat[i] - from_lat) / 2, &sin_hlat, &cos_hlat);
+    SinCosInline((to_lon[i] - from_lon) / 2, &sin_hlon, &cos_hlon);
+
+    double a = sin_hlat * sin_hlat + cos_from * cos_to * sin_hlon * sin_hlon;
+    distance_m[i] = kEarthRadius * 2 * Atan2Inline(sqrt(a), sqrt(1 - a));
+
+    double sin_dlon = 2 * sin_hlon * cos_hlon;
+    double cos_dlon = 1 - 2 * sin_hlon * sin_hlon;
+    double rad = Atan2Inline(sin_dlon * cos_to,
+                             cos_from * sin_to - sin_from * cos_to * cos_dlon);
+    bearing_rad[i] = rad < 0 ? rad + 4 * kPiOver2 : rad;
+  }
+}
+
+void SphericalMoveBatch(const double* lat, const double* lon,
+                        const double* bearing_rad, const double* distance_m,
+                        int n,
+                        double* lat_out, double* lon_out) {
+  for (int i = 0; i < n; ++i) {
+    double sin_lat, cos_lat;
+    double sin_dist, cos_dist;
+    double sin_b, cos_b;
+    SinCosInline(lat[i], &sin_lat, &cos_lat);
+    SinCosInline(distance_m[i] / kEarthRadius, &sin_dist, &cos_dist);
+    SinCosInline(bearing_rad[i], &sin_b, &cos_b);
+
+    double sin_lat2 = sin_lat * cos_dist + cos_lat * sin_dist * cos_b;
+    double dlon = Atan2Inline(sin_b * sin_dist * cos_lat,
+                              cos_dist - sin_lat * sin_lat2);
+    double lon2 = lon[i] + dlon;
+    lat_out[i] = AsinInline(sin_lat2);
+    lon_out[i] = lon2;
+  }
+}
+
+void MinDistanceBatch(double a_rad, double u,
+                      const double* b_rad, const double* v,
+                      const double* a_b_rad, const double* distance_a_b,
+                      int n, double time_window_s,
+                      double* min_distance_m) {
+  for (int i = 0; i < n; ++i) {
+    double sin_alpha, cos_alpha;
+    double sin_beta, cos_beta;
+    SinCosInline(a_b_rad[i] - a_rad, &sin_alpha, &cos_alpha);
+    SinCosInline(b_rad[i] - a_b_rad[i] - 2 * kPiOver2, &sin_beta, &cos_beta);
+    double d = distance_a_b[i];
+
+    double px = v[i] * cos_beta + u * cos_alpha;
+    double py = v[i] * sin_beta - u * sin_alpha;
+
+    // Both candidate moments of minimum distance are computed and the right
+    // one is selected afterwards, see MinDistance in util.cc for the cases.
+    bool parallel = fabs(sin_alpha * cos_beta + sin_beta * cos_alpha) < 1e-9;
+    double v_proj = u + v[i] * (cos_alpha * cos_beta - sin_alpha * sin_beta);
+    bool same_motion = parallel && fabs(v_proj) < 1e-9;
+    double p2 = px * px + py * py;
+    double t_parallel = cos_alpha * d / (same_motion ? 1.0 : v_proj);
+    double t_crossing = d * px / (p2 > 0 ? p2 : 1.0);
+    double t = parallel ? t_parallel : t_crossing;
+    t = t < 0 ? 0 : t;
+    t = t > time_window_s ? time_window_s : t;
+
+    double dx = d - t * px;
+    double dy = t * py;
+    bool still = (u < 1e-9 && v[i] < 1e-9) || same_motion;
+    min_distance_m[i] = still ? d : sqrt(dx * dx + dy * dy);
+  }
+}
+
+}  // skipper
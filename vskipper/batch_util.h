@@ -0,0 +1,63 @@
+// Copyright 2011 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Batch versions of the great circle helpers in util.h.
+//
+// They operate on plain arrays (one array per coordinate) and replace the libm
+// calls by polynomial approximations, so the inner loops contain no function
+// calls and no data dependent branches and the compiler can vectorise them.
+// The same limitations as in util.h apply: short distances only and
+// DO NOT USE FOR LATITUDES ABOVE 70 OR BELOW -70 DEGREES!
+//
+// Maximum deviation from the exact versions in util.h, checked by
+// batch_util_test.cc over the Atlantic (lat -10..70, lon -90..20 degrees,
+// distances up to 200 km):
+//   bearings             < 1e-9 rad
+//   distances            < 1e-6 m
+//   moved positions      < 1e-11 rad (i.e. < 0.1 mm)
+//   MinDistance          < 1e-6 m
+// The building blocks have these absolute errors:
+//   FastSin, FastCos     < 5e-15 for |x| < 100
+//   FastAtan2            < 5e-16 rad
+//   FastAsin             < 1e-15 rad for |x| < 0.95
+
+#ifndef VSKIPPER_BATCH_UTIL_H
+#define VSKIPPER_BATCH_UTIL_H
+
+namespace skipper {
+
+double FastSin(double x);
+double FastCos(double x);
+// Sine and cosine of the same angle, cheaper than calling both.
+void FastSinCos(double x, double* s, double* c);
+// Result in [-pi, pi], like atan2.
+double FastAtan2(double y, double x);
+double FastAsin(double x);
+
+// For every i: shortest path from (from_lat, from_lon) to
+// (to_lat[i], to_lon[i]), all in radians. The bearing is returned in
+// [0, 2*pi) like Bearing::rad().
+void SphericalShortestPathBatch(double from_lat, double from_lon,
+                                const double* to_lat, const double* to_lon,
+                                int n,
+                                double* bearing_rad, double* distance_m);
+
+// For every i: moves from (lat[i], lon[i]) in direction bearing_rad[i] for
+// distance_m[i] meters. Output arrays may alias the input position arrays.
+void SphericalMoveBatch(const double* lat, const double* lon,
+                        const double* bearing_rad, const double* distance_m,
+                        int n,
+                        double* lat_out, double* lon_out);
+
+// For every i: MinDistance(a, u, b[i], v[i], a_b[i], distance_a_b[i],
+// time_window_s), i.e. one own candidate bearing against n other ships.
+void MinDistanceBatch(double a_rad, double u,
+                      const double* b_rad, const double* v,
+                      const double* a_b_rad, const double* distance_a_b,
+                      int n, double time_window_s,
+                      double* min_distance_m);
+
+}  // skipper
+
+#endif  // VSKIPPER_BATCH_UTIL_H
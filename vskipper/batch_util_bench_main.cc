@@ -0,0 +1,109 @@
+// Copyright 2011 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+//
+// Microbenchmark of the batch great circle kernels against the scalar
+// versions in util.h. Run with "make bench".
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "batch_util.h"
+#include "util.h"
+#include "common/convert.h"
+#include "common/now.h"
+
+using std::vector;
+using namespace skipper;
+
+namespace {
+const int kN = 1000;
+const int kRounds = 1000;
+
+double Uniform(double lo, double hi) {
+  return lo + rand() * (hi - lo) / RAND_MAX;
+}
+
+// Keeps the compiler from dropping the benchmarked work.
+double sink = 0;
+
+void Report(const char* name, int64_t scalar_us, int64_t batch_us) {
+  double calls = double(kN) * kRounds;
+  printf("%-22s scalar %7.1lf ns/call  batch %7.1lf ns/call  speedup %5.2lf\n",
+         name, scalar_us * 1000.0 / calls, batch_us * 1000.0 / calls,
+         double(scalar_us) / (batch_us > 0 ? batch_us : 1));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  vector<double> lat(kN), lon(kN), bearing(kN), dist(kN), speed(kN);
+  vector<double> a_b(kN), out1(kN), out2(kN);
+  vector<LatLon> pos(kN);
+  vector<Bearing> bear(kN);
+  for (int i = 0; i < kN; ++i) {
+    lat[i] = Deg2Rad(Uniform(-10, 70));
+    lon[i] = Deg2Rad(Uniform(-90, 20));
+    bearing[i] = Deg2Rad(Uniform(0, 360));
+    dist[i] = Uniform(0, 20000);
+    speed[i] = Uniform(0, 15);
+    pos[i] = LatLon(lat[i], lon[i]);
+    bear[i] = Bearing::Radians(bearing[i]);
+  }
+  for (int i = 0; i < kN; ++i) {
+    a_b[i] = bearing[(i + 1) % kN];
+  }
+  LatLon from = pos[0];
+
+  int64_t start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i < kN; ++i) {
+      Bearing b;
+      double d;
+      SphericalShortestPath(from, pos[i], &b, &d);
+      sink += d;
+    }
+  }
+  int64_t scalar_us = now_micros() - start;
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    SphericalShortestPathBatch(from.lat_rad(), from.lon_rad(), &lat[0], &lon[0],
+                               kN, &out1[0], &out2[0]);
+    sink += out2[r % kN];
+  }
+  Report("SphericalShortestPath", scalar_us, now_micros() - start);
+
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i < kN; ++i) {
+      sink += SphericalMove(pos[i], bear[i], dist[i]).lat_rad();
+    }
+  }
+  scalar_us = now_micros() - start;
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    SphericalMoveBatch(&lat[0], &lon[0], &bearing[0], &dist[0], kN,
+                       &out1[0], &out2[0]);
+    sink += out1[r % kN];
+  }
+  Report("SphericalMove", scalar_us, now_micros() - start);
+
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i < kN; ++i) {
+      sink += MinDistance(bear[r % kN], 2.0, bear[i], speed[i],
+                          bear[(i + 1) % kN], dist[i], 900);
+    }
+  }
+  scalar_us = now_micros() - start;
+  start = now_micros();
+  for (int r = 0; r < kRounds; ++r) {
+    MinDistanceBatch(bearing[r % kN], 2.0, &bearing[0], &speed[0],
+                     &a_b[0], &dist[0], kN, 900, &out1[0]);
+    sink += out1[r % kN];
+  }
+  Report("MinDistance", scalar_us, now_micros() - start);
+
+  fprintf(stderr, "(%lg)\n", sink);
+  return 0;
+}
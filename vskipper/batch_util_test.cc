@@ -0,0 +1,148 @@
+// Copyright 2011 The Avalon Project Authors. All rights reserved.
+// Use of this source code is governed by the Apache License 2.0
+// that can be found in the LICENSE file.
+
+#include "batch_util.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "util.h"
+#include "common/convert.h"
+#include "lib/testing/testing.h"
+
+using std::max;
+using std::vector;
+
+namespace skipper {
+
+namespace {
+double Uniform(double lo, double hi) {
+  return lo + rand() * (hi - lo) / RAND_MAX;
+}
+
+// The Atlantic domain of the error bounds in batch_util.h.
+const double kMinLatDeg = -10;
+const double kMaxLatDeg = 70;
+const double kMinLonDeg = -90;
+const double kMaxLonDeg = 20;
+const double kMaxDistance = 200e3;  // meters
+const int kSamples = 200000;
+}  // namespace
+
+ATEST(BatchUtil, Trigonometry) {
+  double max_sin = 0;
+  double max_cos = 0;
+  double max_atan2 = 0;
+  double max_asin = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    double x = Uniform(-100, 100);
+    max_sin = max(max_sin, fabs(FastSin(x) - sin(x)));
+    max_cos = max(max_cos, fabs(FastCos(x) - cos(x)));
+    double y = Uniform(-10, 10);
+    double z = Uniform(-10, 10);
+    max_atan2 = max(max_atan2, fabs(FastAtan2(y, z) - atan2(y, z)));
+    double a = Uniform(-0.95, 0.95);
+    max_asin = max(max_asin, fabs(FastAsin(a) - asin(a)));
+  }
+  // Special values
+  EXPECT_EQ(0.0, FastSin(0));
+  EXPECT_EQ(1.0, FastCos(0));
+  EXPECT_EQ(0.0, FastAtan2(0, 0));
+  EXPECT_FLOAT_EQ(M_PI, FastAtan2(0, -1));
+  EXPECT_FLOAT_EQ(-M_PI / 2, FastAtan2(-1, 0));
+
+  std::cerr << "max errors sin " << max_sin << " cos " << max_cos
+            << " atan2 " << max_atan2 << " asin " << max_asin << "\n";
+  EXPECT_LT(max_sin, 5e-15);
+  EXPECT_LT(max_cos, 5e-15);
+  EXPECT_LT(max_atan2, 5e-16);
+  EXPECT_LT(max_asin, 1e-15);
+}
+
+ATEST(BatchUtil, ShortestPathAndMove) {
+  vector<double> to_lat(kSamples);
+  vector<double> to_lon(kSamples);
+  vector<double> bearing(kSamples);
+  vector<double> dist(kSamples);
+  vector<double> lat(kSamples);
+  vector<double> lon(kSamples);
+  vector<double> lat_out(kSamples);
+  vector<double> lon_out(kSamples);
+
+  LatLon from = LatLon::Degrees(Uniform(kMinLatDeg, kMaxLatDeg),
+                                Uniform(kMinLonDeg, kMaxLonDeg));
+  for (int i = 0; i < kSamples; ++i) {
+    LatLon to = SphericalMove(from, Bearing::Degrees(Uniform(0, 360)),
+                              Uniform(0, kMaxDistance));
+    to_lat[i] = to.lat_rad();
+    to_lon[i] = to.lon_rad();
+    lat[i] = Deg2Rad(Uniform(kMinLatDeg, kMaxLatDeg));
+    lon[i] = Deg2Rad(Uniform(kMinLonDeg, kMaxLonDeg));
+  }
+  SphericalShortestPathBatch(from.lat_rad(), from.lon_rad(),
+                             &to_lat[0], &to_lon[0], kSamples,
+                             &bearing[0], &dist[0]);
+  SphericalMoveBatch(&lat[0], &lon[0], &bearing[0], &dist[0], kSamples,
+                     &lat_out[0], &lon_out[0]);
+
+  double max_bearing = 0;
+  double max_dist = 0;
+  double max_pos = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    Bearing b;
+    double d;
+    SphericalShortestPath(from, LatLon(to_lat[i], to_lon[i]), &b, &d);
+    max_bearing = max(max_bearing, fabs(SymmetricRad(bearing[i] - b.rad())));
+    max_dist = max(max_dist, fabs(dist[i] - d));
+
+    LatLon moved = SphericalMove(LatLon(lat[i], lon[i]),
+                                 Bearing::Radians(bearing[i]), dist[i]);
+    max_pos = max(max_pos, fabs(moved.lat_rad() - lat_out[i]));
+    max_pos = max(max_pos, fabs(moved.lon_rad() - lon_out[i]));
+  }
+  std::cerr << "max errors bearing " << max_bearing << " distance " << max_dist
+            << " position " << max_pos << "\n";
+  EXPECT_LT(max_bearing, 1e-9);
+  EXPECT_LT(max_dist, 1e-6);
+  EXPECT_LT(max_pos, 1e-11);
+}
+
+ATEST(BatchUtil, MinDistance) {
+  vector<double> b(kSamples);
+  vector<double> v(kSamples);
+  vector<double> a_b(kSamples);
+  vector<double> d(kSamples);
+  vector<double> out(kSamples);
+  for (int i = 0; i < kSamples; ++i) {
+    b[i] = Deg2Rad(Uniform(0, 360));
+    v[i] = i % 10 == 0 ? 0 : Uniform(0, 15);
+    a_b[i] = Deg2Rad(Uniform(0, 360));
+    d[i] = Uniform(0, 20000);
+  }
+  // Parallel and identical motion special cases.
+  b[1] = Deg2Rad(30); v[1] = 2; a_b[1] = Deg2Rad(100);
+  b[2] = Deg2Rad(210); v[2] = 2; a_b[2] = Deg2Rad(100);
+
+  double max_err = 0;
+  for (int step = 0; step < 360; step += 30) {
+    double a = Deg2Rad(step);
+    double u = step == 0 ? 0 : 2.0;
+    MinDistanceBatch(a, u, &b[0], &v[0], &a_b[0], &d[0], kSamples, 900,
+                     &out[0]);
+    for (int i = 0; i < kSamples; ++i) {
+      double expected = MinDistance(Bearing::Radians(a), u,
+                                    Bearing::Radians(b[i]), v[i],
+                                    Bearing::Radians(a_b[i]), d[i], 900);
+      max_err = max(max_err, fabs(expected - out[i]));
+    }
+  }
+  std::cerr << "max error MinDistance " << max_err << "\n";
+  EXPECT_LT(max_err, 1e-6);
+}
+
+}  // skipper
+
+int main(int argc, char **argv) {
+  return testing::RunAllTests();
+}
@@ -10,7 +10,8 @@
 #include <syslog.h>
 
 #include "common/normalize.h"
-#include "common/polar_diagram.h"
+#include "common/polar_table.h"
+#include "batch_util.h"
 #include "vskipper.h"
 
 using namespace std;
@@ -82,12 +83,8 @@ double ExpectedVelocity(Bearing wind_from,
     // TODO(zis): why doesn't ReadPolarDiagram do this?
     return 0;
   }
-  double speed_m_s;
-  bool dead_tack;
-  bool dead_jibe;
-  ReadPolarDiagram(wind_from.deg() - avalon.deg(), wind_speed_m_s,
-                   &dead_tack, &dead_jibe, &speed_m_s);
-  return speed_m_s;
+  return DefaultPolarTable().Speed(wind_from.deg() - avalon.deg(),
+                                   wind_speed_m_s);
 }
 
 // Returns how dangerous it is to be at @distance_m from another ship.
@@ -153,22 +150,35 @@ void SkipperImpl(const AvalonState& now,
         Bearing::Radians(NormalizeRad(now.target.rad() + i * M_PI / 180.0)) ));
   }
 
+  // The other ships as arrays for MinDistanceBatch.
+  const int n = ships.size();
+  std::vector<double> their_bearing(n), their_speed(n), us_them(n), distance(n);
+  std::vector<double> min_distance(n);
+  for (int k = 0; k < n; ++k) {
+    their_bearing[k] = ships[k].bearing.rad();
+    their_speed[k] = ships[k].speed_m_s;
+    us_them[k] = ships[k].us_them.rad();
+    distance[k] = ships[k].distance_m;
+  }
+
   for (size_t i = 0; i < candidates.size(); ++i) {
     CandidateBearing& c = candidates[i];
 
     c.expected_velocity_m_s =
         ExpectedVelocity(now.wind_from, now.wind_speed_m_s, c.bearing);
     c.bearing_diff = fabs(SymmetricDeg(c.bearing.deg() - now.target.deg()));
+    if (n == 0) continue;
 
     for (double wind_fraction = 0; wind_fraction < 2.01; wind_fraction += 0.2) {
       double danger = 0;
       double speed_m_s = wind_fraction * c.expected_velocity_m_s;
-      for (size_t k = 0; k < ships.size(); ++k) {
-        double dist = MinDistance(c.bearing, speed_m_s,
-                                  ships[k].bearing, ships[k].speed_m_s,
-                                  ships[k].us_them, ships[k].distance_m,
-                                  time_window_s);
-        danger = max(danger, WindFractionP(wind_fraction)*DistanceDanger(dist));
+      MinDistanceBatch(c.bearing.rad(), speed_m_s,
+                       &their_bearing[0], &their_speed[0],
+                       &us_them[0], &distance[0],
+                       n, time_window_s, &min_distance[0]);
+      for (int k = 0; k < n; ++k) {
+        danger = max(danger,
+                     WindFractionP(wind_fraction)*DistanceDanger(min_distance[k]));
       }
       c.danger += danger;
     }